@@ -229,6 +229,14 @@ static FAutoConsoleVariableRef CVarConsoleSpinMode(
 	ECVF_Cheat
 	);
 
+static int32 GWorkStealing = 0;
+static FAutoConsoleVariableRef CVarWorkStealing(
+	TEXT("TaskGraph.WorkStealing"),
+	GWorkStealing,
+	TEXT("If > 0, anythread tasks queued from a task thread go onto that thread's own deque instead of the shared queues. The thread runs its newest tasks first and idle task threads steal the oldest ones. Only active with TaskGraph.FastScheduler 0."),
+	ECVF_Cheat
+	);
+
 #if USE_NEW_LOCK_FREE_LISTS
 static int32 GMaxTasksToStartOnDequeue = 1;
 #else
@@ -333,6 +341,129 @@ private:
 
 };
 
+/** 
+ *	FWorkStealingTaskDeque
+ *	Fixed size work stealing deque (Chase-Lev) for the private tasks of an unnamed thread.
+ *	The owning thread pushes and pops at the bottom, any other thread can steal from the top.
+**/
+class FWorkStealingTaskDeque
+{
+public:
+	/** Constructor, sets the deque to the empty state. **/
+	FWorkStealingTaskDeque()
+		: Top(0)
+		, Bottom(0)
+	{
+		FMemory::Memzero(Tasks);
+	}
+
+	/** 
+	 *	Adds a task to the bottom of the deque. Only the owning thread may call this.
+	 *	@param Task; the task to add to the deque
+	 *	@return false if the deque is full, the caller has to queue the task elsewhere
+	**/
+	FORCEINLINE bool Push(FBaseGraphTask* Task)
+	{
+		const int32 LocalBottom = Bottom;
+		if (Distance(Top, LocalBottom) >= CAPACITY)
+		{
+			return false;
+		}
+		Tasks[LocalBottom & (CAPACITY - 1)] = Task;
+		// the task has to be visible before a thief can see the slot
+		FPlatformMisc::MemoryBarrier();
+		Bottom = Next(LocalBottom);
+		return true;
+	}
+
+	/** 
+	 *	Pops the newest task off the bottom of the deque. Only the owning thread may call this.
+	 *	@return The newest task or NULL if the deque is empty
+	**/
+	FORCEINLINE FBaseGraphTask* Pop()
+	{
+		const int32 LocalBottom = int32(uint32(Bottom) - 1);
+		// the interlocked exchange is a full barrier, thieves see the claimed slot before we look at Top
+		FPlatformAtomics::InterlockedExchange(&Bottom, LocalBottom);
+		const int32 LocalTop = Top;
+		const int32 NumLeft = Distance(LocalTop, LocalBottom);
+		if (NumLeft < 0)
+		{
+			// empty, undo the claim
+			Bottom = LocalTop;
+			return nullptr;
+		}
+		FBaseGraphTask* Task = Tasks[LocalBottom & (CAPACITY - 1)];
+		if (NumLeft > 0)
+		{
+			return Task;
+		}
+		// this is the last task, thieves might be racing us for it
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, Next(LocalTop), LocalTop) != LocalTop)
+		{
+			Task = nullptr;
+		}
+		Bottom = Next(LocalTop);
+		return Task;
+	}
+
+	/** 
+	 *	Steals the oldest task from the top of the deque. Can be called from any thread.
+	 *	@return The oldest task or NULL if the deque is empty or another thread took the task first
+	**/
+	FORCEINLINE FBaseGraphTask* Steal()
+	{
+		const int32 LocalTop = Top;
+		FPlatformMisc::MemoryBarrier();
+		const int32 LocalBottom = Bottom;
+		if (Distance(LocalTop, LocalBottom) <= 0)
+		{
+			return nullptr;
+		}
+		FBaseGraphTask* Task = Tasks[LocalTop & (CAPACITY - 1)];
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, Next(LocalTop), LocalTop) != LocalTop)
+		{
+			// the owner or another thief got it
+			return nullptr;
+		}
+		return Task;
+	}
+
+	/** Return true if the deque looks empty, this is only a guess unless called from the owning thread. **/
+	FORCEINLINE bool IsEmptyFast() const
+	{
+		return Distance(Top, Bottom) <= 0;
+	}
+
+private:
+	enum
+	{
+		/** Number of tasks the deque can hold, must be a power of two **/
+		CAPACITY=1024
+	};
+
+	/** Number of tasks between two positions. The positions wrap, so this is computed unsigned. **/
+	static FORCEINLINE int32 Distance(int32 From, int32 To)
+	{
+		return int32(uint32(To) - uint32(From));
+	}
+
+	/** Position after Index, wrapping. **/
+	static FORCEINLINE int32 Next(int32 Index)
+	{
+		return int32(uint32(Index) + 1);
+	}
+
+	/** Position of the oldest task, advanced by thieves and by the owner when it takes the last task. **/
+	MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) volatile int32 Top GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
+
+	/** Position after the newest task, only written by the owning thread. **/
+	MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) volatile int32 Bottom GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
+
+	/** Ring buffer of tasks, only the [Top,Bottom) range is valid. **/
+	FBaseGraphTask* Tasks[CAPACITY];
+};
+
 /** 
  *	FTaskThreadBase
  *	Base class for a thread that executes tasks
@@ -1033,6 +1164,27 @@ public:
 		return !!Queue.RecursionGuard;
 	}
 
+	/** 
+	 *	Queue a task on this thread's own deque for work stealing. Must be called from this thread.
+	 *	@param Task; Task to queue.
+	 *	@return false if the deque is full.
+	 **/
+	bool EnqueueLocal(FBaseGraphTask* Task)
+	{
+		checkThreadGraph(FPlatformTLS::GetTlsValue(PerThreadIDTLSSlot) == OwnerWorker);
+		return LocalTasks[ENamedThreads::GetPriority(Task->ThreadToExecuteOn)].Push(Task);
+	}
+
+	/** 
+	 *	Steal the oldest task of the given priority from this thread's deque. Can be called from any thread.
+	 *	@param Priority; Priority of the deque to steal from.
+	 *	@return the stolen task or NULL if there was nothing to steal.
+	 **/
+	FBaseGraphTask* StealLocal(int32 Priority)
+	{
+		return LocalTasks[Priority].IsEmptyFast() ? nullptr : LocalTasks[Priority].Steal();
+	}
+
 private:
 
 	/** 
@@ -1155,6 +1307,9 @@ private:
 
 	/** Array of queues, only the first one is used for unnamed threads. **/
 	FThreadTaskQueue Queue;
+
+	/** Tasks queued from this thread when work stealing, one deque per priority. **/
+	FWorkStealingTaskDeque LocalTasks[ENamedThreads::NumPriorities];
 };
 
 /** 
@@ -1346,6 +1501,10 @@ public:
 			TASKGRAPH_SCOPE_CYCLE_COUNTER(3, STAT_TaskGraph_QueueTask_AnyThread);
 			if (FPlatformProcess::SupportsMultithreading())
 			{
+				if (GWorkStealing && !GFastSchedulerLatched && QueueTaskOnCurrentWorker(Task, InCurrentThreadIfKnown))
+				{
+					return;
+				}
 				{
 					TASKGRAPH_SCOPE_CYCLE_COUNTER(4, STAT_TaskGraph_QueueTask_IncomingAnyThreadTasks_Push);
 					if (ENamedThreads::GetPriority(Task->ThreadToExecuteOn))
@@ -1562,6 +1721,71 @@ public:
 
 	// Scheduling utilities
 
+	/** 
+	 *	Work stealing: if the current thread is an unnamed thread, push an anythread task onto its own deque and make sure another thread is awake to steal it.
+	 *	@param	Task; the task to queue
+	 *	@param	InCurrentThreadIfKnown; This should be the current thread if it is known, or otherwise use ENamedThreads::AnyThread and the current thread will be determined.
+	 *	@return false if the task has to go through the shared queues instead.
+	**/
+	bool QueueTaskOnCurrentWorker(FBaseGraphTask* Task, ENamedThreads::Type InCurrentThreadIfKnown)
+	{
+		ENamedThreads::Type CurrentThread = ENamedThreads::GetThreadIndex(InCurrentThreadIfKnown);
+		if (CurrentThread == ENamedThreads::AnyThread)
+		{
+			CurrentThread = GetCurrentThread();
+		}
+		if (CurrentThread == ENamedThreads::AnyThread || CurrentThread < NumNamedThreads)
+		{
+			// named and unknown threads have no deque
+			return false;
+		}
+		if (!((FTaskThreadAnyThread&)Thread(CurrentThread)).EnqueueLocal(Task))
+		{
+			return false;
+		}
+
+		// same wake up policy as the shared queues; the owner drains its own deque anyway, so a missed wake up only costs parallelism
+		FTaskThreadBase* Thief = StalledUnnamedThreads.Pop();
+		if (!Thief || (GNumWorkerThreadsToIgnore && (Thief->GetThreadId() - NumNamedThreads) >= GetNumWorkerThreads()))
+		{
+			check(NextUnnamedThreadMod - GNumWorkerThreadsToIgnore > 0); // can't tune it to zero task threads
+			Thief = &Thread(ENamedThreads::Type((uint32(NextUnnamedThreadForTaskFromUnknownThread.Increment()) % uint32(NextUnnamedThreadMod - GNumWorkerThreadsToIgnore)) + NumNamedThreads));
+		}
+		if (Thief->GetThreadId() != CurrentThread)
+		{
+			Thief->WakeUp();
+		}
+		return true;
+	}
+
+	/** 
+	 *	Attempt to steal a task from the deque of another unnamed thread, high priority tasks first.
+	 *	@param	ThreadInNeed; Id of the thread requesting work.
+	 *	@return Task that was stolen if any was found.
+	**/
+	FBaseGraphTask* StealWork(ENamedThreads::Type ThreadInNeed)
+	{
+		const uint32 NumUnnamedThreads = uint32(NumThreads - NumNamedThreads);
+		// start at a different victim every time so thieves spread out
+		const uint32 FirstVictim = uint32(NextStealFromThread.Increment());
+		for (int32 Priority = ENamedThreads::NumPriorities - 1; Priority >= 0; Priority--)
+		{
+			for (uint32 Attempt = 0; Attempt < NumUnnamedThreads; Attempt++)
+			{
+				ENamedThreads::Type Victim = ENamedThreads::Type((FirstVictim + Attempt) % NumUnnamedThreads + NumNamedThreads);
+				if (Victim != ThreadInNeed)
+				{
+					FBaseGraphTask* Task = ((FTaskThreadAnyThread&)Thread(Victim)).StealLocal(Priority);
+					if (Task)
+					{
+						return Task;
+					}
+				}
+			}
+		}
+		return nullptr;
+	}
+
 	void StartTaskThread(int32 IndexToStart)
 	{
 		ENamedThreads::Type ThreadToWake = ENamedThreads::Type(IndexToStart + NumNamedThreads);
@@ -2188,7 +2412,25 @@ private:
 
 FBaseGraphTask* FTaskThreadAnyThread::FindWork()
 {
-	return FTaskGraphImplementation::Get().FindWork(ThreadId);
+	// our own newest tasks first, they were queued by the task we just ran and their data is likely still in cache
+	for (int32 Priority = ENamedThreads::NumPriorities - 1; Priority >= 0; Priority--)
+	{
+		if (!LocalTasks[Priority].IsEmptyFast())
+		{
+			FBaseGraphTask* Task = LocalTasks[Priority].Pop();
+			if (Task)
+			{
+				return Task;
+			}
+		}
+	}
+	FBaseGraphTask* Task = FTaskGraphImplementation::Get().FindWork(ThreadId);
+	// the fast scheduler marks us as stalled when it finds nothing, so we must not pick up work behind its back
+	if (!Task && !GFastSchedulerLatched)
+	{
+		Task = FTaskGraphImplementation::Get().StealWork(ThreadId);
+	}
+	return Task;
 }
 
 void FTaskThreadAnyThread::NotifyStalling()
@@ -0,0 +1,287 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** Log files end their lines the Windows way on Linux too, so they can be opened with Windows tools like the infamous notepad.exe */
+#if PLATFORM_LINUX
+	#define LOG_FILE_LINE_TERMINATOR_ANSI "\r\n"
+#else
+	#define LOG_FILE_LINE_TERMINATOR_ANSI LINE_TERMINATOR_ANSI
+#endif
+
+/**
+ * Writes a log file archive from its own thread.
+ *
+ * Logging threads queue lines that are already converted to UTF-8 in a ring buffer without taking a lock: a line
+ * reserves its space by advancing WritePos, is copied in, and is published by setting its size header last. The
+ * writer thread serializes the published lines in order, in batches, and hands their space back by advancing ReadPos.
+ */
+class FAsyncLogWriter : public FRunnable
+{
+public:
+	/** @return a writer with its thread running, or nullptr if the thread couldn't be created */
+	static FAsyncLogWriter* Create(FArchive& Ar)
+	{
+		uint32 BufferKB = 1024;
+		FParse::Value(FCommandLine::Get(), TEXT("LOGBUFFERKB="), BufferKB);
+
+		FAsyncLogWriter* Writer = new FAsyncLogWriter(Ar, FMath::RoundUpToPowerOfTwo(FMath::Clamp<uint32>(BufferKB, 16, 256 * 1024) * 1024));
+		if (!Writer->Thread)
+		{
+			delete Writer;
+			Writer = nullptr;
+		}
+		return Writer;
+	}
+
+	/**
+	 * @param InAr				Archive the lines are written to
+	 * @param InBufferSize		Size of the ring buffer, a power of two
+	 * @param bCreateThread		If false, lines are only written out by Flush() and by threads that can't drop them
+	 */
+	FAsyncLogWriter(FArchive& InAr, uint32 InBufferSize, bool bCreateThread = true)
+		: Ar(InAr)
+		, BufferSize(InBufferSize)
+		, WritePos(0)
+		, ReadPos(0)
+		, NumDroppedLines(0)
+		, StuckReadPos(0)
+		, bReadStuck(false)
+		, WorkEvent(FPlatformProcess::GetSynchEventFromPool())
+		, Thread(nullptr)
+	{
+		check(FMath::IsPowerOfTwo(BufferSize));
+		Buffer = (uint8*)FMemory::Malloc(BufferSize);
+		FMemory::Memzero(Buffer, BufferSize);
+
+		if (bCreateThread)
+		{
+			Thread = FRunnableThread::Create(this, TEXT("FAsyncLogWriter"), 0, TPri_BelowNormal);
+		}
+	}
+
+	/** Stops the thread and writes out everything still queued. */
+	virtual ~FAsyncLogWriter()
+	{
+		// Stops the thread and waits for it
+		delete Thread;
+		Thread = nullptr;
+
+		Flush();
+
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		FMemory::Free(Buffer);
+	}
+
+	/**
+	 * Queues a line for the writer thread.
+	 *
+	 * @param Data			UTF-8 line, with its terminator
+	 * @param Size			Size of the line in bytes
+	 * @param bMustNotDrop	If the buffer is full, the calling thread writes out queued lines until there is space, instead of dropping this one.
+	 *						If the oldest queued line doesn't get published in time, this line is written directly ahead of the queued ones.
+	 */
+	void Write(const ANSICHAR* Data, int32 Size, bool bMustNotDrop)
+	{
+		if (Size <= 0)
+		{
+			return;
+		}
+
+		const uint32 RecordSize = Align(sizeof(int32) + Size, sizeof(int32));
+		if (RecordSize > BufferSize)
+		{
+			// Never fits, write it directly after whatever is already queued
+			FScopeLock ArchiveLock(&ArchiveCritical);
+			SerializeQueuedLines();
+			Ar.Serialize(const_cast<ANSICHAR*>(Data), Size);
+			return;
+		}
+
+		double WaitStartTime = 0.0;
+		uint32 Reserved;
+		for (;;)
+		{
+			Reserved = (uint32)WritePos;
+			const uint32 Used = Reserved - (uint32)ReadPos;
+			if (Used + RecordSize <= BufferSize)
+			{
+				if ((uint32)FPlatformAtomics::InterlockedCompareExchange(&WritePos, (int32)(Reserved + RecordSize), (int32)Reserved) == Reserved)
+				{
+					// The writer thread also wakes up on its own, only hurry it up once the buffer starts filling up
+					if (Used < BufferSize / 4 && Used + RecordSize >= BufferSize / 4)
+					{
+						WorkEvent->Trigger();
+					}
+					break;
+				}
+			}
+			else if (!bMustNotDrop)
+			{
+				FPlatformAtomics::InterlockedIncrement(&NumDroppedLines);
+				WorkEvent->Trigger();
+				return;
+			}
+			else
+			{
+				// Don't wait for the writer thread, it may be the one that crashed
+				{
+					FScopeLock ArchiveLock(&ArchiveCritical);
+					if (SerializeQueuedLines())
+					{
+						continue;
+					}
+
+					// The oldest line is still being copied in by another thread, which may have been suspended or crashed
+					// before publishing it. Only wait for it for so long, and not at all once it already held up a line.
+					const double Now = FPlatformTime::Seconds();
+					if (WaitStartTime == 0.0)
+					{
+						WaitStartTime = Now;
+					}
+					if ((bReadStuck && StuckReadPos == (uint32)ReadPos) || (Now - WaitStartTime) * 1000.0 > MaxMustNotDropWaitMs)
+					{
+						bReadStuck = true;
+						StuckReadPos = (uint32)ReadPos;
+						Ar.Serialize(const_cast<ANSICHAR*>(Data), Size);
+						return;
+					}
+				}
+				FPlatformProcess::SleepNoStats(0.0f);
+			}
+		}
+
+		const uint32 Mask = BufferSize - 1;
+		const uint32 DataOffset = (Reserved + sizeof(int32)) & Mask;
+		const uint32 FirstPart = FMath::Min<uint32>(Size, BufferSize - DataOffset);
+		FMemory::Memcpy(Buffer + DataOffset, Data, FirstPart);
+		FMemory::Memcpy(Buffer, Data + FirstPart, Size - FirstPart);
+
+		// Publishes the line, the exchange is a full barrier so the writer thread can't see the size before the data
+		FPlatformAtomics::InterlockedExchange((volatile int32*)(Buffer + (Reserved & Mask)), Size);
+	}
+
+	/** @return the number of lines dropped since they were last noted in the log */
+	int32 GetNumDroppedLines() const
+	{
+		return NumDroppedLines;
+	}
+
+	/** Writes out everything queued on the calling thread and flushes the archive. */
+	void Flush()
+	{
+		FScopeLock ArchiveLock(&ArchiveCritical);
+		SerializeQueuedLines();
+		Ar.Flush();
+	}
+
+	// FRunnable interface.
+
+	virtual uint32 Run() override
+	{
+		while (StopTaskCounter.GetValue() == 0)
+		{
+			WorkEvent->Wait(WriterWaitTimeMs);
+
+			FScopeLock ArchiveLock(&ArchiveCritical);
+			SerializeQueuedLines();
+		}
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		StopTaskCounter.Increment();
+		WorkEvent->Trigger();
+	}
+
+private:
+	/** How long the writer thread sleeps when nobody wakes it up, which is as long as a line can sit in the buffer */
+	static const uint32 WriterWaitTimeMs = 50;
+
+	/** How long a line that can't be dropped waits for the oldest queued line to be published when the buffer is full */
+	static const uint32 MaxMustNotDropWaitMs = 100;
+
+	/**
+	 * Serializes the published lines at the front of the buffer and frees their space, and notes how many lines were dropped
+	 * since the last call. Stops at the first line that is still being copied in. The caller holds ArchiveCritical.
+	 *
+	 * @return true if anything was written
+	 */
+	bool SerializeQueuedLines()
+	{
+		const uint32 Mask = BufferSize - 1;
+		const uint32 Reserved = (uint32)WritePos;
+		const uint32 StartPos = (uint32)ReadPos;
+
+		uint32 Pos = StartPos;
+		while (Pos != Reserved)
+		{
+			volatile int32* Header = (volatile int32*)(Buffer + (Pos & Mask));
+			const int32 Size = *Header;
+			if (Size == 0)
+			{
+				break;
+			}
+			FPlatformMisc::MemoryBarrier();
+
+			const uint32 DataOffset = (Pos + sizeof(int32)) & Mask;
+			const uint32 FirstPart = FMath::Min<uint32>(Size, BufferSize - DataOffset);
+			Ar.Serialize(Buffer + DataOffset, FirstPart);
+			if (Size > (int32)FirstPart)
+			{
+				Ar.Serialize(Buffer, Size - FirstPart);
+			}
+
+			// The header of a later line can land anywhere in this record, it has to be zero again before the space is reused
+			const uint32 RecordSize = Align(sizeof(int32) + Size, sizeof(int32));
+			const uint32 RecordOffset = Pos & Mask;
+			const uint32 FirstZeroPart = FMath::Min<uint32>(RecordSize, BufferSize - RecordOffset);
+			FMemory::Memzero(Buffer + RecordOffset, FirstZeroPart);
+			FMemory::Memzero(Buffer, RecordSize - FirstZeroPart);
+
+			Pos += RecordSize;
+		}
+
+		if (Pos != StartPos)
+		{
+			bReadStuck = false;
+
+			// Full barrier, producers only see the space once it is zeroed
+			FPlatformAtomics::InterlockedExchange(&ReadPos, (int32)Pos);
+		}
+
+		const int32 NumDropped = FPlatformAtomics::InterlockedExchange(&NumDroppedLines, 0);
+		if (NumDropped > 0)
+		{
+			ANSICHAR Note[MAX_SPRINTF];
+			FCStringAnsi::Sprintf(Note, "[%d log lines dropped, the log file writer could not keep up]" LOG_FILE_LINE_TERMINATOR_ANSI, NumDropped);
+			Ar.Serialize(Note, FCStringAnsi::Strlen(Note));
+		}
+
+		return Pos != StartPos || NumDropped > 0;
+	}
+
+	/** The log file, only used while holding ArchiveCritical */
+	FArchive& Ar;
+	FCriticalSection ArchiveCritical;
+
+	/** Queued lines, each one is an int32 size header followed by the line and padded to a multiple of 4 bytes. Unused space is zero. */
+	uint8* Buffer;
+	/** Size of Buffer, a power of two */
+	const uint32 BufferSize;
+	/** Positions wrap around and are masked to offsets into Buffer. Everything before WritePos is reserved by producers. */
+	volatile int32 WritePos;
+	/** Everything before ReadPos has been written out */
+	volatile int32 ReadPos;
+	/** Lines dropped because the buffer was full, since the writer last noted them in the log */
+	volatile int32 NumDroppedLines;
+
+	/** ReadPos when the line there held up a line that can't be dropped for too long. Only used while holding ArchiveCritical. */
+	uint32 StuckReadPos;
+	bool bReadStuck;
+
+	FEvent* WorkEvent;
+	FThreadSafeCounter StopTaskCounter;
+	FRunnableThread* Thread;
+};
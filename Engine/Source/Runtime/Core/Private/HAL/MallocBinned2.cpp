@@ -159,6 +159,10 @@ struct FMallocBinned2::PoolHashBucket
 	{
 		After->Prev = Prev;
 		After->Next = this;
+
+		// FindPoolInfo walks the Next links without the mutex, so After has to be complete before it can be reached
+		FPlatformMisc::MemoryBarrier();
+
 		Prev ->Next = After;
 		this ->Prev = After;
 	}
@@ -172,6 +176,149 @@ struct FMallocBinned2::PoolHashBucket
 	}
 };
 
+/** A free block in a per-thread bundle. Only a pointer, so it fits in the smallest block size. */
+struct FMallocBinned2::FBundleNode
+{
+	FBundleNode* NextNodeInCurrentBundle;
+};
+
+/** Singly linked list of free blocks of one block size */
+struct FMallocBinned2::FBundle
+{
+	FBundleNode* Head;
+	uint32       Count;
+
+	FORCEINLINE void Reset()
+	{
+		Head  = nullptr;
+		Count = 0;
+	}
+
+	FORCEINLINE void PushHead(FBundleNode* Node)
+	{
+		Node->NextNodeInCurrentBundle = Head;
+		Head = Node;
+		Count++;
+	}
+
+	FORCEINLINE FBundleNode* PopHead()
+	{
+		FBundleNode* Result = Head;
+		Count--;
+		Head = Head->NextNodeInCurrentBundle;
+		return Result;
+	}
+};
+
+/**
+ * Lock free slots for full bundles of each block size. Blocks freed on one thread and allocated on another go through here
+ * instead of through the pools. A slot holds a whole bundle and is taken with a single compare and swap, so there's no ABA
+ * problem. Bundles in the recycler are always full, which is how their count is known.
+ */
+struct FMallocBinned2::FGlobalRecycler
+{
+	FBundleNode* FreeBundles[POOL_COUNT][BINNED2_MAX_GLOBAL_BUNDLES];
+
+	bool PushBundle(uint32 PoolIndex, FBundleNode* Bundle)
+	{
+		for (uint32 Slot = 0; Slot < BINNED2_MAX_GLOBAL_BUNDLES; ++Slot)
+		{
+			if (!FreeBundles[PoolIndex][Slot] && !FPlatformAtomics::InterlockedCompareExchangePointer((void**)&FreeBundles[PoolIndex][Slot], Bundle, nullptr))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FBundleNode* PopBundle(uint32 PoolIndex)
+	{
+		for (uint32 Slot = 0; Slot < BINNED2_MAX_GLOBAL_BUNDLES; ++Slot)
+		{
+			FBundleNode* Result = FreeBundles[PoolIndex][Slot];
+			if (Result && FPlatformAtomics::InterlockedCompareExchangePointer((void**)&FreeBundles[PoolIndex][Slot], nullptr, Result) == Result)
+			{
+				return Result;
+			}
+		}
+		return nullptr;
+	}
+};
+
+/**
+ * A thread's free blocks of one block size. Frees go to the partial bundle, when it's full it becomes the full bundle, and
+ * when both are full the full one is handed to the recycler. Allocations come from the partial bundle, then the full one,
+ * then a bundle from the recycler.
+ */
+struct FMallocBinned2::FFreeBlockList
+{
+	FBundle PartialBundle;
+	FBundle FullBundle;
+
+	FORCEINLINE bool CanPushToFront(uint32 BundleCapacity) const
+	{
+		return !FullBundle.Head || PartialBundle.Count < BundleCapacity;
+	}
+
+	/** Returns false if both bundles are full, RecycleFull() has to make room first */
+	FORCEINLINE bool PushToFront(void* Ptr, uint32 BundleCapacity)
+	{
+		if (PartialBundle.Count >= BundleCapacity)
+		{
+			if (FullBundle.Head)
+			{
+				return false;
+			}
+			FullBundle = PartialBundle;
+			PartialBundle.Reset();
+		}
+		PartialBundle.PushHead((FBundleNode*)Ptr);
+		return true;
+	}
+
+	FORCEINLINE void* PopFromFront()
+	{
+		if (!PartialBundle.Head && FullBundle.Head)
+		{
+			PartialBundle = FullBundle;
+			FullBundle.Reset();
+		}
+		return PartialBundle.Head ? PartialBundle.PopHead() : nullptr;
+	}
+
+	/** Hands the full bundle to the recycler. If the recycler has no room, returns its blocks for the caller to give back to the pools. */
+	FBundleNode* RecycleFull(FGlobalRecycler& Recycler, uint32 PoolIndex)
+	{
+		FBundleNode* Result = nullptr;
+		if (FullBundle.Head)
+		{
+			if (!Recycler.PushBundle(PoolIndex, FullBundle.Head))
+			{
+				Result = FullBundle.Head;
+			}
+			FullBundle.Reset();
+		}
+		return Result;
+	}
+
+	/** Takes a bundle from the recycler if this list is empty */
+	bool ObtainRecycledPartial(FGlobalRecycler& Recycler, uint32 PoolIndex, uint32 BundleCapacity)
+	{
+		if (!PartialBundle.Head)
+		{
+			PartialBundle.Head  = Recycler.PopBundle(PoolIndex);
+			PartialBundle.Count = PartialBundle.Head ? BundleCapacity : 0;
+		}
+		return PartialBundle.Head != nullptr;
+	}
+};
+
+/** Free block lists for every small block size, one per thread that called SetupTLSCachesOnCurrentThread() */
+struct FMallocBinned2::FPerThreadFreeBlockLists
+{
+	FFreeBlockList FreeLists[POOL_COUNT];
+};
+
 struct FMallocBinned2::Private
 {
 	static_assert(ARRAY_COUNT(GMallocBinned2BlockSizes) == POOL_COUNT, "Block size array size must match POOL_COUNT");
@@ -201,8 +348,6 @@ struct FMallocBinned2::Private
 		// keep track of memory lost to padding
 		Table->TotalWaste += Table->BlockSize - Size;
 		Table->TotalRequests++;
-		Table->ActiveRequests++;
-		Table->MaxActiveRequests = FMath::Max(Table->MaxActiveRequests, Table->ActiveRequests);
 		Table->MaxRequest = Size > Table->MaxRequest ? Size : Table->MaxRequest;
 		Table->MinRequest = Size < Table->MinRequest ? Size : Table->MinRequest;
 #endif
@@ -232,7 +377,8 @@ struct FMallocBinned2::Private
 	/** 
 	 * Gets the FPoolInfo for a memory address. If no valid info exists one is created. 
 	 * NOTE: This function requires a mutex across threads, but it's the caller's responsibility to 
-	 * acquire the mutex before calling
+	 * acquire the mutex before calling. FindPoolInfo() doesn't take the mutex, so buckets are only
+	 * published once their key and indirect table are set.
 	 */
 	static /*FORCEINLINE*/ FPoolInfo* GetPoolInfo(FMallocBinned2& Allocator, void* InPtr)
 	{
@@ -247,8 +393,9 @@ struct FMallocBinned2::Private
 		{
 			if (!Collision->FirstPool)
 			{
-				Collision->Key       = Key;
 				Collision->FirstPool = CreateIndirect(Allocator);
+				FPlatformMisc::MemoryBarrier();
+				Collision->Key       = Key;
 
 				return &Collision->FirstPool[PoolIndex];
 			}
@@ -296,6 +443,7 @@ struct FMallocBinned2::Private
 
 		NewBucket->Key = Key;
 
+		FPlatformMisc::MemoryBarrier();
 		Allocator.HashBuckets[Hash].Link(NewBucket);
 
 		return &NewBucket->FirstPool[PoolIndex];
@@ -402,6 +550,10 @@ struct FMallocBinned2::Private
 	{
 		// Pick first available block and unlink it.
 		Pool->Taken++;
+#if STATS
+		Table.ActiveRequests++;
+		Table.MaxActiveRequests = FMath::Max(Table.MaxActiveRequests, Table.ActiveRequests);
+#endif
 		checkSlow(Pool->TableIndex < Allocator.BinnedOSTableIndex); // if this is false, FirstMem is actually a size not a pointer
 		checkSlow(Pool->FirstMem);
 		checkSlow(Pool->FirstMem->NumFreeBlocks > 0);
@@ -421,6 +573,68 @@ struct FMallocBinned2::Private
 		return Align(Free, Alignment);
 	}
 
+	/** 
+	 * Gives a block back to its pool, and the pool back to the OS if it was the last block taken from it.
+	 * Requires the allocator mutex.
+	 */
+	static void FreePooledBlock(FMallocBinned2& Allocator, FPoolTable* Table, FPoolInfo* Pool, void* Ptr, void* BasePtr)
+	{
+#if STATS
+		Table->ActiveRequests--;
+#endif
+		// If this pool was exhausted, move to available list.
+		if (!Pool->FirstMem)
+		{
+			Pool->Unlink();
+			Pool->Link(Table->FirstPool);
+		}
+
+		// Free a pooled allocation.
+		FFreeMem* Free		= (FFreeMem*)Ptr;
+		Free->NumFreeBlocks	= 1;
+		Free->Next			= Pool->FirstMem;
+		Pool->FirstMem		= Free;
+		BINNED2_ADD_STATCOUNTER(Allocator.Stats.UsedCurrent, -(int64)Table->BlockSize);
+
+		// Free this pool.
+		checkSlow(Pool->Taken >= 1);
+		if( --Pool->Taken == 0 )
+		{
+#if STATS
+			Table->NumActivePools--;
+#endif
+			// Free the OS memory.
+			SIZE_T OsBytes = Pool->GetOsBytes(Allocator.PageSize, Allocator.BinnedOSTableIndex);
+			BINNED2_ADD_STATCOUNTER(Allocator.Stats.OsCurrent,    -(int64)OsBytes);
+			BINNED2_ADD_STATCOUNTER(Allocator.Stats.WasteCurrent, -(int64)(OsBytes - Pool->AllocSize));
+			Pool->Unlink();
+			Pool->SetAllocationSizes(0, 0, 0, Allocator.BinnedOSTableIndex);
+			Allocator.CachedOSPageAllocator.Free(BasePtr, OsBytes);
+		}
+	}
+
+	/** Gives every block of a bundle back to its pool. Requires the allocator mutex. */
+	static void FreeBundles(FMallocBinned2& Allocator, FBundleNode* Node)
+	{
+		while (Node)
+		{
+			FBundleNode* NextNode = Node->NextNodeInCurrentBundle;
+
+			void* BasePtr;
+			FPoolInfo* Pool = FindPoolInfo(Allocator, Node, BasePtr);
+			checkSlow(Pool && Pool->TableIndex < Allocator.BinnedOSTableIndex);
+			FreePooledBlock(Allocator, Allocator.MemSizeToPoolTable[Pool->TableIndex], Pool, Node, BasePtr);
+
+			Node = NextNode;
+		}
+	}
+
+	/** The calling thread's free block lists, or null if it doesn't cache blocks */
+	static FORCEINLINE FPerThreadFreeBlockLists* GetFreeBlockLists(FMallocBinned2& Allocator)
+	{
+		return (FPerThreadFreeBlockLists*)FPlatformTLS::GetTlsValue(Allocator.FreeBlockListsTlsSlot);
+	}
+
 #if	STATS
 	static void UpdateSlackStat(FMallocBinned2& Allocator)
 	{
@@ -442,7 +656,10 @@ void FMallocBinned2::GetAllocatorStats( FGenericMemoryStats& out_Stats )
 	FMalloc::GetAllocatorStats( out_Stats );
 
 #if	STATS
-	Private::UpdateSlackStat(*this);
+	{
+		FScopeLock Lock(&Mutex);
+		Private::UpdateSlackStat(*this);
+	}
 
 	// Malloc binned stats.
 	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_OsCurrent ),     Stats.OsCurrent );
@@ -485,6 +702,7 @@ FMallocBinned2::FMallocBinned2(uint32 InPageSize, uint64 AddressLimit)
 	, BinnedSizeLimit      (Private::PAGE_SIZE_LIMIT / 2)
 	, BinnedOSTableIndex   (BinnedSizeLimit + EXTENDED_PAGE_POOL_ALLOCATION_COUNT)
 	, HashBucketFreeList   (nullptr)
+	, FreeBlockListsTlsSlot(FPlatformTLS::AllocTlsSlot())
 {
 	check(FMath::IsPowerOfTwo(PageSize));
 	check(FMath::IsPowerOfTwo(AddressLimit));
@@ -500,7 +718,8 @@ FMallocBinned2::FMallocBinned2(uint32 InPageSize, uint64 AddressLimit)
 
 	for (uint32 Index = 0; Index != POOL_COUNT; ++Index)
 	{
-		PoolTable[Index].BlockSize  = GMallocBinned2BlockSizes[Index];
+		PoolTable[Index].BlockSize      = GMallocBinned2BlockSizes[Index];
+		PoolTable[Index].BundleCapacity = FMath::Min<uint32>(BINNED2_BUNDLE_MAX_COUNT, FMath::DivideAndRoundUp<uint32>(BINNED2_BUNDLE_MAX_SIZE, GMallocBinned2BlockSizes[Index]));
 #if STATS
 		PoolTable[Index].MinRequest = GMallocBinned2BlockSizes[Index];
 #endif
@@ -526,6 +745,10 @@ FMallocBinned2::FMallocBinned2(uint32 InPageSize, uint64 AddressLimit)
 		new (HashBuckets + i) PoolHashBucket();
 	}
 
+	check(FPlatformTLS::IsValidTlsSlot(FreeBlockListsTlsSlot));
+	Recycler = (FGlobalRecycler*)FPlatformMemory::BinnedAllocFromOS(Align(sizeof(FGlobalRecycler), PageSize));
+	FMemory::Memzero(Recycler, sizeof(FGlobalRecycler));
+
 	check(MAX_POOLED_ALLOCATION_SIZE - 1 == PoolTable[POOL_COUNT - 1].BlockSize);
 }
 
@@ -535,7 +758,59 @@ FMallocBinned2::~FMallocBinned2()
 
 bool FMallocBinned2::IsInternallyThreadSafe() const
 { 
-	return false;
+	return true;
+}
+
+void FMallocBinned2::SetupTLSCachesOnCurrentThread()
+{
+	if (Private::GetFreeBlockLists(*this))
+	{
+		return;
+	}
+
+	// Not allocated from the pools, the lists would otherwise be freed into themselves
+	const SIZE_T ListsSize = Align(sizeof(FPerThreadFreeBlockLists), PageSize);
+	FPerThreadFreeBlockLists* Lists = (FPerThreadFreeBlockLists*)FPlatformMemory::BinnedAllocFromOS(ListsSize);
+	if (!Lists)
+	{
+		Private::OutOfMemory(ListsSize);
+	}
+	FMemory::Memzero(Lists, sizeof(FPerThreadFreeBlockLists));
+
+	BINNED2_PEAK_STATCOUNTER(Stats.OsPeak,    BINNED2_ADD_STATCOUNTER(Stats.OsCurrent,    (int64)ListsSize));
+	BINNED2_PEAK_STATCOUNTER(Stats.WastePeak, BINNED2_ADD_STATCOUNTER(Stats.WasteCurrent, (int64)ListsSize));
+
+	FPlatformTLS::SetTlsValue(FreeBlockListsTlsSlot, Lists);
+}
+
+void FMallocBinned2::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	FPerThreadFreeBlockLists* Lists = Private::GetFreeBlockLists(*this);
+	if (!Lists)
+	{
+		return;
+	}
+	FPlatformTLS::SetTlsValue(FreeBlockListsTlsSlot, nullptr);
+
+	{
+		FScopeLock Lock(&Mutex);
+		for (uint32 PoolIndex = 0; PoolIndex < POOL_COUNT; ++PoolIndex)
+		{
+			FFreeBlockList& List = Lists->FreeLists[PoolIndex];
+
+			// Full bundles can still be used by other threads, partial ones go back to the pools
+			if (FBundleNode* Nodes = List.RecycleFull(*Recycler, PoolIndex))
+			{
+				Private::FreeBundles(*this, Nodes);
+			}
+			Private::FreeBundles(*this, List.PartialBundle.Head);
+		}
+	}
+
+	const SIZE_T ListsSize = Align(sizeof(FPerThreadFreeBlockLists), PageSize);
+	BINNED2_ADD_STATCOUNTER(Stats.OsCurrent,    -(int64)ListsSize);
+	BINNED2_ADD_STATCOUNTER(Stats.WasteCurrent, -(int64)ListsSize);
+	FPlatformMemory::BinnedFreeToOS(Lists);
 }
 
 void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
@@ -560,6 +835,25 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 
 		checkSlow(Size <= Table->BlockSize);
 
+		// Any block of this size fits the aligned allocation, the padding for it is already in Size
+		const uint32 PoolIndex = Table - PoolTable;
+		FPerThreadFreeBlockLists* Lists = Private::GetFreeBlockLists(*this);
+		if (Lists)
+		{
+			FFreeBlockList& List = Lists->FreeLists[PoolIndex];
+			void* Block = List.PopFromFront();
+			if (!Block && List.ObtainRecycledPartial(*Recycler, PoolIndex, Table->BundleCapacity))
+			{
+				Block = List.PopFromFront();
+			}
+			if (Block)
+			{
+				return Align(Block, Alignment);
+			}
+		}
+
+		FScopeLock Lock(&Mutex);
+
 		Private::TrackStats(Table, Size);
 
 		FPoolInfo* Pool = Table->FirstPool;
@@ -569,6 +863,17 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 		}
 
 		FFreeMem* Result = Private::AllocateBlockFromPool(*this, *Table, Pool, Alignment);
+
+		// While the lock is held, take some more blocks for this thread so its next allocations don't need it
+		if (Lists)
+		{
+			FFreeBlockList& List = Lists->FreeLists[PoolIndex];
+			for (int32 Index = 0; Index < BINNED2_ALLOC_EXTRA && Table->FirstPool && List.CanPushToFront(Table->BundleCapacity); ++Index)
+			{
+				FFreeMem* Extra = Private::AllocateBlockFromPool(*this, *Table, Table->FirstPool, Private::DEFAULT_BINNED_ALLOCATOR_ALIGNMENT);
+				verify(List.PushToFront(Extra, Table->BundleCapacity));
+			}
+		}
 		return Result;
 	}
 
@@ -581,6 +886,8 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 
 		checkSlow(Size <= Table->BlockSize);
 
+		FScopeLock Lock(&Mutex);
+
 		Private::TrackStats(Table, Size);
 
 		FPoolInfo* Pool = Table->FirstPool;
@@ -594,6 +901,8 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 	}
 
 	// Use OS for large allocations.
+	FScopeLock Lock(&Mutex);
+
 	UPTRINT AlignedSize = Align(Size, PageSize);
 	FFreeMem* Result = (FFreeMem*)CachedOSPageAllocator.Allocate(AlignedSize);
 	if (!Result)
@@ -726,15 +1035,6 @@ void FMallocBinned2::Free( void* Ptr )
 	if (Pool->TableIndex < BinnedOSTableIndex)
 	{
 		FPoolTable* Table = MemSizeToPoolTable[Pool->TableIndex];
-#if STATS
-		Table->ActiveRequests--;
-#endif
-		// If this pool was exhausted, move to available list.
-		if (!Pool->FirstMem)
-		{
-			Pool->Unlink();
-			Pool->Link(Table->FirstPool);
-		}
 
 		check((UPTRINT)BasePtr <= (UPTRINT)Ptr);
 
@@ -743,28 +1043,29 @@ void FMallocBinned2::Free( void* Ptr )
 		// Patch pointer to include previously applied alignment.
 		Ptr = (void*)((PTRINT)Ptr - (PTRINT)AlignOffset);
 
-		// Free a pooled allocation.
-		FFreeMem* Free		= (FFreeMem*)Ptr;
-		Free->NumFreeBlocks	= 1;
-		Free->Next			= Pool->FirstMem;
-		Pool->FirstMem		= Free;
-		BINNED2_ADD_STATCOUNTER(Stats.UsedCurrent, -(int64)Table->BlockSize);
-
-		// Free this pool.
-		checkSlow(Pool->Taken >= 1);
-		if( --Pool->Taken == 0 )
+		// Keep small blocks in this thread's free block lists. The page pool tables aren't cached.
+		FPerThreadFreeBlockLists* Lists = Private::GetFreeBlockLists(*this);
+		if (Lists && Table < PoolTable + POOL_COUNT)
 		{
-#if STATS
-			Table->NumActivePools--;
-#endif
-			// Free the OS memory.
-			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-			BINNED2_ADD_STATCOUNTER(Stats.OsCurrent,    -(int64)OsBytes);
-			BINNED2_ADD_STATCOUNTER(Stats.WasteCurrent, -(int64)(OsBytes - Pool->AllocSize));
-			Pool->Unlink();
-			Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
-			CachedOSPageAllocator.Free(BasePtr, OsBytes);
+			const uint32 PoolIndex = Table - PoolTable;
+			FFreeBlockList& List = Lists->FreeLists[PoolIndex];
+			if (List.PushToFront(Ptr, Table->BundleCapacity))
+			{
+				return;
+			}
+
+			// Both bundles are full, pass one on to other threads, or back to the pools if enough are waiting already
+			if (FBundleNode* Nodes = List.RecycleFull(*Recycler, PoolIndex))
+			{
+				FScopeLock Lock(&Mutex);
+				Private::FreeBundles(*this, Nodes);
+			}
+			verify(List.PushToFront(Ptr, Table->BundleCapacity));
+			return;
 		}
+
+		FScopeLock Lock(&Mutex);
+		Private::FreePooledBlock(*this, Table, Pool, Ptr, BasePtr);
 	}
 	else
 	{
@@ -772,6 +1073,8 @@ void FMallocBinned2::Free( void* Ptr )
 		checkSlow(IsAligned(Ptr, PageSize));
 		SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
 
+		FScopeLock Lock(&Mutex);
+
 		BINNED2_ADD_STATCOUNTER(Stats.UsedCurrent,  -(int64)Pool->AllocSize);
 		BINNED2_ADD_STATCOUNTER(Stats.OsCurrent,    -(int64)OsBytes);
 		BINNED2_ADD_STATCOUNTER(Stats.WasteCurrent, -(int64)(OsBytes - Pool->AllocSize));
@@ -793,6 +1096,8 @@ bool FMallocBinned2::GetAllocationSize(void* Original, SIZE_T& SizeOut)
 
 bool FMallocBinned2::ValidateHeap()
 {
+	FScopeLock Lock(&Mutex);
+
 	for (FPoolTable& Table : PoolTable)
 	{
 		for( FPoolInfo** PoolPtr = &Table.FirstPool; *PoolPtr; PoolPtr = &(*PoolPtr)->Next )
@@ -820,8 +1125,10 @@ void FMallocBinned2::UpdateStats()
 {
 	FMalloc::UpdateStats();
 #if STATS
-
-	Private::UpdateSlackStat(*this);
+	{
+		FScopeLock Lock(&Mutex);
+		Private::UpdateSlackStat(*this);
+	}
 
 	SET_MEMORY_STAT( STAT_Binned2_OsCurrent,     Stats.OsCurrent );
 	SET_MEMORY_STAT( STAT_Binned2_OsPeak,        Stats.OsPeak );
@@ -839,6 +1146,8 @@ void FMallocBinned2::DumpAllocatorStats( class FOutputDevice& Ar )
 {
 	FBufferedOutputDevice BufferedOutput;
 	{
+		FScopeLock Lock(&Mutex);
+
 		ValidateHeap();
 #if STATS
 		Private::UpdateSlackStat(*this);
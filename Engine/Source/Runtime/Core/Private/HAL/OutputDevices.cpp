@@ -7,6 +7,7 @@
 #include "CorePrivatePCH.h"
 #include "Misc/App.h"
 #include "Templates/UniquePtr.h"
+#include "HAL/AsyncLogWriter.h"
 #include <stdio.h>
 
 // #if _MSC_VER
@@ -727,7 +728,10 @@ FLogScopedVerbosityOverride::~FLogScopedVerbosityOverride()
 FOutputDeviceRedirector::FOutputDeviceRedirector()
 :	MasterThreadID(FPlatformTLS::GetCurrentThreadId())
 ,	bEnableBacklog(false)
+,	AnyThreadCallEpoch(0)
 {
+	NumAnyThreadCalls[0] = 0;
+	NumAnyThreadCalls[1] = 0;
 }
 
 FOutputDeviceRedirector* FOutputDeviceRedirector::Get()
@@ -758,8 +762,37 @@ void FOutputDeviceRedirector::AddOutputDevice( FOutputDevice* OutputDevice )
  */
 void FOutputDeviceRedirector::RemoveOutputDevice( FOutputDevice* OutputDevice )
 {
-	FScopeLock ScopeLock( &SynchronizationObject );
-	OutputDevices.Remove( OutputDevice );
+	int32 PreviousEpoch;
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		OutputDevices.Remove( OutputDevice );
+		PreviousEpoch = UnsynchronizedBeginAnyThreadCallEpoch();
+	}
+
+	// Secondary threads may still be calling the device outside the lock, the caller is free to delete it once they are done
+	WaitForAnyThreadCalls( PreviousEpoch );
+}
+
+/**
+ * Starts a new epoch for calls to devices that can be used on any thread.
+ * Assumes that the caller holds a lock on SynchronizationObject.
+ *
+ * @return the epoch that ended, calls started in it may still be using devices that were removed before it ended
+ */
+int32 FOutputDeviceRedirector::UnsynchronizedBeginAnyThreadCallEpoch()
+{
+	const int32 PreviousEpoch = AnyThreadCallEpoch;
+	AnyThreadCallEpoch ^= 1;
+	return PreviousEpoch;
+}
+
+/** Waits for the calls to devices that can be used on any thread started in Epoch to return. Must not hold SynchronizationObject. */
+void FOutputDeviceRedirector::WaitForAnyThreadCalls( int32 Epoch )
+{
+	while( NumAnyThreadCalls[Epoch] > 0 )
+	{
+		FPlatformProcess::SleepNoStats( 0.0f );
+	}
 }
 
 /**
@@ -788,7 +821,7 @@ void FOutputDeviceRedirector::UnsynchronizedFlushThreadedLogs( bool bUseAllDevic
 		for( int32 OutputDeviceIndex=0; OutputDeviceIndex<OutputDevices.Num(); OutputDeviceIndex++ )
 		{
 			FOutputDevice* OutputDevice = OutputDevices[OutputDeviceIndex];
-			if( OutputDevice->CanBeUsedOnAnyThread() || bUseAllDevices )
+			if( OutputDevice->CanBeUsedOnAnyThread() ? !BufferedLine.bSentToAnyThreadDevices : bUseAllDevices )
 			{
 				OutputDevice->Serialize( *BufferedLine.Data, BufferedLine.Verbosity, BufferedLine.Category, BufferedLine.Time );
 			}
@@ -881,42 +914,80 @@ void FOutputDeviceRedirector::Serialize( const TCHAR* Data, ELogVerbosity::Type
 {
 	const double RealTime = Time == -1.0f ? FPlatformTime::Seconds() - GStartTime : Time;
 
-	FScopeLock ScopeLock( &SynchronizationObject );
+	// Devices that can be used on any thread, like the log file, get lines from secondary threads right away instead of waiting
+	// for the master thread. They are called once the lock is released so logging threads don't wait on each other's device I/O.
+	// The call is counted in the current epoch, so a device that is removed meanwhile isn't deleted until it returns.
+	TArray<FOutputDevice*, TInlineAllocator<16>> AnyThreadDevices;
+	int32 CallEpoch = 0;
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
 
 #if PLATFORM_DESKTOP
-	// this is for errors which occur after shutdown we might be able to salvage information from stdout 
-	if ((OutputDevices.Num() == 0)&& GIsRequestingExit)
-	{
+		// this is for errors which occur after shutdown we might be able to salvage information from stdout 
+		if ((OutputDevices.Num() == 0)&& GIsRequestingExit)
+		{
 #if PLATFORM_WINDOWS
-		_tprintf(_T("%s\n"), Data);
+			_tprintf(_T("%s\n"), Data);
 #else
-		FGenericPlatformMisc::LocalPrint(Data);
-		// printf("%s\n", TCHAR_TO_ANSI(Data));
+			FGenericPlatformMisc::LocalPrint(Data);
+			// printf("%s\n", TCHAR_TO_ANSI(Data));
 #endif
-		return;
-	}
+			return;
+		}
 #endif
 
 
-	if ( bEnableBacklog )
-	{
-		new(BacklogLines)FBufferedLine( Data, Category, Verbosity, RealTime );
-	}
+		if ( bEnableBacklog )
+		{
+			new(BacklogLines)FBufferedLine( Data, Category, Verbosity, RealTime );
+		}
 
-	if(FPlatformTLS::GetCurrentThreadId() != MasterThreadID || OutputDevices.Num() == 0)
-	{
-		new(BufferedLines)FBufferedLine( Data, Category, Verbosity, RealTime );
+		if( OutputDevices.Num() == 0 )
+		{
+			new(BufferedLines)FBufferedLine( Data, Category, Verbosity, RealTime );
+		}
+		else if( FPlatformTLS::GetCurrentThreadId() != MasterThreadID )
+		{
+			for( int32 OutputDeviceIndex=0; OutputDeviceIndex<OutputDevices.Num(); OutputDeviceIndex++ )
+			{
+				FOutputDevice* OutputDevice = OutputDevices[OutputDeviceIndex];
+				if( OutputDevice->CanBeUsedOnAnyThread() )
+				{
+					AnyThreadDevices.Add( OutputDevice );
+				}
+			}
+
+			if( AnyThreadDevices.Num() < OutputDevices.Num() )
+			{
+				new(BufferedLines)FBufferedLine( Data, Category, Verbosity, RealTime, true );
+			}
+
+			if( AnyThreadDevices.Num() > 0 )
+			{
+				CallEpoch = AnyThreadCallEpoch;
+				FPlatformAtomics::InterlockedIncrement( &NumAnyThreadCalls[CallEpoch] );
+			}
+		}
+		else
+		{
+			// Flush previously buffered lines from secondary threads.
+			// Since we already hold a lock on SynchronizationObject, call the unsynchronized version.
+			UnsynchronizedFlushThreadedLogs( true );
+
+			for( int32 OutputDeviceIndex=0; OutputDeviceIndex<OutputDevices.Num(); OutputDeviceIndex++ )
+			{
+				OutputDevices[OutputDeviceIndex]->Serialize( Data, Verbosity, Category, RealTime );
+			}
+		}
 	}
-	else
-	{
-		// Flush previously buffered lines from secondary threads.
-		// Since we already hold a lock on SynchronizationObject, call the unsynchronized version.
-		UnsynchronizedFlushThreadedLogs( true );
 
-		for( int32 OutputDeviceIndex=0; OutputDeviceIndex<OutputDevices.Num(); OutputDeviceIndex++ )
+	if( AnyThreadDevices.Num() > 0 )
+	{
+		for( int32 OutputDeviceIndex=0; OutputDeviceIndex<AnyThreadDevices.Num(); OutputDeviceIndex++ )
 		{
-			OutputDevices[OutputDeviceIndex]->Serialize( Data, Verbosity, Category, RealTime );
+			AnyThreadDevices[OutputDeviceIndex]->Serialize( Data, Verbosity, Category, RealTime );
 		}
+		FPlatformAtomics::InterlockedDecrement( &NumAnyThreadCalls[CallEpoch] );
 	}
 }
 
@@ -954,17 +1025,27 @@ void FOutputDeviceRedirector::TearDown()
 {
 	check(FPlatformTLS::GetCurrentThreadId() == MasterThreadID);
 
-	FScopeLock ScopeLock( &SynchronizationObject );
+	TArray<FOutputDevice*> LocalOutputDevices;
+	int32 PreviousEpoch;
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
 
-	// Flush previously buffered lines from secondary threads.
-	// Since we already hold a lock on SynchronizationObject, call the unsynchronized version.
-	UnsynchronizedFlushThreadedLogs( false );
+		// Flush previously buffered lines from secondary threads.
+		// Since we already hold a lock on SynchronizationObject, call the unsynchronized version.
+		UnsynchronizedFlushThreadedLogs( false );
+
+		LocalOutputDevices = MoveTemp( OutputDevices );
+		OutputDevices.Empty();
+		PreviousEpoch = UnsynchronizedBeginAnyThreadCallEpoch();
+	}
 
-	for( int32 OutputDeviceIndex=0; OutputDeviceIndex<OutputDevices.Num(); OutputDeviceIndex++ )
+	// Secondary threads may still be calling the devices outside the lock
+	WaitForAnyThreadCalls( PreviousEpoch );
+
+	for( int32 OutputDeviceIndex=0; OutputDeviceIndex<LocalOutputDevices.Num(); OutputDeviceIndex++ )
 	{
-		OutputDevices[OutputDeviceIndex]->TearDown();
+		LocalOutputDevices[OutputDeviceIndex]->TearDown();
 	}
-	OutputDevices.Empty();
 }
 
 
@@ -980,6 +1061,8 @@ void FOutputDeviceRedirector::TearDown()
  */
 FOutputDeviceFile::FOutputDeviceFile( const TCHAR* InFilename, bool bInDisableBackup  )
 :	LogAr( NULL ),
+	AsyncWriter( NULL ),
+	NumAsyncWriterUsers( 0 ),
 	Opened( 0 ),
 	Dead( 0 ),
 	bDisableBackup(bInDisableBackup)
@@ -1009,12 +1092,23 @@ void FOutputDeviceFile::SetFilename(const TCHAR* InFilename)
  */
 void FOutputDeviceFile::TearDown()
 {
+	FScopeLock ScopeLock( &SynchronizationObject );
+
 	if( LogAr )
 	{
 		if (!bSuppressEventTag)
 		{
 			Logf( TEXT("Log file closed, %s"), FPlatformTime::StrTimestamp() );
 		}
+		// Lines are queued without the lock, stop new ones from reaching the writer and wait for the ones on their way
+		FAsyncLogWriter* Writer = (FAsyncLogWriter*)FPlatformAtomics::InterlockedExchangePtr( (void**)&AsyncWriter, NULL );
+		while( NumAsyncWriterUsers > 0 )
+		{
+			FPlatformProcess::SleepNoStats( 0.0f );
+		}
+
+		// Writes out the lines that are still queued
+		delete Writer;
 		delete LogAr;
 		LogAr = NULL;
 	}
@@ -1026,12 +1120,32 @@ void FOutputDeviceFile::TearDown()
  */
 void FOutputDeviceFile::Flush()
 {
-	if( LogAr )
+	FScopeLock ScopeLock( &SynchronizationObject );
+
+	if( AsyncWriter )
+	{
+		AsyncWriter->Flush();
+	}
+	else if( LogAr )
 	{
 		LogAr->Flush();
 	}
 }
 
+/** @return true if the log file should be flushed after every line, which also means it is written synchronously */
+static bool ShouldForceLogFlush()
+{
+	static bool GForceLogFlush = false;
+	static bool GTestedCmdLine = false;
+	if (!GTestedCmdLine)
+	{
+		GTestedCmdLine = true;
+		// Force a log flush after each line
+		GForceLogFlush = FParse::Param( FCommandLine::Get(), TEXT("FORCELOGFLUSH") );
+	}
+	return GForceLogFlush;
+}
+
 /** if the passed in file exists, makes a timestamped backup copy
  * @param Filename the name of the file to check
  */
@@ -1092,31 +1206,71 @@ FArchive* FOutputDeviceFile::CreateArchive(uint32 MaxAttempts)
 	return Result;
 }
 
-void FOutputDeviceFile::CastAndSerializeData(const TCHAR* Data)
+/** Log lines are put together on the logging thread, most fit without allocating */
+typedef TArray<ANSICHAR, TInlineAllocator<1024>> FLogFileLine;
+
+static void AppendUTF8(FLogFileLine& Line, const TCHAR* Data)
 {
 	auto ConvertedData = FTCHARToUTF8(Data);
-	LogAr->Serialize((ANSICHAR*)(ConvertedData.Get()), ConvertedData.Length());
+	Line.Append((ANSICHAR*)(ConvertedData.Get()), ConvertedData.Length());
 }
 
 void FOutputDeviceFile::WriteDataToArchive(const TCHAR* Data, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time)
 {
+	FLogFileLine Line;
+
 	if (!bSuppressEventTag)
 	{
 		FString Prefix = FOutputDevice::FormatLogLine(Verbosity, Category, NULL, GPrintLogTimes, Time);
-		CastAndSerializeData(*Prefix);
+		AppendUTF8(Line, *Prefix);
 	}
 
-	CastAndSerializeData(Data);
+	AppendUTF8(Line, Data);
 
 	if (bAutoEmitLineTerminator)
 	{
-#if PLATFORM_LINUX
-		// on Linux, we still want to have logs with Windows line endings so they can be opened with Windows tools like infamous notepad.exe
-		ANSICHAR WindowsTerminator[] = { '\r', '\n' };
-		LogAr->Serialize(WindowsTerminator, sizeof(WindowsTerminator));
-#else
-		CastAndSerializeData(LINE_TERMINATOR);
-#endif // PLATFORM_LINUX
+		Line.Append(LOG_FILE_LINE_TERMINATOR_ANSI, ARRAY_COUNT(LOG_FILE_LINE_TERMINATOR_ANSI) - 1);
+	}
+
+	// Errors are never dropped, and once we crashed every line goes straight to the disk
+	const bool bMustNotDrop = GIsCriticalError || (Verbosity & ELogVerbosity::VerbosityMask) <= ELogVerbosity::Error;
+
+	// The writer queues lines from any number of threads without a lock, the count only keeps TearDown from deleting it meanwhile.
+	// Counting before reading the pointer, and TearDown clearing it before reading the count, means one of the two sees the other.
+	FPlatformAtomics::InterlockedIncrement(&NumAsyncWriterUsers);
+	if (FAsyncLogWriter* Writer = AsyncWriter)
+	{
+		Writer->Write(Line.GetData(), Line.Num(), bMustNotDrop);
+		if (GIsCriticalError)
+		{
+			Writer->Flush();
+		}
+		FPlatformAtomics::InterlockedDecrement(&NumAsyncWriterUsers);
+		return;
+	}
+	FPlatformAtomics::InterlockedDecrement(&NumAsyncWriterUsers);
+
+	FScopeLock ScopeLock( &SynchronizationObject );
+
+	if (!LogAr)
+	{
+		// Torn down by another thread while this line was put together
+		return;
+	}
+
+	if (AsyncWriter)
+	{
+		// Opened by another thread while this line was put together
+		AsyncWriter->Write(Line.GetData(), Line.Num(), bMustNotDrop);
+	}
+	else
+	{
+		LogAr->Serialize(Line.GetData(), Line.Num());
+
+		if (ShouldForceLogFlush())
+		{
+			LogAr->Flush();
+		}
 	}
 }
 
@@ -1134,54 +1288,52 @@ void FOutputDeviceFile::Serialize( const TCHAR* Data, ELogVerbosity::Type Verbos
 	{
 		if( !LogAr && !Dead )
 		{
-			// Make log filename.
-			if( !Filename[0] )
-			{
-				FCString::Strcpy(Filename, *FPlatformOutputDevices::GetAbsoluteLogFilename());
-			}
+			FScopeLock ScopeLock( &SynchronizationObject );
 
-			// if the file already exists, create a backup as we are going to overwrite it
-			if (!bDisableBackup && !Opened)
+			// Another thread may have opened it in the meantime
+			if( !LogAr && !Dead )
 			{
-				CreateBackupCopy(Filename);
-			}
+				// Make log filename.
+				if( !Filename[0] )
+				{
+					FCString::Strcpy(Filename, *FPlatformOutputDevices::GetAbsoluteLogFilename());
+				}
+
+				// if the file already exists, create a backup as we are going to overwrite it
+				if (!bDisableBackup && !Opened)
+				{
+					CreateBackupCopy(Filename);
+				}
 
-			// Open log file.
-			LogAr = CreateArchive();
+				// Open log file.
+				LogAr = CreateArchive();
 
-			if( LogAr )
-			{
-				Opened = 1;
+				if( LogAr )
+				{
+					Opened = 1;
+
+					WriteByteOrderMarkToArchive(EByteOrderMark::UTF8);
 
-				WriteByteOrderMarkToArchive(EByteOrderMark::UTF8);
+					if (!bSuppressEventTag)
+					{
+						Logf( TEXT("Log file open, %s"), FPlatformTime::StrTimestamp() );
+					}
 
-				if (!bSuppressEventTag)
+					if (!ShouldForceLogFlush() && FPlatformProcess::SupportsMultithreading())
+					{
+						AsyncWriter = FAsyncLogWriter::Create(*LogAr);
+					}
+				}
+				else 
 				{
-					Logf( TEXT("Log file open, %s"), FPlatformTime::StrTimestamp() );
+					Dead = true;
 				}
 			}
-			else 
-			{
-				Dead = true;
-			}
 		}
 
 		if( LogAr && Verbosity != ELogVerbosity::SetColor )
 		{
 			WriteDataToArchive(Data, Verbosity, Category, Time);
-
-			static bool GForceLogFlush = false;
-			static bool GTestedCmdLine = false;
-			if (!GTestedCmdLine)
-			{
-				GTestedCmdLine = true;
-				// Force a log flush after each line
-				GForceLogFlush = FParse::Param( FCommandLine::Get(), TEXT("FORCELOGFLUSH") );
-			}
-			if( GForceLogFlush )
-			{
-				LogAr->Flush();
-			}
 		}
 	}
 	else
@@ -3,6 +3,7 @@
 #include "CorePrivatePCH.h"
 #include <sys/file.h>	// flock()
 #include <sys/stat.h>   // mkdirp()
+#include <sys/mman.h>   // mmap()
 
 DEFINE_LOG_CATEGORY_STATIC(LogLinuxPlatformFile, Log, All);
 
@@ -319,6 +320,76 @@ __thread FFileHandleLinux* FFileHandleLinux::ActiveHandles[ FFileHandleLinux::AC
 __thread double FFileHandleLinux::AccessTimes[ FFileHandleLinux::ACTIVE_HANDLE_COUNT ];
 #endif // MANAGE_FILE_HANDLES
 
+/**
+ * Linux mapped file region. mmap() offsets have to be page aligned, so the mapping can start before the first byte that
+ * was asked for.
+ */
+class CORE_API FMappedFileRegionLinux : public IMappedFileRegion
+{
+public:
+	FMappedFileRegionLinux(const uint8* InMappedPtr, int64 InMappedSize, void* InMappingPtr, SIZE_T InMappingSize)
+		: IMappedFileRegion(InMappedPtr, InMappedSize)
+		, MappingPtr(InMappingPtr)
+		, MappingSize(InMappingSize)
+	{
+	}
+
+	virtual ~FMappedFileRegionLinux()
+	{
+		// The mapping doesn't need the file descriptor, so this is fine after the handle has been closed.
+		munmap(MappingPtr, MappingSize);
+	}
+
+private:
+	void* MappingPtr;
+	SIZE_T MappingSize;
+};
+
+/**
+ * Linux mapped file handle implementation
+ */
+class CORE_API FMappedFileHandleLinux : public IMappedFileHandle
+{
+public:
+	FMappedFileHandleLinux(int32 InFileHandle, int64 InFileSize, const TCHAR* InFilename)
+		: IMappedFileHandle(InFileSize)
+		, FileHandle(InFileHandle)
+		, Filename(InFilename)
+	{
+	}
+
+	virtual ~FMappedFileHandleLinux()
+	{
+		close(FileHandle);
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) override
+	{
+		check(Offset >= 0 && Offset <= GetFileSize());
+		BytesToMap = FMath::Min<int64>(BytesToMap, GetFileSize() - Offset);
+		if (BytesToMap <= 0)
+		{
+			return nullptr;
+		}
+
+		const int64 PageSize = FPlatformMemory::GetConstants().PageSize;
+		const int64 MappingOffset = Offset & ~(PageSize - 1);
+		const SIZE_T MappingSize = SIZE_T(Offset - MappingOffset + BytesToMap);
+		void* MappingPtr = mmap(nullptr, MappingSize, PROT_READ, MAP_PRIVATE, FileHandle, MappingOffset);
+		if (MappingPtr == MAP_FAILED)
+		{
+			int ErrNo = errno;
+			UE_LOG(LogLinuxPlatformFile, Warning, TEXT( "mmap('%s', Offset=%lld, Size=%llu) failed: errno=%d (%s)" ), *Filename, MappingOffset, (uint64)MappingSize, ErrNo, ANSI_TO_TCHAR(strerror(ErrNo)));
+			return nullptr;
+		}
+		return new FMappedFileRegionLinux((const uint8*)MappingPtr + (Offset - MappingOffset), BytesToMap, MappingPtr, MappingSize);
+	}
+
+private:
+	int32 FileHandle;
+	FString Filename;
+};
+
 /**
  * A class to handle case insensitive file opening. This is a band-aid, non-performant approach,
  * without any caching.
@@ -801,6 +872,25 @@ IFileHandle* FLinuxPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrit
 	return nullptr;
 }
 
+IMappedFileHandle* FLinuxPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	FString MappedToName;
+	int32 Handle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(Filename), MappedToName);
+	if (Handle == -1)
+	{
+		return nullptr;
+	}
+
+	// empty files can't be mapped
+	struct stat FileInfo;
+	if (fstat(Handle, &FileInfo) == -1 || !S_ISREG(FileInfo.st_mode) || FileInfo.st_size <= 0)
+	{
+		close(Handle);
+		return nullptr;
+	}
+	return new FMappedFileHandleLinux(Handle, FileInfo.st_size, *MappedToName);
+}
+
 IFileHandle* FLinuxPlatformFile::OpenWrite(const TCHAR* Filename, bool bAppend, bool bAllowRead)
 {
 	int Flags = O_CREAT | O_CLOEXEC;	// prevent children from inheriting this
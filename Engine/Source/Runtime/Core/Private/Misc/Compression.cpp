@@ -68,12 +68,9 @@ static bool appCompressMemoryGZIP(void* CompressedBuffer, int32& CompressedSize,
 		MAX_MEM_LEVEL,
 		Z_DEFAULT_STRATEGY);
 
-	// Setup output buffer
-	const unsigned long GzipHeaderLength = 12;
-	// This is how much memory we may need, however the consumer is allocating memory for us without knowing the required length.
-	//unsigned long CompressedMaxSize = deflateBound(&gzipstream, gzipstream.avail_in) + GzipHeaderLength;
+	// Setup output buffer, FCompression::CompressMemoryBound tells the caller how large it has to be
 	gzipstream.next_out = (uint8*)CompressedBuffer;
-	gzipstream.avail_out = UncompressedSize;
+	gzipstream.avail_out = CompressedSize;
 
 	int status = 0;
 	bool bOperationSucceeded = false;
@@ -81,8 +78,8 @@ static bool appCompressMemoryGZIP(void* CompressedBuffer, int32& CompressedSize,
 	if (status == Z_STREAM_END)
 	{
 		bOperationSucceeded = true;
-		deflateEnd(&gzipstream);
 	}
+	deflateEnd(&gzipstream);
 
 	// Propagate compressed size from intermediate variable back into out variable.
 	CompressedSize = gzipstream.total_out;
@@ -143,6 +140,366 @@ bool appUncompressMemoryZLIB( void* UncompressedBuffer, int32 UncompressedSize,
 	return bOperationSucceeded;
 }
 
+/**
+ * LZ4 block format: a sequence of literal runs each followed by a match, described by a token byte with the literal length
+ * in the high and the match length minus 4 in the low nibble, both extended by bytes of 255 when they're 15. Matches are
+ * a 16-bit little endian offset back into the output. The last sequence only has literals.
+ */
+namespace LZ4
+{
+	/** A match is at least this long */
+	const int32 MinMatch = 4;
+	/** The last bytes are always literals */
+	const int32 LastLiterals = 5;
+	/** The last match starts at least this far from the end */
+	const int32 MatchFindLimit = 12;
+	const int32 MaxOffset = 65535;
+	const int32 HashLog = 12;
+
+	FORCEINLINE uint32 Read32(const uint8* Ptr)
+	{
+		uint32 Value;
+		FMemory::Memcpy(&Value, Ptr, sizeof(Value));
+		return Value;
+	}
+
+	FORCEINLINE uint32 Hash(uint32 Sequence)
+	{
+		return (Sequence * 2654435761u) >> (32 - HashLog);
+	}
+
+	/** Writes a length that didn't fit in its nibble. @return false if it didn't fit in the output either */
+	FORCEINLINE bool WriteLength(uint8*& Out, const uint8* OutEnd, int32 Length)
+	{
+		if (OutEnd - Out < Length / 255 + 1)
+		{
+			return false;
+		}
+		for (; Length >= 255; Length -= 255)
+		{
+			*Out++ = 255;
+		}
+		*Out++ = (uint8)Length;
+		return true;
+	}
+
+	/** Reads the rest of a length that didn't fit in its nibble. @return false if the input ended first */
+	FORCEINLINE bool ReadLength(const uint8*& In, const uint8* InEnd, int32& Length)
+	{
+		uint8 Byte;
+		do
+		{
+			if (In >= InEnd)
+			{
+				return false;
+			}
+			Byte = *In++;
+			Length += Byte;
+		}
+		while (Byte == 255);
+		return true;
+	}
+
+	/** Writes LiteralLength literals starting at Anchor, and the match following them unless MatchLength is 0. */
+	FORCEINLINE bool WriteSequence(uint8*& Out, const uint8* OutEnd, const uint8* Anchor, int32 LiteralLength, int32 Offset, int32 MatchLength)
+	{
+		if (Out >= OutEnd)
+		{
+			return false;
+		}
+		uint8* Token = Out++;
+		*Token = (uint8)(FMath::Min(LiteralLength, 15) << 4);
+		if (LiteralLength >= 15 && !WriteLength(Out, OutEnd, LiteralLength - 15))
+		{
+			return false;
+		}
+		if (OutEnd - Out < LiteralLength)
+		{
+			return false;
+		}
+		FMemory::Memcpy(Out, Anchor, LiteralLength);
+		Out += LiteralLength;
+
+		if (MatchLength > 0)
+		{
+			if (OutEnd - Out < 2)
+			{
+				return false;
+			}
+			*Out++ = (uint8)Offset;
+			*Out++ = (uint8)(Offset >> 8);
+			const int32 MatchCode = MatchLength - MinMatch;
+			*Token |= (uint8)FMath::Min(MatchCode, 15);
+			if (MatchCode >= 15 && !WriteLength(Out, OutEnd, MatchCode - 15))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	int32 CompressBound(int32 UncompressedSize)
+	{
+		return UncompressedSize + UncompressedSize / 255 + 16;
+	}
+}
+
+/**
+ * Thread-safe LZ4 compression. Greedy, with a single candidate per hash like the fast mode of the reference compressor,
+ * it skips ahead faster the longer it doesn't find a match so incompressible data goes through quickly.
+ *
+ * @param	CompressedBuffer			Buffer compressed data is going to be written to
+ * @param	CompressedSize	[in/out]	Size of CompressedBuffer, at exit will be size of compressed data
+ * @param	UncompressedBuffer			Buffer containing uncompressed data
+ * @param	UncompressedSize			Size of uncompressed data in bytes
+ * @return true if compression succeeds, false if it fails because CompressedBuffer was too small
+ */
+static bool appCompressMemoryLZ4( void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize )
+{
+	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "Compress Memory LZ4" ), STAT_appCompressMemoryLZ4, STATGROUP_Compression );
+
+	const uint8* Src = (const uint8*)UncompressedBuffer;
+	const uint8* SrcEnd = Src + UncompressedSize;
+	uint8* Out = (uint8*)CompressedBuffer;
+	const uint8* OutEnd = Out + CompressedSize;
+	const uint8* Anchor = Src;
+
+	if (UncompressedSize > LZ4::MatchFindLimit)
+	{
+		const uint8* MatchLimit = SrcEnd - LZ4::LastLiterals;
+		const uint8* SearchLimit = SrcEnd - LZ4::MatchFindLimit;
+
+		// Positions relative to Src, candidates are verified so the initial zeros don't need to be told apart from position 0
+		uint32 HashTable[1 << LZ4::HashLog];
+		FMemory::Memzero(HashTable);
+
+		const uint8* In = Src + 1;
+		while (In <= SearchLimit)
+		{
+			const uint32 Sequence = LZ4::Read32(In);
+			const uint32 Hash = LZ4::Hash(Sequence);
+			const uint8* Candidate = Src + HashTable[Hash];
+			HashTable[Hash] = (uint32)(In - Src);
+			if (In - Candidate > LZ4::MaxOffset || LZ4::Read32(Candidate) != Sequence)
+			{
+				In += 1 + ((In - Anchor) >> 6);
+				continue;
+			}
+
+			// Extend the match backwards into the literals and forwards as far as it goes
+			while (In > Anchor && Candidate > Src && In[-1] == Candidate[-1])
+			{
+				--In;
+				--Candidate;
+			}
+			const uint8* MatchEnd = In + LZ4::MinMatch;
+			const uint8* Reference = Candidate + LZ4::MinMatch;
+			while (MatchEnd < MatchLimit && *MatchEnd == *Reference)
+			{
+				++MatchEnd;
+				++Reference;
+			}
+
+			if (!LZ4::WriteSequence(Out, OutEnd, Anchor, (int32)(In - Anchor), (int32)(In - Candidate), (int32)(MatchEnd - In)))
+			{
+				return false;
+			}
+			In = MatchEnd;
+			Anchor = In;
+
+			// The position just before the end of a match is a good candidate for the next one
+			if (In <= SearchLimit)
+			{
+				HashTable[LZ4::Hash(LZ4::Read32(In - 2))] = (uint32)(In - 2 - Src);
+			}
+		}
+	}
+
+	if (!LZ4::WriteSequence(Out, OutEnd, Anchor, (int32)(SrcEnd - Anchor), 0, 0))
+	{
+		return false;
+	}
+	CompressedSize = (int32)(Out - (uint8*)CompressedBuffer);
+	return true;
+}
+
+/**
+ * Thread-safe LZ4 decompression. Checks every length and offset against the buffers, corrupt data fails instead of
+ * reading or writing past them.
+ *
+ * @param	UncompressedBuffer			Buffer containing uncompressed data
+ * @param	UncompressedSize			Size of uncompressed data in bytes
+ * @param	CompressedBuffer			Buffer compressed data is going to be read from
+ * @param	CompressedSize				Size of CompressedBuffer data in bytes
+ * @return true if decompression succeeds and produced exactly UncompressedSize bytes
+ */
+static bool appUncompressMemoryLZ4( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize )
+{
+	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "Uncompress Memory LZ4" ), STAT_appUncompressMemoryLZ4, STATGROUP_Compression );
+
+	const uint8* In = (const uint8*)CompressedBuffer;
+	const uint8* InEnd = In + CompressedSize;
+	uint8* const Dst = (uint8*)UncompressedBuffer;
+	uint8* Out = Dst;
+	const uint8* OutEnd = Out + UncompressedSize;
+
+	for (;;)
+	{
+		if (In >= InEnd)
+		{
+			return false;
+		}
+		const uint8 Token = *In++;
+
+		int32 LiteralLength = Token >> 4;
+		if (LiteralLength == 15 && !LZ4::ReadLength(In, InEnd, LiteralLength))
+		{
+			return false;
+		}
+		if (InEnd - In < LiteralLength || OutEnd - Out < LiteralLength)
+		{
+			return false;
+		}
+		FMemory::Memcpy(Out, In, LiteralLength);
+		Out += LiteralLength;
+		In += LiteralLength;
+
+		if (In == InEnd)
+		{
+			// The last sequence has no match
+			break;
+		}
+
+		if (InEnd - In < 2)
+		{
+			return false;
+		}
+		const int32 Offset = In[0] | (In[1] << 8);
+		In += 2;
+		int32 MatchLength = Token & 15;
+		if (MatchLength == 15 && !LZ4::ReadLength(In, InEnd, MatchLength))
+		{
+			return false;
+		}
+		MatchLength += LZ4::MinMatch;
+		if (Offset == 0 || Offset > Out - Dst || OutEnd - Out < MatchLength)
+		{
+			return false;
+		}
+
+		const uint8* Match = Out - Offset;
+		if (Offset >= MatchLength)
+		{
+			FMemory::Memcpy(Out, Match, MatchLength);
+			Out += MatchLength;
+		}
+		else
+		{
+			// The match overlaps what it writes, repeating the last Offset bytes
+			for (const uint8* MatchEnd = Out + MatchLength; Out < MatchEnd; )
+			{
+				*Out++ = *Match++;
+			}
+		}
+	}
+
+	UE_CLOG(Out != OutEnd, LogCompression, Warning, TEXT("appUncompressMemoryLZ4 failed: uncompressed to %d bytes, expected %d"), (int32)(Out - Dst), UncompressedSize);
+	return Out == OutEnd;
+}
+
+/** Built in codecs, wrapping the functions above. */
+class FCompressionFormatZLIB : public ICompressionFormat
+{
+public:
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("ZLIB");
+	}
+	virtual int32 GetCompressedBufferSize( ECompressionFlags Flags, int32 UncompressedSize ) const override
+	{
+		return compressBound(UncompressedSize);
+	}
+	virtual bool Compress( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const override
+	{
+		return appCompressMemoryZLIB(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
+	}
+	virtual bool Uncompress( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const override
+	{
+		return appUncompressMemoryZLIB(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+	}
+};
+
+class FCompressionFormatGZIP : public ICompressionFormat
+{
+public:
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("GZIP");
+	}
+	virtual int32 GetCompressedBufferSize( ECompressionFlags Flags, int32 UncompressedSize ) const override
+	{
+		// deflateBound's worst case for a stream that doesn't use the default window and memory level, like
+		// appCompressMemoryGZIP's, plus 18 bytes of gzip header and trailer
+		return UncompressedSize + ((UncompressedSize + 7) >> 3) + ((UncompressedSize + 63) >> 6) + 5 + 18;
+	}
+	virtual bool Compress( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const override
+	{
+		return appCompressMemoryGZIP(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
+	}
+	virtual bool Uncompress( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const override
+	{
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::UncompressMemory - GZIP decompression is not supported"));
+		return false;
+	}
+};
+
+class FCompressionFormatLZ4 : public ICompressionFormat
+{
+public:
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("LZ4");
+	}
+	virtual int32 GetCompressedBufferSize( ECompressionFlags Flags, int32 UncompressedSize ) const override
+	{
+		return LZ4::CompressBound(UncompressedSize);
+	}
+	virtual bool Compress( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const override
+	{
+		return appCompressMemoryLZ4(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
+	}
+	virtual bool Uncompress( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const override
+	{
+		return appUncompressMemoryLZ4(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+	}
+};
+
+static FCompressionFormatZLIB GCompressionFormatZLIB;
+static FCompressionFormatGZIP GCompressionFormatGZIP;
+static FCompressionFormatLZ4 GCompressionFormatLZ4;
+
+/** Codec for every compression type, indexed by the type bits of the flags */
+static ICompressionFormat* GCompressionFormats[COMPRESSION_FLAGS_TYPE_MASK + 1] =
+{
+	nullptr,
+	&GCompressionFormatZLIB,
+	&GCompressionFormatGZIP,
+	nullptr,
+	&GCompressionFormatLZ4,
+};
+
+void FCompression::RegisterFormat( ECompressionFlags Type, ICompressionFormat* Format )
+{
+	check(Type != COMPRESS_None && (Type & ~COMPRESSION_FLAGS_TYPE_MASK) == 0);
+	GCompressionFormats[Type] = Format;
+	FPlatformMisc::MemoryBarrier();
+}
+
+ICompressionFormat* FCompression::GetFormat( ECompressionFlags Flags )
+{
+	return GCompressionFormats[Flags & COMPRESSION_FLAGS_TYPE_MASK];
+}
+
 /** Time spent compressing data in seconds. */
 double FCompression::CompressorTime		= 0;
 /** Number of bytes before compression.		*/
@@ -185,22 +542,13 @@ static ECompressionFlags CheckGlobalCompressionFlags(ECompressionFlags Flags)
 */
 int32 FCompression::CompressMemoryBound( ECompressionFlags Flags, int32 UncompressedSize ) 
 {
-	int32 CompressionBound = UncompressedSize;
+	ICompressionFormat* Format = GetFormat(Flags);
 	// make sure a valid compression scheme was provided
-	check(Flags & COMPRESS_ZLIB);
+	check(Format);
 
 	Flags = CheckGlobalCompressionFlags(Flags);
 
-	switch(Flags & COMPRESSION_FLAGS_TYPE_MASK)
-	{
-	case COMPRESS_ZLIB:
-		CompressionBound = compressBound(UncompressedSize);
-		break;
-	default:
-		break;
-	}
-
-	return CompressionBound;
+	return Format->GetCompressedBufferSize(Flags, UncompressedSize);
 }
 
 /**
@@ -218,24 +566,22 @@ bool FCompression::CompressMemory( ECompressionFlags Flags, void* CompressedBuff
 {
 	double CompressorStartTime = FPlatformTime::Seconds();
 
+	ICompressionFormat* Format = GetFormat(Flags);
 	// make sure a valid compression scheme was provided
-	check(Flags & COMPRESS_ZLIB || Flags & COMPRESS_GZIP);
+	check(Format || (Flags & COMPRESSION_FLAGS_TYPE_MASK) == COMPRESS_Custom);
 
 	bool bCompressSucceeded = false;
 
 	Flags = CheckGlobalCompressionFlags(Flags);
 
-	switch(Flags & COMPRESSION_FLAGS_TYPE_MASK)
+	if (Format)
 	{
-		case COMPRESS_ZLIB:
-			bCompressSucceeded = appCompressMemoryZLIB(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
-			break;
-		case COMPRESS_GZIP:
-			bCompressSucceeded = appCompressMemoryGZIP(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
-			break;
-		default:
-			UE_LOG(LogCompression, Warning, TEXT("appCompressMemory - This compression type not supported"));
-			bCompressSucceeded =  false;
+		bCompressSucceeded = Format->Compress(Flags, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
+	}
+	else
+	{
+		UE_LOG(LogCompression, Warning, TEXT("appCompressMemory - This compression type not supported"));
+		bCompressSucceeded =  false;
 	}
 
 	// Keep track of compression time and stats.
@@ -268,39 +614,40 @@ bool FCompression::UncompressMemory( ECompressionFlags Flags, void* Uncompressed
 	// Keep track of time spent uncompressing memory.
 	STAT(double UncompressorStartTime = FPlatformTime::Seconds();)
 	
+	ICompressionFormat* Format = GetFormat(Flags);
 	// make sure a valid compression scheme was provided
-	check(Flags & COMPRESS_ZLIB);
+	check(Format || (Flags & COMPRESSION_FLAGS_TYPE_MASK) == COMPRESS_Custom);
 
 	bool bUncompressSucceeded = false;
 
-	switch(Flags & COMPRESSION_FLAGS_TYPE_MASK)
+	if (Format)
 	{
-		case COMPRESS_ZLIB:
-			bUncompressSucceeded = appUncompressMemoryZLIB(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
-			if (!bUncompressSucceeded)
+		bUncompressSucceeded = Format->Uncompress(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+		if (!bUncompressSucceeded)
+		{
+			// This is only to skip serialization errors caused by asset corruption 
+			// that can be fixed during re-save, should never be disabled by default!
+			static struct FFailOnUncompressErrors
 			{
-				// This is only to skip serialization errors caused by asset corruption 
-				// that can be fixed during re-save, should never be disabled by default!
-				static struct FFailOnUncompressErrors
-				{
-					bool Value;
-					FFailOnUncompressErrors()
-						: Value(true) // fail by default
-					{
-						GConfig->GetBool(TEXT("Core.System"), TEXT("FailOnUncompressErrors"), Value, GEngineIni);
-					}
-				} FailOnUncompressErrors;
-				if (!FailOnUncompressErrors.Value)
+				bool Value;
+				FFailOnUncompressErrors()
+					: Value(true) // fail by default
 				{
-					bUncompressSucceeded = true;
+					GConfig->GetBool(TEXT("Core.System"), TEXT("FailOnUncompressErrors"), Value, GEngineIni);
 				}
-				// Always log an error
-				UE_LOG(LogCompression, Error, TEXT("FCompression::UncompressMemory - Failed to uncompress memory (%d/%d), this may indicate the asset is corrupt!"), CompressedSize, UncompressedSize);
+			} FailOnUncompressErrors;
+			if (!FailOnUncompressErrors.Value)
+			{
+				bUncompressSucceeded = true;
 			}
-			break;
-		default:
-			UE_LOG(LogCompression, Warning, TEXT("FCompression::UncompressMemory - This compression type not supported"));
-			bUncompressSucceeded = false;
+			// Always log an error
+			UE_LOG(LogCompression, Error, TEXT("FCompression::UncompressMemory - Failed to uncompress memory (%d/%d), this may indicate the asset is corrupt!"), CompressedSize, UncompressedSize);
+		}
+	}
+	else
+	{
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::UncompressMemory - This compression type not supported"));
+		bUncompressSucceeded = false;
 	}
 
 #if	STATS
@@ -10,6 +10,7 @@
 #include "EngineBuildSettings.h"
 #include "Paths.h"
 #include "ConfigManifest.h"
+#include "EngineVersion.h"
 
 #if WITH_EDITOR
 	#define INI_CACHE 1
@@ -2847,6 +2848,315 @@ static FString GetDestIniFilename(const TCHAR* BaseIniName, const TCHAR* Platfor
 	return IniFilename;
 }
 
+/**
+ * Binary snapshot of the global .ini files.
+ *
+ * Merging the global .ini files from their hierarchies is a measurable part of startup. Cooked builds, which never write
+ * the merged files back to disk, save the result to a snapshot once and load that on later runs instead of parsing and
+ * merging the hierarchies again. A snapshot is only used for the same build and the same config switches on the command
+ * line, and while every .ini file it was merged from still has the size and timestamp it had when the snapshot was saved.
+ */
+namespace ConfigSnapshot
+{
+	/** Bump this when the snapshot layout, or the way .ini files are merged, changes */
+	const uint32 Version = 3;
+	const uint32 Magic = 0x50534E43; // 'CNSP'
+
+	/** An .ini file that went into the snapshot, missing files are recorded too so it goes stale when they show up */
+	struct FSourceFile
+	{
+		FString Filename;
+		int64 Size;
+		FDateTime Timestamp;
+
+		explicit FSourceFile(const FString& InFilename = FString())
+			: Filename(InFilename)
+			, Size(InFilename.Len() ? IFileManager::Get().FileSize(*InFilename) : -1)
+			, Timestamp(InFilename.Len() ? IFileManager::Get().GetTimeStamp(*InFilename) : FDateTime::MinValue())
+		{
+		}
+
+		bool operator==(const FSourceFile& Other) const
+		{
+			return Size == Other.Size && Timestamp == Other.Timestamp && Filename == Other.Filename;
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FSourceFile& File)
+		{
+			return Ar << File.Filename << File.Size << File.Timestamp;
+		}
+	};
+
+	static bool IsEnabled()
+	{
+		return FPlatformProperties::RequiresCookedData() && !FParse::Param(FCommandLine::Get(), TEXT("NoConfigSnapshot"));
+	}
+
+	/**
+	 * @return the command line switches that change what goes into the global .ini files: -ini: overrides, the <Base>INI= and
+	 * DEF<Base>INI= filename overrides, -REGENERATEINIS and -NOAUTOINIUPDATE. Everything else, like the map or -log, doesn't matter.
+	 */
+	static FString GetConfigSwitches()
+	{
+		FString ConfigSwitches;
+		const TCHAR* CommandLine = FCommandLine::Get();
+		FString Token;
+		while (FParse::Token(CommandLine, Token, false))
+		{
+			const FString Switch = Token.StartsWith(TEXT("-")) || Token.StartsWith(TEXT("/")) ? Token.Mid(1) : Token;
+			if (Token.StartsWith(CommandlineOverrideSpecifiers::IniSwitchIdentifier) || Switch.Contains(TEXT("INI="))
+				|| Switch == TEXT("REGENERATEINIS") || Switch == TEXT("NOAUTOINIUPDATE"))
+			{
+				ConfigSwitches += Token;
+				ConfigSwitches += TEXT(" ");
+			}
+		}
+		return ConfigSwitches;
+	}
+
+	/**
+	 * @return what tells builds apart. The build date alone doesn't, every build configuration of the same day shares the
+	 * snapshot file and they don't all merge the .ini files the same way.
+	 */
+	static FString GetBuildKey()
+	{
+		return FString::Printf(TEXT("%s %s %s"), EBuildConfigurations::ToString(FApp::GetBuildConfiguration()), *FEngineVersion::Current().ToString(), *FApp::GetBuildDate());
+	}
+
+	static FString GetFilename()
+	{
+		return FString::Printf(TEXT("%s%s/ConfigSnapshot.bin"), *FPaths::GeneratedConfigDir(), ANSI_TO_TCHAR(FPlatformProperties::PlatformName()));
+	}
+
+	static void SerializeSections(FArchive& Ar, FConfigFile& File)
+	{
+		int32 NumSections = File.Num();
+		Ar << NumSections;
+		if (Ar.IsLoading())
+		{
+			File.Reserve(NumSections);
+			for (int32 SectionIndex = 0; SectionIndex < NumSections && !Ar.IsError(); SectionIndex++)
+			{
+				FString SectionName;
+				int32 NumValues = 0;
+				Ar << SectionName << NumValues;
+
+				FConfigSection& Section = File.Add(SectionName, FConfigSection());
+				for (int32 ValueIndex = 0; ValueIndex < NumValues && !Ar.IsError(); ValueIndex++)
+				{
+					FName Key;
+					FString Value;
+					Ar << Key << Value;
+					Section.Add(Key, Value);
+				}
+			}
+		}
+		else
+		{
+			for (TMap<FString,FConfigSection>::TIterator SectionIt(File); SectionIt; ++SectionIt)
+			{
+				int32 NumValues = SectionIt.Value().Num();
+				Ar << SectionIt.Key() << NumValues;
+				for (FConfigSection::TIterator It(SectionIt.Value()); It; ++It)
+				{
+					Ar << It.Key() << It.Value();
+				}
+			}
+		}
+	}
+
+	static void SerializeConfigFile(FArchive& Ar, FConfigFile& File)
+	{
+		SerializeSections(Ar, File);
+
+		FString Name = File.Name.ToString();
+		Ar << Name << File.Dirty << File.NoSave;
+		File.Name = *Name;
+
+		int32 NumHierarchyFiles = File.SourceIniHierarchy.Num();
+		Ar << NumHierarchyFiles;
+		if (Ar.IsLoading())
+		{
+			for (int32 Index = 0; Index < NumHierarchyFiles && !Ar.IsError(); Index++)
+			{
+				uint8 Entry = 0;
+				FIniFilename IniFilename(FString(), false);
+				Ar << Entry << IniFilename.Filename << IniFilename.bRequired << IniFilename.CacheKey;
+				File.SourceIniHierarchy.Add((EConfigFileHierarchy)Entry, IniFilename);
+			}
+		}
+		else
+		{
+			for (auto& HierarchyIt : File.SourceIniHierarchy)
+			{
+				uint8 Entry = (uint8)HierarchyIt.Key;
+				Ar << Entry << HierarchyIt.Value.Filename << HierarchyIt.Value.bRequired << HierarchyIt.Value.CacheKey;
+			}
+		}
+
+		// The untainted hierarchy is needed to tell what changed when the file is saved
+		bool bHasSourceConfigFile = File.SourceConfigFile != NULL;
+		Ar << bHasSourceConfigFile;
+		if (bHasSourceConfigFile)
+		{
+			if (Ar.IsLoading())
+			{
+				File.SourceConfigFile = new FConfigFile();
+			}
+			SerializeSections(Ar, *File.SourceConfigFile);
+		}
+
+		// Shipping builds don't keep the command line overrides, but the layout is the same in every build configuration
+#if !UE_BUILD_SHIPPING
+		int32 NumCommandlineOptions = File.CommandlineOptions.Num();
+		Ar << NumCommandlineOptions;
+		if (Ar.IsLoading())
+		{
+			File.CommandlineOptions.SetNum(NumCommandlineOptions);
+		}
+		for (FConfigCommandlineOverride& Option : File.CommandlineOptions)
+		{
+			Ar << Option.BaseFileName << Option.Section << Option.PropertyKey << Option.PropertyValue;
+		}
+#else
+		int32 NumCommandlineOptions = 0;
+		Ar << NumCommandlineOptions;
+		for (int32 Index = 0; Index < NumCommandlineOptions && !Ar.IsError(); Index++)
+		{
+			FString BaseFileName, Section, PropertyKey, PropertyValue;
+			Ar << BaseFileName << Section << PropertyKey << PropertyValue;
+		}
+#endif // !UE_BUILD_SHIPPING
+	}
+
+	/** Adds the global .ini files to a config cache that doesn't have them yet. @return false if there is no valid snapshot */
+	static bool Load(FConfigCacheIni& Config)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ConfigSnapshot::Load"), STAT_ConfigSnapshot_Load, STATGROUP_LoadTime);
+
+		const FString Filename = GetFilename();
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		FMemoryReader Ar(Data);
+		uint32 FileMagic = 0;
+		uint32 FileVersion = 0;
+		uint32 PayloadCrc = 0;
+		Ar << FileMagic << FileVersion << PayloadCrc;
+		if (FileMagic != Magic || FileVersion != Version || Ar.IsError()
+			|| FCrc::MemCrc32(Data.GetData() + Ar.Tell(), Data.Num() - Ar.Tell()) != PayloadCrc)
+		{
+			UE_LOG(LogConfig, Log, TEXT("Ignoring config snapshot %s, it is from another version or corrupt"), *Filename);
+			return false;
+		}
+
+		FString BuildKey;
+		FString ConfigSwitches;
+		TArray<FSourceFile> SourceFiles;
+		Ar << BuildKey << ConfigSwitches << SourceFiles;
+		if (BuildKey != GetBuildKey() || ConfigSwitches != GetConfigSwitches())
+		{
+			UE_LOG(LogConfig, Log, TEXT("Ignoring config snapshot %s, it is from another build or other config switches on the command line"), *Filename);
+			return false;
+		}
+		for (const FSourceFile& SourceFile : SourceFiles)
+		{
+			if (!(FSourceFile(SourceFile.Filename) == SourceFile))
+			{
+				UE_LOG(LogConfig, Log, TEXT("Ignoring config snapshot %s, %s changed"), *Filename, *SourceFile.Filename);
+				return false;
+			}
+		}
+
+		int32 NumConfigFiles = 0;
+		Ar << NumConfigFiles;
+		for (int32 Index = 0; Index < NumConfigFiles && !Ar.IsError(); Index++)
+		{
+			FString ConfigFilename;
+			Ar << ConfigFilename;
+			SerializeConfigFile(Ar, Config.Add(ConfigFilename, FConfigFile()));
+		}
+
+		if (Ar.IsError())
+		{
+			Config.Empty();
+			return false;
+		}
+
+		UE_LOG(LogConfig, Log, TEXT("Loaded %d config files from snapshot %s"), NumConfigFiles, *Filename);
+		return true;
+	}
+
+	/** Saves every config file in the cache, along with the .ini files they were merged from. */
+	static void Save(FConfigCacheIni& Config)
+	{
+		TArray<FString> ConfigFilenames;
+		Config.GetConfigFilenames(ConfigFilenames);
+
+		TArray<FSourceFile> SourceFiles;
+		TSet<FString> SeenFilenames;
+		for (const FString& ConfigFilename : ConfigFilenames)
+		{
+			// Remote config files can change without anything on disk changing
+			if (FRemoteConfig::Get()->FindConfig(*ConfigFilename))
+			{
+				return;
+			}
+
+			const FConfigFile* File = Config.FindConfigFile(ConfigFilename);
+			TArray<FString> InputFilenames;
+			InputFilenames.Add(ConfigFilename);
+			for (const auto& HierarchyIt : File->SourceIniHierarchy)
+			{
+				InputFilenames.Add(HierarchyIt.Value.Filename);
+			}
+
+			for (const FString& InputFilename : InputFilenames)
+			{
+				if (!SeenFilenames.Contains(InputFilename))
+				{
+					SeenFilenames.Add(InputFilename);
+					SourceFiles.Add(FSourceFile(InputFilename));
+				}
+			}
+		}
+
+		TArray<uint8> Payload;
+		FMemoryWriter PayloadAr(Payload);
+		FString BuildKey = GetBuildKey();
+		FString ConfigSwitches = GetConfigSwitches();
+		PayloadAr << BuildKey << ConfigSwitches << SourceFiles;
+
+		int32 NumConfigFiles = ConfigFilenames.Num();
+		PayloadAr << NumConfigFiles;
+		for (FString& ConfigFilename : ConfigFilenames)
+		{
+			PayloadAr << ConfigFilename;
+			SerializeConfigFile(PayloadAr, *Config.FindConfigFile(ConfigFilename));
+		}
+
+		TArray<uint8> Data;
+		FMemoryWriter Ar(Data);
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = Version;
+		uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+		Ar << FileMagic << FileVersion << PayloadCrc;
+		Ar.Serialize(Payload.GetData(), Payload.Num());
+
+		// Write it next to the real one and move it over, so processes starting at the same time never read half a snapshot
+		const FString Filename = GetFilename();
+		const FString TempFilename = Filename + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Data, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+		{
+			UE_LOG(LogConfig, Log, TEXT("Couldn't save config snapshot %s"), *Filename);
+			IFileManager::Get().Delete(*TempFilename);
+		}
+	}
+}
+
 void FConfigCacheIni::InitializeConfigSystem()
 {
 	// Perform any upgrade we need before we load any configuration files
@@ -2855,6 +3165,10 @@ void FConfigCacheIni::InitializeConfigSystem()
 	// create GConfig
 	GConfig = new FConfigCacheIni(EConfigCacheType::DiskBacked);
 
+	// Global .ini files loaded from the snapshot are already in GConfig, which makes LoadGlobalIniFile skip them
+	const bool bUseConfigSnapshot = ConfigSnapshot::IsEnabled();
+	const bool bLoadedConfigSnapshot = bUseConfigSnapshot && ConfigSnapshot::Load(*GConfig);
+
 	// load the main .ini files (unless we're running a program or a gameless UE4Editor.exe, DefaultEngine.ini is required).
 	const bool bIsGamelessExe = !FApp::HasGameName();
 	const bool bDefaultEngineIniRequired = !bIsGamelessExe && (GIsGameAgnosticExe || FApp::IsGameNameEmpty());
@@ -2911,6 +3225,11 @@ void FConfigCacheIni::InitializeConfigSystem()
 	// Load user game settings .ini, allowing merging. This also updates the user .ini if necessary.
 	FConfigCacheIni::LoadGlobalIniFile(GGameUserSettingsIni, TEXT("GameUserSettings"));
 
+	if (bUseConfigSnapshot && !bLoadedConfigSnapshot)
+	{
+		ConfigSnapshot::Save(*GConfig);
+	}
+
 	// now we can make use of GConfig
 	GConfig->bIsReadyForUse = true;
 }
@@ -2,6 +2,7 @@
 
 #include "CorePrivatePCH.h"
 #include "Crc.h"
+#include "HashSIMD.h"
 
 /** CRC 32 polynomial */
 enum { Crc32Poly = 0x04c11db7 };
@@ -391,6 +392,15 @@ uint32 FCrc::MemCrc32( const void* InData, int32 Length, uint32 CRC/*=0 */ )
 
 	const uint8* __restrict Data = (uint8*)InData;
 
+	// Carry-less multiplication gets through long inputs several times faster, the tables do the rest
+	if (Length >= HashSIMD::MinCrc32Length && HashSIMD::CanCrc32())
+	{
+		const int32 SIMDLength = Length & ~15;
+		CRC = HashSIMD::Crc32(Data, SIMDLength, CRC);
+		Data += SIMDLength;
+		Length -= SIMDLength;
+	}
+
 	// First we need to align to 32-bits
 	int32 InitBytes = Align(Data, 4) - Data;
 
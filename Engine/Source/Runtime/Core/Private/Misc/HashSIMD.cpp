@@ -0,0 +1,258 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "HashSIMD.h"
+
+// The intrinsics are compiled for newer CPUs than the rest of the engine and only called after cpuid says they're there.
+// MSVC allows that anywhere, GCC and clang only in functions with a target attribute.
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_64BITS && (defined(_M_X64) || defined(__x86_64__))
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#define HASH_SIMD_SUPPORTED		(_MSC_VER >= 1900)
+		#define HASH_SIMD_TARGET(Features)
+	#elif defined(__clang__)
+		#define HASH_SIMD_SUPPORTED		(__has_attribute(target))
+		#define HASH_SIMD_TARGET(Features)	__attribute__((target(Features)))
+	#elif defined(__GNUC__)
+		#define HASH_SIMD_SUPPORTED		(__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+		#define HASH_SIMD_TARGET(Features)	__attribute__((target(Features)))
+	#endif
+#endif
+
+#ifndef HASH_SIMD_SUPPORTED
+	#define HASH_SIMD_SUPPORTED			0
+#endif
+
+#if HASH_SIMD_SUPPORTED
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+#else
+	#include <cpuid.h>
+#endif
+#include <immintrin.h>
+
+namespace HashSIMD
+{
+	/** cpuid feature bits */
+	enum
+	{
+		Leaf1ECX_SSSE3		= 1 << 9,
+		Leaf1ECX_SSE41		= 1 << 19,
+		Leaf1ECX_PCLMULQDQ	= 1 << 1,
+		Leaf7EBX_SHA		= 1 << 29,
+	};
+
+	/** Runs cpuid for a leaf, subleaf 0. @return false if the CPU doesn't have the leaf */
+	static bool CPUID(uint32 Leaf, uint32 Registers[4])
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		int32 Args[4];
+		__cpuid(Args, 0);
+		if ((uint32)Args[0] < Leaf)
+		{
+			return false;
+		}
+		__cpuidex(Args, Leaf, 0);
+		FMemory::Memcpy(Registers, Args, sizeof(Args));
+		return true;
+#else
+		if (__get_cpuid_max(0, nullptr) < Leaf)
+		{
+			return false;
+		}
+		__cpuid_count(Leaf, 0, Registers[0], Registers[1], Registers[2], Registers[3]);
+		return true;
+#endif
+	}
+
+	static bool DetectCrc32()
+	{
+		uint32 Registers[4];
+		const uint32 Required = Leaf1ECX_SSE41 | Leaf1ECX_PCLMULQDQ;
+		return CPUID(1, Registers) && (Registers[2] & Required) == Required;
+	}
+
+	static bool DetectSha1()
+	{
+		uint32 Leaf1[4];
+		uint32 Leaf7[4];
+		const uint32 Required = Leaf1ECX_SSSE3 | Leaf1ECX_SSE41;
+		return CPUID(1, Leaf1) && (Leaf1[2] & Required) == Required && CPUID(7, Leaf7) && (Leaf7[1] & Leaf7EBX_SHA) != 0;
+	}
+
+	bool CanCrc32()
+	{
+		// Racing threads all come up with the same answer
+		static const bool bCanCrc32 = DetectCrc32();
+		return bCanCrc32;
+	}
+
+	bool CanSha1()
+	{
+		static const bool bCanSha1 = DetectSha1();
+		return bCanSha1;
+	}
+
+	/**
+	 * Folds four 16 byte lanes at a time, then the lanes into one, then reduces it to 32 bits with a Barrett reduction. The
+	 * constants are the bit reflected ones for the CRC-32 polynomial, from "Fast CRC Computation for Generic Polynomials
+	 * Using PCLMULQDQ Instruction" (Gopal et al., Intel 2009).
+	 */
+	HASH_SIMD_TARGET("pclmul,sse4.1")
+	uint32 Crc32(const uint8* Data, int32 Length, uint32 CRC)
+	{
+		check(Length >= MinCrc32Length && Length % 16 == 0);
+
+		MS_ALIGN(16) static const uint64 K1K2[2] GCC_ALIGN(16) = { 0x0154442bd4ull, 0x01c6e41596ull };
+		MS_ALIGN(16) static const uint64 K3K4[2] GCC_ALIGN(16) = { 0x01751997d0ull, 0x00ccaa009eull };
+		MS_ALIGN(16) static const uint64 K5K0[2] GCC_ALIGN(16) = { 0x0163cd6124ull, 0x0000000000ull };
+		MS_ALIGN(16) static const uint64 Poly[2] GCC_ALIGN(16) = { 0x01db710641ull, 0x01f7011641ull };
+
+		__m128i X1 = _mm_loadu_si128((const __m128i*)(Data + 0x00));
+		__m128i X2 = _mm_loadu_si128((const __m128i*)(Data + 0x10));
+		__m128i X3 = _mm_loadu_si128((const __m128i*)(Data + 0x20));
+		__m128i X4 = _mm_loadu_si128((const __m128i*)(Data + 0x30));
+		X1 = _mm_xor_si128(X1, _mm_cvtsi32_si128((int32)CRC));
+		Data += 64;
+		Length -= 64;
+
+		// Four lanes in parallel
+		__m128i K = _mm_load_si128((const __m128i*)K1K2);
+		for (; Length >= 64; Data += 64, Length -= 64)
+		{
+			const __m128i X5 = _mm_clmulepi64_si128(X1, K, 0x00);
+			const __m128i X6 = _mm_clmulepi64_si128(X2, K, 0x00);
+			const __m128i X7 = _mm_clmulepi64_si128(X3, K, 0x00);
+			const __m128i X8 = _mm_clmulepi64_si128(X4, K, 0x00);
+			X1 = _mm_clmulepi64_si128(X1, K, 0x11);
+			X2 = _mm_clmulepi64_si128(X2, K, 0x11);
+			X3 = _mm_clmulepi64_si128(X3, K, 0x11);
+			X4 = _mm_clmulepi64_si128(X4, K, 0x11);
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, X5), _mm_loadu_si128((const __m128i*)(Data + 0x00)));
+			X2 = _mm_xor_si128(_mm_xor_si128(X2, X6), _mm_loadu_si128((const __m128i*)(Data + 0x10)));
+			X3 = _mm_xor_si128(_mm_xor_si128(X3, X7), _mm_loadu_si128((const __m128i*)(Data + 0x20)));
+			X4 = _mm_xor_si128(_mm_xor_si128(X4, X8), _mm_loadu_si128((const __m128i*)(Data + 0x30)));
+		}
+
+		// Fold the lanes into one, then the 16 byte blocks that are left
+		K = _mm_load_si128((const __m128i*)K3K4);
+		const __m128i Lanes[3] = { X2, X3, X4 };
+		for (const __m128i& Lane : Lanes)
+		{
+			const __m128i X5 = _mm_clmulepi64_si128(X1, K, 0x00);
+			X1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(X1, K, 0x11), Lane), X5);
+		}
+		for (; Length >= 16; Data += 16, Length -= 16)
+		{
+			const __m128i X5 = _mm_clmulepi64_si128(X1, K, 0x00);
+			X1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(X1, K, 0x11), _mm_loadu_si128((const __m128i*)Data)), X5);
+		}
+
+		// 128 bits to 64
+		const __m128i Mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+		X2 = _mm_clmulepi64_si128(X1, K, 0x10);
+		X1 = _mm_xor_si128(_mm_srli_si128(X1, 8), X2);
+		K = _mm_loadl_epi64((const __m128i*)K5K0);
+		X2 = _mm_srli_si128(X1, 4);
+		X1 = _mm_clmulepi64_si128(_mm_and_si128(X1, Mask32), K, 0x00);
+		X1 = _mm_xor_si128(X1, X2);
+
+		// Barrett reduction to 32 bits
+		K = _mm_load_si128((const __m128i*)Poly);
+		X2 = _mm_clmulepi64_si128(_mm_and_si128(X1, Mask32), K, 0x10);
+		X2 = _mm_clmulepi64_si128(_mm_and_si128(X2, Mask32), K, 0x00);
+		X1 = _mm_xor_si128(X1, X2);
+
+		return (uint32)_mm_extract_epi32(X1, 1);
+	}
+
+	/**
+	 * Four rounds with the SHA extensions, Round is the first of them divided by 4. The message schedule runs alongside,
+	 * computing the words for four rounds later from the last four groups: W[g] = msg2(msg1(W[g-4], W[g-3]) ^ W[g-2], W[g-1]).
+	 */
+	template<int32 Function>
+	HASH_SIMD_TARGET("sha,ssse3,sse4.1")
+	FORCEINLINE void Sha1Rounds4(int32 Round, __m128i& ABCD, __m128i& E, __m128i& PreviousABCD, __m128i Message[4])
+	{
+		if (Round >= 4)
+		{
+			Message[Round & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(Message[Round & 3], Message[(Round + 1) & 3]), Message[(Round + 2) & 3]), Message[(Round + 3) & 3]);
+		}
+		const __m128i RoundE = Round == 0 ? _mm_add_epi32(E, Message[0]) : _mm_sha1nexte_epu32(PreviousABCD, Message[Round & 3]);
+		PreviousABCD = ABCD;
+		ABCD = _mm_sha1rnds4_epu32(ABCD, RoundE, Function);
+	}
+
+	HASH_SIMD_TARGET("sha,ssse3,sse4.1")
+	void Sha1Transform(uint32 State[5], const uint8* Blocks, int32 NumBlocks)
+	{
+		// Words are big endian in the message, and the instructions keep A in the highest lane
+		const __m128i ByteSwapWords = _mm_set_epi64x(0x0001020304050607ll, 0x08090a0b0c0d0e0fll);
+		__m128i ABCD = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)State), 0x1B);
+		__m128i E = _mm_set_epi32((int32)State[4], 0, 0, 0);
+
+		for (; NumBlocks > 0; --NumBlocks, Blocks += 64)
+		{
+			const __m128i SavedABCD = ABCD;
+			const __m128i SavedE = E;
+
+			__m128i Message[4];
+			for (int32 Index = 0; Index < 4; ++Index)
+			{
+				Message[Index] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(Blocks + Index * 16)), ByteSwapWords);
+			}
+
+			__m128i PreviousABCD = ABCD;
+			for (int32 Round = 0; Round < 5; ++Round)
+			{
+				Sha1Rounds4<0>(Round, ABCD, E, PreviousABCD, Message);
+			}
+			for (int32 Round = 5; Round < 10; ++Round)
+			{
+				Sha1Rounds4<1>(Round, ABCD, E, PreviousABCD, Message);
+			}
+			for (int32 Round = 10; Round < 15; ++Round)
+			{
+				Sha1Rounds4<2>(Round, ABCD, E, PreviousABCD, Message);
+			}
+			for (int32 Round = 15; Round < 20; ++Round)
+			{
+				Sha1Rounds4<3>(Round, ABCD, E, PreviousABCD, Message);
+			}
+
+			E = _mm_sha1nexte_epu32(PreviousABCD, SavedE);
+			ABCD = _mm_add_epi32(ABCD, SavedABCD);
+		}
+
+		_mm_storeu_si128((__m128i*)State, _mm_shuffle_epi32(ABCD, 0x1B));
+		State[4] = (uint32)_mm_extract_epi32(E, 3);
+	}
+}
+
+#else
+
+namespace HashSIMD
+{
+	bool CanCrc32()
+	{
+		return false;
+	}
+
+	uint32 Crc32(const uint8* Data, int32 Length, uint32 CRC)
+	{
+		check(false);
+		return CRC;
+	}
+
+	bool CanSha1()
+	{
+		return false;
+	}
+
+	void Sha1Transform(uint32 State[5], const uint8* Blocks, int32 NumBlocks)
+	{
+		check(false);
+	}
+}
+
+#endif // HASH_SIMD_SUPPORTED
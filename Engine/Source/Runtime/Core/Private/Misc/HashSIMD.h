@@ -0,0 +1,40 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+
+/**
+ * CRC-32 and SHA-1 on the x64 instructions made for them, used by FCrc::MemCrc32 and FSHA1 when the CPU has them.
+ * Both produce exactly what the portable implementations do. On platforms or compilers without them every Can* is false.
+ */
+namespace HashSIMD
+{
+	/** Shortest input Crc32 takes */
+	const int32 MinCrc32Length = 64;
+
+	/** @return true if the CPU has PCLMULQDQ and SSE4.1, which Crc32 needs */
+	bool CanCrc32();
+
+	/**
+	 * Folds Length bytes into a CRC-32 with carry-less multiplication. This is the CRC-32 of zlib and FCrc::MemCrc32, the
+	 * SSE4.2 crc32 instruction computes CRC-32C, which uses a different polynomial.
+	 *
+	 * @param Data		Data to checksum, no alignment needed
+	 * @param Length	At least MinCrc32Length and a multiple of 16
+	 * @param CRC		Inverted CRC so far, the way MemCrc32 keeps it while it works
+	 * @return the inverted CRC including Data
+	 */
+	uint32 Crc32(const uint8* Data, int32 Length, uint32 CRC);
+
+	/** @return true if the CPU has the SHA extensions, and SSSE3 and SSE4.1 which Sha1Transform uses with them */
+	bool CanSha1();
+
+	/**
+	 * Runs the SHA-1 compression function over consecutive 64 byte blocks.
+	 *
+	 * @param State		The five words of SHA-1 state, updated in place
+	 * @param Blocks	Data to hash, no alignment needed
+	 * @param NumBlocks	Number of 64 byte blocks in Blocks
+	 */
+	void Sha1Transform(uint32 State[5], const uint8* Blocks, int32 NumBlocks);
+}
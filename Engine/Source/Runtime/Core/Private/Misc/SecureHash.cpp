@@ -2,6 +2,7 @@
 
 #include "CorePrivatePCH.h"
 #include "SecureHash.h"
+#include "HashSIMD.h"
 
 
 DEFINE_LOG_CATEGORY_STATIC(LogSecureHash, Log, All);
@@ -667,9 +668,20 @@ void FSHA1::Update(const uint8 *data, uint32 len)
 	{
 		i = 64 - j;
 		FMemory::Memcpy(&m_buffer[j], data, i);
-		Transform(m_state, m_buffer);
+		if (HashSIMD::CanSha1())
+		{
+			// The SHA extensions take the whole run of blocks in one go
+			HashSIMD::Sha1Transform(m_state, m_buffer, 1);
+			const uint32 NumBlocks = (len - i) / 64;
+			HashSIMD::Sha1Transform(m_state, &data[i], NumBlocks);
+			i += NumBlocks * 64;
+		}
+		else
+		{
+			Transform(m_state, m_buffer);
 
-		for( ; i + 63 < len; i += 64) Transform(m_state, &data[i]);
+			for( ; i + 63 < len; i += 64) Transform(m_state, &data[i]);
+		}
 
 		j = 0;
 	}
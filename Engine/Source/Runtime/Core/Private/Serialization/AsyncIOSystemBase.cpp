@@ -492,6 +492,7 @@ int32 FAsyncIOSystemBase::CancelRequests( uint64* RequestIndices, int32 NumIndic
 				DEC_DWORD_STAT_BY( STAT_AsyncIO_OutstandingReadSize, IORequest.Size );				
 				// Decrement thread-safe counter to indicate that request has been "completed".
 				IORequest.Counter->Decrement();
+				NotifyRequestCompleted();
 				// IORequest variable no longer valid after removal.
 				OutstandingRequests.RemoveAt( OutstandingIndex );
 				RequestsCanceled++;
@@ -575,6 +576,11 @@ int64 FAsyncIOSystemBase::MinimumReadSize()
 	return PlatformMinimumReadSize();
 }
 
+void FAsyncIOSystemBase::SetRequestCompletedEvent(FEvent* Event)
+{
+	RequestCompletedEvent = Event;
+}
+
 
 void FAsyncIOSystemBase::Exit()
 {
@@ -714,6 +720,7 @@ void FAsyncIOSystemBase::Tick()
 		{
 			IORequest.Counter->Decrement(); 
 		}
+		NotifyRequestCompleted();
 		// We're done reading for now.
 		BusyWithRequest.Decrement();	
 	}
@@ -18,6 +18,7 @@ struct CORE_API FAsyncIOSystemBase : public FIOSystem, FRunnable, FSingleThreadR
 	**/
 	FAsyncIOSystemBase(IPlatformFile& InLowLevel)
 		: LowLevel(InLowLevel)
+		, RequestCompletedEvent(nullptr)
 	{
 	}
 
@@ -164,6 +165,13 @@ struct CORE_API FAsyncIOSystemBase : public FIOSystem, FRunnable, FSingleThreadR
 	 */
 	virtual int64 MinimumReadSize() override;
 
+	/**
+	 * Sets an event to trigger whenever a request finishes or is canceled
+	 *
+	 * @param Event		Event to trigger, nullptr for none
+	 */
+	virtual void SetRequestCompletedEvent(FEvent* Event) override;
+
 protected:
 
 	/**
@@ -384,6 +392,16 @@ protected:
 	 */
 	void LogIORequest(const FString& Message, const FAsyncIORequest& IORequest);
 
+	/** Triggers RequestCompletedEvent if there is one, called after a request's counter has been decremented */
+	FORCEINLINE void NotifyRequestCompleted()
+	{
+		FEvent* Event = RequestCompletedEvent;
+		if( Event )
+		{
+			Event->Trigger();
+		}
+	}
+
 	/** Critical section used to synchronize access to outstanding requests map						*/
 	FCriticalSection*				CriticalSection;
 	/** TMap of file name string hash to file handles												*/
@@ -392,6 +410,8 @@ protected:
 	TArray<FAsyncIORequest>			OutstandingRequests;
 	/** Event that is signaled if there are outstanding requests									*/
 	FEvent*							OutstandingRequestsEvent;
+	/** Event triggered whenever a request is fulfilled or canceled, can be nullptr					*/
+	FEvent* volatile				RequestCompletedEvent;
 	/** Thread safe counter that is 1 if the thread is currently busy with request, 0 otherwise		*/
 	FThreadSafeCounter				BusyWithRequest;
 	/** Thread safe counter that is 1 if the thread is available to process requests, 0 otherwise	*/
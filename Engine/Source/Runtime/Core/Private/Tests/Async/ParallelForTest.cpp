@@ -0,0 +1,63 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+#include "ParallelFor.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForMinBatchSizeTest, "System.Core.Async.ParallelFor MinBatchSize", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+/**
+ * Checks that ParallelFor with a minimum batch size calls the body exactly once for every index, including when the
+ * counts don't divide evenly and when it is nested inside another ParallelFor.
+ */
+bool FParallelForMinBatchSizeTest::RunTest(const FString& Parameters)
+{
+	const int32 Nums[] = { 0, 1, 7, 64, 1000, 100003 };
+	const int32 MinBatchSizes[] = { 1, 3, 64, 4096 };
+
+	for (int32 Num : Nums)
+	{
+		for (int32 MinBatchSize : MinBatchSizes)
+		{
+			TArray<int32> Calls;
+			Calls.AddZeroed(Num);
+			ParallelFor(Num, MinBatchSize, [&Calls](int32 Index)
+			{
+				FPlatformAtomics::InterlockedIncrement(&Calls[Index]);
+			});
+
+			int32 NumWrong = 0;
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				NumWrong += Calls[Index] != 1 ? 1 : 0;
+			}
+			TestEqual(FString::Printf(TEXT("Indices not called exactly once, Num %d, MinBatchSize %d"), Num, MinBatchSize), NumWrong, 0);
+		}
+	}
+
+	// every outer index runs its own ParallelFor, outer bodies on task threads have to help instead of blocking their thread
+	{
+		const int32 NumOuter = 64;
+		const int32 NumInner = 2000;
+		TArray<int32> Calls;
+		Calls.AddZeroed(NumOuter * NumInner);
+		ParallelFor(NumOuter, 1, [&Calls](int32 OuterIndex)
+		{
+			ParallelFor(NumInner, 16, [&Calls, OuterIndex](int32 InnerIndex)
+			{
+				FPlatformAtomics::InterlockedIncrement(&Calls[OuterIndex * NumInner + InnerIndex]);
+			});
+		});
+
+		int32 NumWrong = 0;
+		for (int32 Index = 0; Index < Calls.Num(); ++Index)
+		{
+			NumWrong += Calls[Index] != 1 ? 1 : 0;
+		}
+		TestEqual(TEXT("Nested indices not called exactly once"), NumWrong, 0);
+	}
+
+	return true;
+}
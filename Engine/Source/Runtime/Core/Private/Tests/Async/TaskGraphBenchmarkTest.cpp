@@ -0,0 +1,254 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+#include "TaskGraphInterfaces.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTaskGraphBenchmarkTest, "System.Core.Async.TaskGraph Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace TaskGraphBenchmarkTest
+{
+	/** Tasks queued by the spawn benchmarks */
+	const int32 NumSpawnTasks = 100000;
+
+	/** Fan-out/fan-in rounds, and tasks each round fans out into */
+	const int32 NumFanOutRounds = 200;
+	const int32 FanOutWidth = 256;
+
+	/** Tasks in the chain, every one queues the next */
+	const int32 ChainLength = 10000;
+
+	/** Nothing here should take anywhere near this long, it only keeps a broken scheduler from hanging the test */
+	const FTimespan MaxWaitTime(0, 0, 30);
+
+	/** Tasks that ran in the current benchmark. Not on the stack, so tasks of a benchmark that timed out can't write to a dead frame. */
+	FThreadSafeCounter CompletedTasks;
+
+	/** Counts how often it ran, it does no other work so the benchmarks only measure scheduling. */
+	class FCountTask : public FCustomStatIDGraphTaskBase
+	{
+	public:
+		FCountTask(FThreadSafeCounter& InCounter)
+			: FCustomStatIDGraphTaskBase(TStatId())
+			, Counter(InCounter)
+		{
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::FireAndForget; }
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			Counter.Increment();
+		}
+	private:
+		FThreadSafeCounter& Counter;
+	};
+
+	/** FCountTask that other tasks can wait for. */
+	class FTrackedCountTask : public FCountTask
+	{
+	public:
+		FTrackedCountTask(FThreadSafeCounter& InCounter)
+			: FCountTask(InCounter)
+		{
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::TrackSubsequents; }
+	};
+
+	/** Queues all of the spawn benchmark's tasks from a task thread instead of the thread running the test. */
+	class FSpawnTask : public FCustomStatIDGraphTaskBase
+	{
+	public:
+		FSpawnTask(FThreadSafeCounter& InCounter)
+			: FCustomStatIDGraphTaskBase(TStatId())
+			, Counter(InCounter)
+		{
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::FireAndForget; }
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			for (int32 Index = 0; Index < NumSpawnTasks; ++Index)
+			{
+				TGraphTask<FCountTask>::CreateTask(nullptr, CurrentThread).ConstructAndDispatchWhenReady(Counter);
+			}
+		}
+	private:
+		FThreadSafeCounter& Counter;
+	};
+
+	/** Fans out into FanOutWidth tasks from a task thread and doesn't complete until all of them have. */
+	class FFanOutTask : public FCustomStatIDGraphTaskBase
+	{
+	public:
+		FFanOutTask(FThreadSafeCounter& InCounter)
+			: FCustomStatIDGraphTaskBase(TStatId())
+			, Counter(InCounter)
+		{
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::TrackSubsequents; }
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			FGraphEventArray Children;
+			for (int32 Index = 0; Index < FanOutWidth; ++Index)
+			{
+				Children.Add(TGraphTask<FTrackedCountTask>::CreateTask(nullptr, CurrentThread).ConstructAndDispatchWhenReady(Counter));
+			}
+			MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FNullGraphTask>::CreateTask(&Children, CurrentThread).ConstructAndDispatchWhenReady(TStatId(), ENamedThreads::AnyThread));
+		}
+	private:
+		FThreadSafeCounter& Counter;
+	};
+
+	/** Queues the next link of a chain from the task thread it ran on, the last link triggers the event. */
+	class FChainTask : public FCustomStatIDGraphTaskBase
+	{
+	public:
+		FChainTask(int32 InRemaining, FEvent* InDoneEvent)
+			: FCustomStatIDGraphTaskBase(TStatId())
+			, Remaining(InRemaining)
+			, DoneEvent(InDoneEvent)
+		{
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::FireAndForget; }
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			if (Remaining > 0)
+			{
+				TGraphTask<FChainTask>::CreateTask(nullptr, CurrentThread).ConstructAndDispatchWhenReady(Remaining - 1, DoneEvent);
+			}
+			else
+			{
+				DoneEvent->Trigger();
+			}
+		}
+	private:
+		int32 Remaining;
+		FEvent* DoneEvent;
+	};
+
+	/** Spins until Counter reaches Target. @return false if that took too long */
+	bool WaitForCounter(const FThreadSafeCounter& Counter, int32 Target)
+	{
+		const FDateTime StartTime = FDateTime::UtcNow();
+		while (Counter.GetValue() < Target)
+		{
+			if (FDateTime::UtcNow() - StartTime > MaxWaitTime)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.0f);
+		}
+		return true;
+	}
+}
+
+
+/**
+ * Measures the scheduling overhead of the task graph's anythread tasks, with TaskGraph.WorkStealing off and on:
+ *   spawn - lots of tiny independent tasks, queued from the thread running the test and from a task thread
+ *   fan-out/fan-in - a task thread queues a batch of tasks and waits for all of them, over and over
+ *   chain - every task queues the next one, which measures the latency from queueing a task to it running
+ */
+bool FTaskGraphBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace TaskGraphBenchmarkTest;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		AddLogItem(TEXT("The task graph runs everything on the game thread, nothing to measure."));
+		return true;
+	}
+
+	IConsoleVariable* WorkStealingVar = IConsoleManager::Get().FindConsoleVariable(TEXT("TaskGraph.WorkStealing"));
+	check(WorkStealingVar);
+	const int32 OldWorkStealing = WorkStealingVar->GetInt();
+
+	AddLogItem(FString::Printf(TEXT("%d worker threads"), FTaskGraphInterface::Get().GetNumWorkerThreads()));
+
+	for (int32 WorkStealing = 0; WorkStealing < 2; ++WorkStealing)
+	{
+		WorkStealingVar->Set(WorkStealing);
+		const TCHAR* Mode = WorkStealing ? TEXT("work stealing") : TEXT("shared queues");
+
+		// spawn from the thread running the test
+		{
+			CompletedTasks.Reset();
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumSpawnTasks; ++Index)
+			{
+				TGraphTask<FCountTask>::CreateTask().ConstructAndDispatchWhenReady(CompletedTasks);
+			}
+			const double QueueTime = FPlatformTime::Seconds();
+			TestTrue(FString::Printf(TEXT("%s: spawned tasks complete"), Mode), WaitForCounter(CompletedTasks, NumSpawnTasks));
+			const double EndTime = FPlatformTime::Seconds();
+
+			AddLogItem(FString::Printf(TEXT("%-14s spawn                %8.3fms queue %8.3fms total %8.2f M tasks/s"), Mode,
+				1000.0 * (QueueTime - StartTime), 1000.0 * (EndTime - StartTime), NumSpawnTasks / FMath::Max(EndTime - StartTime, 1.0e-6) / 1.0e6));
+		}
+
+		// spawn from a task thread
+		{
+			CompletedTasks.Reset();
+			const double StartTime = FPlatformTime::Seconds();
+			TGraphTask<FSpawnTask>::CreateTask().ConstructAndDispatchWhenReady(CompletedTasks);
+			TestTrue(FString::Printf(TEXT("%s: tasks spawned from a task thread complete"), Mode), WaitForCounter(CompletedTasks, NumSpawnTasks));
+			const double EndTime = FPlatformTime::Seconds();
+
+			AddLogItem(FString::Printf(TEXT("%-14s spawn from task       %27.3fms total %8.2f M tasks/s"), Mode,
+				1000.0 * (EndTime - StartTime), NumSpawnTasks / FMath::Max(EndTime - StartTime, 1.0e-6) / 1.0e6));
+		}
+
+		// fan-out/fan-in
+		{
+			CompletedTasks.Reset();
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Round = 0; Round < NumFanOutRounds; ++Round)
+			{
+				FTaskGraphInterface::Get().WaitUntilTaskCompletes(TGraphTask<FFanOutTask>::CreateTask().ConstructAndDispatchWhenReady(CompletedTasks));
+			}
+			const double EndTime = FPlatformTime::Seconds();
+			TestEqual(FString::Printf(TEXT("%s: fanned out tasks run before the fan-in"), Mode), CompletedTasks.GetValue(), NumFanOutRounds * FanOutWidth);
+
+			AddLogItem(FString::Printf(TEXT("%-14s fan-out/fan-in x%-4d %27.3fus per round"), Mode, FanOutWidth,
+				1.0e6 * (EndTime - StartTime) / NumFanOutRounds));
+		}
+
+		// chain latency
+		{
+			FEvent* DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+			const double StartTime = FPlatformTime::Seconds();
+			TGraphTask<FChainTask>::CreateTask().ConstructAndDispatchWhenReady(ChainLength - 1, DoneEvent);
+			const bool bChainCompleted = DoneEvent->Wait(MaxWaitTime);
+			const double EndTime = FPlatformTime::Seconds();
+			TestTrue(FString::Printf(TEXT("%s: chain completes"), Mode), bChainCompleted);
+			if (bChainCompleted)
+			{
+				// otherwise the chain might still trigger it
+				FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+			}
+
+			AddLogItem(FString::Printf(TEXT("%-14s chain                %27.3fus per task"), Mode,
+				1.0e6 * (EndTime - StartTime) / ChainLength));
+		}
+	}
+
+	WorkStealingVar->Set(OldWorkStealing);
+
+	return true;
+}
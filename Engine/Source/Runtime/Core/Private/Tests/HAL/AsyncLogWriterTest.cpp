@@ -0,0 +1,120 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "HAL/AsyncLogWriter.h"
+#include "Misc/AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLogWriterTest, "System.Core.HAL.Async Log Writer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+namespace AsyncLogWriterTest
+{
+	const uint32 BufferSize = 256;
+
+	/** Queues a line and keeps track of what the log should end up holding */
+	void WriteLine(FAsyncLogWriter& Writer, TArray<ANSICHAR>& Expected, const ANSICHAR* Line, bool bMustNotDrop, bool bExpectWritten)
+	{
+		const int32 Size = FCStringAnsi::Strlen(Line);
+		Writer.Write(Line, Size, bMustNotDrop);
+		if (bExpectWritten)
+		{
+			Expected.Append(Line, Size);
+		}
+	}
+
+	void AppendDroppedNote(TArray<ANSICHAR>& Expected, int32 NumDropped)
+	{
+		ANSICHAR Note[MAX_SPRINTF];
+		FCStringAnsi::Sprintf(Note, "[%d log lines dropped, the log file writer could not keep up]" LOG_FILE_LINE_TERMINATOR_ANSI, NumDropped);
+		Expected.Append(Note, FCStringAnsi::Strlen(Note));
+	}
+
+	bool LogMatches(const FBufferArchive& Ar, const TArray<ANSICHAR>& Expected)
+	{
+		return Ar.Num() == Expected.Num() && FMemory::Memcmp(Ar.GetData(), Expected.GetData(), Expected.Num()) == 0;
+	}
+}
+
+/**
+ * Runs FAsyncLogWriter without its thread, so the buffer only empties when the test says so. Checks that lines are dropped
+ * and counted once the buffer is full, that lines that can't be dropped write out the queued ones to make space, that
+ * lines larger than the buffer go straight to the archive, and that lines wrapping around the end of the buffer come out whole.
+ */
+bool FAsyncLogWriterTest::RunTest(const FString& Parameters)
+{
+	using namespace AsyncLogWriterTest;
+
+	// Full buffer
+	{
+		FBufferArchive Ar;
+		TArray<ANSICHAR> Expected;
+		{
+			FAsyncLogWriter Writer(Ar, BufferSize, false);
+
+			// Every line takes 12 bytes with its size header, so 21 of them fit
+			const int32 NumFit = BufferSize / 12;
+			ANSICHAR Line[16];
+			for (int32 Index = 0; Index < NumFit; ++Index)
+			{
+				FCStringAnsi::Sprintf(Line, "Line %02d\n", Index);
+				WriteLine(Writer, Expected, Line, false, true);
+			}
+			TestEqual(TEXT("Nothing is written without the writer thread"), Ar.Num(), 0);
+			TestEqual(TEXT("Nothing is dropped until the buffer is full"), Writer.GetNumDroppedLines(), 0);
+
+			const int32 NumDropped = 5;
+			for (int32 Index = 0; Index < NumDropped; ++Index)
+			{
+				WriteLine(Writer, Expected, "Dropped\n", false, false);
+			}
+			TestEqual(TEXT("Lines that don't fit are dropped and counted"), Writer.GetNumDroppedLines(), NumDropped);
+
+			// An error doesn't fit either, it writes out the queued lines and the dropped count and takes their space
+			AppendDroppedNote(Expected, NumDropped);
+			const int32 SizeBeforeError = Expected.Num();
+			WriteLine(Writer, Expected, "Error!!\n", true, true);
+			TestEqual(TEXT("Queued lines are written out to make space for an error"), Ar.Num(), SizeBeforeError);
+			TestEqual(TEXT("The dropped count is reset once it is in the log"), Writer.GetNumDroppedLines(), 0);
+
+			// A line larger than the whole buffer goes straight to the archive after what is queued
+			TArray<ANSICHAR> LongLine;
+			LongLine.Init('x', BufferSize * 2);
+			LongLine.Last() = '\n';
+			LongLine.Add(0);
+			WriteLine(Writer, Expected, LongLine.GetData(), false, true);
+			TestTrue(TEXT("Log after a line larger than the buffer"), LogMatches(Ar, Expected));
+		}
+		TestTrue(TEXT("Log after a full buffer"), LogMatches(Ar, Expected));
+	}
+
+	// Lines of every size, wrapping around the end of the buffer
+	{
+		FBufferArchive Ar;
+		TArray<ANSICHAR> Expected;
+		{
+			FAsyncLogWriter Writer(Ar, BufferSize, false);
+			FRandomStream Random(0x109);
+
+			ANSICHAR Line[BufferSize];
+			for (int32 Index = 0; Index < 1000; ++Index)
+			{
+				const int32 Size = Random.RandRange(1, BufferSize / 3);
+				for (int32 CharIndex = 0; CharIndex < Size - 1; ++CharIndex)
+				{
+					Line[CharIndex] = 'a' + (Index + CharIndex) % 26;
+				}
+				Line[Size - 1] = '\n';
+				Line[Size] = 0;
+
+				WriteLine(Writer, Expected, Line, true, true);
+				if (Random.RandHelper(8) == 0)
+				{
+					Writer.Flush();
+				}
+			}
+		}
+		TestTrue(TEXT("Log after wrapping around the buffer"), LogMatches(Ar, Expected));
+	}
+
+	return true;
+}
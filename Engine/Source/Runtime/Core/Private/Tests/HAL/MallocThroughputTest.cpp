@@ -0,0 +1,203 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+#include "MallocBinned2.h"
+#include "MallocThreadSafeProxy.h"
+#include "MallocJemalloc.h"
+#include "MallocTBB.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocThroughputTest, "System.Core.HAL.Malloc Multithreaded Throughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace MallocThroughputTest
+{
+	/** Malloc and free pairs done by every thread */
+	const int32 OpsPerThread = 500000;
+
+	/** Blocks each thread keeps alive, every iteration frees one of them and allocates its replacement */
+	const int32 LiveBlocksPerThread = 256;
+
+	const int32 MaxThreads = 32;
+
+	/**
+	 * Allocates and frees small blocks of mixed sizes as fast as it can, and checks that nothing else wrote to them.
+	 */
+	class FMallocWorker : public FRunnable
+	{
+	public:
+		FMallocWorker(FMalloc* InAllocator, bool bInUseTLSCaches, int32 InSeed, FEvent* InStartEvent, FThreadSafeCounter& InReadyCounter)
+			: Allocator(InAllocator)
+			, bUseTLSCaches(bInUseTLSCaches)
+			, Random(InSeed)
+			, Tag((uint8)InSeed)
+			, StartEvent(InStartEvent)
+			, ReadyCounter(InReadyCounter)
+			, NumCorrupted(0)
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			if (bUseTLSCaches)
+			{
+				Allocator->SetupTLSCachesOnCurrentThread();
+			}
+
+			uint8* Blocks[LiveBlocksPerThread];
+			int32 Sizes[LiveBlocksPerThread];
+			FMemory::Memzero(Blocks);
+
+			ReadyCounter.Increment();
+			StartEvent->Wait();
+
+			for (int32 Op = 0; Op < OpsPerThread; ++Op)
+			{
+				const int32 Slot = Op % LiveBlocksPerThread;
+				Free(Blocks[Slot], Sizes[Slot]);
+
+				// Mostly small allocations, like the containers and strings gameplay code churns through
+				Sizes[Slot] = 1 + Random.RandHelper(Random.RandHelper(8) == 0 ? 4096 : 256);
+				Blocks[Slot] = (uint8*)Allocator->Malloc(Sizes[Slot], DEFAULT_ALIGNMENT);
+				Blocks[Slot][0] = Tag;
+				Blocks[Slot][Sizes[Slot] - 1] = Tag;
+			}
+
+			for (int32 Slot = 0; Slot < LiveBlocksPerThread; ++Slot)
+			{
+				Free(Blocks[Slot], Sizes[Slot]);
+			}
+
+			if (bUseTLSCaches)
+			{
+				Allocator->ClearAndDisableTLSCachesOnCurrentThread();
+			}
+			return 0;
+		}
+
+		int32 GetNumCorrupted() const
+		{
+			return NumCorrupted;
+		}
+
+	private:
+		void Free(uint8* Block, int32 Size)
+		{
+			if (Block)
+			{
+				NumCorrupted += (Block[0] != Tag || Block[Size - 1] != Tag) ? 1 : 0;
+				Allocator->Free(Block);
+			}
+		}
+
+		FMalloc* Allocator;
+		bool bUseTLSCaches;
+		FRandomStream Random;
+		uint8 Tag;
+		FEvent* StartEvent;
+		FThreadSafeCounter& ReadyCounter;
+		int32 NumCorrupted;
+	};
+
+	struct FResult
+	{
+		double Seconds;
+		int32 NumCorrupted;
+	};
+
+	FResult RunWorkers(FMalloc* Allocator, bool bUseTLSCaches, int32 NumThreads)
+	{
+		FEvent* StartEvent = FPlatformProcess::GetSynchEventFromPool(true);
+		FThreadSafeCounter ReadyCounter;
+
+		TArray<FMallocWorker*> Workers;
+		TArray<FRunnableThread*> Threads;
+		for (int32 Index = 0; Index < NumThreads; ++Index)
+		{
+			Workers.Add(new FMallocWorker(Allocator, bUseTLSCaches, Index + 1, StartEvent, ReadyCounter));
+			Threads.Add(FRunnableThread::Create(Workers.Last(), *FString::Printf(TEXT("MallocThroughputTest%d"), Index)));
+		}
+
+		while (ReadyCounter.GetValue() < NumThreads)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		StartEvent->Trigger();
+
+		FResult Result;
+		Result.NumCorrupted = 0;
+		for (int32 Index = 0; Index < NumThreads; ++Index)
+		{
+			Threads[Index]->WaitForCompletion();
+		}
+		Result.Seconds = FPlatformTime::Seconds() - StartTime;
+
+		for (int32 Index = 0; Index < NumThreads; ++Index)
+		{
+			Result.NumCorrupted += Workers[Index]->GetNumCorrupted();
+			delete Threads[Index];
+			delete Workers[Index];
+		}
+
+		FPlatformProcess::ReturnSynchEventToPool(StartEvent);
+		return Result;
+	}
+}
+
+
+/**
+ * Runs the same malloc/free workload on every core with FMallocBinned2 behind a single lock (the way it was used before it
+ * became internally thread safe), FMallocBinned2 with per-thread caches, and jemalloc and TBB where the platform has them.
+ * Reports the throughput of each and checks that no block was handed to two threads at once.
+ */
+bool FMallocThroughputTest::RunTest(const FString& Parameters)
+{
+	using namespace MallocThroughputTest;
+
+	// Allocators are never destroyed, keep one of each for every run of the test
+	static FMallocBinned2* Binned2 = new FMallocBinned2((uint32)(FPlatformMemory::GetConstants().PageSize & MAX_uint32), (uint64)MAX_uint32 + 1);
+	static FMallocThreadSafeProxy* LockedBinned2 = new FMallocThreadSafeProxy(Binned2);
+
+	struct FCase
+	{
+		const TCHAR* Name;
+		FMalloc* Allocator;
+		bool bUseTLSCaches;
+	};
+
+	TArray<FCase> Cases;
+	Cases.Add({ TEXT("binned2, single lock"), LockedBinned2, false });
+	Cases.Add({ TEXT("binned2, per-thread caches"), Binned2, true });
+#if PLATFORM_SUPPORTS_JEMALLOC
+	static FMallocJemalloc* Jemalloc = new FMallocJemalloc();
+	Cases.Add({ TEXT("jemalloc"), Jemalloc, false });
+#endif
+#if PLATFORM_SUPPORTS_TBB && TBB_ALLOCATOR_ALLOWED
+	static FMallocTBB* TBB = new FMallocTBB();
+	Cases.Add({ TEXT("tbb"), TBB, false });
+#endif
+
+	const int32 NumThreads = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 2, MaxThreads);
+	AddLogItem(FString::Printf(TEXT("%d threads, %d malloc/free pairs each, %d live blocks per thread"), NumThreads, OpsPerThread, LiveBlocksPerThread));
+
+	double SingleLockSeconds = 0.0;
+	for (const FCase& Case : Cases)
+	{
+		const FResult Result = RunWorkers(Case.Allocator, Case.bUseTLSCaches, NumThreads);
+		if (Case.Allocator == LockedBinned2)
+		{
+			SingleLockSeconds = Result.Seconds;
+		}
+
+		AddLogItem(FString::Printf(TEXT("%-28s %8.2f M ops/s, %6.2fx single lock binned2"), Case.Name,
+			2.0 * NumThreads * OpsPerThread / FMath::Max(Result.Seconds, 1.0e-6) / 1.0e6, SingleLockSeconds / FMath::Max(Result.Seconds, 1.0e-6)));
+		TestEqual(FString::Printf(TEXT("%s: blocks overwritten by another thread"), Case.Name), Result.NumCorrupted, 0);
+	}
+
+	TestTrue(TEXT("binned2 heap is valid"), Binned2->ValidateHeap());
+
+	return true;
+}
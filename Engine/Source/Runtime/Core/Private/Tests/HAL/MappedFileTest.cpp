@@ -0,0 +1,76 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "Misc/AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMappedFileTest, "System.Core.HAL.Mapped File", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Maps regions of a file that start on and off page and allocation granularity boundaries, and that run past the end of
+ * the file, and checks they hold what was written. Also checks regions stay mapped once the file handle is closed.
+ */
+bool FMappedFileTest::RunTest( const FString& Parameters )
+{
+	const int64 FileSize = 3 * 65536 + 123;
+
+	TArray<uint8> Data;
+	Data.AddUninitialized(FileSize);
+	FRandomStream Random(0x1234);
+	for (int64 Index = 0; Index < FileSize; ++Index)
+	{
+		Data[Index] = (uint8)Random.RandHelper(256);
+	}
+
+	const FString TempFilename = FPaths::EngineSavedDir() / FGuid::NewGuid().ToString();
+	if (!FFileHelper::SaveArrayToFile(Data, *TempFilename))
+	{
+		AddError(FString::Printf(TEXT("Couldn't write %s."), *TempFilename));
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	IMappedFileHandle* MappedFile = PlatformFile.OpenMapped(*TempFilename);
+	if (!MappedFile)
+	{
+		AddLogItem(FString::Printf(TEXT("%s can't map files."), PlatformFile.GetName()));
+		PlatformFile.DeleteFile(*TempFilename);
+		return true;
+	}
+	TestEqual(TEXT("Mapped file size"), MappedFile->GetFileSize(), FileSize);
+
+	const int64 Offsets[] = { 0, 1, 4095, 4096, 4097, 65535, 65536, 65537, FileSize - 1 };
+	const int64 Sizes[] = { 1, 100, 4096, 65536 + 3, FileSize };
+
+	TArray<IMappedFileRegion*> Regions;
+	TArray<int64> RegionOffsets;
+	for (int64 Offset : Offsets)
+	{
+		for (int64 Size : Sizes)
+		{
+			IMappedFileRegion* Region = MappedFile->MapRegion(Offset, Size);
+			const int64 ExpectedSize = FMath::Min(Size, FileSize - Offset);
+			TestNotNull(*FString::Printf(TEXT("Region of %lld bytes at %lld"), Size, Offset), Region);
+			if (Region)
+			{
+				TestEqual(*FString::Printf(TEXT("Size of region of %lld bytes at %lld"), Size, Offset), Region->GetMappedSize(), ExpectedSize);
+				TestTrue(*FString::Printf(TEXT("Contents of region of %lld bytes at %lld"), Size, Offset), FMemory::Memcmp(Region->GetMappedPtr(), Data.GetData() + Offset, ExpectedSize) == 0);
+				Regions.Add(Region);
+				RegionOffsets.Add(Offset);
+			}
+		}
+	}
+
+	delete MappedFile;
+
+	for (int32 RegionIndex = 0; RegionIndex < Regions.Num(); ++RegionIndex)
+	{
+		IMappedFileRegion* Region = Regions[RegionIndex];
+		TestTrue(TEXT("Contents of region after closing the file"), FMemory::Memcmp(Region->GetMappedPtr(), Data.GetData() + RegionOffsets[RegionIndex], Region->GetMappedSize()) == 0);
+		delete Region;
+	}
+
+	PlatformFile.DeleteFile(*TempFilename);
+
+	return true;
+}
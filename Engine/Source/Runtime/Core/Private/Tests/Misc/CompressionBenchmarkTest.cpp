@@ -0,0 +1,133 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "Misc/AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionBenchmarkTest, "System.Core.Misc.Compression Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace CompressionBenchmarkTest
+{
+	/** Package data the corpus stops growing at */
+	const int64 MaxCorpusSize = 64 * 1024 * 1024;
+
+	/** Pak files compress in blocks of this size by default */
+	const int32 BlockSize = 64 * 1024;
+
+	/**
+	 * Loads packages into blocks until the corpus is big enough, from -CompressionCorpus=<dir> if it's given and the
+	 * game's and the engine's content otherwise, which are cooked packages in a cooked build.
+	 */
+	void LoadCorpus(TArray<TArray<uint8>>& OutBlocks)
+	{
+		TArray<FString> Directories;
+		FString CorpusDirectory;
+		if (FParse::Value(FCommandLine::Get(), TEXT("CompressionCorpus="), CorpusDirectory))
+		{
+			Directories.Add(CorpusDirectory);
+		}
+		else
+		{
+			Directories.Add(FPaths::GameContentDir());
+			Directories.Add(FPaths::EngineContentDir());
+		}
+
+		TArray<FString> Filenames;
+		for (const FString& Directory : Directories)
+		{
+			IFileManager::Get().FindFilesRecursive(Filenames, *Directory, TEXT("*.uasset"), true, false, false);
+			IFileManager::Get().FindFilesRecursive(Filenames, *Directory, TEXT("*.umap"), true, false, false);
+		}
+
+		int64 CorpusSize = 0;
+		TArray<uint8> Package;
+		for (int32 FileIndex = 0; FileIndex < Filenames.Num() && CorpusSize < MaxCorpusSize; ++FileIndex)
+		{
+			if (!FFileHelper::LoadFileToArray(Package, *Filenames[FileIndex], FILEREAD_Silent))
+			{
+				continue;
+			}
+			for (int32 Offset = 0; Offset < Package.Num(); Offset += BlockSize)
+			{
+				TArray<uint8>& Block = OutBlocks[OutBlocks.AddDefaulted()];
+				Block.Append(Package.GetData() + Offset, FMath::Min(BlockSize, Package.Num() - Offset));
+			}
+			CorpusSize += Package.Num();
+		}
+	}
+}
+
+
+/**
+ * Compresses and uncompresses packages in pak sized blocks with every codec, and reports the ratio and the speed each way.
+ */
+bool FCompressionBenchmarkTest::RunTest( const FString& Parameters )
+{
+	using namespace CompressionBenchmarkTest;
+
+	TArray<TArray<uint8>> Blocks;
+	LoadCorpus(Blocks);
+	int64 CorpusSize = 0;
+	for (const TArray<uint8>& Block : Blocks)
+	{
+		CorpusSize += Block.Num();
+	}
+	if (CorpusSize == 0)
+	{
+		AddLogItem(TEXT("No packages found, pass -CompressionCorpus=<dir> to point the benchmark at some."));
+		return true;
+	}
+	AddLogItem(FString::Printf(TEXT("%.1fMB of packages in %d blocks"), CorpusSize / (1024.0 * 1024.0), Blocks.Num()));
+
+	const ECompressionFlags Types[] = { COMPRESS_ZLIB, COMPRESS_LZ4, COMPRESS_Custom };
+	for (ECompressionFlags Type : Types)
+	{
+		ICompressionFormat* Format = FCompression::GetFormat(Type);
+		if (!Format)
+		{
+			continue;
+		}
+
+		TArray<TArray<uint8>> CompressedBlocks;
+		CompressedBlocks.AddDefaulted(Blocks.Num());
+		int64 CompressedCorpusSize = 0;
+		bool bCompressed = true;
+
+		const double CompressStartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Blocks.Num() && bCompressed; ++Index)
+		{
+			int32 CompressedSize = FCompression::CompressMemoryBound(Type, Blocks[Index].Num());
+			CompressedBlocks[Index].AddUninitialized(CompressedSize);
+			bCompressed = FCompression::CompressMemory(Type, CompressedBlocks[Index].GetData(), CompressedSize, Blocks[Index].GetData(), Blocks[Index].Num());
+			CompressedBlocks[Index].SetNum(CompressedSize);
+			CompressedCorpusSize += CompressedSize;
+		}
+		const double CompressTime = FPlatformTime::Seconds() - CompressStartTime;
+		TestTrue(FString::Printf(TEXT("%s compresses the corpus"), Format->GetName()), bCompressed);
+		if (!bCompressed)
+		{
+			continue;
+		}
+
+		TArray<uint8> Uncompressed;
+		Uncompressed.AddUninitialized(BlockSize);
+		int32 NumWrongBlocks = 0;
+		double UncompressTime = 0.0;
+		for (int32 Index = 0; Index < Blocks.Num(); ++Index)
+		{
+			const double UncompressStartTime = FPlatformTime::Seconds();
+			const bool bUncompressed = FCompression::UncompressMemory(Type, Uncompressed.GetData(), Blocks[Index].Num(), CompressedBlocks[Index].GetData(), CompressedBlocks[Index].Num());
+			UncompressTime += FPlatformTime::Seconds() - UncompressStartTime;
+			NumWrongBlocks += (!bUncompressed || FMemory::Memcmp(Uncompressed.GetData(), Blocks[Index].GetData(), Blocks[Index].Num()) != 0) ? 1 : 0;
+		}
+		TestEqual(FString::Printf(TEXT("%s blocks that don't uncompress to the original"), Format->GetName()), NumWrongBlocks, 0);
+
+		AddLogItem(FString::Printf(TEXT("%-8s ratio %6.3f  compress %8.1f MB/s  uncompress %8.1f MB/s"), Format->GetName(),
+			(double)CompressedCorpusSize / CorpusSize,
+			CorpusSize / (1024.0 * 1024.0) / FMath::Max(CompressTime, 1.0e-6),
+			CorpusSize / (1024.0 * 1024.0) / FMath::Max(UncompressTime, 1.0e-6)));
+	}
+
+	return true;
+}
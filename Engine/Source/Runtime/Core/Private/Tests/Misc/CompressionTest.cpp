@@ -0,0 +1,84 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "Misc/AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionRoundTripTest, "System.Core.Misc.Compression RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Compresses data that's empty, tiny, incompressible, made of long runs and full of short overlapping matches with every
+ * codec that can decompress, and checks it comes back the same. Also checks GZIP's bound holds for incompressible data.
+ */
+bool FCompressionRoundTripTest::RunTest( const FString& Parameters )
+{
+	const int32 Sizes[] = { 0, 1, 12, 13, 100, 4096, 65536, (int32)FCompression::MaxUncompressedSize };
+	const ECompressionFlags Types[] = { COMPRESS_ZLIB, COMPRESS_LZ4, COMPRESS_Custom };
+
+	FRandomStream Random(0x1234);
+	for (ECompressionFlags Type : Types)
+	{
+		ICompressionFormat* Format = FCompression::GetFormat(Type);
+		if (!Format)
+		{
+			continue;
+		}
+
+		for (int32 Size : Sizes)
+		{
+			for (int32 Pattern = 0; Pattern < 3; ++Pattern)
+			{
+				TArray<uint8> Uncompressed;
+				Uncompressed.AddUninitialized(Size);
+				for (int32 Index = 0; Index < Size; ++Index)
+				{
+					switch (Pattern)
+					{
+					case 0:
+						Uncompressed[Index] = (uint8)Random.RandHelper(256);
+						break;
+					case 1:
+						Uncompressed[Index] = (uint8)(Index / 1000);
+						break;
+					default:
+						Uncompressed[Index] = Index > 16 && Random.RandHelper(8) ? Uncompressed[Index - 1 - Random.RandHelper(16)] : (uint8)Random.RandHelper(4);
+						break;
+					}
+				}
+
+				int32 CompressedSize = FCompression::CompressMemoryBound(Type, Size);
+				TArray<uint8> Compressed;
+				Compressed.AddUninitialized(CompressedSize);
+				const bool bCompressed = FCompression::CompressMemory(Type, Compressed.GetData(), CompressedSize, Uncompressed.GetData(), Size);
+				TestTrue(FString::Printf(TEXT("%s compresses %d bytes of pattern %d"), Format->GetName(), Size, Pattern), bCompressed);
+				if (!bCompressed)
+				{
+					continue;
+				}
+
+				TArray<uint8> RoundTrip;
+				RoundTrip.AddZeroed(Size);
+				const bool bUncompressed = FCompression::UncompressMemory(Type, RoundTrip.GetData(), Size, Compressed.GetData(), CompressedSize);
+				TestTrue(FString::Printf(TEXT("%s uncompresses %d bytes of pattern %d"), Format->GetName(), Size, Pattern), bUncompressed && RoundTrip == Uncompressed);
+			}
+		}
+	}
+
+	// GZIP can't decompress, but incompressible data still has to fit in the bound it gives
+	for (int32 Size : Sizes)
+	{
+		TArray<uint8> Uncompressed;
+		Uncompressed.AddUninitialized(Size);
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			Uncompressed[Index] = (uint8)Random.RandHelper(256);
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_GZIP, Size);
+		TArray<uint8> Compressed;
+		Compressed.AddUninitialized(CompressedSize);
+		TestTrue(FString::Printf(TEXT("GZIP compresses %d incompressible bytes within its bound"), Size), FCompression::CompressMemory(COMPRESS_GZIP, Compressed.GetData(), CompressedSize, Uncompressed.GetData(), Size));
+	}
+
+	return true;
+}
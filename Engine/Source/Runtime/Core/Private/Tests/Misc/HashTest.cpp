@@ -0,0 +1,111 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "SecureHash.h"
+#include "Misc/AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemCrc32Test, "System.Core.Misc.MemCrc32", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+/**
+ * Checks MemCrc32 against the CRC computed a byte at a time from the table, at every alignment and for lengths on both
+ * sides of where it switches to carry-less multiplication on CPUs that have it.
+ */
+bool FMemCrc32Test::RunTest( const FString& Parameters )
+{
+	TestTrue(TEXT("CRC-32 check value"), FCrc::MemCrc32("123456789", 9) == 0xCBF43926);
+
+	FRandomStream Random(0x5eed);
+	TArray<uint8> Data;
+	Data.AddUninitialized(4096 + 16);
+	for (uint8& Byte : Data)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	const int32 Lengths[] = { 0, 1, 15, 16, 17, 63, 64, 65, 79, 80, 127, 128, 129, 1000, 4096 };
+	int32 NumWrong = 0;
+	for (int32 Offset = 0; Offset < 16; ++Offset)
+	{
+		for (int32 Length : Lengths)
+		{
+			const uint32 InitialCRC = Random.GetUnsignedInt();
+			uint32 Expected = ~InitialCRC;
+			for (int32 Index = 0; Index < Length; ++Index)
+			{
+				Expected = (Expected >> 8) ^ FCrc::CRCTablesSB8[0][(Expected ^ Data[Offset + Index]) & 0xFF];
+			}
+			Expected = ~Expected;
+
+			NumWrong += FCrc::MemCrc32(Data.GetData() + Offset, Length, InitialCRC) != Expected ? 1 : 0;
+		}
+	}
+	TestEqual(TEXT("CRCs that differ from the byte at a time CRC"), NumWrong, 0);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSHA1Test, "System.Core.Misc.SHA1", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+/**
+ * Checks FSHA1 against the FIPS 180 test vectors, and that hashing the same data in one go and in pieces of every size
+ * up to a couple of blocks gives the same hash.
+ */
+bool FSHA1Test::RunTest( const FString& Parameters )
+{
+	struct FTestVector
+	{
+		const ANSICHAR* Message;
+		int32 Repeat;
+		const TCHAR* Hash;
+	};
+	const FTestVector Vectors[] =
+	{
+		{ "", 1, TEXT("DA39A3EE5E6B4B0D3255BFEF95601890AFD80709") },
+		{ "abc", 1, TEXT("A9993E364706816ABA3E25717850C26C9CD0D89D") },
+		{ "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, TEXT("84983E441C3BD26EBAAE4AA1F95129E5E54670F1") },
+		{ "a", 1000000, TEXT("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F") },
+	};
+	for (const FTestVector& Vector : Vectors)
+	{
+		const int32 Length = FCStringAnsi::Strlen(Vector.Message);
+		TArray<uint8> Message;
+		for (int32 Repeat = 0; Repeat < Vector.Repeat; ++Repeat)
+		{
+			Message.Append((const uint8*)Vector.Message, Length);
+		}
+
+		uint8 Hash[20];
+		FSHA1::HashBuffer(Message.GetData(), Message.Num(), Hash);
+		TestEqual(FString::Printf(TEXT("SHA-1 of %d x \"%s\""), Vector.Repeat, ANSI_TO_TCHAR(Vector.Message)), BytesToHex(Hash, sizeof(Hash)), FString(Vector.Hash));
+	}
+
+	FRandomStream Random(0x5eed);
+	TArray<uint8> Data;
+	Data.AddUninitialized(64 * 20 + 7);
+	for (uint8& Byte : Data)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	uint8 Expected[20];
+	FSHA1::HashBuffer(Data.GetData(), Data.Num(), Expected);
+
+	int32 NumWrong = 0;
+	for (int32 PieceSize = 1; PieceSize <= 130; ++PieceSize)
+	{
+		FSHA1 Sha;
+		for (int32 Offset = 0; Offset < Data.Num(); Offset += PieceSize)
+		{
+			Sha.Update(Data.GetData() + Offset, FMath::Min(PieceSize, Data.Num() - Offset));
+		}
+		Sha.Final();
+		uint8 Hash[20];
+		Sha.GetHash(Hash);
+		NumWrong += FMemory::Memcmp(Hash, Expected, sizeof(Hash)) != 0 ? 1 : 0;
+	}
+	TestEqual(TEXT("Hashes of data updated in pieces that differ from hashing it in one go"), NumWrong, 0);
+
+	return true;
+}
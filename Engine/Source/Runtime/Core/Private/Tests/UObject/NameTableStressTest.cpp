@@ -0,0 +1,166 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameTableStressTest, "System.Core.UObject.Name Table Multithreaded Stress", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace NameTableStressTest
+{
+	/** Distinct names shared by all threads. They stay in the name table, so later runs only find them. */
+	const int32 NumKeys = 256 * 1024;
+
+	const int32 MaxThreads = 32;
+
+	/** Builds the string for a key. It must not end in a number, or FName would split that off and every key would share one entry. */
+	void MakeKeyString(int32 Key, TCHAR (&Buffer)[64])
+	{
+		FCString::Sprintf(Buffer, TEXT("NameTableStress%dKey"), Key);
+	}
+
+	/**
+	 * Creates every key's FName, starting at a different key on each thread so that threads race to add the same names,
+	 * then looks them all up again with FNAME_Find.
+	 */
+	class FNameWorker : public FRunnable
+	{
+	public:
+		FNameWorker(int32 InFirstKey, FEvent* InStartEvent, FEvent* InFindEvent, FThreadSafeCounter& InReadyCounter)
+			: NumFindMismatches(0)
+			, FirstKey(InFirstKey)
+			, StartEvent(InStartEvent)
+			, FindEvent(InFindEvent)
+			, ReadyCounter(InReadyCounter)
+		{
+			Indices.AddUninitialized(NumKeys);
+		}
+
+		virtual uint32 Run() override
+		{
+			TCHAR Buffer[64];
+
+			ReadyCounter.Increment();
+			StartEvent->Wait();
+
+			for (int32 Op = 0; Op < NumKeys; ++Op)
+			{
+				const int32 Key = (FirstKey + Op) % NumKeys;
+				MakeKeyString(Key, Buffer);
+				Indices[Key] = FName(Buffer, FNAME_Add).GetComparisonIndex();
+			}
+
+			ReadyCounter.Increment();
+			FindEvent->Wait();
+
+			for (int32 Op = 0; Op < NumKeys; ++Op)
+			{
+				const int32 Key = (FirstKey + Op) % NumKeys;
+				MakeKeyString(Key, Buffer);
+				NumFindMismatches += FName(Buffer, FNAME_Find).GetComparisonIndex() != Indices[Key] ? 1 : 0;
+			}
+
+			ReadyCounter.Increment();
+			return 0;
+		}
+
+		/** Comparison index this thread got for every key */
+		TArray<int32> Indices;
+
+		/** Keys FNAME_Find returned a different entry for than FNAME_Add did */
+		int32 NumFindMismatches;
+
+	private:
+		int32 FirstKey;
+		FEvent* StartEvent;
+		FEvent* FindEvent;
+		FThreadSafeCounter& ReadyCounter;
+	};
+
+	/** Releases the waiting workers and returns how long it took all of them to reach the counter again */
+	double RunPhase(FEvent* Event, FThreadSafeCounter& ReadyCounter, int32 NumReady)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Event->Trigger();
+		while (ReadyCounter.GetValue() < NumReady)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+
+/**
+ * Builds the same set of names from every core at once, so that most adds collide with another thread adding the same
+ * string, and then looks them all up again. Reports names per second for both and checks that every thread ended up with
+ * the same entry for every string and that the entries hold the right strings.
+ */
+bool FNameTableStressTest::RunTest(const FString& Parameters)
+{
+	using namespace NameTableStressTest;
+
+	const int32 NumThreads = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 2, MaxThreads);
+	const int32 NumNamesBefore = FName::GetMaxNames();
+
+	FEvent* StartEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	FEvent* FindEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	FThreadSafeCounter ReadyCounter;
+
+	TArray<FNameWorker*> Workers;
+	TArray<FRunnableThread*> Threads;
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		Workers.Add(new FNameWorker(Index * NumKeys / NumThreads, StartEvent, FindEvent, ReadyCounter));
+		Threads.Add(FRunnableThread::Create(Workers.Last(), *FString::Printf(TEXT("NameTableStressTest%d"), Index)));
+	}
+
+	while (ReadyCounter.GetValue() < NumThreads)
+	{
+		FPlatformProcess::Sleep(0.0f);
+	}
+
+	const double AddSeconds = RunPhase(StartEvent, ReadyCounter, 2 * NumThreads);
+	const double FindSeconds = RunPhase(FindEvent, ReadyCounter, 3 * NumThreads);
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		Threads[Index]->WaitForCompletion();
+	}
+
+	const double NumOps = (double)NumThreads * NumKeys;
+	AddLogItem(FString::Printf(TEXT("%d threads, %d names each, %d new names in the table"), NumThreads, NumKeys, FName::GetMaxNames() - NumNamesBefore));
+	AddLogItem(FString::Printf(TEXT("find or add %8.2f M names/s"), NumOps / FMath::Max(AddSeconds, 1.0e-6) / 1.0e6));
+	AddLogItem(FString::Printf(TEXT("find        %8.2f M names/s"), NumOps / FMath::Max(FindSeconds, 1.0e-6) / 1.0e6));
+
+	int32 NumIndexMismatches = 0;
+	int32 NumFindMismatches = 0;
+	int32 NumStringMismatches = 0;
+	TCHAR Buffer[64];
+	for (int32 Key = 0; Key < NumKeys; ++Key)
+	{
+		const int32 Index = Workers[0]->Indices[Key];
+		for (int32 Worker = 1; Worker < NumThreads; ++Worker)
+		{
+			NumIndexMismatches += Workers[Worker]->Indices[Key] != Index ? 1 : 0;
+		}
+
+		MakeKeyString(Key, Buffer);
+		NumStringMismatches += FName(Index, Index, NAME_NO_NUMBER_INTERNAL).ToString() != Buffer ? 1 : 0;
+	}
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		NumFindMismatches += Workers[Index]->NumFindMismatches;
+		delete Threads[Index];
+		delete Workers[Index];
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(StartEvent);
+	FPlatformProcess::ReturnSynchEventToPool(FindEvent);
+
+	TestEqual(TEXT("Names that got a different entry on different threads"), NumIndexMismatches, 0);
+	TestEqual(TEXT("Names that FNAME_Find resolved to a different entry than FNAME_Add"), NumFindMismatches, 0);
+	TestEqual(TEXT("Entries that don't hold the string they were added for"), NumStringMismatches, 0);
+
+	return true;
+}
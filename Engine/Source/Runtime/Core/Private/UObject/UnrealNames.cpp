@@ -211,15 +211,16 @@ FNameEntry*** FName::GetNameTableForDebuggerVisualizers_MT()
 }
 
 
-FCriticalSection* FName::GetCriticalSection()
+FCriticalSection* FName::GetCriticalSection(uint32 HashIndex)
 {
-	static FCriticalSection*	CriticalSection = NULL;
-	if( CriticalSection == NULL )
+	// Created by StaticInit before any other thread can add names, see GetNames() for why this isn't a plain static array
+	static FCriticalSection*	CriticalSections = NULL;
+	if( CriticalSections == NULL )
 	{
 		check(IsInGameThread());
-		CriticalSection = new FCriticalSection();
+		CriticalSections = new FCriticalSection[FNameDefs::NameHashShardCount];
 	}
-	return CriticalSection;
+	return &CriticalSections[HashIndex & (FNameDefs::NameHashShardCount - 1)];
 }
 
 FString FName::NameToDisplayString( const FString& InDisplayName, const bool bIsBool )
@@ -628,10 +629,13 @@ bool FName::InitInternal_FindOrAddNameEntry(const TCharType* InName, const EFind
 	// Hash value of string
 	const int32 iHash = ( (ComparisonMode == ENameCase::IgnoreCase) ? FCrc::Strihash_DEPRECATED( InName ) : FCrc::StrCrc32( InName ) ) & (ARRAY_COUNT(NameHash)-1);
 
+	// Entries are only ever pushed onto the front of a bucket, so everything from this entry on has been searched already
+	FNameEntry* const SearchedHead = NameHash[iHash];
+
 	if (OutIndex < 0)
 	{
-		// Try to find the name in the hash.
-		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
+		// Try to find the name in the hash. This doesn't need a lock, finding a name that already exists is the common case.
+		for( FNameEntry* Hash=SearchedHead; Hash; Hash=Hash->HashNext )
 		{
 			FPlatformMisc::Prefetch( Hash->HashNext );
 			// Compare the passed in string
@@ -666,12 +670,13 @@ bool FName::InitInternal_FindOrAddNameEntry(const TCharType* InName, const EFind
 			return false;
 		}
 	}
-	// acquire the lock
-	FScopeLock ScopeLock(GetCriticalSection());
+	// acquire the lock for this bucket, adds to buckets in other shards carry on in parallel
+	FScopeLock ScopeLock(GetCriticalSection(iHash));
 	if (OutIndex < 0)
 	{
-		// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it
-		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
+		// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it.
+		// Only the entries added since the unlocked search need to be compared.
+		for( FNameEntry* Hash=NameHash[iHash]; Hash != SearchedHead; Hash=Hash->HashNext )
 		{
 			// Compare the passed in string
 			if( Hash->IsEqual( InName, ComparisonMode ) )
@@ -770,12 +775,9 @@ void FName::StaticInit()
 		NameHash[HashIndex] = NULL;
 	}
 
-	{
-		FScopeLock ScopeLock(GetCriticalSection());
-
-		TNameEntryArray& Names = GetNames();
-		Names.AddZeroed(NAME_MaxHardcodedNameIndex + 1);
-	}
+	// Create the name table and its locks before any other thread can add a name
+	GetCriticalSection(0);
+	GetNames().AddZeroed(NAME_MaxHardcodedNameIndex + 1);
 
 	{
 		// Register all hardcoded names.
@@ -1021,6 +1023,9 @@ FArchive& operator<<( FArchive& Ar, FNameEntry& E )
  * never go away. It simply uses 64K chunks and allocates new ones as space runs out. This reduces
  * allocation overhead significantly (only minor waste on 64k boundaries) and also greatly helps
  * with fragmentation as 50-100k allocations turn into tens of allocations.
+ *
+ * Names are added from many threads at once, so allocation is lock free: every pool keeps an
+ * interlocked count of the bytes handed out from it and threads race to replace a full pool.
  */
 class FNameEntryPoolAllocator
 {
@@ -1029,9 +1034,7 @@ public:
 	FNameEntryPoolAllocator()
 	{
 		TotalAllocatedPages	= 0;
-		CurrentPoolStart	= NULL;
-		CurrentPoolEnd		= NULL;
-		check(ThreadGuard.GetValue() == 0);
+		CurrentPool			= NULL;
 	}
 
 	/**
@@ -1042,23 +1045,40 @@ public:
 	 */
 	FNameEntry* Allocate( int32 Size )
 	{
-		check(ThreadGuard.Increment() == 1);
 		// Some platforms need all of the name entries to be aligned to 4 bytes, so by
 		// aligning the size here the next allocation will be aligned to 4
 		Size = Align( Size, ALIGNOF(FNameEntry) );
+		check( Size <= PoolSize() - PoolHeaderSize() );
 
-		// Allocate a new pool if current one is exhausted. We don't worry about a little bit
-		// of waste at the end given the relative size of pool to average and max allocation.
-		if( CurrentPoolEnd - CurrentPoolStart < Size )
+		FPool* Pool = CurrentPool;
+		while( 1 )
 		{
-			AllocateNewPool();
+			if( Pool )
+			{
+				// Claim the next Size bytes. Racing claims can run past the end, those bytes are simply never used.
+				const int32 Offset = FPlatformAtomics::InterlockedAdd( &Pool->Used, Size );
+				if( Offset + Size <= PoolSize() )
+				{
+					return (FNameEntry*) ((uint8*)Pool + Offset);
+				}
+			}
+
+			// Allocate a new pool if current one is exhausted. We don't worry about a little bit
+			// of waste at the end given the relative size of pool to average and max allocation.
+			FPool* NewPool = AllocateNewPool();
+			FPool* PreviousPool = (FPool*) FPlatformAtomics::InterlockedCompareExchangePointer( (void**)&CurrentPool, NewPool, Pool );
+			if( PreviousPool == Pool )
+			{
+				FPlatformAtomics::InterlockedIncrement( &TotalAllocatedPages );
+				Pool = NewPool;
+			}
+			else
+			{
+				// Another thread replaced the pool first, use theirs. Pools are never freed, so an older one is safe to look at.
+				FMemory::Free( NewPool );
+				Pool = PreviousPool;
+			}
 		}
-		check( CurrentPoolEnd - CurrentPoolStart >= Size );
-		// Return current pool start as allocation and increment by size.
-		FNameEntry* NameEntry = (FNameEntry*) CurrentPoolStart;
-		CurrentPoolStart += Size;
-		check(ThreadGuard.Decrement() == 0);
-		return NameEntry;
 	}
 
 	/**
@@ -1083,22 +1103,31 @@ public:
 	}
 
 private:
-	/** Allocates a new pool. */
-	void AllocateNewPool()
+	/** Header at the start of every pool, name entries follow it. */
+	struct FPool
+	{
+		/** Bytes claimed from this pool, including the header. Can exceed PoolSize() when allocations race for the last bytes. */
+		volatile int32 Used;
+	};
+
+	/** Size of the pool header, rounded up so the first name entry is aligned. */
+	FORCEINLINE int32 PoolHeaderSize()
+	{
+		return Align( (int32)sizeof(FPool), ALIGNOF(FNameEntry) );
+	}
+
+	/** Allocates a new pool, it isn't visible to other threads until it is swapped into CurrentPool. */
+	FPool* AllocateNewPool()
 	{
-		TotalAllocatedPages++;
-		CurrentPoolStart = (uint8*) FMemory::Malloc(PoolSize());
-		CurrentPoolEnd = CurrentPoolStart + PoolSize();
+		FPool* Pool = (FPool*) FMemory::Malloc(PoolSize());
+		Pool->Used = PoolHeaderSize();
+		return Pool;
 	}
 
-	/** Beginning of pool. Allocated by AllocateNewPool, incremented by Allocate.	*/
-	uint8* CurrentPoolStart;
-	/** End of current pool. Set by AllocateNewPool and checked by Allocate.		*/
-	uint8* CurrentPoolEnd;
+	/** Pool currently being allocated from. Replaced by Allocate when it is exhausted. */
+	FPool* volatile CurrentPool;
 	/** Total number of pages that have been allocated.								*/
-	int32 TotalAllocatedPages;
-	/** Threadsafe counter to test for unwanted concurrency							*/
-	FThreadSafeCounter ThreadGuard;
+	volatile int32 TotalAllocatedPages;
 };
 
 /** Global allocator for name entries. */
@@ -1109,7 +1138,7 @@ FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* H
 	const SIZE_T NameLen  = bIsPureAnsi ? FCStringAnsi::Strlen((ANSICHAR*)Name) : FCString::Strlen((TCHAR*)Name);
 	int32 NameEntrySize	  = FNameEntry::GetSize( NameLen, bIsPureAnsi );
 	FNameEntry* NameEntry = GNameEntryPoolAllocator.Allocate( NameEntrySize );
-	FName::NameEntryMemorySize += NameEntrySize;
+	FPlatformAtomics::InterlockedAdd( &FName::NameEntryMemorySize, NameEntrySize );
 	NameEntry->Index      = (Index << NAME_INDEX_SHIFT) | (bIsPureAnsi ? 0 : 1);
 	NameEntry->HashNext   = HashNext;
 	// Can't rely on the template override for static arrays since the safe crt version of strcpy will fill in
@@ -1117,12 +1146,12 @@ FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* H
 	if( bIsPureAnsi )
 	{
 		FCStringAnsi::Strcpy( const_cast<ANSICHAR*>(NameEntry->GetAnsiName()), NameLen + 1, (ANSICHAR*) Name );
-		FName::NumAnsiNames++;
+		FPlatformAtomics::InterlockedIncrement( &FName::NumAnsiNames );
 	}
 	else
 	{
 		FCStringWide::Strcpy( const_cast<WIDECHAR*>(NameEntry->GetWideName()), NameLen + 1, (WIDECHAR*) Name );
-		FName::NumWideNames++;
+		FPlatformAtomics::InterlockedIncrement( &FName::NumWideNames );
 	}
 	return NameEntry;
 }
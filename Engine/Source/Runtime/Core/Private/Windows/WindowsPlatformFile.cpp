@@ -496,6 +496,76 @@ public:
 	}
 };
 
+/**
+ * Windows mapped file region. Views have to start on an allocation granularity boundary, so the view can start before the
+ * first byte that was asked for.
+**/
+class CORE_API FMappedFileRegionWindows : public IMappedFileRegion
+{
+	const uint8* ViewPtr;
+
+public:
+	FMappedFileRegionWindows(const uint8* InMappedPtr, int64 InMappedSize, const uint8* InViewPtr)
+		: IMappedFileRegion(InMappedPtr, InMappedSize)
+		, ViewPtr(InViewPtr)
+	{
+	}
+	virtual ~FMappedFileRegionWindows()
+	{
+		// The view keeps the file mapping open on its own, so this is fine after the handle has been closed.
+		UnmapViewOfFile(ViewPtr);
+	}
+};
+
+/**
+ * Windows mapped file handle implementation
+**/
+class CORE_API FMappedFileHandleWindows : public IMappedFileHandle
+{
+	HANDLE FileHandle;
+	HANDLE MappingHandle;
+
+public:
+	FMappedFileHandleWindows(HANDLE InFileHandle, HANDLE InMappingHandle, int64 InFileSize)
+		: IMappedFileHandle(InFileSize)
+		, FileHandle(InFileHandle)
+		, MappingHandle(InMappingHandle)
+	{
+	}
+	virtual ~FMappedFileHandleWindows()
+	{
+		CloseHandle(MappingHandle);
+		CloseHandle(FileHandle);
+	}
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) override
+	{
+		check(Offset >= 0 && Offset <= GetFileSize());
+		BytesToMap = FMath::Min<int64>(BytesToMap, GetFileSize() - Offset);
+		if (BytesToMap <= 0)
+		{
+			// MapViewOfFile would map all of the file for a size of zero.
+			return nullptr;
+		}
+
+		SYSTEM_INFO SystemInfo;
+		GetSystemInfo(&SystemInfo);
+		const int64 ViewOffset = Offset - Offset % SystemInfo.dwAllocationGranularity;
+		const int64 ViewSize = Offset - ViewOffset + BytesToMap;
+		if (int64(SIZE_T(ViewSize)) != ViewSize)
+		{
+			// Doesn't fit in the address space of a 32 bit process.
+			return nullptr;
+		}
+
+		const uint8* ViewPtr = (const uint8*)MapViewOfFile(MappingHandle, FILE_MAP_READ, uint32(ViewOffset >> 32), uint32(ViewOffset), SIZE_T(ViewSize));
+		if (ViewPtr == NULL)
+		{
+			return nullptr;
+		}
+		return new FMappedFileRegionWindows(ViewPtr + (Offset - ViewOffset), BytesToMap, ViewPtr);
+	}
+};
+
 /**
  * Windows File I/O implementation
 **/
@@ -672,6 +742,27 @@ public:
 		}
 		return NULL;
 	}
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override
+	{
+		HANDLE Handle = CreateFileW(*NormalizeFilename(Filename), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (Handle == INVALID_HANDLE_VALUE)
+		{
+			return NULL;
+		}
+		// Empty files can't be mapped.
+		LARGE_INTEGER FileSize;
+		HANDLE MappingHandle = NULL;
+		if (GetFileSizeEx(Handle, &FileSize) && FileSize.QuadPart > 0)
+		{
+			MappingHandle = CreateFileMappingW(Handle, NULL, PAGE_READONLY, 0, 0, NULL);
+		}
+		if (MappingHandle == NULL)
+		{
+			CloseHandle(Handle);
+			return NULL;
+		}
+		return new FMappedFileHandleWindows(Handle, MappingHandle, FileSize.QuadPart);
+	}
 
 	virtual bool DirectoryExists(const TCHAR* Directory) override
 	{
@@ -68,6 +68,9 @@ uint32 FRunnableThreadWin::Run()
 		// Setup TLS for this thread, used by FTlsAutoCleanup objects.
 		SetTls();
 
+		// Let the allocator cache free blocks for this thread
+		FMemory::SetupTLSCachesOnCurrentThread();
+
 		// Now run the task that needs to be done
 		ExitCode = Runnable->Run();
 		// Allow any allocated resources to be cleaned up
@@ -77,6 +80,9 @@ uint32 FRunnableThreadWin::Run()
 		FThreadStats::Shutdown();
 #endif
 		FreeTls();
+
+		// Give the cached blocks back before the thread goes away
+		FMemory::ClearAndDisableTLSCachesOnCurrentThread();
 	}
 	else
 	{
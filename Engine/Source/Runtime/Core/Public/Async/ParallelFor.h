@@ -144,6 +144,125 @@ inline bool FParallelForData::Process(int32 TasksToSpawn, TSharedRef<FParallelFo
 	return false;
 }
 
+// struct to hold the working data of a ParallelFor with a minimum batch size; like FParallelForData this outlives the ParallelFor call
+struct FParallelForGuidedData
+{
+	int32 Num;
+	int32 MinBatchSize;
+	int32 NumThreads;
+	TFunctionRef<void(int32)> Body;
+	FEvent* Event;
+	volatile int32 NextIndex;
+	volatile int32 NumCompleted;
+	bool bExited;
+	bool bTriggered;
+	FParallelForGuidedData(int32 InTotalNum, int32 InMinBatchSize, int32 InNumThreads, TFunctionRef<void(int32)> InBody)
+		: Num(InTotalNum)
+		, MinBatchSize(InMinBatchSize)
+		, NumThreads(InNumThreads)
+		, Body(InBody)
+		, Event(FPlatformProcess::GetSynchEventFromPool(false))
+		, NextIndex(0)
+		, NumCompleted(0)
+		, bExited(false)
+		, bTriggered(false)
+	{
+		check(Num > 0 && MinBatchSize > 0 && NumThreads > 0);
+	}
+	~FParallelForGuidedData()
+	{
+		check(NextIndex >= Num);
+		check(NumCompleted == Num);
+		check(bExited);
+		FPlatformProcess::ReturnSynchEventToPool(Event);
+	}
+	/** 
+	 *	Claims the next batch of indices. Batches start large and shrink as the work runs out (guided scheduling), so there are few
+	 *	claims while there is plenty left and threads that finish early can still even out the tail. No batch is smaller than MinBatchSize,
+	 *	except for whatever is left at the very end.
+	 *	@param OutStart; first index of the batch
+	 *	@return number of indices in the batch, 0 if there is no work left to claim
+	**/
+	int32 ClaimBatch(int32& OutStart)
+	{
+		int32 Start = NextIndex;
+		while (Start < Num)
+		{
+			const int32 Remaining = Num - Start;
+			const int32 BatchSize = FMath::Min<int32>(Remaining, FMath::Max<int32>(MinBatchSize, Remaining / (NumThreads * 2)));
+			const int32 PreviousStart = FPlatformAtomics::InterlockedCompareExchange(&NextIndex, Start + BatchSize, Start);
+			if (PreviousStart == Start)
+			{
+				OutStart = Start;
+				return BatchSize;
+			}
+			Start = PreviousStart;
+		}
+		return 0;
+	}
+	bool Process(int32 TasksToSpawn, TSharedRef<FParallelForGuidedData, ESPMode::ThreadSafe>& Data);
+};
+
+class FParallelForGuidedTask
+{
+	TSharedRef<FParallelForGuidedData, ESPMode::ThreadSafe> Data;
+	int32 TasksToSpawn;
+public:
+	FParallelForGuidedTask(TSharedRef<FParallelForGuidedData, ESPMode::ThreadSafe>& InData, int32 InTasksToSpawn = 0)
+		: Data(InData) 
+		, TasksToSpawn(InTasksToSpawn)
+	{
+	}
+	static FORCEINLINE TStatId GetStatId()
+	{
+		return GET_STATID(STAT_ParallelForTask);
+	}
+	static FORCEINLINE ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::HiPri(ENamedThreads::AnyThread);
+	}
+	static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode() 
+	{ 
+		return ESubsequentsMode::FireAndForget; 
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		if (Data->Process(TasksToSpawn, Data))
+		{
+			checkSlow(!Data->bTriggered);
+			Data->bTriggered = true;
+			Data->Event->Trigger();
+		}
+	}
+};
+
+inline bool FParallelForGuidedData::Process(int32 TasksToSpawn, TSharedRef<FParallelForGuidedData, ESPMode::ThreadSafe>& Data)
+{
+	if (TasksToSpawn && NextIndex < Num)
+	{
+		TGraphTask<FParallelForGuidedTask>::CreateTask().ConstructAndDispatchWhenReady(Data, TasksToSpawn - 1);
+	}
+	TFunctionRef<void(int32)> LocalBody(Body);
+	int32 Start = 0;
+	int32 BatchSize;
+	while ((BatchSize = ClaimBatch(Start)) > 0)
+	{
+		for (int32 Index = Start; Index < Start + BatchSize; Index++)
+		{
+			LocalBody(Index);
+		}
+		checkSlow(!bExited);
+		// InterlockedAdd returns the old value
+		const int32 LocalNumCompleted = FPlatformAtomics::InterlockedAdd(&NumCompleted, BatchSize) + BatchSize;
+		if (LocalNumCompleted == Num)
+		{
+			return true;
+		}
+		checkSlow(LocalNumCompleted < Num);
+	}
+	return false;
+}
+
 /** 
 	*	General purpose parallel for that uses the taskgraph
 	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
@@ -238,3 +357,51 @@ inline void ParallelForWithPreWork(int32 Num, TFunctionRef<void(int32)> Body, TF
 	// Data must live on until all of the tasks are cleared which might be long after this function exits
 }
 
+/** 
+	*	General purpose parallel for that uses the taskgraph, for bodies that are too cheap to be worth a task each
+	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+	*	@param MinBatchSize; smallest number of consecutive calls of Body a thread takes at once, no more threads are used than there are batches
+	*	@param Body; Function to call from multiple threads
+	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
+	*	Notes: Threads claim batches as they go, starting with large batches and shrinking them towards the end, so uneven per index cost
+	*	evens out. The calling thread keeps claiming batches until none are left and then only waits for batches other threads are already
+	*	running, so this can be nested inside another ParallelFor or called from a task.
+	*	Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+inline void ParallelFor(int32 Num, int32 MinBatchSize, TFunctionRef<void(int32)> Body, bool bForceSingleThread = false)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+	check(Num >= 0 && MinBatchSize > 0);
+
+	int32 AnyThreadTasks = 0;
+	const int32 NumBatches = Num / MinBatchSize + (Num % MinBatchSize ? 1 : 0);
+	if (NumBatches > 1 && !bForceSingleThread && FApp::ShouldUseThreadingForPerformance())
+	{
+		AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), NumBatches - 1);
+	}
+	if (!AnyThreadTasks)
+	{
+		// no threads, just do it and return
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Body(Index);
+		}
+		return;
+	}
+	FParallelForGuidedData* DataPtr = new FParallelForGuidedData(Num, MinBatchSize, AnyThreadTasks + 1, Body);
+	TSharedRef<FParallelForGuidedData, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
+	TGraphTask<FParallelForGuidedTask>::CreateTask().ConstructAndDispatchWhenReady(Data, AnyThreadTasks - 1);
+	// this thread helps until there is nothing left to claim, which is what makes nesting safe
+	if (!Data->Process(0, Data))
+	{
+		Data->Event->Wait();
+		check(Data->bTriggered);
+	}
+	else
+	{
+		check(!Data->bTriggered);
+	}
+	check(Data->NumCompleted == Data->Num);
+	Data->bExited = true;
+	// Data must live on until all of the tasks are cleared which might be long after this function exits
+}
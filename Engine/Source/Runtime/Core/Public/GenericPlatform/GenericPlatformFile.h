@@ -63,6 +63,76 @@ public:
 };
 
 
+/**
+ * Read only view of part of a file that is mapped into memory.
+ * The view stays valid until the region is deleted, even once the handle that mapped it has been deleted.
+**/
+class CORE_API IMappedFileRegion
+{
+public:
+	IMappedFileRegion(const uint8* InMappedPtr, int64 InMappedSize)
+		: MappedPtr(InMappedPtr)
+		, MappedSize(InMappedSize)
+	{
+	}
+
+	/** Destructor, also the only way to unmap the region **/
+	virtual ~IMappedFileRegion()
+	{
+	}
+
+	/** Return the first mapped byte, which is the byte at the offset that was asked for. **/
+	FORCEINLINE const uint8* GetMappedPtr() const
+	{
+		return MappedPtr;
+	}
+
+	/** Return the number of bytes mapped. **/
+	FORCEINLINE int64 GetMappedSize() const
+	{
+		return MappedSize;
+	}
+
+private:
+	const uint8* MappedPtr;
+	int64 MappedSize;
+};
+
+/**
+ * Handle to a file opened for memory mapping.
+**/
+class CORE_API IMappedFileHandle
+{
+public:
+	IMappedFileHandle(int64 InFileSize)
+		: FileSize(InFileSize)
+	{
+	}
+
+	/** Destructor, also the only way to close the file handle **/
+	virtual ~IMappedFileHandle()
+	{
+	}
+
+	/** Return the total size of the file **/
+	FORCEINLINE int64 GetFileSize() const
+	{
+		return FileSize;
+	}
+
+	/**
+	 * Map part of the file into memory, read only.
+	 * @param Offset		Offset of the first byte to map, doesn't need to be aligned to anything.
+	 * @param BytesToMap	Number of bytes to map, clamped to the end of the file.
+	 * @return				If successful will return a non-nullptr pointer. Unmap the region by delete'ing it.
+	**/
+	virtual IMappedFileRegion* MapRegion(int64 Offset = 0, int64 BytesToMap = MAX_int64) = 0;
+
+private:
+	int64 FileSize;
+};
+
+
 /**
  * Contains the information that's returned from stat'ing a file or directory 
  */
@@ -213,6 +283,16 @@ public:
 	virtual IFileHandle*	OpenRead(const TCHAR* Filename, bool bAllowWrite = false) = 0;
 	/** Attempt to open a file for writing. If successful will return a non-nullptr pointer. Close the file by delete'ing the handle. **/
 	virtual IFileHandle*	OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) = 0;
+	/**
+	 * Attempt to open a file for memory mapping, read only. Platform files that can't map the file return nullptr, in
+	 * which case it has to be read with OpenRead instead.
+	 *
+	 * @return If successful will return a non-nullptr pointer. Close the file by delete'ing the handle.
+	 */
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename)
+	{
+		return nullptr;
+	}
 
 	/** Return true if the directory exists. **/
 	virtual bool		DirectoryExists(const TCHAR* Directory) = 0;
@@ -140,5 +140,13 @@ struct CORE_API FIOSystem
 	 * @return Minimum read size
 	 */
 	virtual int64 MinimumReadSize() = 0;
+
+	/**
+	 * Sets an event to trigger whenever a request finishes or is canceled, after its counter has been decremented. This
+	 * lets a thread waiting on the counters of many requests sleep until one of them changes instead of polling them all.
+	 *
+	 * @param Event		Event to trigger, nullptr for none
+	 */
+	virtual void SetRequestCompletedEvent(FEvent* Event) = 0;
 };
 
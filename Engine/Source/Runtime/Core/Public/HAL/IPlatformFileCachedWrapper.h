@@ -317,6 +317,10 @@ public:
 		}
 		return new FCachedFileHandle(InnerHandle, bAllowRead, true);
 	}
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenMapped(Filename);
+	}
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
 		return LowerLevel->DirectoryExists(Directory);
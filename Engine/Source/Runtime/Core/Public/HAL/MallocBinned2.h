@@ -11,6 +11,15 @@
 	#define BINNED2_MAX_CACHED_OS_FREES_BYTE_LIMIT (16*1024*1024)
 #endif
 
+/** Most free blocks a per-thread bundle holds, for the small block sizes */
+#define BINNED2_BUNDLE_MAX_COUNT (64)
+/** Most bytes of free blocks a per-thread bundle holds, for the large block sizes */
+#define BINNED2_BUNDLE_MAX_SIZE (8192)
+/** Full bundles of each block size that can wait in the global recycler for another thread to pick them up */
+#define BINNED2_MAX_GLOBAL_BUNDLES (8)
+/** Extra blocks taken from a pool for the thread's cache when it has to lock the allocator anyway */
+#define BINNED2_ALLOC_EXTRA (32)
+
 #if STATS
 #	if PLATFORM_64BITS
 #		define BINNED2_STAT volatile int64
@@ -21,6 +30,8 @@
 
 //
 // Optimized virtual memory allocator.
+// Internally thread safe. Threads that set up TLS caches keep bundles of free small blocks and share full bundles through
+// a lock free recycler, so most of their allocations and frees don't take the allocator lock.
 //
 class FMallocBinned2 : public FMalloc
 {
@@ -40,6 +51,11 @@ private:
 	struct FPoolTable;
 	struct FPoolInfo;
 	struct PoolHashBucket;
+	struct FBundleNode;
+	struct FBundle;
+	struct FFreeBlockList;
+	struct FPerThreadFreeBlockLists;
+	struct FGlobalRecycler;
 
 	/** Pool table. */
 	struct FPoolTable
@@ -47,6 +63,8 @@ private:
 		FPoolInfo*			FirstPool;
 		FPoolInfo*			ExhaustedPool;
 		uint32				BlockSize;
+		/** Number of free blocks in a full per-thread bundle of this block size */
+		uint32				BundleCapacity;
 #if STATS
 		/** Number of currently active pools */
 		uint32				NumActivePools;
@@ -76,6 +94,7 @@ private:
 			: FirstPool(nullptr)
 			, ExhaustedPool(nullptr)
 			, BlockSize(0)
+			, BundleCapacity(0)
 #if STATS
 			, NumActivePools(0)
 			, MaxActivePools(0)
@@ -119,6 +138,18 @@ private:
 
 	TCachedOSPageAllocator<BINNED2_MAX_CACHED_OS_FREES, BINNED2_MAX_CACHED_OS_FREES_BYTE_LIMIT> CachedOSPageAllocator;
 
+	/**
+	 * Guards the pool tables, the hash buckets and the OS page cache. Allocations and frees served by the
+	 * calling thread's free block lists or the global recycler don't take it.
+	 */
+	FCriticalSection Mutex;
+
+	/** TLS slot holding the calling thread's FPerThreadFreeBlockLists, null for threads without caches */
+	uint32 FreeBlockListsTlsSlot;
+
+	/** Full bundles of free blocks handed between threads without locking */
+	FGlobalRecycler* Recycler;
+
 #if STATS
 	struct FStats
 	{
@@ -170,6 +201,12 @@ public:
 	 */
 	virtual bool IsInternallyThreadSafe() const override;
 
+	/** Creates the calling thread's free block lists, so its small allocations and frees stop taking the allocator lock */
+	virtual void SetupTLSCachesOnCurrentThread() override;
+
+	/** Returns the calling thread's cached blocks to the recycler or the pools and deletes its free block lists */
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+
 	/** 
 	 * Malloc
 	 */
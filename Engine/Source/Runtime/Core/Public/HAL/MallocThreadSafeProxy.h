@@ -63,6 +63,18 @@ public:
 		}
 	}
 
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
 	/** Writes allocator stats from the last update into the specified destination. */
 	virtual void GetAllocatorStats( FGenericMemoryStats& out_Stats ) override
 	{
@@ -125,6 +125,19 @@ public:
 		return false; 
 	}
 
+	/**
+	 * Gives the calling thread its own cache of free blocks, if the allocator keeps them.
+	 * A thread that does this must call ClearAndDisableTLSCachesOnCurrentThread() before it exits, or its cached blocks are lost.
+	 */
+	virtual void SetupTLSCachesOnCurrentThread()
+	{
+	}
+
+	/** Returns the calling thread's cached free blocks to the allocator and stops caching on this thread. */
+	virtual void ClearAndDisableTLSCachesOnCurrentThread()
+	{
+	}
+
 	/**
 	 * Validates the allocator's heap
 	 */
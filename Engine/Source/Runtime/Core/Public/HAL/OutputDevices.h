@@ -252,13 +252,16 @@ struct FBufferedLine
 	const FName Category;
 	const double Time;
 	const ELogVerbosity::Type Verbosity;
+	/** Whether the devices that can be used on any thread already got this line when it was logged */
+	const bool bSentToAnyThreadDevices;
 
 	/** Initialization constructor. */
-	FBufferedLine( const TCHAR* InData, const class FName& InCategory, ELogVerbosity::Type InVerbosity, const double InTime = -1 )
+	FBufferedLine( const TCHAR* InData, const class FName& InCategory, ELogVerbosity::Type InVerbosity, const double InTime = -1, bool bInSentToAnyThreadDevices = false )
 		: Data( InData )
 		, Category( InCategory )
 		, Time( InTime )
 		, Verbosity( InVerbosity )
+		, bSentToAnyThreadDevices( bInSentToAnyThreadDevices )
 	{}
 };
 
@@ -286,6 +289,12 @@ private:
 	/** Object used for synchronization via a scoped lock */
 	FCriticalSection	SynchronizationObject;
 
+	/** Calls to devices that can be used on any thread that are in progress outside the lock, by the epoch they started in */
+	volatile int32 NumAnyThreadCalls[2];
+
+	/** Epoch new calls to devices that can be used on any thread are counted in, flipped when devices are removed */
+	int32 AnyThreadCallEpoch;
+
 	/**
 	 * The unsynchronized version of FlushThreadedLogs.
 	 * Assumes that the caller holds a lock on SynchronizationObject.
@@ -293,6 +302,12 @@ private:
 	 */
 	void UnsynchronizedFlushThreadedLogs( bool bUseAllDevices );
 
+	/** Flips AnyThreadCallEpoch and returns the epoch that ended. Assumes that the caller holds a lock on SynchronizationObject. */
+	int32 UnsynchronizedBeginAnyThreadCallEpoch();
+
+	/** Waits for the calls to devices that can be used on any thread started in Epoch to return */
+	void WaitForAnyThreadCalls( int32 Epoch );
+
 public:
 
 	/** Initialization constructor. */
@@ -312,6 +327,7 @@ public:
 
 	/**
 	 * Removes an output device from the chain of redirections.	
+	 * Waits for secondary threads that are still calling it, so it can be deleted once this returns. Must not be called from a device's Serialize.
 	 *
 	 * @param OutputDevice	output device to remove
 	 */
@@ -390,6 +406,11 @@ public:
 
 /**
  * File output device (Note: Only works if ALLOW_LOG_FILE && !NO_LOGGING is true, otherwise Serialize does nothing).
+ *
+ * Lines are converted to UTF-8 on the logging thread and written to the file by a dedicated thread, through a bounded
+ * ring buffer (-LOGBUFFERKB=, 1MB by default). When the buffer is full, lines below Error verbosity are dropped and
+ * counted in the log; errors, fatal errors and everything logged while handling a crash wait for the space instead.
+ * Flush() writes out everything buffered on the calling thread. -FORCELOGFLUSH writes and flushes every line synchronously.
  */
 class CORE_API FOutputDeviceFile : public FOutputDevice
 {
@@ -429,6 +450,12 @@ public:
 
 private:
 	FArchive*	LogAr;
+	/** Writes LogAr from its own thread, nullptr if lines are written synchronously. Lines are queued on it without taking SynchronizationObject. */
+	class FAsyncLogWriter* volatile AsyncWriter;
+	/** Number of threads queuing a line on AsyncWriter, TearDown waits for them before deleting it */
+	volatile int32 NumAsyncWriterUsers;
+	/** Guards opening, closing and flushing the file, and writing to it when there is no AsyncWriter */
+	FCriticalSection SynchronizationObject;
 	TCHAR		Filename[1024];
 	bool		Opened;
 	bool		Dead;
@@ -442,8 +469,6 @@ private:
 
 	void WriteByteOrderMarkToArchive(EByteOrderMark ByteOrderMark);
 
-	void CastAndSerializeData(const TCHAR* Data);
-
 	void WriteDataToArchive(const TCHAR* Data, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time);
 };
 
@@ -140,6 +140,12 @@ struct CORE_API FMemory
 
 	static SIZE_T GetAllocSize( void* Original );
 
+	/** Lets the allocator keep a cache of free blocks for the calling thread, see FMalloc::SetupTLSCachesOnCurrentThread */
+	static void SetupTLSCachesOnCurrentThread();
+
+	/** Returns the calling thread's cached free blocks to the allocator, must be called before a thread with caches exits */
+	static void ClearAndDisableTLSCachesOnCurrentThread();
+
 	/**
 	 * A helper function that will perform a series of random heap allocations to test
 	 * the internal validity of the heap. Note, this function will "leak" memory, but another call
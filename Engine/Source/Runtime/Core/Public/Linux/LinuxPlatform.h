@@ -51,6 +51,11 @@ typedef FLinuxPlatformTypes FPlatformTypes;
 	#define PLATFORM_HAS_BSD_SOCKET_FEATURE_CLOSE_ON_EXEC	1
 #endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,27)
 
+// sendmmsg is available on Linux since 3.0 (recvmmsg since 2.6.33)
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+	#define PLATFORM_HAS_BSD_SOCKET_FEATURE_MMSG	1
+#endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+
 // only enable vectorintrinsics on x86(-64) for now
 #if defined(_M_IX86) || defined(__i386__) || defined(_M_X64) || defined(__x86_64__) || defined (__amd64__) 
 	#define PLATFORM_ENABLE_VECTORINTRINSICS		1
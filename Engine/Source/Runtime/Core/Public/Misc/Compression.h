@@ -15,6 +15,10 @@ enum ECompressionFlags
 	COMPRESS_ZLIB 					= 0x01,
 	/** Compress with GZIP															*/
 	COMPRESS_GZIP					= 0x02,
+	/** Compress with the LZ4 block format, bigger than ZLIB but much faster		*/
+	COMPRESS_LZ4					= 0x04,
+	/** Compress with the codec a plugin registered with FCompression::RegisterFormat	*/
+	COMPRESS_Custom					= 0x08,
 	/** Prefer compression that compresses smaller (ONLY VALID FOR COMPRESSION)		*/
 	COMPRESS_BiasMemory 			= 0x10,
 	/** Prefer compression that compresses faster (ONLY VALID FOR COMPRESSION)		*/
@@ -41,6 +45,32 @@ enum ECompressionFlags
 #define LOADING_COMPRESSION_CHUNK_SIZE			131072
 #define SAVING_COMPRESSION_CHUNK_SIZE			LOADING_COMPRESSION_CHUNK_SIZE
 
+/**
+ * A codec FCompression compresses and uncompresses memory with, registered for one of the compression types with
+ * FCompression::RegisterFormat. It can be called from any thread at once.
+ */
+class ICompressionFormat
+{
+public:
+	virtual ~ICompressionFormat() {}
+
+	/** @return the name of the codec, for logs and benchmarks */
+	virtual const TCHAR* GetName() const = 0;
+
+	/**
+	 * @param	Flags						Compression flags, including the options like COMPRESS_BiasSpeed
+	 * @param	UncompressedSize			Size of uncompressed data in bytes
+	 * @return The maximum possible bytes needed for compression of data buffer of size UncompressedSize
+	 */
+	virtual int32 GetCompressedBufferSize( ECompressionFlags Flags, int32 UncompressedSize ) const = 0;
+
+	/** Same as FCompression::CompressMemory, Flags include the options like COMPRESS_BiasSpeed. */
+	virtual bool Compress( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const = 0;
+
+	/** Same as FCompression::UncompressMemory, fails if the data doesn't uncompress to exactly UncompressedSize bytes. */
+	virtual bool Uncompress( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const = 0;
+};
+
 struct FCompression
 {
 	/** Maximum allowed size of an uncompressed buffer passed to CompressMemory or UncompressMemory. */
@@ -88,6 +118,22 @@ struct FCompression
 	 * @return true if compression succeeds, false if it fails because CompressedBuffer was too small or other reasons
 	 */
 	CORE_API static bool UncompressMemory( ECompressionFlags Flags, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize, bool bIsSourcePadded = false );
+
+	/**
+	 * Registers the codec used for a compression type, replacing the one registered before. ZLIB, GZIP and LZ4 are built in,
+	 * COMPRESS_Custom is meant for a plugin to register a codec with, e.g. one that compresses smaller than ZLIB for downloads.
+	 * Register before anything uses the type and unregister after the last use, the codecs are looked up without a lock.
+	 *
+	 * @param	Type						One of the compression types, without options
+	 * @param	Format						Codec to use for the type, nullptr to unregister it. Not owned.
+	 */
+	CORE_API static void RegisterFormat( ECompressionFlags Type, ICompressionFormat* Format );
+
+	/**
+	 * @param	Flags						Compression flags, the options are ignored
+	 * @return the codec used for the compression type in Flags, nullptr if none is registered for it
+	 */
+	CORE_API static ICompressionFormat* GetFormat( ECompressionFlags Flags );
 };
 
 
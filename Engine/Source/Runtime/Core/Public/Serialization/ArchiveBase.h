@@ -864,6 +864,28 @@ public:
 		ArIsFilterEditorOnly = InFilterEditorOnly;
 	}
 
+	/**
+	 * Indicates whether tagged properties are serialized without tags, as a bitmask of the values that are present
+	 * followed by the raw values. Only cooked packages are saved like this, as loading them relies on the properties
+	 * being laid out exactly as they were when the package was saved.
+	 *
+	 * @return true if the archive serializes unversioned properties, false otherwise.
+	 */
+	FORCEINLINE bool UseUnversionedPropertySerialization() const
+	{
+		return ArUseUnversionedPropertySerialization;
+	}
+
+	/**
+	 * Sets whether tagged properties are serialized without tags.
+	 *
+	 * @param InUseUnversioned Whether to serialize unversioned properties.
+	 */
+	void SetUseUnversionedPropertySerialization(bool InUseUnversioned)
+	{
+		ArUseUnversionedPropertySerialization = InUseUnversioned;
+	}
+
 	/**
 	 * Indicates whether this archive is saving or loading game state
 	 *
@@ -1070,6 +1092,9 @@ public:
 	/** Whether this archive is saving/loading game state */
 	bool ArIsSaveGame;
 
+	/** Whether tagged properties are serialized without tags, see UseUnversionedPropertySerialization(). */
+	bool ArUseUnversionedPropertySerialization;
+
 	/** Whether we are currently serializing defaults. > 0 means yes, <= 0 means no. */
 	int32 ArSerializingDefaults;
 
@@ -92,6 +92,16 @@ public:
 		return UsedMalloc->IsInternallyThreadSafe(); 
 	}
 
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
 	virtual void UpdateStats() override;
 
 	virtual void GetAllocatorStats( FGenericMemoryStats& out_Stats ) override
@@ -79,6 +79,11 @@ namespace FNameDefs
 	// use of FNames to store asset path and content tags
 	static const uint32 NameHashBucketCount = 65536;
 #endif
+
+	// Names are added under one of these locks, picked by hash bucket, so threads adding different names rarely wait on each other.
+	// Lookups of names that already exist never take a lock.
+	static const uint32 NameHashShardCount = 64;
+	static_assert((NameHashShardCount & (NameHashShardCount - 1)) == 0 && NameHashShardCount <= NameHashBucketCount, "NameHashShardCount must be a power of two no larger than NameHashBucketCount");
 }
 
 
@@ -274,31 +279,31 @@ class TStaticIndirectArrayThreadSafeRead
 
 	/**
 	 * Expands the array so that Element[Index] is allocated. New pointers are all zero.
+	 * Thread safe, several threads may be expanding at once.
 	 * @param Index The Index of an element we want to be sure is allocated
 	 **/
 	void ExpandChunksToIndex(int32 Index)
 	{
 		check(Index >= 0 && Index < MaxTotalElements);
 		int32 ChunkIndex = Index / ElementsPerChunk;
-		while (1)
+		int32 CurrentNumChunks = NumChunks;
+		while (ChunkIndex >= CurrentNumChunks)
 		{
-			if (ChunkIndex < NumChunks)
+			// add the next chunk, unless another thread already has
+			ElementType*** Chunk = &Chunks[CurrentNumChunks];
+			if (!*Chunk)
 			{
-				break;
-			}
-			// add a chunk, and make sure nobody else tries
-			ElementType*** Chunk = &Chunks[ChunkIndex];
-			ElementType** NewChunk = (ElementType**)FMemory::Malloc(sizeof(ElementType*) * ElementsPerChunk);
-			FMemory::Memzero(NewChunk, sizeof(ElementType*) * ElementsPerChunk);
-			if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)Chunk, NewChunk, nullptr))
-			{
-				// someone else beat us to the add, we don't support multiple concurrent adds
-				check(0)
-			}
-			else
-			{
-				NumChunks++;
+				ElementType** NewChunk = (ElementType**)FMemory::Malloc(sizeof(ElementType*) * ElementsPerChunk);
+				FMemory::Memzero(NewChunk, sizeof(ElementType*) * ElementsPerChunk);
+				if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)Chunk, NewChunk, nullptr))
+				{
+					// someone else beat us to the add, theirs is as good as ours
+					FMemory::Free(NewChunk);
+				}
 			}
+			// the chunk is in place before NumChunks covers it, whoever gets here first publishes it
+			const int32 PreviousNumChunks = FPlatformAtomics::InterlockedCompareExchange(&NumChunks, CurrentNumChunks + 1, CurrentNumChunks);
+			CurrentNumChunks = PreviousNumChunks == CurrentNumChunks ? CurrentNumChunks + 1 : PreviousNumChunks;
 		}
 		check(ChunkIndex < NumChunks && Chunks[ChunkIndex]); // should have a valid pointer now
 	}
@@ -360,17 +365,24 @@ public:
 	 * Add more elements to the array
 	 * @param	NumToAdd	Number of elements to add
 	 * @return	the number of elements in the container before we did the add. In other words, the add index.
-	 * Not thread safe. This should only be called by one thread, but the other methods can be called while this is going on.
+	 * Thread safe, concurrent adds each get their own range of elements and the other methods can be called while this is going on.
 	**/
 	int32 AddZeroed(int32 NumToAdd)
 	{
 		int32 Result = NumElements;
-		check(NumElements + NumToAdd <= MaxTotalElements);
-		ExpandChunksToIndex(NumElements + NumToAdd - 1);
-		check(Result == NumElements);
-		NumElements += NumToAdd;
-		FPlatformMisc::MemoryBarrier();
-		return Result;
+		while (1)
+		{
+			check(Result + NumToAdd <= MaxTotalElements);
+			ExpandChunksToIndex(Result + NumToAdd - 1);
+			// the interlocked exchange is a full barrier, the new chunks are visible before the new elements are
+			const int32 PreviousNumElements = FPlatformAtomics::InterlockedCompareExchange(&NumElements, Result + NumToAdd, Result);
+			if (PreviousNumElements == Result)
+			{
+				return Result;
+			}
+			// another thread added first, retry after its elements
+			Result = PreviousNumElements;
+		}
 	}
 	/** 
 	 * Return a naked pointer to the fundamental data structure for debug visualizers.
@@ -1036,8 +1048,13 @@ private:
 #endif
 	}
 
-	/** Singleton to retrieve the critical section. */
-	static FCriticalSection* GetCriticalSection();
+	/**
+	 * Singleton to retrieve the critical section that guards adding names to a hash bucket.
+	 * Buckets are striped across FNameDefs::NameHashShardCount locks.
+	 *
+	 * @param HashIndex		Hash bucket the name is going to be added to
+	 */
+	static FCriticalSection* GetCriticalSection(uint32 HashIndex);
 
 };
 
@@ -264,6 +264,16 @@ static FAutoConsoleVariableRef CVarPreloadPackageDependencies(
 	ECVF_Default
 	);
 
+static int32 GParallelExportSerialization = 0;
+static FAutoConsoleVariableRef CVarParallelExportSerialization(
+	TEXT("s.ParallelExportSerialization"),
+	GParallelExportSerialization,
+	TEXT("Enables serializing the exports that allow it (UObject::IsSerializeThreadSafe) on thread pool workers, when loading on the async loading thread.\n") \
+	TEXT("0 - Serialize all exports on the async loading thread [default].\n") \
+	TEXT("1 - Serialize exports that allow it on thread pool workers, in cooked builds.\n"),
+	ECVF_Default
+	);
+
 static FORCEINLINE bool IsTimeLimitExceeded(double InTickStartTime, bool bUseTimeLimit, float InTimeLimit, const TCHAR* InLastTypeOfWorkPerformed = nullptr, UObject* InLastObjectWorkWasPerformedOn = nullptr)
 {
 	bool bTimeLimitExceeded = false;
@@ -323,6 +333,8 @@ struct FAsyncLoadingTickScope
 
 void FAsyncLoadingThread::InitializeAsyncThread()
 {
+	// Packages waiting on IO are only checked again once a read has finished, so have the IO system wake us up then
+	FIOSystem::Get().SetRequestCompletedEvent(WakeUpEvent);
 	AsyncThreadReady.Increment();
 }
 
@@ -350,6 +362,7 @@ void FAsyncLoadingThread::CancelAsyncLoadingInternal()
 		}
 
 		AsyncPackages.Reset();
+		AsyncPackageNameLookup.Reset();
 	}
 
 	{
@@ -399,7 +412,7 @@ void FAsyncLoadingThread::QueuePackage(const FAsyncPackageDesc& Package)
 		QueuedPackagesCounter.Increment();
 		QueuedPackages.Add(new FAsyncPackageDesc(Package));
 	}
-	QueuedRequestsEvent->Trigger();
+	WakeUpEvent->Trigger();
 }
 
 FAsyncPackage* FAsyncLoadingThread::FindExistingPackageAndAddCompletionCallback(FAsyncPackageDesc* PackageRequest, TArray<FAsyncPackage*>& PackageList)
@@ -428,7 +441,13 @@ void FAsyncLoadingThread::UpdateExistingPackagePriorities(FAsyncPackage* InPacka
 
 	if (InNewPriority > InPackage->GetPriority())
 	{
-		AsyncPackages.Remove(InPackage);
+		{
+#if THREADSAFE_UOBJECTS
+			FScopeLock LockAsyncPackages(&AsyncPackagesCritical);
+#endif
+			AsyncPackages.Remove(InPackage);
+			AsyncPackageNameLookup.Remove(InPackage->GetPackageName());
+		}
 		InPackage->SetPriority(InNewPriority);
 
 		// Reduce loading counters ready for InsertPackage to increment them again
@@ -447,11 +466,9 @@ void FAsyncLoadingThread::UpdateExistingPackagePriorities(FAsyncPackage* InPacka
 		{
 			if (!InDependencyTracker.Contains(DependencyName))
 			{
-				int32 PackageIndex = FindPackageByName(AsyncPackages, DependencyName);
-
-				if (PackageIndex >= 0)
+				FAsyncPackage* DependencyPackage = FindAsyncPackage(DependencyName);
+				if (DependencyPackage)
 				{
-					FAsyncPackage* DependencyPackage = AsyncPackages[PackageIndex];
 					UpdateExistingPackagePriorities(DependencyPackage, InNewPriority, InDependencyTracker, InAssetRegistry);
 				}
 			}
@@ -623,6 +640,7 @@ void FAsyncLoadingThread::InsertPackage(FAsyncPackage* Package, EAsyncPackageIns
 
 		AsyncPackages.InsertUninitialized(InsertIndex);
 		AsyncPackages[InsertIndex] = Package;
+		AsyncPackageNameLookup.Add(Package->GetPackageName(), Package);
 	}
 }
 
@@ -637,19 +655,38 @@ EAsyncPackageState::Type FAsyncLoadingThread::ProcessAsyncLoading(int32& OutPack
 	// like e.g. when called from FlushAsyncLoading.
 	for (int32 PackageIndex = 0; LoadingState != EAsyncPackageState::TimeOut && PackageIndex < AsyncPackages.Num(); ++PackageIndex)
 	{
-		OutPackagesProcessed++;
-
 		// Package to be loaded.
 		FAsyncPackage* Package = AsyncPackages[PackageIndex];
 
 		if (Package->HasFinishedLoading() == false)
 		{
+			if (!Package->IsReadyToTick())
+			{
+				// Still waiting for its imports or its IO, it'll be ticked again once they're done
+				LoadingState = EAsyncPackageState::PendingImports;
+				if (!bUseTimeLimit && !FPlatformProcess::SupportsMultithreading())
+				{
+					// Tick async loading when multithreading is disabled.
+					FIOSystem::Get().TickSingleThreaded();
+				}
+				continue;
+			}
+
+			OutPackagesProcessed++;
+
 			// Package tick returns EAsyncPackageState::Complete on completion.
 			// We only tick packages that have not yet been loaded.
 			LoadingState = Package->Tick(bUseTimeLimit, bUseFullTimeLimit, TimeLimit);
+			if (LoadingState == EAsyncPackageState::TimeOut && Package->IsWaitingForIO())
+			{
+				// Out of data rather than out of time, move on to the next package while the read finishes
+				LoadingState = EAsyncPackageState::PendingImports;
+			}
 		}
 		else
 		{
+			OutPackagesProcessed++;
+
 			// This package has finished loading but some other package is still holding
 			// a reference to it because it has this package in its dependency list.
 			LoadingState = EAsyncPackageState::Complete;
@@ -664,6 +701,7 @@ EAsyncPackageState::Type FAsyncLoadingThread::ProcessAsyncLoading(int32& OutPack
 				FScopeLock LockAsyncPackages(&AsyncPackagesCritical);
 #endif
 				AsyncPackages.RemoveAt(PackageIndex);
+				AsyncPackageNameLookup.Remove(Package->GetPackageName());
 			}
 					
 			// Need to process this index again as we just removed an item
@@ -817,7 +855,7 @@ FAsyncLoadingThread::FAsyncLoadingThread()
 #if !UE_BUILD_SHIPPING
 	GAsyncLoadingExec = new FAsyncLoadingExec();
 #endif
-	QueuedRequestsEvent = FPlatformProcess::GetSynchEventFromPool();
+	WakeUpEvent = FPlatformProcess::GetSynchEventFromPool();
 	CancelLoadingEvent = FPlatformProcess::GetSynchEventFromPool();
 	ThreadSuspendedEvent = FPlatformProcess::GetSynchEventFromPool();
 	ThreadResumedEvent = FPlatformProcess::GetSynchEventFromPool();
@@ -839,8 +877,12 @@ FAsyncLoadingThread::~FAsyncLoadingThread()
 {
 	delete Thread;
 	Thread = nullptr;
-	FPlatformProcess::ReturnSynchEventToPool(QueuedRequestsEvent);
-	QueuedRequestsEvent = nullptr;
+	if (!FIOSystem::HasShutdown())
+	{
+		FIOSystem::Get().SetRequestCompletedEvent(nullptr);
+	}
+	FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+	WakeUpEvent = nullptr;
 	FPlatformProcess::ReturnSynchEventToPool(CancelLoadingEvent);
 	CancelLoadingEvent = nullptr;
 	FPlatformProcess::ReturnSynchEventToPool(ThreadSuspendedEvent);
@@ -894,10 +936,13 @@ EAsyncPackageState::Type  FAsyncLoadingThread::TickAsyncThread(bool bUseTimeLimi
 			CreateAsyncPackagesFromQueue();
 			Result = ProcessAsyncLoading(ProcessedRequests, bUseTimeLimit, bUseFullTimeLimit, TimeLimit);
 		}
-		if (ProcessedRequests == 0 && IsMultithreaded())
+		// Sleep if every package is waiting on something, new requests and finished reads wake us up. Flushing on the
+		// game thread without an async loading thread would otherwise spin until the IO system catches up.
+		const bool bFlushingWithoutThread = !bUseTimeLimit && AsyncPackages.Num() > 0 && FPlatformProcess::SupportsMultithreading();
+		if (ProcessedRequests == 0 && (IsMultithreaded() || bFlushingWithoutThread))
 		{
 			const bool bIgnoreThreadIdleStats = true;
-			QueuedRequestsEvent->Wait(30, bIgnoreThreadIdleStats);
+			WakeUpEvent->Wait(30, bIgnoreThreadIdleStats);
 		}
 	}
 	else
@@ -1035,6 +1080,7 @@ FAsyncPackage::FAsyncPackage(const FAsyncPackageDesc& InDesc)
 , LoadImportIndex(0)
 , ImportIndex(0)
 , ExportIndex(0)
+, SerializeExportIndex(0)
 , DeferredPostLoadIndex(0)
 , TimeLimit(FLT_MAX)
 , bUseTimeLimit(false)
@@ -1042,6 +1088,8 @@ FAsyncPackage::FAsyncPackage(const FAsyncPackageDesc& InDesc)
 , bTimeLimitExceeded(false)
 , bLoadHasFailed(false)
 , bLoadHasFinished(false)
+, bWaitingForIO(false)
+, bSerializeExportsInParallel(false)
 , TickStartTime(0)
 , LastObjectWorkWasPerformedOn(nullptr)
 , LastTypeOfWorkPerformed(nullptr)
@@ -1151,6 +1199,21 @@ bool FAsyncPackage::GiveUpTimeSlice()
 	return bTimeLimitExceeded;
 }
 
+bool FAsyncPackage::IsReadyToTick()
+{
+	if (bWaitingForIO)
+	{
+		if (Linker && Linker->IsPrecachePending())
+		{
+			return false;
+		}
+		bWaitingForIO = false;
+	}
+
+	// All imports have been requested and some are still loading. ImportFullyLoadedCallback removes them as they finish.
+	return !Linker || LoadImportIndex < Linker->ImportMap.Num() || PendingImportedPackages.Num() == 0;
+}
+
 /**
  * Begin async loading process. Simulates parts of BeginLoad.
  *
@@ -1214,6 +1277,7 @@ EAsyncPackageState::Type FAsyncPackage::Tick(bool InbUseTimeLimit, bool InbUseFu
 	bUseTimeLimit = InbUseTimeLimit;
 	bUseFullTimeLimit = InbUseFullTimeLimit;
 	bTimeLimitExceeded = false;
+	bWaitingForIO = false;
 	TimeLimit = InOutTimeLimit;
 	TickStartTime = FPlatformTime::Seconds();
 
@@ -1309,9 +1373,9 @@ EAsyncPackageState::Type FAsyncPackage::Tick(bool InbUseTimeLimit, bool InbUseFu
 		{
 			LoadingState = FinishObjects();
 		}
-	} while (!IsTimeLimitExceeded() && LoadingState == EAsyncPackageState::TimeOut);
+	} while (!bWaitingForIO && !IsTimeLimitExceeded() && LoadingState == EAsyncPackageState::TimeOut);
 
-	check(bUseTimeLimit || LoadingState != EAsyncPackageState::TimeOut || AsyncLoadingThread.IsAsyncLoadingSuspended());
+	check(bUseTimeLimit || LoadingState != EAsyncPackageState::TimeOut || bWaitingForIO || AsyncLoadingThread.IsAsyncLoadingSuspended());
 
 	// We can't have a reference to a UObject.
 	LastObjectWorkWasPerformedOn = nullptr;
@@ -1419,8 +1483,11 @@ EAsyncPackageState::Type FAsyncPackage::FinishLinker()
 	
 		const float RemainingTimeLimit = TimeLimit - (float)(FPlatformTime::Seconds() - TickStartTime);
 
-		// Operation still pending if Tick returns false
-		FLinkerLoad::ELinkerStatus LinkerResult = Linker->Tick(RemainingTimeLimit, bUseTimeLimit, bUseFullTimeLimit);
+		// Operation still pending if Tick returns false. Without a time limit the linker would spin until its reads
+		// finish, so give it an unreachable one instead to have it return and let other packages load meanwhile.
+		FLinkerLoad::ELinkerStatus LinkerResult = bUseTimeLimit ?
+			Linker->Tick(RemainingTimeLimit, bUseTimeLimit, bUseFullTimeLimit) :
+			Linker->Tick(FLT_MAX, true, false);
 		if (LinkerResult != FLinkerLoad::LINKER_Loaded)
 		{
 			// Give up remainder of timeslice if there is one to give up.
@@ -1432,6 +1499,10 @@ EAsyncPackageState::Type FAsyncPackage::FinishLinker()
 				// The error will be handled as bLoadHasFailed will be true.
 				bLoadHasFailed = true;
 			}
+			else
+			{
+				bWaitingForIO = Linker->IsPrecachePending();
+			}
 		}
 	}
 
@@ -1463,11 +1534,10 @@ FORCEINLINE int32 ContainsDependencyPackage(TArray<FAsyncPackage*>& Dependencies
 	*
 	* @param PendingImport Name of the package imported either directly or by one of the imported packages
 	*/
-void FAsyncPackage::AddImportDependency(int32 CurrentPackageIndex, const FName& PendingImport)
+void FAsyncPackage::AddImportDependency(const FName& PendingImport)
 {
-	FAsyncPackage* PackageToStream = nullptr;
-	int32 ExistingAsyncPackageIndex = FAsyncLoadingThread::Get().FindAsyncPackage(PendingImport);
-	if (ExistingAsyncPackageIndex == INDEX_NONE)
+	FAsyncPackage* PackageToStream = FAsyncLoadingThread::Get().FindAsyncPackage(PendingImport);
+	if (!PackageToStream)
 	{
 		const FAsyncPackageDesc Info(INDEX_NONE, PendingImport);
 		PackageToStream = new FAsyncPackage(Info);
@@ -1479,10 +1549,6 @@ void FAsyncPackage::AddImportDependency(int32 CurrentPackageIndex, const FName&
 		}
 		FAsyncLoadingThread::Get().InsertPackage(PackageToStream);
 	}
-	else
-	{
-		PackageToStream = FAsyncLoadingThread::Get().GetPackage(ExistingAsyncPackageIndex);
-	}
 	
 	if (!PackageToStream->HasFinishedLoading() && 
 		!PackageToStream->bLoadHasFailed)
@@ -1504,14 +1570,14 @@ void FAsyncPackage::AddImportDependency(int32 CurrentPackageIndex, const FName&
  *
  * @param PendingImport Package imported either directly or by one of the imported packages
  */
-bool FAsyncPackage::AddUniqueLinkerDependencyPackage(int32 CurrentPackageIndex, FAsyncPackage& PendingImport)
+bool FAsyncPackage::AddUniqueLinkerDependencyPackage(FAsyncPackage& PendingImport)
 {
 	if (ContainsDependencyPackage(PendingImportedPackages, PendingImport.GetPackageName()) == INDEX_NONE)
 	{
 		FLinkerLoad* PendingImportLinker = PendingImport.Linker;
 		if (PendingImportLinker == nullptr || !PendingImportLinker->HasFinishedInitialization())
 		{
-			AddImportDependency(CurrentPackageIndex, PendingImport.GetPackageName());
+			AddImportDependency(PendingImport.GetPackageName());
 			UE_LOG(LogStreaming, Verbose, TEXT("  Adding linker dependency %s"), *PendingImport.GetPackageName().ToString());
 		}
 		else if (this != &PendingImport)
@@ -1527,7 +1593,7 @@ bool FAsyncPackage::AddUniqueLinkerDependencyPackage(int32 CurrentPackageIndex,
  *
  * @param ImportedPackage Package imported either directly or by one of the imported packages
  */
-void FAsyncPackage::AddDependencyTree(int32 CurrentPackageIndex, FAsyncPackage& ImportedPackage, TSet<FAsyncPackage*>& SearchedPackages)
+void FAsyncPackage::AddDependencyTree(FAsyncPackage& ImportedPackage, TSet<FAsyncPackage*>& SearchedPackages)
 {
 	if (SearchedPackages.Contains(&ImportedPackage))
 	{
@@ -1537,9 +1603,9 @@ void FAsyncPackage::AddDependencyTree(int32 CurrentPackageIndex, FAsyncPackage&
 	for (int32 Index = 0; Index < ImportedPackage.PendingImportedPackages.Num(); ++Index)
 	{
 		FAsyncPackage& PendingImport = *ImportedPackage.PendingImportedPackages[Index];
-		if (!AddUniqueLinkerDependencyPackage(CurrentPackageIndex, PendingImport))
+		if (!AddUniqueLinkerDependencyPackage(PendingImport))
 		{
-			AddDependencyTree(CurrentPackageIndex, PendingImport, SearchedPackages);
+			AddDependencyTree(PendingImport, SearchedPackages);
 		}
 	}
 	// Mark this package as searched
@@ -1557,9 +1623,6 @@ EAsyncPackageState::Type FAsyncPackage::LoadImports()
 	LastObjectWorkWasPerformedOn	= LinkerRoot;
 	LastTypeOfWorkPerformed			= TEXT("loading imports");
 	
-	// Index of this package in the async queue.
-	const int32 AsyncQueueIndex = FAsyncLoadingThread::Get().FindAsyncPackage(GetPackageName());
-
 	// GC can't run in here
 	FGCScopeGuard GCGuard;
 
@@ -1599,15 +1662,15 @@ EAsyncPackageState::Type FAsyncPackage::LoadImports()
 			// we add all dependencies that don't yet have linkers created otherwise we risk that if the current package
 			// doesn't depend on any other packages that have not yet started streaming, creating imports is going
 			// to load packages blocking the main thread.
-			int32 PendingAsyncPackageIndex = FAsyncLoadingThread::Get().FindAsyncPackage(ImportPackageFName);
-			if (PendingAsyncPackageIndex != INDEX_NONE)
+			FAsyncPackage* PendingAsyncPackage = FAsyncLoadingThread::Get().FindAsyncPackage(ImportPackageFName);
+			if (PendingAsyncPackage)
 			{
-				FAsyncPackage& PendingPackage = *FAsyncLoadingThread::Get().GetPackage(PendingAsyncPackageIndex);
+				FAsyncPackage& PendingPackage = *PendingAsyncPackage;
 				FLinkerLoad* PendingPackageLinker = PendingPackage.Linker;
 				if (PendingPackageLinker == nullptr || !PendingPackageLinker->HasFinishedInitialization())
 				{
 					// Add this import to the dependency list.
-					AddUniqueLinkerDependencyPackage(AsyncQueueIndex, PendingPackage);
+					AddUniqueLinkerDependencyPackage(PendingPackage);
 				}
 				else
 				{
@@ -1617,7 +1680,7 @@ EAsyncPackageState::Type FAsyncPackage::LoadImports()
 					ReferencedImports.Add(&PendingPackage);
 					// Check if we need to add its dependencies too.
 					TSet<FAsyncPackage*> SearchedPackages;
-					AddDependencyTree(AsyncQueueIndex, PendingPackage, SearchedPackages);
+					AddDependencyTree(PendingPackage, SearchedPackages);
 				}
 			}
 		}
@@ -1629,7 +1692,7 @@ EAsyncPackageState::Type FAsyncPackage::LoadImports()
 			if (!FPackageName::IsShortPackageName(ImportPackageName))
 			{
 				UE_LOG(LogStreaming, Verbose, TEXT("FAsyncPackage::LoadImports for %s: Loading %s"), *Desc.NameToLoad.ToString(), *ImportPackageName);
-				AddImportDependency(AsyncQueueIndex, ImportPackageFName);
+				AddImportDependency(ImportPackageFName);
 			}
 			else
 			{
@@ -1736,6 +1799,16 @@ EAsyncPackageState::Type FAsyncPackage::CreateExports()
 	// GC can't run in here
 	FGCScopeGuard GCGuard;
 
+	// Decided before the first export is created, and only on the async loading thread which has no time limit
+	if (ExportIndex == 0)
+	{
+		bSerializeExportsInParallel = GParallelExportSerialization && !bUseTimeLimit && IsInAsyncLoadingThread();
+	}
+	if (bSerializeExportsInParallel)
+	{
+		return CreateExportsAndSerializeInParallel();
+	}
+
 	// Create exports.
 	while( ExportIndex < Linker->ExportMap.Num() && !IsTimeLimitExceeded() )
 	{
@@ -1762,7 +1835,13 @@ EAsyncPackageState::Type FAsyncPackage::CreateExports()
 				
 			UpdateLoadPercentage();
 		}
-		// Data isn't ready yet. Give up remainder of time slice if we're not using a time limit.
+		// Data isn't ready yet. Without a time limit sleep until a read finishes rather than spin. Other packages can't
+		// load meanwhile, the objects loaded so far are shared with them until FinishObjects.
+		else if (!bUseTimeLimit)
+		{
+			FAsyncLoadingThread::Get().WaitForIO();
+		}
+		// Otherwise give up the remainder of the time slice.
 		else if (GiveUpTimeSlice())
 		{
 			INC_FLOAT_STAT_BY(STAT_AsyncIO_AsyncPackagePrecacheWaitTime, (float)FApp::GetDeltaTime());
@@ -1776,6 +1855,61 @@ EAsyncPackageState::Type FAsyncPackage::CreateExports()
 	return ExportIndex == Linker->ExportMap.Num() ? EAsyncPackageState::Complete : EAsyncPackageState::TimeOut;
 }
 
+EAsyncPackageState::Type FAsyncPackage::CreateExportsAndSerializeInParallel()
+{
+	// Create all exports first, the way EndLoad does for synchronous loads. Workers only look up the objects an export
+	// references, so those have to exist before any export is handed to one.
+	while (ExportIndex < Linker->ExportMap.Num() && !IsTimeLimitExceeded())
+	{
+		UObject* Object = Linker->CreateExport(ExportIndex++);
+
+		LastObjectWorkWasPerformedOn = Object;
+		LastTypeOfWorkPerformed = TEXT("creating exports for");
+
+		UpdateLoadPercentage();
+	}
+
+	// Serialize them in order, handing those that allow it to workers
+	while (ExportIndex == Linker->ExportMap.Num() && SerializeExportIndex < Linker->ExportMap.Num() && !IsTimeLimitExceeded())
+	{
+		const FObjectExport& Export = Linker->ExportMap[SerializeExportIndex];
+
+		if (!Export.Object)
+		{
+			SerializeExportIndex++;
+		}
+		else if (Linker->Precache(Export.SerialOffset, Export.SerialSize))
+		{
+			UObject* Object = Export.Object;
+			SerializeExportIndex++;
+			if (!Linker->PreloadOnWorkerThread(Object))
+			{
+				Linker->Preload(Object);
+			}
+
+			LastObjectWorkWasPerformedOn = Object;
+			LastTypeOfWorkPerformed = TEXT("serializing exports for");
+		}
+		else
+		{
+			FAsyncLoadingThread::Get().WaitForIO();
+		}
+	}
+
+	// Workers can't outlive the GC guard, or be running while the objects are handed to other packages
+	Linker->WaitForWorkerPreloads();
+
+	if (SerializeExportIndex < Linker->ExportMap.Num())
+	{
+		return EAsyncPackageState::TimeOut;
+	}
+
+	// We no longer need the referenced packages.
+	FreeReferencedImports();
+
+	return EAsyncPackageState::Complete;
+}
+
 /**
  * Removes references to any imported packages.
  */
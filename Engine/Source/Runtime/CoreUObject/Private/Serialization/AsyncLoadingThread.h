@@ -19,8 +19,8 @@ class FAsyncLoadingThread : public FRunnable
 	/** Stops this thread */
 	FThreadSafeCounter StopTaskCounter;
 
-	/** [ASYNC/GAME THREAD] Event used to signal there's queued packages to stream */
-	FEvent* QueuedRequestsEvent;
+	/** [ASYNC/GAME/IO THREAD] Event used to signal there's queued packages to stream or that an IO request finished, which a package waiting on IO may have been waiting for */
+	FEvent* WakeUpEvent;
 	/** [ASYNC/GAME THREAD] Event used to signal loading should be cancelled */
 	FEvent* CancelLoadingEvent;
 	/** [ASYNC/GAME THREAD] Event used to signal that the async loading thread should be suspended */
@@ -54,6 +54,8 @@ class FAsyncLoadingThread : public FRunnable
 
 	/** [ASYNC THREAD] Array of packages that are being preloaded */
 	TArray<FAsyncPackage*> AsyncPackages;
+	/** [ASYNC THREAD] Packages in AsyncPackages by name, so looking up imports doesn't scan the whole queue */
+	TMap<FName, FAsyncPackage*> AsyncPackageNameLookup;
 #if THREADSAFE_UOBJECTS
 	/** We only lock AsyncPackages array to make GetAsyncLoadPercentage thread safe, so we only care about locking Add/Remove operations on the async thread */
 	FCriticalSection AsyncPackagesCritical;
@@ -206,12 +208,13 @@ public:
 	* [ASYNC THREAD] Finds an existing async package in the AsyncPackages by its name.
 	*
 	* @param PackageName async package name.
-	* @return Index of the async package in AsyncPackages array or INDEX_NONE if not found.
+	* @return The async package or nullptr if not found.
 	*/
-	FORCEINLINE int32 FindAsyncPackage(const FName& PackageName)
+	FORCEINLINE FAsyncPackage* FindAsyncPackage(const FName& PackageName)
 	{
 		checkSlow(IsInAsyncLoadThread());
-		return FindPackageByName(AsyncPackages, PackageName);
+		FAsyncPackage** Package = AsyncPackageNameLookup.Find(PackageName);
+		return Package ? *Package : nullptr;
 	}
 
 	/**
@@ -257,20 +260,10 @@ public:
 	void ResumeLoading();
 
 	/**
-	* [ASYNC/GAME THREAD] Queues a package for streaming.
-	*
-	* @param Package package descriptor.
-	*/
-	FORCEINLINE FAsyncPackage* GetPackage(int32 PackageIndex)
-	{
-		checkSlow(IsInAsyncLoadThread());
-		return AsyncPackages[PackageIndex];
-	}
-
-	/**
-	* [ASYNC* THREAD] Loads all packages
+	* [ASYNC* THREAD] Loads all packages that can make progress. Packages waiting for their imports to load or for IO are
+	* skipped until what they're waiting for is done, rather than being ticked again to find out.
 	*
-	* @param OutPackagesProcessed Number of packages processed in this call.
+	* @param OutPackagesProcessed Number of packages ticked in this call.
 	* @param bUseTimeLimit True if time limit should be used [time-slicing].
 	* @param bUseFullTimeLimit True if full time limit should be used [time-slicing].
 	* @param TimeLimit Maximum amount of time that can be spent in this call [time-slicing].
@@ -300,6 +293,19 @@ public:
 	/** Initializes async loading thread */
 	void InitializeAsyncThread();
 
+	/** [ASYNC THREAD] Blocks until an IO request finishes or a package is queued, or ticks the IO system without threads */
+	void WaitForIO()
+	{
+		if (FPlatformProcess::SupportsMultithreading())
+		{
+			WakeUpEvent->Wait(30);
+		}
+		else
+		{
+			FIOSystem::Get().TickSingleThreaded();
+		}
+	}
+
 	/** 
 	 * [GAME THREAD] Gets the load percentage of the specified package
 	 * @param PackageName Name of the package to return async load percentage for
@@ -129,6 +129,7 @@ FUntypedBulkData::~FUntypedBulkData()
 	// Free memory.
 	BulkData     .Deallocate();
 	BulkDataAsync.Deallocate();
+	UnmapPayload();
 	
 #if WITH_EDITOR
 	// Detach from archive.
@@ -335,7 +336,18 @@ ECompressionFlags FUntypedBulkData::GetDecompressionFlags() const
  */
 bool FUntypedBulkData::IsBulkDataLoaded() const
 {
-	return !!BulkData;
+	return !!BulkData || MappedRegion != nullptr;
+}
+
+/**
+ * Returns whether the bulk data is loaded by mapping it straight from the file it is stored in, rather than by
+ * copying it to memory.
+ *
+ * @return true if bulk data is memory mapped, false otherwise
+ */
+bool FUntypedBulkData::IsBulkDataMemoryMapped() const
+{
+	return MappedRegion != nullptr;
 }
 
 bool FUntypedBulkData::IsAsyncLoadingComplete()
@@ -380,15 +392,16 @@ void FUntypedBulkData::GetCopy( void** Dest, bool bDiscardInternalCopy )
 	if( *Dest )
 	{
 		// The data is already loaded so we can simply use a mempcy.
-		if( BulkData )
+		if( IsBulkDataLoaded() )
 		{
 			// Copy data into destination memory.
-			FMemory::Memcpy( *Dest, BulkData.Get(), GetBulkDataSize() );
+			FMemory::Memcpy( *Dest, GetLoadedPayload(), GetBulkDataSize() );
 			// Discard internal copy if wanted and we're still attached to an archive or if we're
 			// single use bulk data.
 			if( bDiscardInternalCopy && (CanLoadFromDisk() || (BulkDataFlags & BULKDATA_SingleUse)) )
 			{
 				BulkData.Deallocate();
+				UnmapPayload();
 			}
 		}
 		// Data isn't currently loaded so we need to load it from disk.
@@ -407,8 +420,20 @@ void FUntypedBulkData::GetCopy( void** Dest, bool bDiscardInternalCopy )
 			BulkData = MoveTemp(BulkDataAsync);
 			ResetAsyncData();
 		}
+		// A mapped payload can't be handed over, so it's copied like one that can't be discarded.
+		if( MappedRegion )
+		{
+			int32 BulkDataSize = GetBulkDataSize();
+			*Dest = FMemory::Malloc( BulkDataSize, BulkDataAlignment );
+			FMemory::Memcpy( *Dest, MappedRegion->GetMappedPtr(), BulkDataSize );
+
+			if( bDiscardInternalCopy && (CanLoadFromDisk() || (BulkDataFlags & BULKDATA_SingleUse)) )
+			{
+				UnmapPayload();
+			}
+		}
 		// The data is already loaded so we can simply use a mempcy.
-		if( BulkData )
+		else if( BulkData )
 		{
 			// If the internal copy should be discarded and we are still attached to an archive we can
 			// simply "return" the already existing copy and NULL out the internal reference. We can
@@ -473,6 +498,10 @@ void* FUntypedBulkData::Lock( uint32 LockFlags )
 	{
 		LockStatus = LOCKSTATUS_ReadWriteLock;
 
+		// Mapped files are read only, and the changes won't be in the file.
+		CopyMappedPayloadToMemory();
+		bCanMapPayload = false;
+
 #if WITH_EDITOR
 		// We need to detach from the archive to not be able to clobber changes by serializing
 		// over them.
@@ -494,7 +523,7 @@ void* FUntypedBulkData::Lock( uint32 LockFlags )
 		UE_LOG(LogSerialization, Fatal,TEXT("Unknown lock flag %i"),LockFlags);
 	}
 
-	return BulkData.Get();
+	return GetLoadedPayload();
 }
 
 const void* FUntypedBulkData::LockReadOnly() const
@@ -509,8 +538,8 @@ const void* FUntypedBulkData::LockReadOnly() const
 	// Only read operations are allowed on returned memory.
 	mutable_this->LockStatus = LOCKSTATUS_ReadOnlyLock;
 
-	check(BulkData);
-	return BulkData.Get();
+	check(IsBulkDataLoaded());
+	return GetLoadedPayload();
 }
 
 /**
@@ -546,6 +575,7 @@ void FUntypedBulkData::Unlock() const
 	if (BulkDataFlags & BULKDATA_SingleUse)
 	{
 		mutable_this->BulkData.Deallocate();
+		mutable_this->UnmapPayload();
 	}
 }
 
@@ -570,6 +600,7 @@ void FUntypedBulkData::RemoveBulkData()
 	// Resize to 0 elements.
 	ElementCount	= 0;
 	BulkData.Deallocate();
+	UnmapPayload();
 }
 
 /**
@@ -580,6 +611,9 @@ void FUntypedBulkData::ForceBulkDataResident()
 	// Make sure bulk data is loaded.
 	MakeSureBulkDataIsLoaded();
 
+	// A mapped payload is only as resident as the file it is mapped from.
+	CopyMappedPayloadToMemory();
+
 #if WITH_EDITOR
 	// Detach from the archive 
 	if( AttachedAr )
@@ -692,6 +726,68 @@ bool FUntypedBulkData::ShouldStreamBulkData()
 		GMinimumBulkDataSizeForAsyncLoading >= 0);
 }
 
+int32 GMemoryMapBulkData = 0;
+static FAutoConsoleVariableRef CVarMemoryMapBulkData(
+	TEXT("s.MemoryMapBulkData"),
+	GMemoryMapBulkData,
+	TEXT("If set, uncompressed bulk data in cooked packages is mapped read only straight from the package or pak file it is stored in, rather than copied to memory."),
+	ECVF_Default
+	);
+
+bool FUntypedBulkData::TryMapPayload()
+{
+	check(!MappedRegion);
+
+	// Nothing to map if the payload has already been loaded into memory.
+	if (BulkData || !GMemoryMapBulkData || !bCanMapPayload || Filename.IsEmpty() || GetBulkDataSize() == 0)
+	{
+		return false;
+	}
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FUntypedBulkData::TryMapPayload"), STAT_UBD_TryMapPayload, STATGROUP_Memory);
+
+	IMappedFileHandle* MappedFile = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename);
+	if (MappedFile)
+	{
+		if (BulkDataOffsetInFile >= 0 && BulkDataOffsetInFile + GetBulkDataSize() <= MappedFile->GetFileSize())
+		{
+			MappedRegion = MappedFile->MapRegion(BulkDataOffsetInFile, GetBulkDataSize());
+		}
+		// The region stays mapped after the file is closed.
+		delete MappedFile;
+	}
+
+	// Payloads that aren't aligned in the file as the data needs to be in memory are loaded instead. The default alignment
+	// is zero, which doesn't ask for any.
+	if (MappedRegion && BulkDataAlignment != DEFAULT_ALIGNMENT && !IsAligned(MappedRegion->GetMappedPtr(), BulkDataAlignment))
+	{
+		UnmapPayload();
+	}
+	return MappedRegion != nullptr;
+}
+
+void FUntypedBulkData::UnmapPayload()
+{
+	delete MappedRegion;
+	MappedRegion = nullptr;
+}
+
+void FUntypedBulkData::CopyMappedPayloadToMemory()
+{
+	if (MappedRegion)
+	{
+		BulkData.Reallocate(GetBulkDataSize(), BulkDataAlignment);
+		FMemory::Memcpy(BulkData.Get(), MappedRegion->GetMappedPtr(), GetBulkDataSize());
+		UnmapPayload();
+	}
+}
+
+void* FUntypedBulkData::GetLoadedPayload() const
+{
+	// Mapped payloads can only be changed through a read-write lock, which copies them to memory first.
+	return MappedRegion ? const_cast<uint8*>(MappedRegion->GetMappedPtr()) : BulkData.Get();
+}
+
 /**
 * Serialize function used to serialize this bulk data structure.
 *
@@ -724,6 +820,7 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 				Ar << ElementCount;
 
 				// Allocate bulk data.
+				UnmapPayload();
 				BulkData.Reallocate( GetBulkDataSize(), BulkDataAlignment );
 
 				// Deserialize bulk data.
@@ -745,7 +842,7 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 					MakeSureBulkDataIsLoaded();
 
 					// Serialize bulk data.
-					SerializeBulkData(Ar, BulkData.Get());
+					SerializeBulkData(Ar, GetLoadedPayload());
 				}
 			}
 		}
@@ -770,6 +867,7 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 		if( Ar.IsLoading() )
 		{
 			Filename = TEXT("");
+			UnmapPayload();
 			
 			// @todo when Landscape (and others?) only Lock/Unlock once, we can enable this
 			if (false) // FPlatformProperties::RequiresCookedData())
@@ -794,6 +892,13 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 				BulkDataOffsetInFile += Owner->GetLinker()->Summary.BulkDataStartOffset;
 			}
 
+			// Uncompressed payloads that are read in bulk are stored in cooked packages exactly as they are laid out in
+			// memory, at a file offset that doesn't depend on the archive.
+			FLinkerLoad* OwnerLinker = Owner ? Owner->GetLinker() : nullptr;
+			bCanMapPayload = FPlatformProperties::RequiresCookedData() && OwnerLinker && !OwnerLinker->IsCompressed() &&
+				!(BulkDataFlags & (BULKDATA_SerializeCompressed | BULKDATA_ForceSingleElementSerialization | BULKDATA_Unused)) &&
+				!RequiresSingleElementSerialization(Ar) && !Ar.ForceByteSwapping() && BulkDataSizeOnDisk == GetBulkDataSize();
+
 			// We're allowing defered serialization.
 			if( Ar.IsAllowingLazyLoading() && Owner != NULL)
 			{				
@@ -812,7 +917,12 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 #endif // WITH_EDITOR
 				if (bPayloadInline)
 				{
-					if (ShouldStreamBulkData())
+					if (TryMapPayload())
+					{
+						// Skip bulk data in this archive
+						Ar.Seek(Ar.Tell() + BulkDataSizeOnDisk);
+					}
+					else if (ShouldStreamBulkData())
 					{
 						// Start serializing immediately
 						StartSerializingBulkData(Ar, Owner, Idx, bPayloadInline);
@@ -833,7 +943,15 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 				{
 					Filename = Owner->GetLinker()->Filename;
 				}
-				if (ShouldStreamBulkData())
+				if (TryMapPayload())
+				{
+					if (bPayloadInline)
+					{
+						// Skip bulk data in this archive
+						Ar.Seek(Ar.Tell() + BulkDataSizeOnDisk);
+					}
+				}
+				else if (ShouldStreamBulkData())
 				{
 					StartSerializingBulkData(Ar, Owner, Idx, bPayloadInline);
 				}
@@ -939,7 +1057,7 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 				int64 SavedBulkDataStartPos = Ar.Tell();
 
 				// Serialize bulk data.
-				SerializeBulkData( Ar, BulkData.Get() );
+				SerializeBulkData( Ar, GetLoadedPayload() );
 				// store the payload endpos
 				int64 SavedBulkDataEndPos = Ar.Tell();
 
@@ -1065,11 +1183,11 @@ void FUntypedBulkData::Copy( const FUntypedBulkData& Other )
 	if( Other.GetElementCount() )
 	{
 		// Make sure src is loaded without calling Lock as the object is const.
-		check(Other.BulkData);
+		check(Other.IsBulkDataLoaded());
 		check(BulkData);
 		check(ElementCount == Other.GetElementCount() );
 		// Copy from src to dest.
-		FMemory::Memcpy( BulkData.Get(), Other.BulkData.Get(), Other.GetBulkDataSize() );
+		FMemory::Memcpy( BulkData.Get(), Other.GetLoadedPayload(), Other.GetBulkDataSize() );
 	}
 }
 
@@ -1084,6 +1202,8 @@ void FUntypedBulkData::InitializeMemberVariables()
 	BulkDataSizeOnDisk = INDEX_NONE;
 	BulkDataAlignment = DEFAULT_ALIGNMENT;
 	LockStatus = LOCKSTATUS_Unlocked;
+	MappedRegion = nullptr;
+	bCanMapPayload = false;
 #if WITH_EDITOR
 	Linker = nullptr;
 	AttachedAr = nullptr;
@@ -1207,7 +1327,7 @@ void FUntypedBulkData::MakeSureBulkDataIsLoaded()
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FUntypedBulkData::MakeSureBulkDataIsLoaded"), STAT_UBD_MakeSureBulkDataIsLoaded, STATGROUP_Memory);
 
 	// Nothing to do if data is already loaded.
-	if( !BulkData )
+	if( !IsBulkDataLoaded() )
 	{
 		// Look for async request first
 		if (SerializeFuture.IsValid())
@@ -1216,7 +1336,7 @@ void FUntypedBulkData::MakeSureBulkDataIsLoaded()
 			BulkData = MoveTemp(BulkDataAsync);
 			ResetAsyncData();
 		}
-		else
+		else if (!TryMapPayload())
 		{
 			const int32 BytesNeeded = GetBulkDataSize();
 			// Allocate memory for bulk data.
@@ -455,6 +455,7 @@ UStruct::UStruct( EStaticConstructor, int32 InSize, EObjectFlags InFlags )
 ,	RefLink			( NULL )
 ,	DestructorLink	( NULL )
 , PostConstructLink( NULL )
+,	NumUnversionedSlots( 0 )
 {
 }
 
@@ -468,6 +469,7 @@ UStruct::UStruct(UStruct* InSuperStruct, SIZE_T ParamsSize, SIZE_T Alignment)
 	, RefLink(NULL)
 	, DestructorLink(NULL)
 	, PostConstructLink(NULL)
+	, NumUnversionedSlots(0)
 {
 }
 
@@ -481,6 +483,7 @@ UStruct::UStruct(const FObjectInitializer& ObjectInitializer, UStruct* InSuperSt
 ,	RefLink			( NULL )
 ,	DestructorLink	( NULL )
 , PostConstructLink( NULL )
+,	NumUnversionedSlots( 0 )
 {
 }
 
@@ -720,6 +723,19 @@ void UStruct::Link(FArchive& Ar, bool bRelinkExistingProperties)
 	*PropertyLinkPtr = NULL;
 	*DestructorLinkPtr = NULL;
 	*RefLinkPtr = NULL;
+
+	// The unversioned layout only depends on property flags, so it is the same for every archive and the same in the cooker
+	// and in cooked builds. Editor-only properties don't exist in cooked builds and deprecated ones are never saved.
+	UnversionedProperties.Reset();
+	NumUnversionedSlots = 0;
+	for (UProperty* Property = PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (!Property->HasAnyPropertyFlags(CPF_EditorOnly | CPF_Deprecated))
+		{
+			UnversionedProperties.Add(Property);
+			NumUnversionedSlots += Property->ArrayDim;
+		}
+	}
 }
 
 void UStruct::InitializeStruct(void* InDest, int32 ArrayDim/* = 1*/) const
@@ -843,6 +859,12 @@ void UStruct::SerializeTaggedProperties(FArchive& Ar, uint8* Data, UStruct* Defa
 {
 	check(Ar.IsLoading() || Ar.IsSaving());
 
+	if (Ar.UseUnversionedPropertySerialization())
+	{
+		SerializeUnversionedProperties(Ar, Data, DefaultsStruct, Defaults);
+		return;
+	}
+
 	UClass* DefaultsClass = dynamic_cast<UClass*>(DefaultsStruct);
 	UScriptStruct* DefaultsScriptStruct = dynamic_cast<UScriptStruct*>(DefaultsStruct);
 
@@ -1428,6 +1450,93 @@ void UStruct::SerializeTaggedProperties(FArchive& Ar, uint8* Data, UStruct* Defa
 		Ar << Temp;
 	}
 }
+void UStruct::SerializeUnversionedProperties(FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults) const
+{
+	// One bit per slot of UnversionedProperties, set for the values that were saved.
+	TArray<uint8, TInlineAllocator<32>> SavedValues;
+	SavedValues.AddZeroed((NumUnversionedSlots + 7) / 8);
+
+	if (Ar.IsLoading())
+	{
+		uint32 NumSavedSlots = 0;
+		Ar.SerializeIntPacked(NumSavedSlots);
+		if (NumSavedSlots != (uint32)NumUnversionedSlots)
+		{
+			UE_LOG(LogClass, Fatal, TEXT("%s was saved with %u unversioned property values in %s, but has %d. Packages cooked with unversioned properties can only be loaded by the code they were cooked with."),
+				*GetFullName(), NumSavedSlots, *Ar.GetArchiveName(), NumUnversionedSlots);
+			return;
+		}
+		Ar.Serialize(SavedValues.GetData(), SavedValues.Num());
+
+		int32 Slot = 0;
+		for (UProperty* Property : UnversionedProperties)
+		{
+			for (int32 Idx = 0; Idx < Property->ArrayDim; Idx++, Slot++)
+			{
+				if (SavedValues[Slot >> 3] & (1 << (Slot & 7)))
+				{
+					uint8* DataPtr      = Property->ContainerPtrToValuePtr           <uint8>(Data, Idx);
+					uint8* DefaultValue = Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx);
+
+					FSerializedPropertyScope SerializedProperty(Ar, Property);
+					Property->SerializeItem(Ar, DataPtr, DefaultValue);
+				}
+			}
+		}
+	}
+	else
+	{
+		UScriptStruct* DefaultsScriptStruct = dynamic_cast<UScriptStruct*>(DefaultsStruct);
+		const bool bUseAtomicSerialization = DefaultsScriptStruct && DefaultsScriptStruct->ShouldSerializeAtomically(Ar);
+
+		// Values that match the defaults are left out, in the same cases as tagged properties. So are values the archive
+		// doesn't want, which only clears their bits and leaves the layout alone.
+		const bool bDoDelta = Ar.DoDelta() && !Ar.IsTransacting() && (Defaults || dynamic_cast<const UClass*>(this));
+
+		int32 Slot = 0;
+		for (UProperty* Property : UnversionedProperties)
+		{
+			if (!Property->ShouldSerializeValue(Ar))
+			{
+				Slot += Property->ArrayDim;
+				continue;
+			}
+
+			for (int32 Idx = 0; Idx < Property->ArrayDim; Idx++, Slot++)
+			{
+				if (!bDoDelta || !Property->Identical(Property->ContainerPtrToValuePtr<uint8>(Data, Idx), Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx), Ar.GetPortFlags()))
+				{
+					SavedValues[Slot >> 3] |= 1 << (Slot & 7);
+				}
+			}
+		}
+
+		uint32 NumSlots = NumUnversionedSlots;
+		Ar.SerializeIntPacked(NumSlots);
+		Ar.Serialize(SavedValues.GetData(), SavedValues.Num());
+
+		Slot = 0;
+		for (UProperty* Property : UnversionedProperties)
+		{
+			for (int32 Idx = 0; Idx < Property->ArrayDim; Idx++, Slot++)
+			{
+				if (SavedValues[Slot >> 3] & (1 << (Slot & 7)))
+				{
+					uint8* DataPtr      = Property->ContainerPtrToValuePtr<uint8>(Data, Idx);
+					uint8* DefaultValue = bUseAtomicSerialization ? NULL : Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx);
+#if WITH_EDITOR
+					static const FName NAME_PropertySerialize = FName(TEXT("PropertySerialize"));
+					FArchive::FScopeAddDebugData P(Ar, NAME_PropertySerialize);
+					FArchive::FScopeAddDebugData S(Ar, Property->GetFName());
+#endif
+					FSerializedPropertyScope SerializedProperty(Ar, Property);
+					Property->SerializeItem(Ar, DataPtr, DefaultValue);
+				}
+			}
+		}
+	}
+}
+
 void UStruct::FinishDestroy()
 {
 	Script.Empty();
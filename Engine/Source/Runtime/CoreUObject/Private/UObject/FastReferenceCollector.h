@@ -155,6 +155,32 @@ public:
 		}
 	}
 
+	/**
+	* Performs reachability analysis on the calling thread until there is nothing left to process or EndTime has passed.
+	* Can be called again with the same array to carry on where the previous call stopped.
+	*
+	* @param ObjectsToCollectReferencesFor List of objects which references should be collected, holds the objects that still need processing on return
+	* @param EndTime FPlatformTime::Seconds() to stop at
+	* @return true if all references have been collected, false if time ran out
+	*/
+	bool CollectReferencesTimeSliced(TArray<UObject*>& ObjectsToCollectReferencesFor, double EndTime)
+	{
+		check(!ReferenceProcessor.IsRunningMultithreaded());
+		check(EndTime > 0.0);
+
+		bool bFinished = true;
+		if (ObjectsToCollectReferencesFor.Num())
+		{
+			FGraphEventRef InvalidRef;
+			bFinished = ProcessObjectArray(ObjectsToCollectReferencesFor, InvalidRef, EndTime);
+		}
+		if (bFinished)
+		{
+			ObjectsToCollectReferencesFor.Reset();
+		}
+		return bFinished;
+	}
+
 private:
 
 	/**
@@ -162,8 +188,10 @@ private:
 	 *
 	 * @param InObjectsToSerializeArray Objects to process
 	 * @param MyCompletionGraphEvent Task graph event
+	 * @param EndTime If non zero, FPlatformTime::Seconds() to stop at (single threaded only)
+	 * @return false if processing stopped at EndTime, in which case InObjectsToSerializeArray holds the objects that still need processing
 	 */
-	void ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGraphEventRef& MyCompletionGraphEvent)
+	bool ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGraphEventRef& MyCompletionGraphEvent, double EndTime = 0.0)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("TFastReferenceCollector::ProcessObjectArray"), STAT_FFastReferenceCollector_ProcessObjectArray, STATGROUP_GC);
 
@@ -185,6 +213,9 @@ private:
 		// it is necessary to have at least one extra item in the array memory block for the iffy prefetch code, below
 		ObjectsToSerialize.Reserve(ObjectsToSerialize.Num() + 1);
 
+		// Number of objects processed since the time limit was last checked
+		uint32 ObjectsSinceTimeCheck = 0;
+
 		// Keep serializing objects till we reach the end of the growing array at which point
 		// we are done.
 		int32 CurrentIndex = 0;
@@ -193,6 +224,16 @@ private:
 			CollectorType ReferenceCollector(ReferenceProcessor, NewObjectsToSerialize);
 			while (CurrentIndex < ObjectsToSerialize.Num())
 			{
+				if (EndTime > 0.0 && (++ObjectsSinceTimeCheck & 255) == 0 && FPlatformTime::Seconds() >= EndTime)
+				{
+					// Out of time. ObjectsToSerialize always refers to the caller's array (Exchange only swaps contents), so leave
+					// everything that has been found but not processed yet in there.
+					ObjectsToSerialize.RemoveAt(0, CurrentIndex, false);
+					ObjectsToSerialize.Append(NewObjectsToSerialize);
+					ArrayPool.ReturnToPool(&NewObjectsToSerializeArray);
+					return false;
+				}
+
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 				uint32 StartCycles = FPlatformTime::Cycles();
 #endif
@@ -423,5 +464,6 @@ private:
 		while (CurrentIndex < ObjectsToSerialize.Num());
 
 		ArrayPool.ReturnToPool(&NewObjectsToSerializeArray);
+		return true;
 	}
 };
\ No newline at end of file
@@ -52,6 +52,9 @@ static bool GObjCurrentPurgeObjectIndexResetPastPermanent = false;
 /** Currently running a parallel reachability test.											*/
 static volatile bool GIsRunningParallelReachability = false;
 
+/** Whether incremental reachability analysis has started and not finished yet, checked by GCWriteBarrier.	*/
+COREUOBJECT_API bool GIsIncrementalReachabilityPending = false;
+
 /** Whether we are currently purging an object in the GC purge pass. */
 static bool GIsPurgingObject = false;
 
@@ -180,6 +183,8 @@ private:
 };
 
 void CleanupClusterArrayPools();
+int32 DissolvePendingClusters();
+
 /** Called on shutdown to free GC memory */
 void CleanupGCArrayPools()
 {
@@ -203,6 +208,36 @@ static FAutoConsoleVariableRef CVarMinDesiredObjectsPerSubTask(
 	ECVF_Default
 	);
 
+// Spread reachability analysis over several frames when going through TryCollectGarbageIncremental
+static int32 GIncrementalReachability = 0;
+static FAutoConsoleVariableRef CVarIncrementalReachability(
+	TEXT("gc.IncrementalReachability"),
+	GIncrementalReachability,
+	TEXT("Experimental. If enabled, reachability analysis is spread over several frames with a time limit per frame.\n")
+	TEXT("Requires every UObject reference written while it's in progress to go through GCWriteBarrier, including raw UObject* writes in native code. Off by default."),
+	ECVF_Default
+	);
+
+// Time limit for each incremental reachability analysis step
+static float GIncrementalReachabilityTimeLimit = 0.002f;
+static FAutoConsoleVariableRef CVarIncrementalReachabilityTimeLimit(
+	TEXT("gc.IncrementalReachabilityTimeLimit"),
+	GIncrementalReachabilityTimeLimit,
+	TEXT("Time in seconds incremental reachability analysis may spend marking objects each frame."),
+	ECVF_Default
+	);
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+// Check incremental reachability analysis against a full one to find references written without the write barrier
+static int32 GVerifyIncrementalReachability = 0;
+static FAutoConsoleVariableRef CVarVerifyIncrementalReachability(
+	TEXT("gc.VerifyIncrementalReachability"),
+	GVerifyIncrementalReachability,
+	TEXT("If enabled, incremental reachability analysis finishes with a full one and logs objects it would have collected even though they are still referenced. Slow, for finding missing GCWriteBarrier calls."),
+	ECVF_Default
+	);
+#endif
+
 #if PERF_DETAILED_PER_CLASS_GC_STATS
 /** Map from a UClass' FName to the number of objects that were purged during the last purge phase of this class.	*/
 static TMap<const FName,uint32> GClassToPurgeCountMap;
@@ -345,7 +380,11 @@ public:
 		for (int32 ReferencedMutableObjectIndex : Cluster->MutableObjects)
 		{
 			FUObjectItem* ReferencedMutableObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ReferencedMutableObjectIndex);
-			if (bParallel)
+			if (ReferencedMutableObjectItem->GetOwnerIndex() || ReferencedMutableObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				MarkClusteredMutableObjectAsReachable(ObjectsToSerialize, ReferencedMutableObjectItem);
+			}
+			else if (bParallel)
 			{
 				if (ReferencedMutableObjectItem->IsUnreachable() && ReferencedMutableObjectItem->ThisThreadAtomicallyClearedRFUnreachable())
 				{
@@ -361,6 +400,17 @@ public:
 		}
 	}
 
+	/**
+	 * Marks a mutable object that is part of a cluster (or a cluster root) itself as reachable, together with its cluster.
+	 * Mutable objects are usually objects that can't be in a cluster, but objects referenced by a cluster that got dissolved
+	 * or that were in another package than the cluster root can end up in a cluster created later.
+	 */
+	FORCENOINLINE void MarkClusteredMutableObjectAsReachable(TArray<UObject*>& ObjectsToSerialize, FUObjectItem* ObjectItem)
+	{
+		UObject* Object = static_cast<UObject*>(ObjectItem->Object);
+		HandleObjectReference(ObjectsToSerialize, nullptr, Object, false);
+	}
+
 	/** Marks all clusters referenced by another cluster as rechable */
 	template <bool bParallel>
 	FORCEINLINE void MarkReferencedClustersAsReachable(int32 ClusterRootIndex, TArray<UObject*>& ObjectsToSerialize)
@@ -543,18 +593,207 @@ public:
 };
 
 /**
-* Specialized FReferenceCollector that uses FGCReferenceProcessor to mark objects as reachable.
+* Handles UObject references found by TFastReferenceCollector during incremental reachability analysis.
+*
+* Marking is spread over several frames, so objects can't be flagged as unreachable while it's in progress: weak pointers,
+* FindObject and friends treat unreachable objects as gone. Instead, every object that is a candidate for collection has
+* a bit set in UnmarkedObjects (indexed by object index) that is cleared once the object is found to be reachable.
+* Objects that were created after marking started are past the end of the bit array or in slots that were free at the
+* time, so they are never candidates.
+*/
+class FIncrementalGCReferenceProcessor
+{
+	TBitArray<>& UnmarkedObjects;
+
+public:
+
+	FIncrementalGCReferenceProcessor(TBitArray<>& InUnmarkedObjects)
+		: UnmarkedObjects(InUnmarkedObjects)
+	{
+	}
+
+	FORCEINLINE int32 GetMinDesiredObjectsPerSubTask() const
+	{
+		return GMinDesiredObjectsPerSubTask;
+	}
+
+	FORCEINLINE volatile bool IsRunningMultithreaded() const
+	{
+		return false;
+	}
+
+	FORCEINLINE void SetIsRunningMultithreaded(bool bIsParallel)
+	{
+		// Incremental marking always runs on the game thread, between frames
+		check(!bIsParallel);
+	}
+
+	void UpdateDetailedStats(UObject* CurrentObject, uint32 DeltaCycles)
+	{
+	}
+
+	void LogDetailedStatsSummary()
+	{
+	}
+
+	/** Clears the unmarked bit of an object, returns true if it was set */
+	FORCEINLINE bool Mark(int32 ObjectIndex)
+	{
+		if (ObjectIndex < UnmarkedObjects.Num() && UnmarkedObjects[ObjectIndex])
+		{
+			UnmarkedObjects[ObjectIndex] = false;
+			return true;
+		}
+		return false;
+	}
+
+	/** Marks all objects that can't be directly in a cluster but are referenced by it as reachable */
+	FORCEINLINE void MarkClusterMutableObjectsAsReachable(FUObjectCluster* Cluster, TArray<UObject*>& ObjectsToSerialize)
+	{
+		for (int32 ReferencedMutableObjectIndex : Cluster->MutableObjects)
+		{
+			FUObjectItem* ReferencedMutableObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ReferencedMutableObjectIndex);
+			if (ReferencedMutableObjectItem->GetOwnerIndex() || ReferencedMutableObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				MarkClusteredMutableObjectAsReachable(ObjectsToSerialize, ReferencedMutableObjectItem);
+			}
+			else if (Mark(ReferencedMutableObjectIndex))
+			{
+				ReferencedMutableObjectItem->ClearFlags(EInternalObjectFlags::NoStrongReference);
+				ObjectsToSerialize.Add(static_cast<UObject*>(ReferencedMutableObjectItem->Object));
+			}
+		}
+	}
+
+	/** Marks a mutable object that is part of a cluster (or a cluster root) itself as reachable, together with its cluster */
+	FORCENOINLINE void MarkClusteredMutableObjectAsReachable(TArray<UObject*>& ObjectsToSerialize, FUObjectItem* ObjectItem)
+	{
+		MarkObjectAsReachable(ObjectsToSerialize, static_cast<UObject*>(ObjectItem->Object));
+	}
+
+	/** Marks all clusters referenced by another cluster as rechable */
+	FORCEINLINE void MarkReferencedClustersAsReachable(int32 ClusterRootIndex, TArray<UObject*>& ObjectsToSerialize)
+	{
+		FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
+		// Also mark all referenced objects from outside of the cluster as reachable
+		MarkClusterMutableObjectsAsReachable(Cluster, ObjectsToSerialize);
+		for (int32 ReferncedClusterIndex : Cluster->ReferencedClusters)
+		{
+			Mark(ReferncedClusterIndex);
+			GUObjectArray.IndexToObjectUnsafeForGC(ReferncedClusterIndex)->ClearFlags(EInternalObjectFlags::NoStrongReference);
+			FUObjectCluster* ReferencedCluster = GUObjectClusters.FindChecked(ReferncedClusterIndex);
+			MarkClusterMutableObjectsAsReachable(ReferencedCluster, ObjectsToSerialize);
+		}
+	}
+
+	/**
+	 * Marks an object as reachable, queueing it up for reference collection if it hasn't been marked before.
+	 *
+	 * @param ObjectsToSerialize	Objects that still need their references collected
+	 * @param Object				Object to mark
+	 */
+	FORCEINLINE void MarkObjectAsReachable(TArray<UObject*>& ObjectsToSerialize, UObject* Object)
+	{
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+
+		if (Mark(ObjectIndex))
+		{
+			// Objects that are part of a GC cluster should never be candidates for collection!
+			checkSlow(ObjectItem->GetOwnerIndex() == 0);
+
+			if (!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				// Add it to the list of objects to serialize.
+				ObjectsToSerialize.Add(Object);
+			}
+			else
+			{
+				// This is a cluster root reference so mark all referenced clusters as reachable
+				MarkReferencedClustersAsReachable(ObjectIndex, ObjectsToSerialize);
+			}
+		}
+		else if (ObjectItem->GetOwnerIndex() && !ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster))
+		{
+			ObjectItem->SetFlags(EInternalObjectFlags::ReachableInCluster);
+			// Make sure cluster root object is reachable too
+			const int32 OwnerIndex = ObjectItem->GetOwnerIndex();
+			if (Mark(OwnerIndex))
+			{
+				GUObjectArray.IndexToObjectUnsafeForGC(OwnerIndex)->ClearFlags(EInternalObjectFlags::NoStrongReference);
+				// Make sure all referenced clusters are marked as reachable too
+				MarkReferencedClustersAsReachable(OwnerIndex, ObjectsToSerialize);
+			}
+		}
+	}
+
+	/**
+	 * Handles object reference, potentially NULL'ing
+	 *
+	 * @param Object						Object pointer passed by reference
+	 * @param ReferencingObject UObject which owns the reference (can be NULL)
+	 * @param bAllowReferenceElimination	Whether to allow NULL'ing the reference if RF_PendingKill is set
+	*/
+	FORCEINLINE void HandleObjectReference(TArray<UObject*>& ObjectsToSerialize, const UObject * const ReferencingObject, UObject*& Object, const bool bAllowReferenceElimination, const bool bStrongReference = true)
+	{
+		if (Object == nullptr || GUObjectAllocator.ResidesInPermanentPool(Object))
+		{
+			return;
+		}
+
+		FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(Object);
+		// Remove references to pending kill objects if we're allowed to do so.
+		if (ObjectItem->IsPendingKill() && bAllowReferenceElimination)
+		{
+			// Null out reference.
+			Object = NULL;
+		}
+		else
+		{
+			MarkObjectAsReachable(ObjectsToSerialize, Object);
+		}
+
+		if (bStrongReference && ObjectItem->HasAnyFlags(EInternalObjectFlags::NoStrongReference))
+		{
+			ObjectItem->ClearFlags(EInternalObjectFlags::NoStrongReference);
+		}
+	}
+
+	/**
+	* Handles UObject reference from the token stream.
+	*
+	* @param ObjectsToSerialize An array of remaining objects to serialize.
+	* @param ReferencingObject Object referencing the object to process.
+	* @param TokenIndex Index to the token stream where the reference was found.
+	* @param bAllowReferenceElimination True if reference elimination is allowed.
+	*/
+	FORCEINLINE void HandleTokenStreamObjectReference(TArray<UObject*>& ObjectsToSerialize, UObject* ReferencingObject, UObject*& Object, const int32 TokenIndex, bool bAllowReferenceElimination)
+	{
+#if !(UE_BUILD_TEST || UE_BUILD_SHIPPING)
+		// With incremental marking this usually means a reference was written without going through GCWriteBarrier
+		UE_CLOG(Object && !Object->IsValidLowLevelFast(), LogGarbage, Fatal, TEXT("Invalid object in incremental GC: 0x%016llx, ReferencingObject: %s, TokenIndex: %d"),
+			(int64)(PTRINT)Object,
+			ReferencingObject ? *ReferencingObject->GetFullName() : TEXT("NULL"),
+			TokenIndex);
+#endif
+		HandleObjectReference(ObjectsToSerialize, ReferencingObject, Object, bAllowReferenceElimination);
+	}
+};
+
+/**
+* Specialized FReferenceCollector that uses a GC reference processor to mark objects as reachable.
 */
-class FGCCollector : public FReferenceCollector
+template <typename ReferenceProcessorType>
+class TGCCollector : public FReferenceCollector
 {
-	FGCReferenceProcessor& ReferenceProcessor;
+	ReferenceProcessorType& ReferenceProcessor;
 	TArray<UObject*>& ObjectArray;
 	bool bAllowEliminatingReferences;
 	bool bShouldHandleAsWeakRef;
 
 public:
 
-	FGCCollector(FGCReferenceProcessor& InProcessor, TArray<UObject*>& InObjectArray)
+	TGCCollector(ReferenceProcessorType& InProcessor, TArray<UObject*>& InObjectArray)
 		: ReferenceProcessor(InProcessor)
 		, ObjectArray(InObjectArray)
 		, bAllowEliminatingReferences(true)
@@ -612,6 +851,9 @@ public:
 	}
 };
 
+typedef TGCCollector<FGCReferenceProcessor> FGCCollector;
+typedef TGCCollector<FIncrementalGCReferenceProcessor> FIncrementalGCCollector;
+
 
 /*----------------------------------------------------------------------------
 	FReferenceFinder.
@@ -699,10 +941,16 @@ public:
 	/** 
 	 * Marks all objects that don't have KeepFlags and EInternalObjectFlags::GarbageCollectionKeepFlags as unreachable
 	 * This function is a template to speed up the case where we don't need to assemble the token stream (saves about 6ms on PS4)
+	 * For incremental reachability analysis (bIncremental) the objects get their bit in UnmarkedObjects set instead.
 	 */
-	template <bool bAssembleTokenStream>
-	void MarkObjectsAsUnreachable(TArray<UObject*>& ObjectsToSerialize, const EObjectFlags KeepFlags)
+	template <bool bAssembleTokenStream, bool bIncremental = false>
+	void MarkObjectsAsUnreachable(TArray<UObject*>& ObjectsToSerialize, const EObjectFlags KeepFlags, TBitArray<>* UnmarkedObjects = nullptr)
 	{
+		if (bIncremental)
+		{
+			UnmarkedObjects->Init(false, GUObjectArray.GetObjectArrayNum());
+		}
+
 		const EInternalObjectFlags FastKeepFlags = EInternalObjectFlags::GarbageCollectionKeepFlags;
 
 		// Iterate over all objects. Note that we iterate over the UObjectArray and usually check only internal flags which
@@ -753,6 +1001,11 @@ public:
 					checkSlow(Object->IsValidLowLevel());
 					ObjectsToSerialize.Add(Object);
 				}
+				else if (bIncremental)
+				{
+					(*UnmarkedObjects)[It.GetIndex()] = true;
+					ObjectItem->SetFlags(EInternalObjectFlags::NoStrongReference);
+				}
 				else
 				{
 					ObjectItem->SetFlags(EInternalObjectFlags::Unreachable | EInternalObjectFlags::NoStrongReference);
@@ -823,79 +1076,384 @@ public:
 };
 
 /**
- * Incrementally purge garbage by deleting all unreferenced objects after routing Destroy.
- *
- * Calling code needs to be EXTREMELY careful when and how to call this function as 
- * RF_Unreachable cannot change on any objects unless any pending purge has completed!
+ * Reachability analysis spread over several frames.
  *
- * @param	bUseTimeLimit	whether the time limit parameter should be used
- * @param	TimeLimit		soft time limit for this function call
+ * Start does the same pass over the object array FRealtimeGC does, and each Step collects references for as long as its
+ * time limit allows. Gameplay code runs in between and may store a reference to an object that hasn't been marked yet in
+ * one that has already been processed, so every such write has to go through GCWriteBarrier, which marks the newly
+ * referenced object. Objects created after Start are kept, and their references are collected in Finish together with
+ * FGCObject references, which the barrier doesn't see. Finish has no time limit and flags everything that is still
+ * unmarked as unreachable, leaving the rest to the regular unhash and purge.
  */
-void IncrementalPurgeGarbage( bool bUseTimeLimit, float TimeLimit )
+class FIncrementalRealtimeGC : public FUObjectArray::FUObjectCreateListener
 {
-	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "IncrementalPurgeGarbage" ), STAT_IncrementalPurgeGarbage, STATGROUP_GC );
+public:
+	/** Default constructor, initializing all members. */
+	FIncrementalRealtimeGC()
+		: KeepFlags(RF_NoFlags)
+		, NumSteps(0)
+	{}
 
-	if (GExitPurge)
+	/**
+	 * Marks all objects that don't have KeepFlags as candidates for collection and starts tracking new objects.
+	 *
+	 * @param InKeepFlags	Objects with these flags will be kept regardless of being referenced or not
+	 */
+	void Start(EObjectFlags InKeepFlags)
 	{
-		GObjPurgeIsRequired = true;
-		GUObjectArray.DisableDisregardForGC();
-		GObjCurrentPurgeObjectIndexNeedsReset = true;
-		GObjCurrentPurgeObjectIndexResetPastPermanent = false;
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FIncrementalRealtimeGC::Start"), STAT_FIncrementalRealtimeGC_Start, STATGROUP_GC);
+		check(!GIsIncrementalReachabilityPending);
+
+		KeepFlags = InKeepFlags;
+		NumSteps = 0;
+
+		// Reset object count.
+		GObjectCountDuringLastMarkPhase = 0;
+
+		// Cluster membership has to stay the same until the pass is finished
+		DissolvePendingClusters();
+
+		// Presize array and add a bit of extra slack for prefetching.
+		ObjectsToSerialize.Reset(GUObjectArray.GetObjectArrayNumMinusPermanent() + 3);
+		// Make sure GC referencer object is checked for references to other objects even if it resides in permanent object pool
+		if (FPlatformProperties::RequiresCookedData() && FGCObject::GGCObjectReferencer && GUObjectArray.IsDisregardForGC(FGCObject::GGCObjectReferencer))
+		{
+			ObjectsToSerialize.Add(FGCObject::GGCObjectReferencer);
+		}
+
+		FRealtimeGC RealtimeGC;
+		if (!IsTokenStreamDirty())
+		{
+			RealtimeGC.MarkObjectsAsUnreachable<false, true>(ObjectsToSerialize, KeepFlags, &UnmarkedObjects);
+		}
+		else
+		{
+			SetTokenStreamMaybeDirty(false);
+			RealtimeGC.MarkObjectsAsUnreachable<true, true>(ObjectsToSerialize, KeepFlags, &UnmarkedObjects);
+		}
+
+		GUObjectArray.AddUObjectCreateListener(this);
+		GIsIncrementalReachabilityPending = true;
 	}
-	// Early out if there is nothing to do.
-	if( !GObjPurgeIsRequired )
+
+	/**
+	 * Collects references until there are no more objects to process or the time limit has been reached.
+	 *
+	 * @param EndTime	FPlatformTime::Seconds() to stop at
+	 * @return true if there is nothing left to mark and Finish can be called
+	 */
+	bool Step(double EndTime)
 	{
-		return;
-	}
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FIncrementalRealtimeGC::Step"), STAT_FIncrementalRealtimeGC_Step, STATGROUP_GC);
+		check(GIsIncrementalReachabilityPending);
 
-	// Set 'I'm garbage collecting' flag - might be checked inside UObject::Destroy etc.
-	FGCScopeLock GCLock;
+		NumSteps++;
 
-	// Incremental purge is now in progress.
-	GObjIncrementalPurgeIsInProgress						= true;
+		FIncrementalGCReferenceProcessor ReferenceProcessor(UnmarkedObjects);
+		MarkBarrierObjects(ReferenceProcessor);
 
-	// Keep track of start time to enforce time limit unless bForceFullPurge is true;
-	const double		StartTime							= FPlatformTime::Seconds();
-	bool		bTimeLimitReached							= false;
-	// Depending on platform FPlatformTime::Seconds might take a noticeable amount of time if called thousands of times so we avoid
-	// enforcing the time limit too often, especially as neither Destroy nor actual deletion should take significant
-	// amounts of time.
-	const int32	TimeLimitEnforcementGranularityForDestroy	= 10;
-	const int32	TimeLimitEnforcementGranularityForDeletion	= 100;
+		TFastReferenceCollector<FIncrementalGCReferenceProcessor, FIncrementalGCCollector, FGCArrayPool, true> ReferenceCollector(ReferenceProcessor, FGCArrayPool::Get());
+		return ReferenceCollector.CollectReferencesTimeSliced(ObjectsToSerialize, EndTime);
+	}
 
-	if( !GObjFinishDestroyHasBeenRoutedToAllObjects && !bTimeLimitReached )
+	/** Collects the references nothing kept track of while marking, then flags all unmarked objects as unreachable. */
+	void Finish()
 	{
-		// Try to dispatch all FinishDestroy messages to unreachable objects.  We'll iterate over every
-		// single object and destroy any that are ready to be destroyed.  The objects that aren't yet
-		// ready will be added to a list to be processed afterwards.
-		int32 TimePollCounter = 0;
-		if (GObjCurrentPurgeObjectIndexNeedsReset)
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FIncrementalRealtimeGC::Finish"), STAT_FIncrementalRealtimeGC_Finish, STATGROUP_GC);
+		check(GIsIncrementalReachabilityPending);
+
+		FIncrementalGCReferenceProcessor ReferenceProcessor(UnmarkedObjects);
+
+		// FGCObject references don't go through the write barrier, so collect them again
+		if (FGCObject::GGCObjectReferencer)
 		{
-			// iterators don't have an op=, so we destroy it and reconstruct it with a placement new
-			// GObjCurrentPurgeObjectIndex	= FRawObjectIterator(GObjCurrentPurgeObjectIndexResetPastPermanent);
-			GObjCurrentPurgeObjectIndex.~FRawObjectIterator();
-			new (&GObjCurrentPurgeObjectIndex) FRawObjectIterator(GObjCurrentPurgeObjectIndexResetPastPermanent);
-			GObjCurrentPurgeObjectIndexNeedsReset = false;
+			ObjectsToSerialize.Add(FGCObject::GGCObjectReferencer);
 		}
 
-		while( GObjCurrentPurgeObjectIndex )
+		// Objects created since Start were never candidates for collection, but the objects they reference may be
 		{
-			FUObjectItem* ObjectItem = *GObjCurrentPurgeObjectIndex;
-			checkSlow(ObjectItem);
-
-			//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
+			FScopeLock PendingObjectsLock(&PendingObjectsCritical);
+			for (int32 ObjectIndex : NewObjectIndices)
+			{
+				if (UObject* Object = static_cast<UObject*>(GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex)->Object))
+				{
+					ObjectsToSerialize.Add(Object);
+				}
+			}
+			NewObjectIndices.Reset();
+		}
 
-			if (ObjectItem->IsUnreachable())
+		// Objects that have been added to the root set or given one of the keep flags since Start
+		{
+			const EInternalObjectFlags FastKeepFlags = EInternalObjectFlags::GarbageCollectionKeepFlags;
+			TArray<UObject*> KeptObjects;
+			for (TConstSetBitIterator<> It(UnmarkedObjects); It; ++It)
 			{
+				FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(It.GetIndex());
 				UObject* Object = static_cast<UObject*>(ObjectItem->Object);
-				// Object should always have had BeginDestroy called on it and never already be destroyed
-				check( Object->HasAnyFlags( RF_BeginDestroyed ) && !Object->HasAnyFlags( RF_FinishDestroyed ) );
-
-				// Only proceed with destroying the object if the asynchronous cleanup started by BeginDestroy has finished.
-				if(Object->IsReadyForFinishDestroy())
+				if (ObjectItem->IsRootSet() ||
+					(!ObjectItem->IsPendingKill() && (ObjectItem->HasAnyFlags(FastKeepFlags) || (KeepFlags != RF_NoFlags && Object->HasAnyFlags(KeepFlags)))))
 				{
-#if PERF_DETAILED_PER_CLASS_GC_STATS
-					// Keep track of how many objects of a certain class we're purging.
+					KeptObjects.Add(Object);
+				}
+			}
+			for (UObject* Object : KeptObjects)
+			{
+				ReferenceProcessor.HandleObjectReference(ObjectsToSerialize, nullptr, Object, false);
+			}
+		}
+
+		MarkBarrierObjects(ReferenceProcessor);
+		{
+			TFastReferenceCollector<FIncrementalGCReferenceProcessor, FIncrementalGCCollector, FGCArrayPool, true> ReferenceCollector(ReferenceProcessor, FGCArrayPool::Get());
+			ReferenceCollector.CollectReferences(ObjectsToSerialize, true);
+			ObjectsToSerialize.Reset();
+		}
+
+		bool bVerified = false;
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+		if (GVerifyIncrementalReachability)
+		{
+			VerifyAgainstFullReachabilityAnalysis();
+			bVerified = true;
+		}
+#endif
+
+		if (!bVerified)
+		{
+			for (TConstSetBitIterator<> It(UnmarkedObjects); It; ++It)
+			{
+				FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(It.GetIndex());
+				// Objects that have been added to a cluster since Start live and die with their cluster root
+				if (ObjectItem->GetOwnerIndex() == 0)
+				{
+					ObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
+				}
+				else
+				{
+					ObjectItem->ClearFlags(EInternalObjectFlags::NoStrongReference);
+				}
+			}
+		}
+
+		UE_LOG(LogGarbage, Log, TEXT("Incremental reachability analysis finished after %d steps"), NumSteps);
+		Reset();
+	}
+
+	/** Throws away all marking done so far, for when a full garbage collection is about to run. */
+	void Abort()
+	{
+		check(GIsIncrementalReachabilityPending);
+
+		ClearNoStrongReferenceFlags();
+		Reset();
+	}
+
+	/** Queues up an object to be marked by the next step, called by GCWriteBarrier from any thread. */
+	void AddBarrierObject(UObject* Object)
+	{
+		FScopeLock PendingObjectsLock(&PendingObjectsCritical);
+		BarrierObjects.Add(Object);
+	}
+
+	virtual void NotifyUObjectCreated(const class UObjectBase* Object, int32 Index) override
+	{
+		FScopeLock PendingObjectsLock(&PendingObjectsCritical);
+		NewObjectIndices.Add(Index);
+	}
+
+private:
+
+	/** Marks the objects passed to GCWriteBarrier since the last call. */
+	void MarkBarrierObjects(FIncrementalGCReferenceProcessor& ReferenceProcessor)
+	{
+		TArray<UObject*> Objects;
+		{
+			FScopeLock PendingObjectsLock(&PendingObjectsCritical);
+			Exchange(Objects, BarrierObjects);
+		}
+		for (UObject* Object : Objects)
+		{
+			ReferenceProcessor.HandleObjectReference(ObjectsToSerialize, nullptr, Object, false);
+		}
+	}
+
+	/** Candidates for collection have NoStrongReference set until a strong reference is found, which has to be undone before a full analysis. */
+	void ClearNoStrongReferenceFlags()
+	{
+		for (FRawObjectIterator It(true); It; ++It)
+		{
+			(*It)->ClearFlags(EInternalObjectFlags::NoStrongReference);
+		}
+	}
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	/** Runs a full reachability analysis and logs every object it found reachable that incremental marking didn't. */
+	void VerifyAgainstFullReachabilityAnalysis()
+	{
+		ClearNoStrongReferenceFlags();
+
+		FRealtimeGC RealtimeGC;
+		RealtimeGC.PerformReachabilityAnalysis(KeepFlags, true);
+
+		int32 NumMissed = 0;
+		for (TConstSetBitIterator<> It(UnmarkedObjects); It; ++It)
+		{
+			FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(It.GetIndex());
+			if (!ObjectItem->IsUnreachable() && ObjectItem->GetOwnerIndex() == 0)
+			{
+				UE_LOG(LogGarbage, Warning, TEXT("Incremental reachability analysis missed %s, a reference to it was written without GCWriteBarrier"), *static_cast<UObject*>(ObjectItem->Object)->GetFullName());
+				NumMissed++;
+			}
+		}
+		UE_LOG(LogGarbage, Log, TEXT("Verified incremental reachability analysis, %d objects missed"), NumMissed);
+	}
+#endif
+
+	void Reset()
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GIsIncrementalReachabilityPending = false;
+
+		UnmarkedObjects.Empty();
+		ObjectsToSerialize.Reset();
+
+		FScopeLock PendingObjectsLock(&PendingObjectsCritical);
+		BarrierObjects.Empty();
+		NewObjectIndices.Empty();
+	}
+
+	/** Bit per object index, set for objects that are candidates for collection and haven't been found to be reachable */
+	TBitArray<> UnmarkedObjects;
+	/** Objects that have been marked but haven't had their references collected yet */
+	TArray<UObject*> ObjectsToSerialize;
+	/** Objects passed to GCWriteBarrier since the last step */
+	TArray<UObject*> BarrierObjects;
+	/** Indices of the objects created since Start */
+	TArray<int32> NewObjectIndices;
+	/** Protects BarrierObjects and NewObjectIndices, which are added to from any thread */
+	FCriticalSection PendingObjectsCritical;
+	/** Keep flags passed to Start */
+	EObjectFlags KeepFlags;
+	/** Number of steps taken since Start */
+	int32 NumSteps;
+};
+
+static FIncrementalRealtimeGC GIncrementalRealtimeGC;
+
+void GCMarkObjectReachableIncremental(const class UObjectBase* Object)
+{
+	GIncrementalRealtimeGC.AddBarrierObject(static_cast<UObject*>(const_cast<UObjectBase*>(Object)));
+}
+
+/** Passes every strong object reference serialized to it to GCWriteBarrier */
+class FGCWriteBarrierArchive : public FArchiveUObject
+{
+public:
+	FGCWriteBarrierArchive()
+	{
+		ArIsObjectReferenceCollector = true;
+	}
+
+	virtual FArchive& operator<<(UObject*& Object) override
+	{
+		GCWriteBarrier(Object);
+		return *this;
+	}
+};
+
+void GCWriteBarrierPropertyValue(const UProperty* Property, const void* Value, int32 Count)
+{
+	if (GIsIncrementalReachabilityPending && Property->ContainsObjectReference())
+	{
+		// Structs only serialize their RefLink properties to reference collectors, so this only visits what can hold references
+		FGCWriteBarrierArchive Ar;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Property->SerializeItem(Ar, (uint8*)Value + Index * Property->ElementSize);
+		}
+	}
+}
+
+bool IsIncrementalReachabilityAnalysisPending()
+{
+	return GIsIncrementalReachabilityPending;
+}
+
+/**
+ * Incrementally purge garbage by deleting all unreferenced objects after routing Destroy.
+ *
+ * Calling code needs to be EXTREMELY careful when and how to call this function as 
+ * RF_Unreachable cannot change on any objects unless any pending purge has completed!
+ *
+ * @param	bUseTimeLimit	whether the time limit parameter should be used
+ * @param	TimeLimit		soft time limit for this function call
+ */
+void IncrementalPurgeGarbage( bool bUseTimeLimit, float TimeLimit )
+{
+	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "IncrementalPurgeGarbage" ), STAT_IncrementalPurgeGarbage, STATGROUP_GC );
+
+	if (GExitPurge)
+	{
+		GObjPurgeIsRequired = true;
+		GUObjectArray.DisableDisregardForGC();
+		GObjCurrentPurgeObjectIndexNeedsReset = true;
+		GObjCurrentPurgeObjectIndexResetPastPermanent = false;
+	}
+	// Early out if there is nothing to do.
+	if( !GObjPurgeIsRequired )
+	{
+		return;
+	}
+
+	// Set 'I'm garbage collecting' flag - might be checked inside UObject::Destroy etc.
+	FGCScopeLock GCLock;
+
+	// Incremental purge is now in progress.
+	GObjIncrementalPurgeIsInProgress						= true;
+
+	// Keep track of start time to enforce time limit unless bForceFullPurge is true;
+	const double		StartTime							= FPlatformTime::Seconds();
+	bool		bTimeLimitReached							= false;
+	// Depending on platform FPlatformTime::Seconds might take a noticeable amount of time if called thousands of times so we avoid
+	// enforcing the time limit too often, especially as neither Destroy nor actual deletion should take significant
+	// amounts of time.
+	const int32	TimeLimitEnforcementGranularityForDestroy	= 10;
+	const int32	TimeLimitEnforcementGranularityForDeletion	= 100;
+
+	if( !GObjFinishDestroyHasBeenRoutedToAllObjects && !bTimeLimitReached )
+	{
+		// Try to dispatch all FinishDestroy messages to unreachable objects.  We'll iterate over every
+		// single object and destroy any that are ready to be destroyed.  The objects that aren't yet
+		// ready will be added to a list to be processed afterwards.
+		int32 TimePollCounter = 0;
+		if (GObjCurrentPurgeObjectIndexNeedsReset)
+		{
+			// iterators don't have an op=, so we destroy it and reconstruct it with a placement new
+			// GObjCurrentPurgeObjectIndex	= FRawObjectIterator(GObjCurrentPurgeObjectIndexResetPastPermanent);
+			GObjCurrentPurgeObjectIndex.~FRawObjectIterator();
+			new (&GObjCurrentPurgeObjectIndex) FRawObjectIterator(GObjCurrentPurgeObjectIndexResetPastPermanent);
+			GObjCurrentPurgeObjectIndexNeedsReset = false;
+		}
+
+		while( GObjCurrentPurgeObjectIndex )
+		{
+			FUObjectItem* ObjectItem = *GObjCurrentPurgeObjectIndex;
+			checkSlow(ObjectItem);
+
+			//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
+
+			if (ObjectItem->IsUnreachable())
+			{
+				UObject* Object = static_cast<UObject*>(ObjectItem->Object);
+				// Object should always have had BeginDestroy called on it and never already be destroyed
+				check( Object->HasAnyFlags( RF_BeginDestroyed ) && !Object->HasAnyFlags( RF_FinishDestroyed ) );
+
+				// Only proceed with destroying the object if the asynchronous cleanup started by BeginDestroy has finished.
+				if(Object->IsReadyForFinishDestroy())
+				{
+#if PERF_DETAILED_PER_CLASS_GC_STATS
+					// Keep track of how many objects of a certain class we're purging.
 					const FName& ClassName = Object->GetClass()->GetFName();
 					int32 InstanceCount = GClassToPurgeCountMap.FindRef( ClassName );
 					GClassToPurgeCountMap.Add( ClassName, ++InstanceCount );
@@ -1126,6 +1684,96 @@ static FAutoConsoleVariableRef CVarFlushStreamingOnGC(
 
 bool VerifyClusterAssumptions(UObject* ClusterRootObject);
 
+/**
+ * Unhashes all objects reachability analysis flagged as unreachable and kicks off purging them.
+ *
+ * @param	bPerformFullPurge	if true, perform a full purge right away
+ */
+static void UnhashUnreachableObjectsAndPurge(bool bPerformFullPurge)
+{
+#if WITH_EDITOR
+	if ( GIsEditor && EditorPostReachabilityAnalysisCallback )
+	{
+		EditorPostReachabilityAnalysisCallback();
+	}
+#endif // WITH_EDITOR
+
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "CollectGarbageInternal.UnhashUnreachable" ), STAT_CollectGarbageInternal_UnhashUnreachable, STATGROUP_GC );
+
+		// Unhash all unreachable objects.
+		const double StartTime = FPlatformTime::Seconds();
+		int32 ClustersRemoved = 0;
+		for ( FRawObjectIterator It(true); It; ++It )
+		{
+			//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
+
+			FUObjectItem* ObjectItem = *It;
+			checkSlow(ObjectItem);
+			if (ObjectItem->IsUnreachable())
+			{
+				if ((ObjectItem->GetFlags() & EInternalObjectFlags::ClusterRoot) == EInternalObjectFlags::ClusterRoot)
+				{
+					// Nuke the entire cluster
+					ObjectItem->ClearFlags(EInternalObjectFlags::ClusterRoot|EInternalObjectFlags::NoStrongReference);					
+					const int32 ClusterRootIndex = It.GetIndex();
+					FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
+					checkSlow(Cluster);
+					for (int32 ClusterObjectIndex : Cluster->Objects)
+					{
+						FUObjectItem* ClusterObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ClusterObjectIndex);
+						ClusterObjectItem->ClearFlags(EInternalObjectFlags::NoStrongReference);
+						ClusterObjectItem->SetOwnerIndex(0);
+
+						if (!ClusterObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster))
+						{
+							ClusterObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
+							if (ClusterObjectIndex < ClusterRootIndex)
+							{
+								UObject* ClusterObject = (UObject*)ClusterObjectItem->Object;
+								ClusterObject->ConditionalBeginDestroy();
+							}
+						}
+					}
+					delete Cluster;
+					{
+						FScopeLock ClustersLock(&GUObjectClustersCritical);
+						GUObjectClusters.Remove(ClusterRootIndex);
+					}
+					ClustersRemoved++;
+				}
+
+				// Begin the object's asynchronous destruction.
+				UObject* Object = (UObject*)ObjectItem->Object;
+				Object->ConditionalBeginDestroy();
+			}
+			else if (ObjectItem->IsNoStrongReference())
+			{
+				ObjectItem->ClearNoStrongReference();
+				ObjectItem->SetPendingKill();
+			}
+		}
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects. Clusters removed: %d."), (FPlatformTime::Seconds() - StartTime) * 1000, ClustersRemoved);
+	}
+
+	// Set flag to indicate that we are relying on a purge to be performed.
+	GObjPurgeIsRequired = true;
+	// Reset purged count.
+	GPurgedObjectCountSinceLastMarkPhase = 0;
+
+	// Perform a full purge by not using a time limit for the incremental purge. The Editor always does a full purge.
+	if( bPerformFullPurge || GIsEditor )
+	{
+		IncrementalPurgeGarbage( false );	
+	}
+
+	// Destroy all pending delete linkers
+	DeleteLoaders();
+
+	// Route callbacks to verify GC assumptions
+	FCoreUObjectDelegates::PostGarbageCollect.Broadcast();
+}
+
 /** 
  * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
  *
@@ -1168,6 +1816,17 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 	check( !GObjIncrementalPurgeIsInProgress );
 	check( !GObjPurgeIsRequired );
 
+	// A full reachability analysis supersedes an incremental one that is still in progress
+	if (GIsIncrementalReachabilityPending)
+	{
+		UE_LOG(LogGarbage, Log, TEXT("Aborting incremental reachability analysis"));
+		GIncrementalRealtimeGC.Abort();
+	}
+
+	// Clusters that had references added to them or objects marked pending kill since the last collection are traced object by object from now on
+	const int32 NumDissolvedClusters = DissolvePendingClusters();
+	UE_CLOG(NumDissolvedClusters > 0, LogGarbage, Log, TEXT("Dissolved %d GC clusters"), NumDissolvedClusters);
+
 #if VERIFY_DISREGARD_GC_ASSUMPTIONS
 	FUObjectArray& UObjectArray = GUObjectArray;
 	// Only verify assumptions if option is enabled. This avoids false positives in the Editor or commandlets.
@@ -1242,84 +1901,7 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), (FPlatformTime::Seconds() - StartTime) * 1000 );
 	}
 
-#if WITH_EDITOR
-	if ( GIsEditor && EditorPostReachabilityAnalysisCallback )
-	{
-		EditorPostReachabilityAnalysisCallback();
-	}
-#endif // WITH_EDITOR
-
-	{
-		DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "CollectGarbageInternal.UnhashUnreachable" ), STAT_CollectGarbageInternal_UnhashUnreachable, STATGROUP_GC );
-
-		// Unhash all unreachable objects.
-		const double StartTime = FPlatformTime::Seconds();
-		int32 ClustersRemoved = 0;
-		for ( FRawObjectIterator It(true); It; ++It )
-		{
-			//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
-
-			FUObjectItem* ObjectItem = *It;
-			checkSlow(ObjectItem);
-			if (ObjectItem->IsUnreachable())
-			{
-				if ((ObjectItem->GetFlags() & EInternalObjectFlags::ClusterRoot) == EInternalObjectFlags::ClusterRoot)
-				{
-					// Nuke the entire cluster
-					ObjectItem->ClearFlags(EInternalObjectFlags::ClusterRoot|EInternalObjectFlags::NoStrongReference);					
-					const int32 ClusterRootIndex = It.GetIndex();
-					FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
-					checkSlow(Cluster);
-					for (int32 ClusterObjectIndex : Cluster->Objects)
-					{
-						FUObjectItem* ClusterObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ClusterObjectIndex);
-						ClusterObjectItem->ClearFlags(EInternalObjectFlags::NoStrongReference);
-						ClusterObjectItem->SetOwnerIndex(0);
-
-						if (!ClusterObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster))
-						{
-							ClusterObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
-							if (ClusterObjectIndex < ClusterRootIndex)
-							{
-								UObject* ClusterObject = (UObject*)ClusterObjectItem->Object;
-								ClusterObject->ConditionalBeginDestroy();
-							}
-						}
-					}
-					delete Cluster;
-					GUObjectClusters.Remove(ClusterRootIndex);
-					ClustersRemoved++;
-				}
-
-				// Begin the object's asynchronous destruction.
-				UObject* Object = (UObject*)ObjectItem->Object;
-				Object->ConditionalBeginDestroy();
-			}
-			else if (ObjectItem->IsNoStrongReference())
-			{
-				ObjectItem->ClearNoStrongReference();
-				ObjectItem->SetPendingKill();
-			}
-		}
-		UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects. Clusters removed: %d."), (FPlatformTime::Seconds() - StartTime) * 1000, ClustersRemoved);
-	}
-
-	// Set flag to indicate that we are relying on a purge to be performed.
-	GObjPurgeIsRequired = true;
-	// Reset purged count.
-	GPurgedObjectCountSinceLastMarkPhase = 0;
-
-	// Perform a full purge by not using a time limit for the incremental purge. The Editor always does a full purge.
-	if( bPerformFullPurge || GIsEditor )
-	{
-		IncrementalPurgeGarbage( false );	
-	}
-
-	// Destroy all pending delete linkers
-	DeleteLoaders();
-
-	// Route callbacks to verify GC assumptions
-	FCoreUObjectDelegates::PostGarbageCollect.Broadcast();
+	UnhashUnreachableObjectsAndPurge(bPerformFullPurge);
 
 	STAT_ADD_CUSTOMMESSAGE_NAME( STAT_NamedMarker, TEXT( "GarbageCollection - End" ) );
 }
@@ -1365,6 +1947,93 @@ bool TryCollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge)
 	return bCanRunGC;
 }
 
+/**
+ * Performs one step of incremental reachability analysis, starting it if necessary, and once marking is done unhashes
+ * unreachable objects the same way CollectGarbageInternal does.
+ *
+ * @param	KeepFlags	objects with those flags will be kept regardless of being referenced or not, only used when starting
+ * @return	true if garbage collection completed
+ */
+static bool CollectGarbageIncrementalInternal(EObjectFlags KeepFlags)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "CollectGarbageIncrementalInternal" ), STAT_CollectGarbageIncrementalInternal, STATGROUP_GC );
+
+	// We can't collect garbage while there's a load in progress. E.g. one potential issue is Import.XObject
+	check(!IsLoading());
+
+	const double StartTime = FPlatformTime::Seconds();
+	bool bMarkingFinished = false;
+	{
+		FGCScopeLock GCLock;
+
+		if (!GIsIncrementalReachabilityPending)
+		{
+			// Reset GC skip counter
+			GNumAttemptsSinceLastGC = 0;
+
+			// RF_Unreachable can't change on any objects while a purge is pending
+			if( GObjIncrementalPurgeIsInProgress || GObjPurgeIsRequired )
+			{
+				IncrementalPurgeGarbage( false );
+			}
+
+			UE_LOG(LogGarbage, Log, TEXT("Starting incremental reachability analysis"));
+			GIncrementalRealtimeGC.Start(KeepFlags);
+		}
+
+		bMarkingFinished = GIncrementalRealtimeGC.Step(StartTime + GIncrementalReachabilityTimeLimit);
+	}
+
+	// Async loading may still need objects nothing references yet (Import.XObject), so keep marking until it's done.
+	if (!bMarkingFinished || IsAsyncLoading())
+	{
+		return false;
+	}
+
+	STAT_ADD_CUSTOMMESSAGE_NAME( STAT_NamedMarker, TEXT( "GarbageCollection - Begin" ) );
+
+	FCoreUObjectDelegates::PreGarbageCollect.Broadcast();
+	GLastGCFrame = GFrameCounter;
+
+	FGCScopeLock GCLock;
+
+	{
+		const double FinishStartTime = FPlatformTime::Seconds();
+		GIncrementalRealtimeGC.Finish();
+		UE_LOG(LogGarbage, Log, TEXT("%f ms to finish incremental reachability analysis"), (FPlatformTime::Seconds() - FinishStartTime) * 1000 );
+	}
+
+	UnhashUnreachableObjectsAndPurge(false);
+
+	STAT_ADD_CUSTOMMESSAGE_NAME( STAT_NamedMarker, TEXT( "GarbageCollection - End" ) );
+
+	return true;
+}
+
+bool TryCollectGarbageIncremental(EObjectFlags KeepFlags)
+{
+	// Carry on with a pass that is already in progress even if the console variable has been turned off since
+	if (!GIncrementalReachability && !GIsIncrementalReachabilityPending)
+	{
+		return TryCollectGarbage(KeepFlags, false);
+	}
+
+	// No other thread may be performing UObject operations while we're running. Unlike TryCollectGarbage this never
+	// forces the lock, a skipped step simply happens next time.
+	if (!GGarbageCollectionGuardCritical.TryGCLock())
+	{
+		GNumAttemptsSinceLastGC++;
+		return false;
+	}
+
+	const bool bCollected = CollectGarbageIncrementalInternal(KeepFlags);
+
+	// Other threads are free to use UObjects
+	GGarbageCollectionGuardCritical.GCUnlock();
+
+	return bCollected;
+}
+
 
 /**
  * Helper function to add referenced objects via serialization
@@ -721,6 +721,8 @@ FLinkerLoad::FLinkerLoad(UPackage* InParent, const TCHAR* InFilename, uint32 InL
 , bHaveImportsBeenVerified(false)
 , bDynamicClassLinker(false)
 , Loader(nullptr)
+, PendingPrecacheOffset(INDEX_NONE)
+, PendingPrecacheSize(0)
 , AsyncRoot(nullptr)
 , NameMapIndex(0)
 , GatherableTextDataMapIndex(0)
@@ -961,7 +963,7 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::CreateLoader()
 		int32 PrecacheSize = FMath::Min( MinimumReadSize, Loader->TotalSize() );
 		check( PrecacheSize > 0 );
 		// Wait till we're finished precaching before executing the next step.
-		bExecuteNextStep = Loader->Precache( 0, PrecacheSize);
+		bExecuteNextStep = Precache( 0, PrecacheSize);
 	}
 
 	return (bExecuteNextStep && !IsTimeLimitExceeded( TEXT("creating loader") )) ? LINKER_Loaded : LINKER_TimedOut;
@@ -1190,6 +1192,15 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::SerializePackageFileSummary()
 #endif
 		}
 		
+		// Tagged properties of packages cooked with unversioned properties are read without tags. Only cooked builds can load
+		// them, the layout leaves out editor-only properties that an editor's classes still have.
+		ArUseUnversionedPropertySerialization = (Summary.PackageFlags & PKG_UnversionedProperties) != 0;
+		if (ArUseUnversionedPropertySerialization && (!(Summary.PackageFlags & PKG_FilterEditorOnly) || !FPlatformProperties::RequiresCookedData()))
+		{
+			UE_LOG(LogLinker, Error, TEXT("Unable to load package (%s). It was cooked with unversioned properties, which only cooked builds can load."), *Filename);
+			return LINKER_Failed;
+		}
+
 		// Propagate fact that package cannot use lazy loading to archive (aka this).
 		if( (Summary.PackageFlags & PKG_DisallowLazyLoading) )
 		{
@@ -1234,7 +1245,7 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::SerializeNameMap()
 		if( Summary.TotalHeaderSize > 0 )
 		{
 			// Precache name, import and export map.
-			bFinishedPrecaching = Loader->Precache( Summary.NameOffset, Summary.TotalHeaderSize - Summary.NameOffset );
+			bFinishedPrecaching = Precache( Summary.NameOffset, Summary.TotalHeaderSize - Summary.NameOffset );
 		}
 		// Backward compat code for VER_MOVED_EXPORTIMPORTMAPS_ADDED_TOTALHEADERSIZE.
 		else
@@ -3094,6 +3105,194 @@ UObject* FLinkerLoad::Create( UClass* ObjectClass, FName ObjectName, UObject* Ou
 	return NULL;
 }
 
+/**
+ * Reads an export from a copy of its data, for serializing it on a worker thread. References resolve to the objects
+ * the linker has already created, and reads outside the export (bulk data stored at the end of the package) go to a
+ * file reader of its own. Never calls into the linker, which belongs to the loading thread.
+ */
+class FExportSerializeArchive : public FArchiveUObject
+{
+public:
+	FExportSerializeArchive(FLinkerLoad& InLinker, int64 InOffset, TArray<uint8>& InData)
+		: Linker(InLinker)
+		, Offset(InOffset)
+		, Pos(InOffset)
+		, FileSize(InLinker.TotalSize())
+		, FileReader(nullptr)
+		, bReadingFile(false)
+	{
+		FArchive::operator=(InLinker);
+		Data = MoveTemp(InData);
+
+		// Bulk data can't be attached to the linker from a worker, so it's loaded along with the export
+		ArAllowLazyLoading = false;
+	}
+
+	virtual ~FExportSerializeArchive()
+	{
+		delete FileReader;
+	}
+
+	// FArchive interface.
+	virtual void Serialize(void* V, int64 Length) override
+	{
+		if (bReadingFile)
+		{
+			FileReader->Serialize(V, Length);
+		}
+		else if (Pos + Length <= Offset + Data.Num())
+		{
+			FMemory::Memcpy(V, Data.GetData() + (Pos - Offset), Length);
+		}
+		else
+		{
+			UE_LOG(LogLinker, Error, TEXT("%s: Read past the end of an export at %lld, export ends at %lld"), *Linker.Filename, Pos + Length, Offset + Data.Num());
+			FMemory::Memzero(V, Length);
+			ArIsError = true;
+		}
+		Pos += Length;
+	}
+
+	virtual void Seek(int64 InPos) override
+	{
+		bReadingFile = InPos < Offset || InPos > Offset + Data.Num();
+		if (bReadingFile)
+		{
+			if (!FileReader)
+			{
+				FileReader = IFileManager::Get().CreateFileReader(*Linker.Filename);
+				if (!FileReader)
+				{
+					UE_LOG(LogLinker, Fatal, TEXT("%s: Failed to open the package to read outside of an export"), *Linker.Filename);
+				}
+			}
+			FileReader->Seek(InPos);
+		}
+		Pos = InPos;
+	}
+
+	virtual int64 Tell() override
+	{
+		return Pos;
+	}
+
+	virtual int64 TotalSize() override
+	{
+		return FileSize;
+	}
+
+	virtual FArchive& operator<<(UObject*& Object) override
+	{
+		FPackageIndex Index;
+		FArchive& Ar = *this;
+		Ar << Index;
+
+		if (Index.IsExport())
+		{
+			check(Linker.ExportMap.IsValidIndex(Index.ToExport()));
+			Object = Linker.ExportMap[Index.ToExport()].Object;
+		}
+		else if (Index.IsImport())
+		{
+			check(Linker.ImportMap.IsValidIndex(Index.ToImport()));
+			Object = Linker.ImportMap[Index.ToImport()].XObject;
+		}
+		else
+		{
+			Object = nullptr;
+		}
+		return *this;
+	}
+
+	virtual FArchive& operator<<(FLazyObjectPtr& LazyObjectPtr) override
+	{
+		FArchive& Ar = *this;
+		FUniqueObjectGuid ID;
+		Ar << ID;
+		LazyObjectPtr = ID;
+		return Ar;
+	}
+
+	virtual FArchive& operator<<(FAssetPtr& AssetPtr) override
+	{
+		FArchive& Ar = *this;
+		FStringAssetReference ID;
+		ID.Serialize(Ar);
+		AssetPtr = ID;
+		return Ar;
+	}
+
+	virtual FArchive& operator<<(FName& Name) override
+	{
+		NAME_INDEX NameIndex;
+		int32 Number;
+		FArchive& Ar = *this;
+		Ar << NameIndex;
+		Ar << Number;
+
+		if (!Linker.NameMap.IsValidIndex(NameIndex))
+		{
+			UE_LOG(LogLinker, Fatal, TEXT("Bad name index %i/%i"), NameIndex, Linker.NameMap.Num());
+		}
+
+		const FName& MappedName = Linker.NameMap[NameIndex];
+		Name = MappedName.IsNone() ? NAME_None : FName(MappedName, Number);
+		return *this;
+	}
+
+	virtual void Preload(UObject* Object) override
+	{
+		// Loading anything else would go through the linker
+		ensureMsgf(!Object || !Object->HasAnyFlags(RF_NeedLoad), TEXT("%s can't be preloaded while serializing an export on a worker thread"), *Object->GetFullName());
+	}
+
+	virtual FString GetArchiveName() const override
+	{
+		return Linker.Filename;
+	}
+
+private:
+	FLinkerLoad& Linker;
+	/** Where in the package the export's data starts */
+	int64 Offset;
+	/** Position in the package */
+	int64 Pos;
+	int64 FileSize;
+	TArray<uint8> Data;
+	/** Opened the first time something seeks outside of the export */
+	FArchive* FileReader;
+	bool bReadingFile;
+};
+
+/** Serializes an object PreloadOnWorkerThread handed to a worker. */
+class FExportSerializeTask : public FNonAbandonableTask
+{
+public:
+	UObject* Object;
+	FExportSerializeArchive Archive;
+
+	FExportSerializeTask(FLinkerLoad* Linker, UObject* InObject, TArray<uint8>* Data)
+		: Object(InObject)
+		, Archive(*Linker, Linker->ExportMap[InObject->GetLinkerIndex()].SerialOffset, *Data)
+	{
+	}
+
+	void DoWork()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_LinkerSerialize);
+		FUObjectThreadContext& ThreadContext = FUObjectThreadContext::Get();
+		UObject* PrevSerializedObject = ThreadContext.SerializedObject;
+		ThreadContext.SerializedObject = Object;
+		Object->Serialize(Archive);
+		ThreadContext.SerializedObject = PrevSerializedObject;
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FExportSerializeTask, STATGROUP_ThreadPoolAsyncTasks);
+	}
+};
+
 /**
  * Serialize the object data for the specified object from the unreal package file.  Loads any
  * additional resources required for the object to be in a valid state to receive the loaded
@@ -3115,6 +3314,12 @@ void FLinkerLoad::Preload( UObject* Object )
 	//check(IsValidLowLevel());
 	check(Object);
 
+	// An object a worker is serializing has to be finished before anyone gets to look at it
+	if (WorkerPreloads.Num() > 0)
+	{
+		WaitForWorkerPreload(Object);
+	}
+
 #if USE_CIRCULAR_DEPENDENCY_LOAD_DEFERRING
 	bool const bIsNonNativeObject = !Object->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn);
 	// we can determine that this is a blueprint class/struct by checking if it 
@@ -3404,6 +3609,86 @@ void FLinkerLoad::Preload( UObject* Object )
 	}
 }
 
+bool FLinkerLoad::PreloadOnWorkerThread( UObject* Object )
+{
+	check(Object);
+
+	// Classes, archetypes and default objects are preloaded in order and by whatever needs them first. Cooked data is
+	// required because loading editor data does editor only work, and compressed packages don't map to file offsets.
+	if (!FPlatformProperties::RequiresCookedData() || !GThreadPool || Summary.CompressedChunks.Num() > 0 || Object->GetLinker() != this ||
+		!Object->HasAnyFlags(RF_NeedLoad) || Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) ||
+		!Object->GetClass()->HasAnyClassFlags(CLASS_Native) || !Object->IsSerializeThreadSafe())
+	{
+		return false;
+	}
+
+	const FObjectExport& Export = ExportMap[Object->GetLinkerIndex()];
+	check(Export.Object == Object);
+
+	// The precache buffers are reused by the next precache, so the worker gets a copy of the export's data
+	TArray<uint8> Data;
+	Data.AddUninitialized(Export.SerialSize);
+	{
+		SCOPE_CYCLE_COUNTER(STAT_LinkerPrecache);
+		Loader->Precache(Export.SerialOffset, Export.SerialSize);
+	}
+	const int64 SavedPos = Loader->Tell();
+	Loader->Seek(Export.SerialOffset);
+	Loader->Serialize(Data.GetData(), Data.Num());
+	Loader->Seek(SavedPos);
+
+	// Same as Preload, so nothing else tries to load the object meanwhile
+	Object->ClearFlags(RF_NeedLoad);
+
+	FAsyncTask<FExportSerializeTask>* Task = new FAsyncTask<FExportSerializeTask>(this, Object, &Data);
+	Task->StartBackgroundTask();
+	WorkerPreloads.Add(Object, Task);
+	return true;
+}
+
+void FLinkerLoad::WaitForWorkerPreloads()
+{
+	for (auto& WorkerPreload : WorkerPreloads)
+	{
+		FinishWorkerPreload(WorkerPreload.Value);
+	}
+	WorkerPreloads.Empty();
+}
+
+void FLinkerLoad::WaitForWorkerPreload(UObject* Object)
+{
+	FAsyncTask<FExportSerializeTask>* Task = nullptr;
+	if (WorkerPreloads.RemoveAndCopyValue(Object, Task))
+	{
+		FinishWorkerPreload(Task);
+	}
+}
+
+void FLinkerLoad::FinishWorkerPreload(FAsyncTask<FExportSerializeTask>* Task)
+{
+	Task->EnsureCompletion();
+
+	UObject* Object = Task->GetTask().Object;
+	const FObjectExport& Export = ExportMap[Object->GetLinkerIndex()];
+	Object->SetFlags(RF_LoadCompleted);
+
+	// Make sure we serialized the right amount of stuff.
+	const int64 SerializedSize = Task->GetTask().Archive.Tell() - Export.SerialOffset;
+	if (SerializedSize != Export.SerialSize)
+	{
+		if (Object->GetClass()->HasAnyClassFlags(CLASS_Deprecated))
+		{
+			UE_LOG(LogLinker, Warning, TEXT("%s"), *FString::Printf(TEXT("%s: Serial size mismatch: Got %d, Expected %d"), *Object->GetFullName(), (int32)SerializedSize, Export.SerialSize));
+		}
+		else
+		{
+			UE_LOG(LogLinker, Fatal, TEXT("%s"), *FString::Printf(TEXT("%s: Serial size mismatch: Got %d, Expected %d"), *Object->GetFullName(), (int32)SerializedSize, Export.SerialSize));
+		}
+	}
+
+	delete Task;
+}
+
 /**
  * Builds a string containing the full path for a resource in the export table.
  *
@@ -4178,6 +4463,9 @@ void FLinkerLoad::LoadAndDetachAllBulkData()
 
 void FLinkerLoad::Detach()
 {
+	// Workers may still be writing to exports
+	WaitForWorkerPreloads();
+
 #if WITH_EDITOR
 	// Detach all lazy loaders.
 	const bool bEnsureAllBulkDataIsLoaded = false;
@@ -4294,7 +4582,16 @@ void FLinkerLoad::DetachAllBulkData(bool bEnsureAllBulkDataIsLoaded)
  */
 bool FLinkerLoad::Precache( int64 PrecacheOffset, int64 PrecacheSize )
 {
-	return bDynamicClassLinker || Loader->Precache(PrecacheOffset, PrecacheSize);
+	const bool bIsPrecached = bDynamicClassLinker || Loader->Precache(PrecacheOffset, PrecacheSize);
+	PendingPrecacheOffset = bIsPrecached ? INDEX_NONE : PrecacheOffset;
+	PendingPrecacheSize = PrecacheSize;
+	return bIsPrecached;
+}
+
+bool FLinkerLoad::IsPrecachePending()
+{
+	// Asking again is cheap while the read is in flight, and issues the next read if the region needs more than one
+	return PendingPrecacheOffset != INDEX_NONE && !Precache(PendingPrecacheOffset, PendingPrecacheSize);
 }
 
 void FLinkerLoad::Seek( int64 InPos )
@@ -14,8 +14,9 @@ void UByteProperty::SerializeItem( FArchive& Ar, void* Value, void const* Defaul
 		 return;
 	}
 
-	// Serialize enum values by name unless we're not saving or loading OR for backwards compatibility
-	const bool bUseBinarySerialization = (Enum == NULL) || (!Ar.IsLoading() && !Ar.IsSaving());
+	// Serialize enum values by name unless we're not saving or loading OR for backwards compatibility. Unversioned
+	// properties are only loaded by the code that saved them, so their enums can't have changed either.
+	const bool bUseBinarySerialization = (Enum == NULL) || (!Ar.IsLoading() && !Ar.IsSaving()) || Ar.UseUnversionedPropertySerialization();
 	if( bUseBinarySerialization )
 	{
 		Super::SerializeItem(Ar, Value, Defaults);
@@ -3475,6 +3475,9 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 
 				bool bSaveUnversioned = !!(SaveFlags & SAVE_Unversioned);
 
+				/** If true, tagged properties are saved without tags, which only cooked builds whose code matches ours can load. */
+				const bool bSaveUnversionedProperties = bIsCooking && FilterEditorOnly && (!!(SaveFlags & SAVE_UnversionedProperties) || FParse::Param(FCommandLine::Get(), TEXT("UnversionedProperties")));
+
 				FLinkerSave* Linker = nullptr;
 				
 #if WITH_EDITOR
@@ -3521,6 +3524,7 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 				Linker->SetPortFlags(ComparisonFlags);
 				Linker->SetFilterEditorOnly( FilterEditorOnly );
 				Linker->SetCookingTarget(TargetPlatform);
+				Linker->SetUseUnversionedPropertySerialization(bSaveUnversionedProperties);
 
 				// Make sure the package has the same version as the linker
 				InOuter->LinkerPackageVersion = Linker->UE4Ver();
@@ -4652,7 +4656,11 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 				Linker->LinkerRoot->ThisRequiresLocalizationGather(Linker->RequiresLocalizationGather());
 				
 				// Update package flags from package, in case serialization has modified package flags.
-				Linker->Summary.PackageFlags = Linker->LinkerRoot->GetPackageFlags() & ~PKG_NewlyCreated;
+				Linker->Summary.PackageFlags = Linker->LinkerRoot->GetPackageFlags() & ~(PKG_NewlyCreated | PKG_UnversionedProperties);
+				if (Linker->UseUnversionedPropertySerialization())
+				{
+					Linker->Summary.PackageFlags |= PKG_UnversionedProperties;
+				}
 
 				Linker->Seek(0);
 				*Linker << Linker->Summary;
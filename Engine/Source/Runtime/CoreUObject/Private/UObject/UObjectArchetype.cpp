@@ -20,10 +20,8 @@ UObject* UObject::GetArchetypeFromRequiredInfo(UClass* Class, UObject* Outer, FN
 		if (Outer
 			&& Outer->GetClass() != UPackage::StaticClass()) // packages cannot have subobjects
 		{
-			// Get a lock on the UObject hash tables for the duration of the GetArchetype operation
-			void LockUObjectHashTables();
-			LockUObjectHashTables();
-
+			// Each lookup locks only the part of the UObject hash tables it reads. Locking all of them for the whole
+			// operation would stall every other thread that constructs or finds objects.
 			UObject* ArchetypeToSearch = Outer->GetArchetype();
 			UObject* MyArchetype = static_cast<UObject*>(FindObjectWithOuter(ArchetypeToSearch, Class, Name));
 			if (MyArchetype)
@@ -47,9 +45,6 @@ UObject* UObject::GetArchetypeFromRequiredInfo(UClass* Class, UObject* Outer, FN
 			{
 				Result = ArchetypeToSearch->GetClass()->FindArchetype(Class, Name);
 			}
-
-			void UnlockUObjectHashTables();
-			UnlockUObjectHashTables();
 		}
 
 		if (!Result)
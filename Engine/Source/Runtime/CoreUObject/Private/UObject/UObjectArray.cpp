@@ -9,6 +9,7 @@
 DEFINE_LOG_CATEGORY_STATIC(LogUObjectArray, Log, All);
 
 TMap<int32, FUObjectCluster*> GUObjectClusters;
+FCriticalSection GUObjectClustersCritical;
 
 FUObjectArray::FUObjectArray()
 : ObjFirstGCIndex(0)
@@ -27,6 +27,25 @@ static FAutoConsoleVariableRef CMergeGCClusters(
 	ECVF_Default
 	);
 
+COREUOBJECT_API int32 GAssetClusteringEnabled = 1;
+static FAutoConsoleVariableRef CAssetClusteringEnabled(
+	TEXT("gc.AssetClustering"),
+	GAssetClusteringEnabled,
+	TEXT("If true, static meshes, textures and sound waves will create GC clusters when loaded, not only materials and particle systems."),
+	ECVF_Default
+	);
+
+COREUOBJECT_API int32 GActorClusteringEnabled = 1;
+static FAutoConsoleVariableRef CActorClusteringEnabled(
+	TEXT("gc.ActorClustering"),
+	GActorClusteringEnabled,
+	TEXT("If true, the static, non-replicated actors of a level that opted in with bCanBeInCluster will be put into one GC cluster when the level is loaded."),
+	ECVF_Default
+	);
+
+/** Set when at least one cluster has been flagged with bNeedsDissolving, so the garbage collector doesn't have to look at every cluster */
+static bool GClustersNeedDissolving = false;
+
 #if !UE_BUILD_SHIPPING
 
 // Dumps all clusters to log.
@@ -37,6 +56,7 @@ static void ListClusters(const TArray<FString>& Args)
 	int32 TotalInterClusterReferences = 0;
 	int32 MaxClusterSize = 0;
 	int32 TotalClusterObjects = 0;	
+	FScopeLock ClustersLock(&GUObjectClustersCritical);
 	for (TPair<int32, FUObjectCluster*>& Pair : GUObjectClusters)
 	{
 		FUObjectItem* RootItem = GUObjectArray.IndexToObjectUnsafeForGC(Pair.Key);
@@ -233,14 +253,23 @@ class FClusterReferenceProcessor
 {
 	int32 ClusterRootIndex;
 	FUObjectCluster& Cluster;
+	/** If set, only objects from this package can be added to the cluster */
+	UPackage* ClusterPackage;
 	volatile bool bIsRunningMultithreaded;
 public:
 
 	FClusterReferenceProcessor(int32 InClusterRootIndex, FUObjectCluster& InCluster)
 		: ClusterRootIndex(InClusterRootIndex)
 		, Cluster(InCluster)
+		, ClusterPackage(nullptr)
 		, bIsRunningMultithreaded(false)
-	{}
+	{
+		UObject* ClusterRoot = static_cast<UObject*>(GUObjectArray.IndexToObjectUnsafeForGC(ClusterRootIndex)->Object);
+		if (!ClusterRoot->CanClusterObjectsFromOtherPackages())
+		{
+			ClusterPackage = ClusterRoot->GetOutermost();
+		}
+	}
 
 	FORCEINLINE int32 GetMinDesiredObjectsPerSubTask() const
 	{
@@ -366,7 +395,7 @@ public:
 			{
 				if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) || ObjectItem->GetOwnerIndex() != 0)
 				{					
-					if (GMergeGCClusters)
+					if (GMergeGCClusters && !ClusterPackage)
 					{
 						// This is an existing cluster, merge it with the current one.
 						MergeCluster(ObjectItem, Object, ObjectsToSerialize);
@@ -388,11 +417,13 @@ public:
 					}
 				}
 				}
-				else if (ObjectItem->GetOwnerIndex() == 0 && !ObjectItem->IsRootSet() && !GUObjectArray.IsDisregardForGC(Object) &&
-					!(Object->CanBeClusterRoot() && Object->HasAnyFlags(RF_NeedLoad|RF_NeedPostLoad))) // Objects that can create clusters themselves and haven't been postloaded yet should be excluded
+				else if (ObjectItem->GetOwnerIndex() == 0 && !ObjectItem->IsRootSet() && !GUObjectArray.IsDisregardForGC(Object))
 				{
 					// New object, add it to the cluster.
-					if (Object->CanBeInCluster())
+					// Objects that can create clusters themselves and haven't been postloaded yet, and objects from other packages
+					// when the cluster root doesn't want them, are only referenced. They will be traced like any other object.
+					if (Object->CanBeInCluster() && !(Object->CanBeClusterRoot() && Object->HasAnyFlags(RF_NeedLoad|RF_NeedPostLoad)) &&
+						(!ClusterPackage || Object->GetOutermost() == ClusterPackage))
 					{
 					AddObjectToCluster(GUObjectArray.ObjectToIndex(Object), ObjectItem, Object, ObjectsToSerialize, true);
 				}
@@ -443,6 +474,127 @@ public:
 	}
 };
 
+void MarkClusterForDissolving(int32 ObjectIndex)
+{
+	FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+	const int32 ClusterRootIndex = ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) ? ObjectIndex : ObjectItem->GetOwnerIndex();
+	if (ClusterRootIndex != 0)
+	{
+		FScopeLock ClustersLock(&GUObjectClustersCritical);
+		FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
+		Cluster->bNeedsDissolving = true;
+		GClustersNeedDissolving = true;
+	}
+}
+
+void GCClusterWriteBarrier(const UObjectBase* ReferencingObject, const UObjectBase* Object)
+{
+	GCWriteBarrier(Object);
+
+	if (!ReferencingObject || !Object)
+	{
+		return;
+	}
+
+	// Components and assets can be changed from worker threads while clusters are created or dissolved on the game thread
+	FScopeLock ClustersLock(&GUObjectClustersCritical);
+	if (!GUObjectClusters.Num())
+	{
+		return;
+	}
+
+	const int32 ReferencingObjectIndex = GUObjectArray.ObjectToIndex(ReferencingObject);
+	FUObjectItem* ReferencingObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ReferencingObjectIndex);
+	const int32 ClusterRootIndex = ReferencingObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) ? ReferencingObjectIndex : ReferencingObjectItem->GetOwnerIndex();
+	if (ClusterRootIndex == 0)
+	{
+		return;
+	}
+
+	FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
+	if (Cluster->bNeedsDissolving || GUObjectArray.IsDisregardForGC(Object))
+	{
+		return;
+	}
+
+	// References to objects the cluster already keeps alive are fine, anything else would not be seen by the garbage collector
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+	FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+	const int32 ObjectClusterRootIndex = ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) ? ObjectIndex : ObjectItem->GetOwnerIndex();
+	if (ObjectClusterRootIndex != 0 && (ObjectClusterRootIndex == ClusterRootIndex || Cluster->ReferencedClusters.Contains(ObjectClusterRootIndex)))
+	{
+		return;
+	}
+	if (Cluster->MutableObjects.Contains(ObjectIndex))
+	{
+		return;
+	}
+
+	UE_LOG(LogObj, Verbose, TEXT("%s started referencing %s, dissolving its GC cluster"),
+		*static_cast<const UObject*>(ReferencingObject)->GetFullName(), *static_cast<const UObject*>(Object)->GetFullName());
+	Cluster->bNeedsDissolving = true;
+	GClustersNeedDissolving = true;
+}
+
+/**
+ * Turns the objects of a cluster back into regular objects. Clusters referencing this one from then on reference
+ * its former objects as mutable objects.
+ */
+static void DissolveCluster(int32 ClusterRootIndex)
+{
+	FUObjectCluster* Cluster = nullptr;
+	if (!GUObjectClusters.RemoveAndCopyValue(ClusterRootIndex, Cluster))
+	{
+		return;
+	}
+
+	FUObjectItem* RootItem = GUObjectArray.IndexToObjectUnsafeForGC(ClusterRootIndex);
+	RootItem->ClearFlags(EInternalObjectFlags::ClusterRoot);
+	for (int32 ClusterObjectIndex : Cluster->Objects)
+	{
+		FUObjectItem* ClusterObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ClusterObjectIndex);
+		check(ClusterObjectItem->GetOwnerIndex() == ClusterRootIndex);
+		ClusterObjectItem->SetOwnerIndex(0);
+	}
+
+	for (TPair<int32, FUObjectCluster*>& Pair : GUObjectClusters)
+	{
+		FUObjectCluster* ReferencingCluster = Pair.Value;
+		if (ReferencingCluster->ReferencedClusters.Remove(ClusterRootIndex))
+		{
+			ReferencingCluster->MutableObjects.Add(ClusterRootIndex);
+			ReferencingCluster->MutableObjects.Append(Cluster->Objects);
+		}
+	}
+
+	delete Cluster;
+}
+
+/** Dissolves all clusters flagged by MarkClusterForDissolving or GCClusterWriteBarrier, called by the garbage collector before reachability analysis */
+int32 DissolvePendingClusters()
+{
+	FScopeLock ClustersLock(&GUObjectClustersCritical);
+	if (!GClustersNeedDissolving)
+	{
+		return 0;
+	}
+	GClustersNeedDissolving = false;
+
+	TArray<int32> ClustersToDissolve;
+	for (TPair<int32, FUObjectCluster*>& Pair : GUObjectClusters)
+	{
+		if (Pair.Value->bNeedsDissolving)
+		{
+			ClustersToDissolve.Add(Pair.Key);
+		}
+	}
+	for (int32 ClusterRootIndex : ClustersToDissolve)
+	{
+		DissolveCluster(ClusterRootIndex);
+	}
+	return ClustersToDissolve.Num();
+}
+
 /** Looks through objects loaded with a package and creates clusters from them */
 void CreateClustersFromPackage(FLinkerLoad* PackageLinker)
 {	
@@ -477,6 +629,7 @@ void UObjectBaseUtility::AddToCluster(UObjectBaseUtility* ClusterRootOrObjectFro
 	}
 	if (ClusterRootIndex != 0)
 	{
+		FScopeLock ClustersLock(&GUObjectClustersCritical);
 		FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
 		FClusterReferenceProcessor Processor(ClusterRootIndex, *Cluster);			
 		TFastReferenceCollector<FClusterReferenceProcessor, TClusterCollector<FClusterReferenceProcessor>, FClusterArrayPool, true> ReferenceCollector(Processor, FClusterArrayPool::Get());
@@ -508,6 +661,9 @@ void UObjectBaseUtility::CreateCluster()
 	// If we haven't finished loading, we can't be sure we know all the references
 	check(!HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad));
 
+	// Collecting references can merge other clusters into this one
+	FScopeLock ClustersLock(&GUObjectClustersCritical);
+
 	// Create a new cluster, reserve an arbitrary amount of memory for it.
 	FUObjectCluster* Cluster = new FUObjectCluster;
 	Cluster->Objects.Reserve(64);
@@ -628,8 +784,9 @@ public:
 			FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(Object);
 			if (ObjectItem->GetOwnerIndex() == 0)
 			{
-				// We are allowed to reference other clusters, root set objects and objects from diregard for GC pool
-				if (!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot|EInternalObjectFlags::RootSet) && !GUObjectArray.IsDisregardForGC(Object) && Object->CanBeInCluster())
+				// We are allowed to reference other clusters, root set objects, objects from diregard for GC pool and objects the cluster keeps as mutable
+				if (!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot|EInternalObjectFlags::RootSet) && !GUObjectArray.IsDisregardForGC(Object) && Object->CanBeInCluster() &&
+					!Cluster.MutableObjects.Contains(GUObjectArray.ObjectToIndex(Object)))
 				{
 					UE_LOG(LogObj, Warning, TEXT("Object %s from cluster %s is referencing 0x%016llx %s which is not part of root set or cluster."),
 						*ReferencingObject->GetFullName(),
@@ -645,7 +802,7 @@ public:
 				{
 					// However, clusters need to be referenced by the current cluster otherwise they can also get GC'd too early.
 					const int32 OtherClusterRootIndex = GUObjectArray.ObjectToIndex(Object);
-					UE_CLOG(OtherClusterRootIndex != ClusterRootIndex && !Cluster.ReferencedClusters.Contains(OtherClusterRootIndex), LogObj, Fatal,
+					UE_CLOG(OtherClusterRootIndex != ClusterRootIndex && !Cluster.ReferencedClusters.Contains(OtherClusterRootIndex) && !Cluster.MutableObjects.Contains(OtherClusterRootIndex), LogObj, Fatal,
 						TEXT("Object %s from source cluster %s is referencing cluster root object 0x%016llx %s which is not referenced by the source cluster."),
 						*ReferencingObject->GetFullName(),
 						*ClusterRootObject->GetFullName(),
@@ -665,7 +822,7 @@ public:
 				const FUObjectItem* OtherClusterRootItem = GUObjectArray.IndexToObjectUnsafeForGC(OtherClusterRootIndex);				
 				check(OtherClusterRootItem && OtherClusterRootItem->Object);
 				UObject* OtherClusterRootObject = static_cast<UObject*>(OtherClusterRootItem->Object);
-				UE_CLOG(OtherClusterRootIndex != ClusterRootIndex && !Cluster.ReferencedClusters.Contains(OtherClusterRootIndex), LogObj, Fatal,
+				UE_CLOG(OtherClusterRootIndex != ClusterRootIndex && !Cluster.ReferencedClusters.Contains(OtherClusterRootIndex) && !Cluster.MutableObjects.Contains(GUObjectArray.ObjectToIndex(Object)), LogObj, Fatal,
 					TEXT("Object %s from source cluster %s is referencing cluster %d object 0x%016llx %s which is not referenced by the source cluster."),
 					*ReferencingObject->GetFullName(),
 					*ClusterRootObject->GetFullName(),
@@ -213,12 +213,22 @@ struct FHashBucketIterator
 	}
 };
 
-class FUObjectHashTables
+/**
+ * The number of shards the hash tables are split into, so that threads looking objects up don't wait for threads
+ * creating unrelated ones.
+ *
+ * NOTE: This must be power of 2 so that (size - 1) turns on all bits!
+ */
+#define OBJECT_HASH_SHARDS 32
+
+/**
+ * One shard of the hash tables, with its own lock. Every table keeps each of its keys in the shard the key hashes to,
+ * so an object's entries in the different tables are usually in different shards.
+ */
+struct FUObjectHashShard
 {
 	FCriticalSection CriticalSection;
 
-public:
-
 	/** Hash sets */
 	TMap<int32, FHashBucket> Hash;
 	TMultiMap<int32, class UObjectBase*> HashOuter;
@@ -226,11 +236,6 @@ public:
 	/** Map of object to their outers, used to avoid an object iterator to find such things. **/
 	TMap<UObjectBase*, TSet<UObjectBase*> > ObjectOuterMap;
 	TMap<UClass*, TSet<UObjectBase*> > ClassToObjectListMap;
-	TMap<UClass*, TSet<UClass*> > ClassToChildListMap;
-
-	FUObjectHashTables()
-	{
-	}
 
 	/** Checks if the Hash/Object pair exists in the FName hash table */
 	FORCEINLINE bool PairExistsInHash(int32 InHash, UObjectBase* Object)
@@ -264,15 +269,61 @@ public:
 		}
 		return NumRemoved;
 	}
+};
+
+/**
+ * The UObject hash tables. A shard is only ever locked on its own and nothing else is done while it's locked, so
+ * lookups only wait for threads that use the same shard. Lock() locks everything (in a fixed order, so it can't
+ * deadlock) for GC and anything else that needs all the tables to stay the same for a while.
+ */
+class FUObjectHashTables
+{
+	/** Guards ClassToChildListMap, which is walked across many classes at once so isn't sharded */
+	FCriticalSection ClassTreeCriticalSection;
+
+public:
+
+	FUObjectHashShard Shards[OBJECT_HASH_SHARDS];
+
+	TMap<UClass*, TSet<UClass*> > ClassToChildListMap;
+
+	FUObjectHashTables()
+	{
+	}
+
+	/** Returns the shard Hash and HashOuter keep InHash in */
+	FORCEINLINE FUObjectHashShard& GetShardForHash(int32 InHash)
+	{
+		return Shards[InHash & (OBJECT_HASH_SHARDS - 1)];
+	}
+
+	/** Returns the shard ObjectOuterMap and ClassToObjectListMap keep Key in */
+	FORCEINLINE FUObjectHashShard& GetShardForKey(const UObjectBase* Key)
+	{
+		return Shards[(UPTRINT(Key) >> 4) & (OBJECT_HASH_SHARDS - 1)];
+	}
+
+	FORCEINLINE FCriticalSection& GetClassTreeCriticalSection()
+	{
+		return ClassTreeCriticalSection;
+	}
 
 	FORCEINLINE void Lock()
 	{
-		CriticalSection.Lock();
+		ClassTreeCriticalSection.Lock();
+		for (FUObjectHashShard& Shard : Shards)
+		{
+			Shard.CriticalSection.Lock();
+		}
 	}
 
 	FORCEINLINE void Unlock()
 	{
-		CriticalSection.Unlock();
+		for (int32 ShardIndex = OBJECT_HASH_SHARDS - 1; ShardIndex >= 0; --ShardIndex)
+		{
+			Shards[ShardIndex].CriticalSection.Unlock();
+		}
+		ClassTreeCriticalSection.Unlock();
 	}
 
 	static FUObjectHashTables& Get()
@@ -282,18 +333,19 @@ public:
 	}
 };
 
+/** Locks one shard of the hash tables, or the class tree */
 class FHashTableLock
 {
-	FUObjectHashTables& Tables;
+	FCriticalSection& CriticalSection;
 public:
-	FORCEINLINE FHashTableLock(FUObjectHashTables& InTables)
-		: Tables(InTables)
+	FORCEINLINE FHashTableLock(FCriticalSection& InCriticalSection)
+		: CriticalSection(InCriticalSection)
 	{
 #if THREADSAFE_UOBJECTS
 		// GC locks everything on the main thread so no need to lock here
 		if (!(IsGarbageCollecting() && IsInGameThread()))
 		{
-			Tables.Lock();
+			CriticalSection.Lock();
 		}
 #else
 		check(IsInGameThread());
@@ -304,7 +356,7 @@ public:
 #if THREADSAFE_UOBJECTS
 		if (!(IsGarbageCollecting() && IsInGameThread()))
 		{
-			Tables.Unlock();
+			CriticalSection.Unlock();
 		}
 #endif
 	}
@@ -338,8 +390,9 @@ UObject* StaticFindObjectFastExplicitThreadSafe(FUObjectHashTables& ThreadHash,
 {
 	// Find an object with the specified name and (optional) class, in any package; if bAnyPackage is false, only matches top-level packages
 	int32 Hash = GetObjectHash(ObjectName);
-	FHashTableLock HashLock(ThreadHash);
-	FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
+	FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+	FHashTableLock HashLock(Shard.CriticalSection);
+	FHashBucket* Bucket = Shard.Hash.Find(Hash);
 	if (Bucket)
 	{
 		for (FHashBucketIterator It(*Bucket); It; ++It)
@@ -400,8 +453,9 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 	if (ObjectPackage != nullptr)
 	{
 		int32 Hash = GetObjectOuterHash(ObjectName, (PTRINT)ObjectPackage);
-		FHashTableLock HashLock(ThreadHash);
-		for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(ThreadHash.HashOuter, Hash); HashIt; ++HashIt)
+		FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+		FHashTableLock HashLock(Shard.CriticalSection);
+		for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(Shard.HashOuter, Hash); HashIt; ++HashIt)
 		{
 			UObject *Object = (UObject *)HashIt.Value();
 			if
@@ -447,9 +501,10 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 			ActualObjectName = FName(*ObjectNameString.Mid(DotIndex + 1));
 		}
 		const int32 Hash = GetObjectHash(ActualObjectName);
-		FHashTableLock HashLock(ThreadHash);
+		FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+		FHashTableLock HashLock(Shard.CriticalSection);
 
-		FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
+		FHashBucket* Bucket = Shard.Hash.Find(Hash);
 		if (Bucket)
 		{
 			for (FHashBucketIterator It(*Bucket); It; ++It)
@@ -505,21 +560,23 @@ UObject* StaticFindObjectFastInternal(UClass* ObjectClass, UObject* ObjectPackag
 	return Result;
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void AddToOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
-	TSet<UObjectBase*>& Inners = ThreadHash.ObjectOuterMap.FindOrAdd(Object->GetOuter());
+	FUObjectHashShard& Shard = ThreadHash.GetShardForKey(Object->GetOuter());
+	FHashTableLock HashLock(Shard.CriticalSection);
+	TSet<UObjectBase*>& Inners = Shard.ObjectOuterMap.FindOrAdd(Object->GetOuter());
 	bool bIsAlreadyInSetPtr = false;
 	Inners.Add(Object, &bIsAlreadyInSetPtr);
 	check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	{
 		check(Object->GetClass());
-		TSet<UObjectBase*>& ObjectList = ThreadHash.ClassToObjectListMap.FindOrAdd(Object->GetClass());
+		FUObjectHashShard& Shard = ThreadHash.GetShardForKey(Object->GetClass());
+		FHashTableLock HashLock(Shard.CriticalSection);
+		TSet<UObjectBase*>& ObjectList = Shard.ClassToObjectListMap.FindOrAdd(Object->GetClass());
 		bool bIsAlreadyInSetPtr = false;
 		ObjectList.Add(Object, &bIsAlreadyInSetPtr);
 		check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
@@ -532,6 +589,7 @@ static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 		UClass* SuperClass = Class->GetSuperClass();
 		if ( SuperClass )
 		{
+			FHashTableLock HashLock(ThreadHash.GetClassTreeCriticalSection());
 			TSet<UClass*>& ChildList = ThreadHash.ClassToChildListMap.FindOrAdd(SuperClass);
 			bool bIsAlreadyInSetPtr = false;
 			ChildList.Add(Class, &bIsAlreadyInSetPtr);
@@ -540,10 +598,11 @@ static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void RemoveFromOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
-	TSet<UObjectBase*>& Inners = ThreadHash.ObjectOuterMap.FindOrAdd(Object->GetOuter());
+	FUObjectHashShard& Shard = ThreadHash.GetShardForKey(Object->GetOuter());
+	FHashTableLock HashLock(Shard.CriticalSection);
+	TSet<UObjectBase*>& Inners = Shard.ObjectOuterMap.FindOrAdd(Object->GetOuter());
 	int32 NumRemoved = Inners.Remove(Object);
 	if (NumRemoved != 1)
 	{
@@ -552,17 +611,18 @@ static void RemoveFromOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 	if (!Inners.Num())
 	{
-		ThreadHash.ObjectOuterMap.Remove(Object->GetOuter());
+		Shard.ObjectOuterMap.Remove(Object->GetOuter());
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	UObjectBaseUtility* ObjectWithUtility = static_cast<UObjectBaseUtility*>(Object);
 
 	{
-		TSet<UObjectBase*>& ObjectList = ThreadHash.ClassToObjectListMap.FindOrAdd(Object->GetClass());
+		FUObjectHashShard& Shard = ThreadHash.GetShardForKey(Object->GetClass());
+		FHashTableLock HashLock(Shard.CriticalSection);
+		TSet<UObjectBase*>& ObjectList = Shard.ClassToObjectListMap.FindOrAdd(Object->GetClass());
 		int32 NumRemoved = ObjectList.Remove(Object);
 		if (NumRemoved != 1)
 		{
@@ -571,7 +631,7 @@ static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 		check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 		if (!ObjectList.Num())
 		{
-			ThreadHash.ClassToObjectListMap.Remove(Object->GetClass());
+			Shard.ClassToObjectListMap.Remove(Object->GetClass());
 		}
 	}
 
@@ -582,6 +642,7 @@ static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 		if ( SuperClass )
 		{
 			// Remove the class from the SuperClass' child list
+			FHashTableLock HashLock(ThreadHash.GetClassTreeCriticalSection());
 			TSet<UClass*>& ChildList = ThreadHash.ClassToChildListMap.FindOrAdd(SuperClass);
 			int32 NumRemoved = ChildList.Remove(Class);
 			if (NumRemoved != 1)
@@ -597,6 +658,32 @@ static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 	}
 }
 
+/**
+ * Adds the objects directly inside Outer to Results, and if OutOuters is given, all of them to it whether they're
+ * excluded or not.
+ */
+static void GetInners(FUObjectHashTables& ThreadHash, const UObjectBase* Outer, TArray<UObject*>& Results, TArray<const UObjectBase*>* OutOuters, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+{
+	FUObjectHashShard& Shard = ThreadHash.GetShardForKey(Outer);
+	FHashTableLock HashLock(Shard.CriticalSection);
+	TSet<UObjectBase*> const* Inners = Shard.ObjectOuterMap.Find(Outer);
+	if (Inners)
+	{
+		for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
+		{
+			UObject *Object = static_cast<UObject *>(*It);
+			if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
+			{
+				Results.Add(Object);
+			}
+			if (OutOuters)
+			{
+				OutOuters->Add(Object);
+			}
+		}
+	}
+}
+
 void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Results, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
 {
 	SCOPE_CYCLE_COUNTER( STAT_Hash_GetObjectsWithOuter );	
@@ -608,41 +695,18 @@ void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Resu
 	}
 	int32 StartNum = Results.Num();
 	auto& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
-	TSet<UObjectBase*> const* Inners = ThreadHash.ObjectOuterMap.Find(Outer);
-	if (Inners)
+	GetInners(ThreadHash, Outer, Results, nullptr, ExclusionFlags, ExclusionInternalFlags);
+	int32 MaxResults = GUObjectArray.GetObjectArrayNum();
+	while (StartNum != Results.Num() && bIncludeNestedObjects)
 	{
-		for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
+		int32 RangeStart = StartNum;
+		int32 RangeEnd = Results.Num();
+		StartNum = RangeEnd;
+		for (int32 Index = RangeStart; Index < RangeEnd; Index++)
 		{
-			UObject *Object = static_cast<UObject *>(*It);
-			if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-			{
-				Results.Add(Object);
-			}
-		}
-		int32 MaxResults = GUObjectArray.GetObjectArrayNum();
-		while (StartNum != Results.Num() && bIncludeNestedObjects)
-		{
-			int32 RangeStart = StartNum;
-			int32 RangeEnd = Results.Num();
-			StartNum = RangeEnd;
-			for (int32 Index = RangeStart; Index < RangeEnd; Index++)
-			{
-				TSet<UObjectBase*> const* InnerInners = ThreadHash.ObjectOuterMap.Find(Results[Index]);
-				if (InnerInners)
-				{
-					for (TSet<UObjectBase*>::TConstIterator It(*InnerInners); It; ++It)
-					{
-						UObject *Object = static_cast<UObject *>(*It);
-						if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-						{
-							Results.Add(Object);
-						}
-					}
-				}
-			}
-			check(Results.Num() <= MaxResults); // otherwise we have a cycle in the outer chain, which should not be possible
+			GetInners(ThreadHash, Results[Index], Results, nullptr, ExclusionFlags, ExclusionInternalFlags);
 		}
+		check(Results.Num() <= MaxResults); // otherwise we have a cycle in the outer chain, which should not be possible
 	}
 }
 
@@ -654,32 +718,20 @@ void ForEachObjectWithOuter(const class UObjectBase* Outer, TFunctionRef<void(UO
 	{
 		ExclusionInternalFlags |= EInternalObjectFlags::AsyncLoading;
 	}
+	// Gather the objects first, so no part of the hash tables is locked while Operation runs.
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
-	TArray<TSet<UObjectBase*> const*> AllInners;
-
-	if (TSet<UObjectBase*> const* Inners = ThreadHash.ObjectOuterMap.Find(Outer))
+	TArray<UObject*> Objects;
+	TArray<const UObjectBase*> AllOuters;
+	AllOuters.Add(Outer);
+	while (AllOuters.Num())
 	{
-		AllInners.Add(Inners);
+		const UObjectBase* CurrentOuter = AllOuters.Pop(false);
+		GetInners(ThreadHash, CurrentOuter, Objects, bIncludeNestedObjects ? &AllOuters : nullptr, ExclusionFlags, ExclusionInternalFlags);
 	}
-	while (AllInners.Num())
+
+	for (UObject* Object : Objects)
 	{
-		TSet<UObjectBase*> const* Inners = AllInners.Pop();
-		for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
-		{
-			UObject *Object = static_cast<UObject*>(*It);
-			if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-			{
-				Operation(Object);
-			}
-			if (bIncludeNestedObjects)
-			{
-				if (TSet<UObjectBase*> const* ObjectInners = ThreadHash.ObjectOuterMap.Find(Object))
-				{
-					AllInners.Add(ObjectInners);
-				}
-			}
-		}
+		Operation(Object);
 	}
 }
 
@@ -703,8 +755,9 @@ UObjectBase* FindObjectWithOuter(class UObjectBase* Outer, class UClass* ClassTo
 	else
 	{
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
-		TSet<UObjectBase*> const* Inners = ThreadHash.ObjectOuterMap.Find( Outer );
+		FUObjectHashShard& Shard = ThreadHash.GetShardForKey(Outer);
+		FHashTableLock HashLock(Shard.CriticalSection);
+		TSet<UObjectBase*> const* Inners = Shard.ObjectOuterMap.Find( Outer );
 		if (Inners)
 		{
 			for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
@@ -726,7 +779,7 @@ UObjectBase* FindObjectWithOuter(class UObjectBase* Outer, class UClass* ClassTo
 	return Result;
 }
 
-/** Helper function that returns all the children of the specified class recursively */
+/** Helper function that returns all the children of the specified class recursively, the class tree must be locked */
 static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, UClass* ParentClass, TSet<UClass*>& OutAllDerivedClass)
 {
 	TSet<UClass*>* ChildSet = ThreadHash.ClassToChildListMap.Find(ParentClass);
@@ -747,11 +800,12 @@ static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, UC
 static void GetObjectsOfClassThreadSafe(FUObjectHashTables& ThreadHash, TSet<UClass*>& ClassesToSearch, TArray<UObject *>& Results, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
 {
 	ExclusionInternalFlags |= EInternalObjectFlags::Unreachable;
-	FHashTableLock HashLock(ThreadHash);
 	
 	for (auto ClassIt = ClassesToSearch.CreateConstIterator(); ClassIt; ++ClassIt)
 	{
-		TSet<UObjectBase*> const* List = ThreadHash.ClassToObjectListMap.Find(*ClassIt);
+		FUObjectHashShard& Shard = ThreadHash.GetShardForKey(*ClassIt);
+		FHashTableLock HashLock(Shard.CriticalSection);
+		TSet<UObjectBase*> const* List = Shard.ClassToObjectListMap.Find(*ClassIt);
 		if (List)
 		{
 			for (auto ObjectIt = List->CreateConstIterator(); ObjectIt; ++ObjectIt)
@@ -781,7 +835,7 @@ void GetObjectsOfClass(UClass* ClassToLookFor, TArray<UObject *>& Results, bool
 	if( bIncludeDerivedClasses )
 	{
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock( ThreadHash );
+		FHashTableLock HashLock( ThreadHash.GetClassTreeCriticalSection() );
 		RecursivelyPopulateDerivedClasses( ThreadHash, ClassToLookFor, ClassesToSearch );
 	}
 
@@ -799,30 +853,13 @@ void ForEachObjectOfClass(UClass* ClassToLookFor, TFunctionRef<void(UObject*)> O
 		ExclusionInternalFlags |= EInternalObjectFlags::AsyncLoading;
 	}
 
-	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
+	// Gather the objects first, so no part of the hash tables is locked while Operation runs.
+	TArray<UObject*> Objects;
+	GetObjectsOfClass(ClassToLookFor, Objects, bIncludeDerivedClasses, ExclusionFlags, ExclusionInternalFlags);
 
-	TSet<UClass*> ClassesToSearch;
-	ClassesToSearch.Add( ClassToLookFor );
-	if( bIncludeDerivedClasses )
+	for (UObject* Object : Objects)
 	{
-		RecursivelyPopulateDerivedClasses( ThreadHash, ClassToLookFor, ClassesToSearch );
-	}
-
-	for (auto ClassIt = ClassesToSearch.CreateConstIterator(); ClassIt; ++ClassIt)
-	{
-		TSet<UObjectBase*> const* List = ThreadHash.ClassToObjectListMap.Find(*ClassIt);
-		if (List)
-		{
-			for (auto ObjectIt = List->CreateConstIterator(); ObjectIt; ++ObjectIt)
-			{
-				UObject *Object = static_cast<UObject*>(*ObjectIt);
-				if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-				{
-					Operation(Object);
-				}
-			}
-		}
+		Operation(Object);
 	}
 }
 
@@ -832,14 +869,14 @@ void GetDerivedClasses(UClass* ClassToLookFor, TArray<UClass *>& Results, bool b
 	{
 		TSet<UClass*> AllDerivedClasses;
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
+		FHashTableLock HashLock(ThreadHash.GetClassTreeCriticalSection());
 		RecursivelyPopulateDerivedClasses(ThreadHash, ClassToLookFor, AllDerivedClasses);
 		Results.Append( AllDerivedClasses.Array() );
 	}
 	else
 	{
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
+		FHashTableLock HashLock(ThreadHash.GetClassTreeCriticalSection());
 		TSet<UClass*>* DerivedClasses = ThreadHash.ClassToChildListMap.Find(ClassToLookFor);
 		if ( DerivedClasses )
 		{
@@ -862,16 +899,24 @@ void HashObject(UObjectBase* Object)
 	{
 		int32 Hash = 0;
 
+		// Each table locks its own shard, so the object shows up in them one at a time.
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
 
 		Hash = GetObjectHash(Name);				
-		checkSlow(!ThreadHash.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
-		ThreadHash.AddToHash(Hash, Object);
+		{
+			FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+			FHashTableLock HashLock(Shard.CriticalSection);
+			checkSlow(!Shard.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
+			Shard.AddToHash(Hash, Object);
+		}
 
 		Hash = GetObjectOuterHash( Name, (PTRINT)Object->GetOuter() );
-		checkSlow( !ThreadHash.HashOuter.FindPair( Hash, Object ) );  // if it already exists, something is wrong with the external code
-		ThreadHash.HashOuter.Add( Hash, Object );
+		{
+			FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+			FHashTableLock HashLock(Shard.CriticalSection);
+			checkSlow( !Shard.HashOuter.FindPair( Hash, Object ) );  // if it already exists, something is wrong with the external code
+			Shard.HashOuter.Add( Hash, Object );
+		}
 
 		AddToOuterMap( ThreadHash, Object );
 		AddToClassMap( ThreadHash, Object );
@@ -894,14 +939,21 @@ void UnhashObject(UObjectBase* Object)
 		int32 NumRemoved = 0;
 
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock LockHash(ThreadHash);
 
 		Hash = GetObjectHash(Name);
-		NumRemoved = ThreadHash.RemoveFromHash(Hash, Object);
+		{
+			FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+			FHashTableLock LockHash(Shard.CriticalSection);
+			NumRemoved = Shard.RemoveFromHash(Hash, Object);
+		}
 		check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 
 		Hash = GetObjectOuterHash( Name, (PTRINT)Object->GetOuter() );
-		NumRemoved = ThreadHash.HashOuter.RemoveSingle( Hash, Object );
+		{
+			FUObjectHashShard& Shard = ThreadHash.GetShardForHash(Hash);
+			FHashTableLock LockHash(Shard.CriticalSection);
+			NumRemoved = Shard.HashOuter.RemoveSingle( Hash, Object );
+		}
 		check( NumRemoved == 1 ); // must have existed, else something is wrong with the external code
 
 		RemoveFromOuterMap( ThreadHash, Object );
@@ -933,11 +985,15 @@ void UnlockUObjectHashTables()
 #endif
 }
 
-void LogHashStatisticsInternal(TMultiMap<int32, UObjectBase*>& Hash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
+void LogHashOuterStatisticsInternal(FUObjectHashTables& Tables, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
 {
 	TArray<int32> HashBuckets;
-	// Get the set of keys in use, which is the number of hash buckets
-	int32 SlotsInUse = Hash.GetKeys(HashBuckets);
+	// Get the set of keys in use, which is the number of hash buckets. GetKeys appends, and a key only ever lives in one shard.
+	for (FUObjectHashShard& Shard : Tables.Shards)
+	{
+		Shard.HashOuter.GetKeys(HashBuckets);
+	}
+	const int32 SlotsInUse = HashBuckets.Num();
 
 	int32 TotalCollisions = 0;
 	int32 MinCollisions = OBJECT_HASH_BINS;
@@ -952,7 +1008,7 @@ void LogHashStatisticsInternal(TMultiMap<int32, UObjectBase*>& Hash, FOutputDevi
 	{
 		int32 Collisions = 0;
 
-		for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Hash, HashBucket); HashIt; ++HashIt)
+		for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Tables.GetShardForHash(HashBucket).HashOuter, HashBucket); HashIt; ++HashIt)
 		{
 			// There's one collision per object in a given bucket
 			Collisions++;
@@ -978,7 +1034,7 @@ void LogHashStatisticsInternal(TMultiMap<int32, UObjectBase*>& Hash, FOutputDevi
 	// Dump the first 30 objects in the worst bin for inspection
 	Ar.Logf(TEXT("Worst hash bucket contains:"));
 	int32 Count = 0;
-	for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Hash, MaxBin); HashIt && Count < 30; ++HashIt)
+	for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Tables.GetShardForHash(MaxBin).HashOuter, MaxBin); HashIt && Count < 30; ++HashIt)
 	{
 		UObject* Object = (UObject*)HashIt.Value();
 		Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
@@ -993,15 +1049,22 @@ void LogHashStatisticsInternal(TMultiMap<int32, UObjectBase*>& Hash, FOutputDevi
 		MaxCollisions);
 
 	// Calculate Hashtable size
-	const uint32 HashtableAllocatedSize = Hash.GetAllocatedSize();
+	uint32 HashtableAllocatedSize = 0;
+	for (FUObjectHashShard& Shard : Tables.Shards)
+	{
+		HashtableAllocatedSize += Shard.HashOuter.GetAllocatedSize();
+	}
 	Ar.Logf(TEXT("Total memory allocated for Object Outer Hash: %u bytes."), HashtableAllocatedSize);
 }
 
-void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
+void LogHashStatisticsInternal(FUObjectHashTables& Tables, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
 {
-	TArray<int32> HashBuckets;
 	// Get the set of keys in use, which is the number of hash buckets
-	int32 SlotsInUse = Hash.Num();
+	int32 SlotsInUse = 0;
+	for (FUObjectHashShard& Shard : Tables.Shards)
+	{
+		SlotsInUse += Shard.Hash.Num();
+	}
 
 	int32 TotalCollisions = 0;
 	int32 MinCollisions = OBJECT_HASH_BINS;
@@ -1013,28 +1076,31 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
 
 	// Work through each slot and figure out how many collisions
-	for (auto& HashPair : Hash)
+	for (FUObjectHashShard& Shard : Tables.Shards)
 	{
-		int32 Collisions = HashPair.Value.Num();
-		check(Collisions >= 0);
-		if (Collisions > 1)
+		for (auto& HashPair : Shard.Hash)
 		{
-			NumBucketsWithMoreThanOneItem++;
-		}
+			int32 Collisions = HashPair.Value.Num();
+			check(Collisions >= 0);
+			if (Collisions > 1)
+			{
+				NumBucketsWithMoreThanOneItem++;
+			}
 
-		// Keep the global stats
-		TotalCollisions += Collisions;
-		if (Collisions > MaxCollisions)
-		{
-			MaxBin = HashPair.Key;
-		}
-		MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
-		MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
+			// Keep the global stats
+			TotalCollisions += Collisions;
+			if (Collisions > MaxCollisions)
+			{
+				MaxBin = HashPair.Key;
+			}
+			MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
+			MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
 
-		if (bShowHashBucketCollisionInfo)
-		{
-			// Now log the output
-			Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashPair.Key, Collisions);
+			if (bShowHashBucketCollisionInfo)
+			{
+				// Now log the output
+				Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashPair.Key, Collisions);
+			}
 		}
 	}
 	Ar.Logf(TEXT(""));
@@ -1042,7 +1108,7 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 	// Dump the first 30 objects in the worst bin for inspection
 	Ar.Logf(TEXT("Worst hash bucket contains:"));
 	int32 Count = 0;
-	FHashBucket& WorstBucket = Hash.FindChecked(MaxBin);
+	FHashBucket& WorstBucket = Tables.GetShardForHash(MaxBin).Hash.FindChecked(MaxBin);
 	for (FHashBucketIterator It(WorstBucket); It; ++It)
 	{
 		UObject* Object = (UObject*)*It;
@@ -1060,11 +1126,15 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 		SlotsInUse);
 
 	// Calculate Hashtable size
-	uint32 HashtableAllocatedSize = Hash.GetAllocatedSize();
-	// Calculate the size of a all Allocations inside of the buckets (TSet Items)
-	for (auto& Pair : Hash)
+	uint32 HashtableAllocatedSize = 0;
+	for (FUObjectHashShard& Shard : Tables.Shards)
 	{
-		HashtableAllocatedSize += Pair.Value.GetItemsSize();
+		HashtableAllocatedSize += Shard.Hash.GetAllocatedSize();
+		// Calculate the size of a all Allocations inside of the buckets (TSet Items)
+		for (auto& Pair : Shard.Hash)
+		{
+			HashtableAllocatedSize += Pair.Value.GetItemsSize();
+		}
 	}
 	Ar.Logf(TEXT("Total memory allocated for and by Object Hash: %u bytes."), HashtableAllocatedSize);
 }
@@ -1074,8 +1144,9 @@ void LogHashStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisionInf
 	Ar.Logf(TEXT("Hash efficiency statistics for the Object Hash"));
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
-	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().Hash, Ar, bShowHashBucketCollisionInfo);
+	LockUObjectHashTables();
+	LogHashStatisticsInternal(FUObjectHashTables::Get(), Ar, bShowHashBucketCollisionInfo);
+	UnlockUObjectHashTables();
 	Ar.Logf(TEXT(""));
 }
 
@@ -1084,8 +1155,9 @@ void LogHashOuterStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisi
 	Ar.Logf(TEXT("Hash efficiency statistics for the Outer Object Hash"));
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
-	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().HashOuter, Ar, bShowHashBucketCollisionInfo);
+	LockUObjectHashTables();
+	LogHashOuterStatisticsInternal(FUObjectHashTables::Get(), Ar, bShowHashBucketCollisionInfo);
+	UnlockUObjectHashTables();
 	Ar.Logf(TEXT(""));
 }
 
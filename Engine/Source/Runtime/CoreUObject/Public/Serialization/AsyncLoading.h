@@ -77,6 +77,20 @@ struct FAsyncPackage
 		return bLoadHasFinished;
 	}
 
+	/** Returns true if the last tick stopped because the data the package needs next hasn't been read yet. */
+	FORCEINLINE bool IsWaitingForIO() const
+	{
+		return bWaitingForIO;
+	}
+
+	/**
+	 * Whether ticking the package now could make progress. Packages whose imports are all being loaded or whose data
+	 * is still being read are left alone until that's done, ticking them would only find that out again.
+	 *
+	 * @return false if the package is waiting for its imports or for IO, true otherwise
+	 */
+	bool IsReadyToTick();
+
 	/** Returns package loading priority. */
 	FORCEINLINE TAsyncLoadPriority GetPriority() const
 	{
@@ -150,6 +164,8 @@ private:
 	int32							ImportIndex;
 	/** Current index into linkers export table used to spread creation over several frames				*/
 	int32							ExportIndex;
+	/** Current index into linkers export table used to spread serialization over several frames, only used when exports are serialized in parallel */
+	int32							SerializeExportIndex;
 	/** Current index into GObjLoaded array used to spread routing PreLoad over several frames			*/
 	static int32					PreLoadIndex;
 	/** Current index into GObjLoaded array used to spread routing PostLoad over several frames			*/
@@ -168,6 +184,10 @@ private:
 	bool						bLoadHasFailed;
 	/** True if our load has finished */
 	bool						bLoadHasFinished;
+	/** True if the last tick stopped to wait for the linker's reads to finish							*/
+	bool						bWaitingForIO;
+	/** True if all exports are created before any is serialized, so some can be serialized on workers	*/
+	bool						bSerializeExportsInParallel;
 	/** The time taken when we started the tick.														*/
 	double						TickStartTime;
 	/** Last object work was performed on. Used for debugging/ logging purposes.						*/
@@ -296,6 +316,13 @@ private:
 	 * @return true if we finished creating and preloading all exports, false otherwise.
 	 */
 	EAsyncPackageState::Type CreateExports();
+	/**
+	 * CreateExports for when exports are serialized in parallel. Creates all exports first, then serializes those that
+	 * allow it on workers and the rest here, in order.
+	 *
+	 * @return true if we finished creating and serializing all exports, false otherwise.
+	 */
+	EAsyncPackageState::Type CreateExportsAndSerializeInParallel();
 	/**
 	 * Preloads aka serializes all loaded objects.
 	 *
@@ -324,19 +351,19 @@ private:
 	 *
 	 * @param ImportedPackage Package imported either directly or by one of the imported packages
 	 */
-	void AddDependencyTree(int32 CurrentPackageIndex, FAsyncPackage& ImportedPackage, TSet<FAsyncPackage*>& SearchedPackages);
+	void AddDependencyTree(FAsyncPackage& ImportedPackage, TSet<FAsyncPackage*>& SearchedPackages);
 	/**
 	 * Adds a unique package to the list of packages to wait for until their linkers have been created.
 	 *
 	 * @param PendingImport Package imported either directly or by one of the imported packages
 	 */
-	bool AddUniqueLinkerDependencyPackage(int32 CurrentPackageIndex, FAsyncPackage& PendingImport);
+	bool AddUniqueLinkerDependencyPackage(FAsyncPackage& PendingImport);
 	/**
 	 * Adds a package to the list of pending import packages.
 	 *
 	 * @param PendingImport Name of the package imported either directly or by one of the imported packages
 	 */
-	void AddImportDependency(int32 CurrentPackageIndex, const FName& PendingImport);
+	void AddImportDependency(const FName& PendingImport);
 	/**
 	 * Removes references to any imported packages.
 	 */
@@ -145,6 +145,7 @@ private:
 
 public:
 	friend class FLinkerLoad;
+	friend class FBulkDataMemoryMapTest;
 
 	/*-----------------------------------------------------------------------------
 		Constructors and operators
@@ -248,6 +249,14 @@ public:
 	 */
 	bool IsBulkDataLoaded() const;
 
+	/**
+	 * Returns whether the bulk data is loaded by mapping it straight from the file it is stored in, rather than by
+	 * copying it to memory.
+	 *
+	 * @return true if bulk data is memory mapped, false otherwise
+	 */
+	bool IsBulkDataMemoryMapped() const;
+
 	/**
 	* Returns whether the bulk data asynchronous load has completed.
 	*
@@ -316,7 +325,9 @@ public:
 	void GetCopy( void** Dest, bool bDiscardInternalCopy = true );
 
 	/**
-	 * Locks the bulk data and returns a pointer to it.
+	 * Locks the bulk data and returns a pointer to it. Uncompressed payloads of cooked packages are memory mapped when
+	 * s.MemoryMapBulkData is set, in which case a read-only lock points straight into the mapped file and a read-write
+	 * lock copies the payload to memory first.
 	 *
 	 * @param	LockFlags	Flags determining lock behavior
 	 */
@@ -472,6 +483,22 @@ private:
 	/** Returns true if bulk data should be loaded asynchronously */
 	bool ShouldStreamBulkData();
 
+	/**
+	 * Maps the payload straight from the file it is stored in if it can be, instead of loading it into memory.
+	 *
+	 * @return true if the payload is now mapped, false if it has to be loaded instead
+	 */
+	bool TryMapPayload();
+
+	/** Unmaps the payload, if it is mapped */
+	void UnmapPayload();
+
+	/** Copies a mapped payload to memory and unmaps it, so it can be changed or outlive the file it is stored in */
+	void CopyMappedPayloadToMemory();
+
+	/** Returns the loaded payload, whether it is in memory or mapped, or nullptr if it isn't loaded */
+	void* GetLoadedPayload() const;
+
 	/*-----------------------------------------------------------------------------
 		Member variables.
 	-----------------------------------------------------------------------------*/
@@ -491,6 +518,10 @@ private:
 	FAllocatedPtr		BulkData;
 	/** Pointer to cached async bulk data																				*/
 	FAllocatedPtr		BulkDataAsync;
+	/** Payload mapped straight from the file, used instead of BulkData when set											*/
+	IMappedFileRegion*	MappedRegion;
+	/** Whether the payload is stored in the file exactly as it is in memory, so it can be mapped						*/
+	bool				bCanMapPayload;
 	/** Current lock status																								*/
 	uint32				LockStatus;
 	/** Async helper for loading bulk data on a separate thread */
@@ -261,6 +261,11 @@ public:
 	/** In memory only: Linked list of properties requiring post constructor initialization.**/
 	UProperty* PostConstructLink;
 
+	/** In memory only: Properties with values in the unversioned layout, in PropertyLink order, see SerializeUnversionedProperties() **/
+	TArray<UProperty*> UnversionedProperties;
+	/** In memory only: Number of values in the unversioned layout, every element of every property in UnversionedProperties **/
+	int32 NumUnversionedSlots;
+
 	/** Array of object references embedded in script code. Mirrored for easy access by realtime garbage collection code */
 	TArray<UObject*> ScriptObjectReferences;
 
@@ -319,6 +324,18 @@ public:
 
 	virtual void SerializeTaggedProperties( FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults, const UObject* BreakRecursionIfFullyLoad=NULL) const;
 
+	/**
+	 * Serializes the properties that reside in Data without tags, for archives that use unversioned property serialization.
+	 * A bitmask says which values follow, so values that match the defaults are left out like with tags, but the values
+	 * are read straight into place without looking the properties up.
+	 *
+	 * @param	Ar				the archive to use for serialization
+	 * @param	Data			pointer to the location of the beginning of the property data
+	 * @param	DefaultsStruct	the struct corresponding to the block of memory located at Defaults
+	 * @param	Defaults		pointer to the location of the beginning of the data that should be compared against
+	 */
+	void SerializeUnversionedProperties( FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults ) const;
+
 	/**
 	 * Initialize a struct over uninitialized memory. This may be done by calling the native constructor or individually initializing properties
 	 *
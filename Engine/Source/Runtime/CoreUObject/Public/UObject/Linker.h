@@ -1314,8 +1314,14 @@ public:
 #endif // WITH_EDITOR
 	/** The archive that actually reads the raw data from disk.																*/
 	FArchive*				Loader;
+	/** Offset of the last region Precache returned false for, INDEX_NONE if the last precache had completed				*/
+	int64					PendingPrecacheOffset;
+	/** Size of the last region Precache returned false for																	*/
+	int64					PendingPrecacheSize;
 	/** The async package associated with this linker */
 	struct FAsyncPackage* AsyncRoot;
+	/** Objects being serialized on thread pool workers, see PreloadOnWorkerThread										*/
+	TMap<UObject*, FAsyncTask<class FExportSerializeTask>*> WorkerPreloads;
 
 	/** OldClassName to NewClassName for ImportMap */
 	static TMap<FName, FName> ObjectNameRedirects;
@@ -1625,6 +1631,20 @@ public:
 	 */
 	void Preload( UObject* Object ) override;
 
+	/**
+	 * Serializes the object on a thread pool worker instead of preloading it, if that's safe: the object allows it (see
+	 * UObject::IsSerializeThreadSafe) and this is an uncompressed cooked package. Every export the object may reference
+	 * must have been created already, the worker only looks references up. Preload waits for the worker if it's asked
+	 * for the object before WaitForWorkerPreloads is called.
+	 *
+	 * @param	Object	The object to load data for
+	 * @return	true if a worker is serializing the object, false if it has to be preloaded as usual
+	 */
+	bool PreloadOnWorkerThread( UObject* Object );
+
+	/** Waits for the workers PreloadOnWorkerThread has handed objects to, and finishes loading those objects. */
+	void WaitForWorkerPreloads();
+
 	/**
 	 * Before loading a persistent object from disk, this function can be used to discover
 	 * the object in memory. This could happen in the editor when you save a package (which
@@ -1736,6 +1756,12 @@ private:
 	 */
 	UObject* CreateExportAndPreload(int32 ExportIndex, bool bForcePreload = false);
 
+	/** Waits for the object if PreloadOnWorkerThread handed it to a worker and finishes loading it. */
+	void WaitForWorkerPreload(UObject* Object);
+
+	/** Waits for a worker serializing an object, checks how much it read and completes the object's load. */
+	void FinishWorkerPreload(FAsyncTask<FExportSerializeTask>* Task);
+
 	/**
 	 * Utility function for easily retrieving the specified export's UClass.
 	 * 
@@ -1799,6 +1825,14 @@ private:
 	 * @return	false if precache operation is still pending, true otherwise
 	 */
 	virtual bool Precache( int64 PrecacheOffset, int64 PrecacheSize ) override;
+
+	/**
+	 * Whether the region the last call to Precache returned false for is still being read. Async loading parks packages
+	 * waiting on IO until this returns false rather than ticking them again.
+	 *
+	 * @return true if the last region precached hasn't arrived yet, false if it has or nothing is waiting to be read
+	 */
+	bool IsPrecachePending();
 	
 #if WITH_EDITOR
 	/**
@@ -80,6 +80,7 @@ enum ESaveFlags
 	SAVE_Unversioned	= 0x00000020,	// Save all versions as zero. Upon load this is changed to the current version. This is only reasonable to use with full cooked builds for distribution.
 	SAVE_CutdownPackage	= 0x00000040,	// Saving cutdown packages in a temp location WITHOUT renaming the package.
 	SAVE_KeepEditorOnlyCookedPackages = 0x00000080,  // keep packages which are marked as editor only even though we are cooking
+	SAVE_UnversionedProperties = 0x00000100,	// Save tagged properties without tags when cooking. Only reasonable for cooked builds whose code matches the cooker's exactly.
 };
 
 //
@@ -100,7 +101,7 @@ enum EPackageFlags
 //	PKG_Unused						= 0x00000400,
 //	PKG_Unused						= 0x00000800,
 //	PKG_Unused						= 0x00001000,
-//	PKG_Unused						= 0x00002000,
+	PKG_UnversionedProperties		= 0x00002000,	// Tagged properties were saved without tags, see FArchive::UseUnversionedPropertySerialization()
 //	PKG_Unused						= 0x00004000,
 	PKG_Need						= 0x00008000,	// Client needs to download this package.
 	PKG_Compiling					= 0x00010000,	// package is currently being compiled
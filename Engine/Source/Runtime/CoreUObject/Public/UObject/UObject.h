@@ -373,6 +373,18 @@ public:
 		return false;
 	}
 
+	/**
+	* Called during async load to determine if this object can be serialized on a worker thread, alongside the other
+	* exports of its package. Serialize may then only resolve references to other objects, not preload them or read
+	* their data, and must not touch state shared with other threads. Only asked of objects of native classes.
+	*
+	* @return	true if this object's Serialize is thread safe
+	*/
+	virtual bool IsSerializeThreadSafe() const
+	{
+		return false;
+	}
+
 
 	/** 
 	 *	Determines if you can create an object from the supplied template in the current context (editor, client only, dedicated server, game/listen) 
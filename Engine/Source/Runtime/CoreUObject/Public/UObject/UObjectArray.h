@@ -746,17 +746,41 @@ private:
 /** UObject cluster. Groups UObjects into a single unit for GC. */
 struct FUObjectCluster
 {
+	FUObjectCluster()
+		: bNeedsDissolving(false)
+	{}
+
 	/** Objects that belong to this cluster */
 	TArray<int32> Objects;
 	/** Other clusters referenced by this cluster */
 	TArray<int32> ReferencedClusters;
 	/** Objects that could not be added to the cluster but still need to be referenced by it */
 	TArray<int32> MutableObjects;
+	/** Set when the cluster's references can no longer be trusted, it gets dissolved before the next reachability analysis */
+	bool bNeedsDissolving;
 };
 
 /** Global UObject allocator							*/
 extern COREUOBJECT_API FUObjectArray GUObjectArray;
 extern COREUOBJECT_API TMap<int32, FUObjectCluster* > GUObjectClusters;
+/**
+ * Guards GUObjectClusters and the clusters in it outside of garbage collection. Reachability analysis reads it without
+ * locking, it doesn't change while the garbage collector holds the GC lock other than through the garbage collector itself.
+ */
+extern COREUOBJECT_API FCriticalSection GUObjectClustersCritical;
+
+/** Whether assets other than materials and particle systems create clusters when loaded (gc.AssetClustering) */
+extern COREUOBJECT_API int32 GAssetClusteringEnabled;
+/** Whether levels cluster their static actors when loaded (gc.ActorClustering) */
+extern COREUOBJECT_API int32 GActorClusteringEnabled;
+
+/**
+ * Flags the cluster the object belongs to (or is the root of) to be dissolved before the next reachability analysis,
+ * after which its objects are treated like any other object again. Does nothing if the object isn't part of a cluster.
+ *
+ * @param	ObjectIndex	index of the object in GUObjectArray
+ */
+COREUOBJECT_API void MarkClusterForDissolving(int32 ObjectIndex);
 
 /**
 	* Static version of IndexToObject for use with TWeakObjectPtr.
@@ -128,12 +128,18 @@ public:
 	}
 
 	/**
-	 * Marks this object as RF_PendingKill.
+	 * Marks this object as RF_PendingKill. If the object is part of a GC cluster the cluster gets dissolved, so the
+	 * object can be collected and references to it cleared.
 	 */
 	FORCEINLINE void MarkPendingKill()
 	{
 		check(!IsRooted());
-		GUObjectArray.IndexToObject(InternalIndex)->SetPendingKill();
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(InternalIndex);
+		ObjectItem->SetPendingKill();
+		if (ObjectItem->GetOwnerIndex() || ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+		{
+			MarkClusterForDissolving(InternalIndex);
+		}
 	}
 
 	/**
@@ -151,6 +157,7 @@ public:
 	FORCEINLINE void AddToRoot()
 	{
 		GUObjectArray.IndexToObject(InternalIndex)->SetRootSet();
+		GCWriteBarrier(this);
 	}
 
 	//
@@ -305,6 +312,16 @@ public:
 	*/
 	virtual bool CanBeInCluster() const;
 
+	/**
+	* Called during construction of this object's cluster for objects that are not in the same package as this object
+	*
+	* @return	true if objects from other packages can be added to this object's cluster, otherwise they only get referenced by it
+	*/
+	virtual bool CanClusterObjectsFromOtherPackages() const
+	{
+		return true;
+	}
+
 	/**
 	* Called during PostLoad to create UObject cluster
 	*/
@@ -389,6 +389,70 @@ COREUOBJECT_API void CollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPur
 */
 COREUOBJECT_API bool TryCollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge = true);
 
+/**
+ * Performs garbage collection with reachability analysis spread over several calls (gc.IncrementalReachability), each
+ * limited to gc.IncrementalReachabilityTimeLimit, and is meant to be called once per frame until it returns true.
+ * The first call of a pass also goes over the whole object array, and the last one collects the references that
+ * aren't tracked between calls before unhashing unreachable objects, so those two take longer than the rest.
+ * Falls back to TryCollectGarbage without a full purge when incremental reachability analysis is disabled.
+ * A call to CollectGarbage or TryCollectGarbage while a pass is in progress abandons it.
+ *
+ * @param	KeepFlags	objects with those flags will be kept regardless of being referenced or not, only used by the first call of a pass
+ * @return	true if garbage collection completed during this call
+ */
+COREUOBJECT_API bool TryCollectGarbageIncremental(EObjectFlags KeepFlags);
+
+/**
+ * Returns whether incremental reachability analysis has been started by TryCollectGarbageIncremental and not finished yet.
+ */
+COREUOBJECT_API bool IsIncrementalReachabilityAnalysisPending();
+
+/** Whether incremental reachability analysis is in progress, use IsIncrementalReachabilityAnalysisPending() instead of checking this directly */
+extern COREUOBJECT_API bool GIsIncrementalReachabilityPending;
+
+/** Slow path of GCWriteBarrier */
+COREUOBJECT_API void GCMarkObjectReachableIncremental(const class UObjectBase* Object);
+
+/**
+ * Write barrier for incremental reachability analysis. Has to be called with the object being referenced whenever a
+ * reference the garbage collector follows (a UPROPERTY, or anything reported to AddReferencedObjects) is written while
+ * incremental reachability analysis may be in progress, otherwise an object that is only referenced from objects that
+ * have already been processed can be collected while still in use. UObjectProperty::SetObjectPropertyValue, AddToRoot,
+ * renames and UProperty value copies (through GCWriteBarrierPropertyValue) already call it. Native code writing UObject*
+ * members directly does not go through any of those. Does nothing unless a pass is in progress.
+ *
+ * @param	Object	the object a reference has just been written to, can be null
+ */
+FORCEINLINE void GCWriteBarrier(const class UObjectBase* Object)
+{
+	if (GIsIncrementalReachabilityPending && Object)
+	{
+		GCMarkObjectReachableIncremental(Object);
+	}
+}
+
+/**
+ * Calls GCWriteBarrier for every object referenced by a property value that has just been written. Called by
+ * UProperty::CopySingleValue and CopyCompleteValue, so the Blueprint VM's assignments, out parameters and struct and
+ * container copies are covered. Does nothing unless a pass is in progress or the property can't reference objects.
+ *
+ * @param	Property	the property the value belongs to
+ * @param	Value		address of the first element written
+ * @param	Count		number of consecutive elements written
+ */
+COREUOBJECT_API void GCWriteBarrierPropertyValue(const class UProperty* Property, const void* Value, int32 Count);
+
+/**
+ * Has to be called whenever an object that may be part of a GC cluster starts referencing another object at runtime.
+ * Clusters are traced as a whole, so references added after a cluster has been created are not seen by the garbage
+ * collector: unless the referenced object is already part of the same cluster, the cluster gets dissolved before the next
+ * reachability analysis. Also acts as GCWriteBarrier for the referenced object.
+ *
+ * @param	ReferencingObject	the object a reference has just been written to
+ * @param	Object				the object now being referenced, can be null
+ */
+COREUOBJECT_API void GCClusterWriteBarrier(const class UObjectBase* ReferencingObject, const class UObjectBase* Object);
+
 /**
  * Returns whether an incremental purge is still pending/ in progress.
  *
@@ -421,6 +421,10 @@ public:
 			{
 				CopyValuesInternal(Dest, Src, 1);
 			}
+			if (GIsIncrementalReachabilityPending)
+			{
+				GCWriteBarrierPropertyValue(this, Dest, 1);
+			}
 		}
 	}
 
@@ -463,6 +467,10 @@ public:
 			{
 				CopyValuesInternal(Dest, Src, ArrayDim);
 			}
+			if (GIsIncrementalReachabilityPending)
+			{
+				GCWriteBarrierPropertyValue(this, Dest, ArrayDim);
+			}
 		}
 	}
 	FORCEINLINE void CopyCompleteValue_InContainer( void* Dest, void const* Src ) const
@@ -3140,7 +3140,9 @@ enum class ERotatorQuantization : uint8
 	/** The rotator will be compressed to 8 bits per component. */
 	ByteComponents,
 	/** The rotator will be compressed to 16 bits per component. */
-	ShortComponents
+	ShortComponents,
+	/** The rotation will be sent as a quaternion, with the three smallest components compressed to 15 bits each (47 bits total). */
+	QuatSmallestThree
 };
 
 /** Replicated movement data of our RootComponent.
@@ -3239,6 +3241,18 @@ struct FRepMovement
 				Rotation.SerializeCompressedShort( Ar );
 				break;
 			}
+
+			case ERotatorQuantization::QuatSmallestThree:
+			{
+				FQuat Quat = Rotation.Quaternion();
+				TQuantizedQuat<15>::Serialize( Ar, Quat );
+
+				if ( Ar.IsLoading() )
+				{
+					Rotation = Quat.Rotator();
+				}
+				break;
+			}
 		}
 		
 		bOutSuccess &= SerializeQuantizedVector( Ar, LinearVelocity, VelocityQuantizationLevel );
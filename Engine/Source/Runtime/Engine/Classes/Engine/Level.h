@@ -318,6 +318,26 @@ struct ENGINE_API FLevelSimplificationDetails
 //
 
 
+/**
+ * Root of the GC cluster a level creates for its static actors when it's loaded (gc.ActorClustering).
+ * The level itself can't be the cluster root as actors get added to and removed from it at runtime.
+ */
+UCLASS(Transient)
+class ENGINE_API ULevelActorContainer : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Actors in this cluster, see AActor::CanBeInCluster */
+	UPROPERTY()
+	TArray<AActor*> Actors;
+
+	//~ Begin UObject Interface.
+	virtual bool CanClusterObjectsFromOtherPackages() const override;
+	//~ End UObject Interface.
+};
+
 /**
  * A Level is a collection of Actors (lights, volumes, mesh instances etc.).
  * Multiple Levels can be loaded and unloaded into the World to create a streaming experience.
@@ -367,6 +387,10 @@ public:
 	UPROPERTY(NonTransactional)
 	class ALevelScriptActor* LevelScriptActor;
 
+	/** Static actors of this level clustered together for garbage collection, created when the level is loaded */
+	UPROPERTY(Transient)
+	ULevelActorContainer* ActorCluster;
+
 	/**
 	 * Start and end of the navigation list for this level, used for quickly fixing up
 	 * when streaming this level in/out. @TODO DEPRECATED - DELETE
@@ -555,6 +579,9 @@ public:
 	virtual void PreSave() override;
 	virtual void PostDuplicate(bool bDuplicateForPIE) override;
 	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	virtual bool CanBeClusterRoot() const override;
+	virtual bool CanBeInCluster() const override;
+	virtual void CreateCluster() override;
 	//~ End UObject Interface.
 
 	/**
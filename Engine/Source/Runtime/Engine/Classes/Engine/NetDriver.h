@@ -11,6 +11,9 @@
 class FRepChangedPropertyTracker;
 class FRepLayout;
 class FObjectReplicator;
+class FNetworkObjectList;
+class FNetRelevancyGrid;
+struct FConnectionPriorities;
 
 //
 // Whether to support net lag and packet loss testing.
@@ -172,6 +175,14 @@ public:
 	UPROPERTY(Config)
 	bool bNoTimeouts;
 
+	/** Size in world units of a cell of the spatial relevancy grid (net.SpatialRelevancy) */
+	UPROPERTY(Config)
+	float SpatialRelevancyCellSize;
+
+	/** Native actor classes (and their subclasses) that do not override IsNetRelevantFor and can use the spatial relevancy grid. AActor is always included. */
+	UPROPERTY(Config)
+	TArray<FString> SpatialRelevancyClasses;
+
 	/** Connection to the server (this net driver is a client) */
 	UPROPERTY()
 	class UNetConnection* ServerConnection;
@@ -308,6 +319,27 @@ public:
 	/** Used to invalidate properties marked "unchanged" in FRepChangedPropertyTracker's */
 	uint32																		ReplicationFrame;
 
+	/** Replicated actors known to this driver, maintained incrementally and scheduled by NetUpdateTime */
+	TSharedPtr< FNetworkObjectList >											NetworkObjects;
+
+	/** Per-frame spatial hash shared by all connections for distance based relevancy, used when net.SpatialRelevancy is enabled */
+	TSharedPtr< FNetRelevancyGrid >												RelevancyGrid;
+
+	/** Returns true if Actor is relevant to any of the viewers of a connection, using the spatial relevancy grid when it is active */
+	bool IsActorRelevantToConnection( const AActor* Actor, const TArray<struct FNetViewer>& ConnectionViewers );
+
+	/**
+	 * Builds the list of actors to replicate to a connection this frame. Dormancy, relevancy, GetNetPriority and other game thread work happens here.
+	 * If bDeferSort is true, the sort is left to be done on a worker thread before the list is processed.
+	 */
+	void ServerReplicateActors_PrioritizeActors( UNetConnection* Connection, const TArray<AActor*>& ConsiderList, const bool bCPUSaturated, const float DeltaSeconds, const bool bDeferSort, FConnectionPriorities& OutPriorities );
+
+	/** Replicates the sorted actors of a connection until it is saturated. Returns the number of actors replicated. */
+	int32 ServerReplicateActors_ProcessPrioritizedActors( FConnectionPriorities& Priorities, const int32 NumConsidered );
+
+	/** Compares the shared replicated properties of the considered actors on worker threads, so that connections replicating them this frame can skip the compare */
+	void ServerReplicateActors_PreCompareProperties( const TArray<AActor*>& ConsiderList, const int32 NumClientsToTick );
+
 	/** Maps FRepLayout to the respective UClass */
 	TMap< TWeakObjectPtr< UObject >, TSharedPtr< FRepLayout > >					RepLayoutMap;
 
@@ -561,6 +593,9 @@ public:
 	*/
 	TSharedPtr<FRepChangedPropertyTracker> FindOrCreateRepChangedPropertyTracker(UObject *Obj);
 
+	/** Returns the persistent list of replicated actors used by ServerReplicateActors */
+	FNetworkObjectList& GetNetworkObjectList() { return *NetworkObjects; }
+
 	/** Returns true if the client should destroy immediately any actor that becomes torn-off */
 	virtual bool ShouldClientDestroyTearOffActors() const { return false; }
 
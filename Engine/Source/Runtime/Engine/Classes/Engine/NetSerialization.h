@@ -10,6 +10,7 @@
 #include "CoreNet.h"
 #include "CoreUObject.h"
 #include "EngineLogs.h"
+#include "Net/NetQuantization.h"
 #include "NetSerialization.generated.h"
 
 /**
@@ -792,6 +792,7 @@ public:
 	virtual bool IsReadyForFinishDestroy() override;
 	virtual void PreSave() override;
 	virtual void Serialize(FArchive& Ar) override;
+	virtual bool IsSerializeThreadSafe() const override;
 	virtual void PostInitProperties() override;
 	virtual void PostLoad() override;
 	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
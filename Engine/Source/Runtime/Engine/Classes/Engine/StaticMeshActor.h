@@ -24,6 +24,7 @@ private_subobject:
 public:
 	
 	virtual void BeginPlay() override;
+	virtual bool CanBeInCluster() const override;
 
 	/** This static mesh should replicate movement. Automatically sets the RemoteRole and bReplicateMovement flags. Meant to be edited on placed actors (those other two properties are not) */
 	UPROPERTY(Category=Actor, EditAnywhere, AdvancedDisplay)
@@ -379,6 +379,15 @@ public:
 	UPROPERTY()
 	uint8 bRelevantForNetworkReplays:1;
 
+	/**
+	 * If true, this actor is put into its level's GC cluster when the level is loaded (gc.ActorClustering), as long as it's also static,
+	 * doesn't tick, isn't replicated and isn't a Blueprint class. Clustered actors are not traced by the garbage collector on their own, references they get at
+	 * runtime have to be reported with GCClusterWriteBarrier, which dissolves the cluster. Components, attachment and ownership already do.
+	 * @see CanBeInCluster()
+	 */
+	UPROPERTY(EditDefaultsOnly, Category=Actor, AdvancedDisplay)
+	uint8 bCanBeInCluster:1;
+
 	/** Controls how to handle spawning this actor in a situation where it's colliding with something else. "Default" means AlwaysSpawn here. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Actor)
 	ESpawnActorCollisionHandlingMethod SpawnCollisionHandlingMethod;
@@ -1370,6 +1379,7 @@ public:
 	virtual void Serialize(FArchive& Ar) override;
 	virtual void PostLoad() override;
 	virtual void PostLoadSubobjects( FObjectInstancingGraph* OuterInstanceGraph ) override;
+	virtual bool CanBeInCluster() const override;
 	virtual void BeginDestroy() override;
 	virtual bool IsReadyForFinishDestroy() override;
 	virtual bool Rename( const TCHAR* NewName=NULL, UObject* NewOuter=NULL, ERenameFlags Flags=REN_None ) override;
@@ -283,6 +283,7 @@ public:
 	virtual FName GetExporterName() override;
 	virtual FString GetDesc() override;
 	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+	virtual bool CanBeClusterRoot() const override;
 	//~ End UObject Interface. 
 
 	//~ Begin USoundBase Interface.
@@ -10,6 +10,7 @@
 #include "MessageLog.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/RepLayout.h"
+#include "Net/NetworkObjectList.h"
 #include "DisplayDebugHelpers.h"
 #include "Matinee/MatineeActor.h"
 #include "Matinee/InterpGroup.h"
@@ -96,6 +97,7 @@ void AActor::InitializeDefaults()
 	bFindCameraComponentWhenViewTarget = true;
 	bAllowReceiveTickEventOnDedicatedServer = true;
 	bRelevantForNetworkReplays = true;
+	bCanBeInCluster = false;
 #if WITH_EDITORONLY_DATA
 	PivotOffset = FVector::ZeroVector;
 #endif
@@ -575,6 +577,14 @@ void AActor::PostLoad()
 	}
 }
 
+bool AActor::CanBeInCluster() const
+{
+	// Anything that could make the actor reference new objects at runtime without GCClusterWriteBarrier rules it out,
+	// including Blueprint classes, since Blueprint variable writes don't go through the cluster barrier
+	return bCanBeInCluster && GetClass()->HasAnyClassFlags(CLASS_Native) && !bReplicates && !PrimaryActorTick.bCanEverTick && !HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) &&
+		RootComponent && RootComponent->Mobility == EComponentMobility::Static;
+}
+
 void AActor::PostLoadSubobjects(FObjectInstancingGraph* OuterInstanceGraph)
 {
 	USceneComponent* OldRoot = RootComponent;
@@ -1375,7 +1385,9 @@ void AActor::SetOwner( AActor *NewOwner )
 			// add to new owner's Children array
 			checkSlow(!Owner->Children.Contains(this));
 			Owner->Children.Add(this);
+			GCClusterWriteBarrier(Owner, this);
 		}
+		GCClusterWriteBarrier(this, Owner);
 
 		// mark all components for which Owner is relevant for visibility to be updated
 		MarkOwnerRelevantComponentsDirty(this);
@@ -1647,7 +1659,18 @@ bool AActor::IsRelevancyOwnerFor(const AActor* ReplicatedActor, const AActor* Ac
 
 void AActor::SetNetUpdateTime(float NewUpdateTime)
 {
+	const bool bMovedEarlier = NewUpdateTime < NetUpdateTime;
 	NetUpdateTime = NewUpdateTime;
+
+	// The net driver only revisits an actor once its queued update time has passed, so it needs to hear about earlier updates
+	if (bMovedEarlier && Role == ROLE_Authority && GetWorld() != nullptr)
+	{
+		UNetDriver* NetDriver = GetNetDriver();
+		if (NetDriver != nullptr)
+		{
+			NetDriver->GetNetworkObjectList().Schedule(this);
+		}
+	}
 }
 
 void AActor::ForceNetUpdate()
@@ -2295,6 +2318,7 @@ void AActor::AddOwnedComponent(UActorComponent* Component)
 {
 	check(Component->GetOwner() == this);
 	OwnedComponents.AddUnique(Component);
+	GCClusterWriteBarrier(this, Component);
 
 	if (Component->GetIsReplicated())
 	{
@@ -2390,6 +2414,7 @@ void AActor::AddInstanceComponent(UActorComponent* Component)
 {
 	Component->CreationMethod = EComponentCreationMethod::Instance;
 	InstanceComponents.AddUnique(Component);
+	GCClusterWriteBarrier(this, Component);
 }
 
 void AActor::RemoveInstanceComponent(UActorComponent* Component)
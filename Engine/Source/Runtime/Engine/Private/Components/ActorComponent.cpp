@@ -198,6 +198,13 @@ void UActorComponent::PostLoad()
 	}
 }
 
+bool UActorComponent::CanBeInCluster() const
+{
+	// Components are clustered with their actor, unless they tick, replicate or are Blueprint components (their variables don't go through the cluster barrier)
+	const AActor* MyOwner = GetOwner();
+	return MyOwner && MyOwner->CanBeInCluster() && GetClass()->HasAnyClassFlags(CLASS_Native) && !PrimaryComponentTick.bCanEverTick && !GetIsReplicated();
+}
+
 bool UActorComponent::Rename( const TCHAR* InName, UObject* NewOuter, ERenameFlags Flags )
 {
 	bRoutedPostRename = false;
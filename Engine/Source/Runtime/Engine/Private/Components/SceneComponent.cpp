@@ -1516,6 +1516,8 @@ bool USceneComponent::AttachTo(class USceneComponent* Parent, FName InSocketName
 		{
 			Parent->AttachChildren.Add(this);
 		}
+		GCClusterWriteBarrier(Parent, this);
+		GCClusterWriteBarrier(this, Parent);
 
 		switch ( AttachType )
 		{
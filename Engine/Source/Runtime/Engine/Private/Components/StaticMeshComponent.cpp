@@ -1294,6 +1294,7 @@ bool UStaticMeshComponent::SetStaticMesh(UStaticMesh* NewMesh)
 	RemoveSpeedTreeWind();
 
 	StaticMesh = NewMesh;
+	GCClusterWriteBarrier(this, StaticMesh);
 
 	// Add speed tree wind if required
 	AddSpeedTreeWind();
@@ -8,6 +8,7 @@
 #include "Net/DataChannel.h"
 #include "Net/DataReplication.h"
 #include "Net/NetworkProfiler.h"
+#include "Net/NetworkObjectList.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/ActorChannel.h"
 #include "Engine/ControlChannel.h"
@@ -1464,6 +1465,7 @@ void UActorChannel::Close()
 		{
 			check( Actor->NetDormancy > DORM_Awake ); // Dormancy should have been canceled if game code changed NetDormancy
 			Connection->DormantActors.Add(Actor);
+			Connection->Driver->GetNetworkObjectList().MarkDormant(Actor, Connection, Connection->Driver->ClientConnections.Num());
 
 			// Validation checking
 			static const auto ValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
@@ -1738,6 +1740,7 @@ void UActorChannel::SetChannelActor( AActor* InActor )
 	// Remove from connection's dormancy lists
 	Connection->DormantActors.Remove( InActor );
 	Connection->RecentlyDormantActors.Remove( InActor );
+	Connection->Driver->GetNetworkObjectList().MarkActive( InActor, Connection );
 }
 
 void UActorChannel::SetChannelActorForDestroy( FActorDestructionInfo *DestructInfo )
@@ -9,6 +9,7 @@
 #include "Net/NetworkProfiler.h"
 #include "Net/RepLayout.h"
 #include "Net/DataReplication.h"
+#include "Net/RepArrayDelta.h"
 #include "Engine/ActorChannel.h"
 #include "Engine/PackageMapClient.h"
 
@@ -58,7 +59,7 @@ bool IsCustomDeltaProperty( UProperty * Property )
 		return true;
 	}
 
-	return false;
+	return FRepArrayDelta::IsArrayDeltaProperty( Property );
 }
 
 bool FObjectReplicator::SerializeCustomDeltaProperty( UNetConnection * Connection, void* Src, UProperty * Property, int32 ArrayDim, FNetBitWriter & OutBunch, TSharedPtr<INetDeltaBaseState> &NewFullState, TSharedPtr<INetDeltaBaseState> & OldState )
@@ -67,6 +68,23 @@ bool FObjectReplicator::SerializeCustomDeltaProperty( UNetConnection * Connectio
 
 	SCOPE_CYCLE_COUNTER( STAT_NetSerializeItemDeltaTime );
 
+	FNetSerializeCB NetSerializeCB( Connection->Driver );
+
+	UArrayProperty * ArrayProperty = Cast< UArrayProperty >( Property );
+
+	if ( ArrayProperty != NULL )
+	{
+		FNetDeltaSerializeInfo Parms;
+
+		Parms.Writer			= &OutBunch;
+		Parms.Map				= Connection->PackageMap;
+		Parms.OldState			= OldState.Get();
+		Parms.NewState			= &NewFullState;
+		Parms.NetSerializeCB	= &NetSerializeCB;
+
+		return FRepArrayDelta::WriteDelta( ArrayProperty, Parms, Property->ContainerPtrToValuePtr<void>( Src, ArrayDim ) );
+	}
+
 	UStructProperty * StructProperty = CastChecked< UStructProperty >( Property );
 
 	//------------------------------------------------
@@ -79,8 +97,6 @@ bool FObjectReplicator::SerializeCustomDeltaProperty( UNetConnection * Connectio
 
 	FNetDeltaSerializeInfo Parms;
 
-	FNetSerializeCB NetSerializeCB( Connection->Driver );
-
 	Parms.Writer			= &OutBunch;
 	Parms.Map				= Connection->PackageMap;
 	Parms.OldState			= OldState.Get();
@@ -124,6 +140,12 @@ void FObjectReplicator::InitRecentProperties( uint8* Source )
 		{
 			if ( IsCustomDeltaProperty( *It ) )
 			{
+				if ( It->IsA( UArrayProperty::StaticClass() ) )
+				{
+					// The client has no element IDs for the default state, so array deltas always start with a full update
+					continue;
+				}
+
 				// We have to handle dynamic properties of the array individually
 				for ( int32 ArrayIdx = 0; ArrayIdx < It->ArrayDim; ++ArrayIdx )
 				{
@@ -220,6 +242,7 @@ void FObjectReplicator::CleanUp()
 
 	// Cleanup custom delta state
 	RecentCustomDeltaState.Empty();
+	ArrayDeltaElementIDs.Empty();
 
 	LifetimeCustomDeltaProperties.Empty();
 	LifetimeCustomDeltaPropertyConditions.Empty();
@@ -566,53 +589,81 @@ bool FObjectReplicator::ReceivedBunch( FInBunch& Bunch, const FReplicationFlags&
 				TArray<uint8>	MetaData;
 				const PTRINT DataOffset = Data - (uint8*)Object;
 
-				// Receive custom delta property.
-				UStructProperty * StructProperty = Cast< UStructProperty >( ReplicatedProp );
+				UArrayProperty * ArrayProperty = Cast< UArrayProperty >( ReplicatedProp );
 
-				if ( StructProperty == NULL )
+				if ( ArrayProperty != NULL )
 				{
-					// This property isn't custom delta
-					UE_LOG(LogRepTraffic, Error, TEXT("Property isn't custom delta %s"), *ReplicatedProp->GetName());
-					return false;
-				}
+					if ( ReplicatedProp->HasAnyPropertyFlags( CPF_RepNotify ) )
+					{
+						// Array deltas aren't part of the FRepLayout shadow state, keep it up to date so RepNotifies get the previous value
+						ReplicatedProp->CopySingleValue( ReplicatedProp->ContainerPtrToValuePtr<uint8>( RepState->StaticBuffer.GetData(), Element ), Data );
+					}
 
-				UScriptStruct * InnerStruct = StructProperty->Struct;
+					FNetDeltaSerializeInfo Parms;
 
-				if ( !( InnerStruct->StructFlags & STRUCT_NetDeltaSerializeNative ) )
-				{
-					// This property isn't custom delta
-					UE_LOG(LogRepTraffic, Error, TEXT("Property isn't custom delta %s"), *ReplicatedProp->GetName());
-					return false;
+					FNetSerializeCB NetSerializeCB( OwningChannel->Connection->Driver );
+
+					Parms.DebugName			= ArrayProperty->GetName();
+					Parms.Map				= PackageMap;
+					Parms.Reader			= &Bunch;
+					Parms.NetSerializeCB	= &NetSerializeCB;
+
+					if ( !FRepArrayDelta::ReadDelta( ArrayProperty, Parms, Data, ArrayDeltaElementIDs.FindOrAdd( ReplicatedProp->RepIndex ) ) || Bunch.IsError() )
+					{
+						UE_LOG(LogNet, Error, TEXT("ReceivedBunch: FRepArrayDelta::ReadDelta failed: %s"), *Object->GetFullName());
+						return false;
+					}
 				}
+				else
+				{
+					// Receive custom delta property.
+					UStructProperty * StructProperty = Cast< UStructProperty >( ReplicatedProp );
 
-				UScriptStruct::ICppStructOps * CppStructOps = InnerStruct->GetCppStructOps();
+					if ( StructProperty == NULL )
+					{
+						// This property isn't custom delta
+						UE_LOG(LogRepTraffic, Error, TEXT("Property isn't custom delta %s"), *ReplicatedProp->GetName());
+						return false;
+					}
 
-				check( CppStructOps );
-				check( !InnerStruct->InheritedCppStructOps() );
+					UScriptStruct * InnerStruct = StructProperty->Struct;
 
-				FNetDeltaSerializeInfo Parms;
+					if ( !( InnerStruct->StructFlags & STRUCT_NetDeltaSerializeNative ) )
+					{
+						// This property isn't custom delta
+						UE_LOG(LogRepTraffic, Error, TEXT("Property isn't custom delta %s"), *ReplicatedProp->GetName());
+						return false;
+					}
 
-				FNetSerializeCB NetSerializeCB( OwningChannel->Connection->Driver );
+					UScriptStruct::ICppStructOps * CppStructOps = InnerStruct->GetCppStructOps();
 
-				Parms.DebugName			= StructProperty->GetName();
-				Parms.Struct			= InnerStruct;
-				Parms.Map				= PackageMap;
-				Parms.Reader			= &Bunch;
-				Parms.NetSerializeCB	= &NetSerializeCB;
+					check( CppStructOps );
+					check( !InnerStruct->InheritedCppStructOps() );
 
-				// Call the custom delta serialize function to handle it
-				CppStructOps->NetDeltaSerialize( Parms, Data );
+					FNetDeltaSerializeInfo Parms;
 
-				if ( Bunch.IsError() )
-				{
-					UE_LOG(LogNet, Error, TEXT("ReceivedBunch: NetDeltaSerialize - Bunch.IsError() == true: %s"), *Object->GetFullName());
-					return false;
-				}
+					FNetSerializeCB NetSerializeCB( OwningChannel->Connection->Driver );
 
-				if ( Parms.bOutHasMoreUnmapped )
-				{
-					UnmappedCustomProperties.Add( DataOffset, StructProperty );
-					bOutHasUnmapped = true;
+					Parms.DebugName			= StructProperty->GetName();
+					Parms.Struct			= InnerStruct;
+					Parms.Map				= PackageMap;
+					Parms.Reader			= &Bunch;
+					Parms.NetSerializeCB	= &NetSerializeCB;
+
+					// Call the custom delta serialize function to handle it
+					CppStructOps->NetDeltaSerialize( Parms, Data );
+
+					if ( Bunch.IsError() )
+					{
+						UE_LOG(LogNet, Error, TEXT("ReceivedBunch: NetDeltaSerialize - Bunch.IsError() == true: %s"), *Object->GetFullName());
+						return false;
+					}
+
+					if ( Parms.bOutHasMoreUnmapped )
+					{
+						UnmappedCustomProperties.Add( DataOffset, StructProperty );
+						bOutHasUnmapped = true;
+					}
 				}
 
 				// Successfully received it.
@@ -318,6 +318,49 @@ void ULevel::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collecto
 	Super::AddReferencedObjects( This, Collector );
 }
 
+bool ULevel::CanBeClusterRoot() const
+{
+	// The level only creates the cluster, its root is ActorCluster
+	return GActorClusteringEnabled != 0;
+}
+
+bool ULevel::CanBeInCluster() const
+{
+	// Actors are spawned into and removed from the level at runtime
+	return false;
+}
+
+void ULevel::CreateCluster()
+{
+	if (ActorCluster)
+	{
+		return;
+	}
+
+	TArray<AActor*> ClusterActors;
+	for (AActor* Actor : Actors)
+	{
+		if (Actor && Actor->CanBeInCluster())
+		{
+			ClusterActors.Add(Actor);
+		}
+	}
+
+	if (ClusterActors.Num())
+	{
+		ActorCluster = NewObject<ULevelActorContainer>(this, TEXT("ActorCluster"), RF_Transient);
+		ActorCluster->Actors = MoveTemp(ClusterActors);
+		ActorCluster->CreateCluster();
+		UE_LOG(LogLevel, Verbose, TEXT("Clustered %d actors of %s"), ActorCluster->Actors.Num(), *GetPathName());
+	}
+}
+
+bool ULevelActorContainer::CanClusterObjectsFromOtherPackages() const
+{
+	// Assets used by the level may be used by other levels too, and would otherwise keep this level's cluster alive after it has been unloaded
+	return false;
+}
+
 void ULevel::Serialize( FArchive& Ar )
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("ULevel::Serialize"), STAT_Level_Serialize, STATGROUP_LoadTime);
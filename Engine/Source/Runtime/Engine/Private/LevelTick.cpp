@@ -84,6 +84,7 @@ DEFINE_STAT(STAT_NetPrioritizeActorsTime);
 DEFINE_STAT(STAT_NetReplicateActorsTime);
 DEFINE_STAT(STAT_NetReplicateDynamicPropTime);
 DEFINE_STAT(STAT_NetSkippedDynamicProps);
+DEFINE_STAT(STAT_NetSharedChangelistComparesSaved);
 DEFINE_STAT(STAT_NetSerializeItemDeltaTime);
 DEFINE_STAT(STAT_NetReplicateStaticPropTime);
 DEFINE_STAT(STAT_NetBroadcastPostTickTime);
@@ -1381,6 +1382,12 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 		{
 			bShouldDelayGarbageCollect = false;
 		}
+		// Carry on with incremental reachability analysis (gc.IncrementalReachability) until it's done.
+		else if (IsIncrementalReachabilityAnalysisPending())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+			PerformGarbageCollectionAndCleanupActors();
+		}
 		// Perform incremental purge update if it's pending or in progress.
 		else if( !IsIncrementalPurgePending() 
 		// Purge reference to pending kill objects every now and so often.
@@ -1475,11 +1482,13 @@ void UWorld::DelayGarbageCollection()
 void UWorld::PerformGarbageCollectionAndCleanupActors()
 {
 	// We don't collect garbage while there are outstanding async load requests as we would need
-	// to block on loading the remaining data.
-	if( !IsAsyncLoading() )
+	// to block on loading the remaining data. Incremental reachability analysis that is already in
+	// progress can keep marking, it doesn't finish before loading is done.
+	if( !IsAsyncLoading() || IsIncrementalReachabilityAnalysisPending() )
 	{
-		// Perform housekeeping.
-		if (TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false))
+		// Perform housekeeping. The editor always collects garbage in one go.
+		const bool bCollected = GIsEditor ? TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false) : TryCollectGarbageIncremental(GARBAGE_COLLECTION_KEEPFLAGS);
+		if (bCollected)
 		{
 			CleanupActors();
 
@@ -8,6 +8,7 @@
 #include "Net/UnrealNetwork.h"
 #include "Net/NetworkProfiler.h"
 #include "Net/DataReplication.h"
+#include "Net/NetworkObjectList.h"
 #include "Engine/ActorChannel.h"
 #include "DataChannel.h"
 #include "Engine/PackageMapClient.h"
@@ -288,6 +289,7 @@ void UNetConnection::CleanUp()
 		{
 			check(Driver->ServerConnection == NULL);
 			verify(Driver->ClientConnections.Remove(this) == 1);
+			Driver->GetNetworkObjectList().OnConnectionRemoved(this, Driver->ClientConnections.Num());
 
 			PerfCountersIncrement(TEXT("RemovedConnections"));
 		}
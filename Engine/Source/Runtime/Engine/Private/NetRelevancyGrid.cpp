@@ -0,0 +1,235 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetRelevancyGrid.cpp: Spatial hash for distance based network relevancy.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/NetRelevancyGrid.h"
+#include "GameFramework/GameNetworkManager.h"
+
+FNetRelevancyGrid::FNetRelevancyGrid()
+	: CellSize( 10000.0f )
+	, MaxCullDistance( 0.0f )
+	, NumCellQueries( 0 )
+{
+}
+
+void FNetRelevancyGrid::SetCellSize( float InCellSize )
+{
+	CellSize = FMath::Max( InCellSize, 100.0f );
+	Reset();
+}
+
+void FNetRelevancyGrid::SetDefaultRelevancyClasses( const TArray< FString >& ClassNames )
+{
+	DefaultRelevancyClassNames.Reset();
+
+	for ( const FString& ClassName : ClassNames )
+	{
+		DefaultRelevancyClassNames.AddUnique( FName( *ClassName ) );
+	}
+
+	ClassCache.Empty();
+}
+
+void FNetRelevancyGrid::Reset()
+{
+	GridActors.Reset();
+	ActorToGridIndex.Reset();
+	CellActors.Reset();
+	RelevantSets.Reset();
+	MaxCullDistance = 0.0f;
+	NumCellQueries = 0;
+}
+
+void FNetRelevancyGrid::Build( const TArray< AActor* >& ConsiderList )
+{
+	Reset();
+
+	if ( !GetDefault< AGameNetworkManager >()->bUseDistanceBasedRelevancy )
+	{
+		// Everything that gets this far is relevant at any distance, there is nothing to share
+		return;
+	}
+
+	float MaxCullDistanceSquared = 0.0f;
+
+	for ( const AActor* Actor : ConsiderList )
+	{
+		if ( Actor == nullptr || !CanUseGrid( Actor ) )
+		{
+			continue;
+		}
+
+		FGridActor GridActor;
+		GridActor.Actor = Actor;
+		GridActor.Location = Actor->GetActorLocation();
+		GridActor.CullDistanceSquared = Actor->NetCullDistanceSquared;
+
+		const int32 GridIndex = GridActors.Add( GridActor );
+		ActorToGridIndex.Add( Actor, GridIndex );
+		CellActors.FindOrAdd( GetCell( GridActor.Location ) ).Add( GridIndex );
+
+		MaxCullDistanceSquared = FMath::Max( MaxCullDistanceSquared, GridActor.CullDistanceSquared );
+	}
+
+	MaxCullDistance = FMath::Sqrt( MaxCullDistanceSquared );
+}
+
+bool FNetRelevancyGrid::IsRelevantToViewers( const AActor* Actor, const TArray< FNetViewer >& Viewers )
+{
+	const int32* GridIndex = ActorToGridIndex.Find( Actor );
+
+	if ( GridIndex == nullptr )
+	{
+		for ( const FNetViewer& Viewer : Viewers )
+		{
+			if ( Actor->IsNetRelevantFor( Viewer.InViewer, Viewer.ViewTarget, Viewer.ViewLocation ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	for ( const FNetViewer& Viewer : Viewers )
+	{
+		// Viewer dependent rules from AActor::IsNetRelevantFor, they are cheap so they are not cached
+		if ( Actor->IsOwnedBy( Viewer.ViewTarget ) || Actor->IsOwnedBy( Viewer.InViewer ) || Actor == Viewer.ViewTarget || Viewer.ViewTarget == Actor->Instigator )
+		{
+			return true;
+		}
+
+		// The cell set only rules actors out, the ones in it still need the exact distance from this viewer
+		if ( GetRelevantSet( GetCell( Viewer.ViewLocation ) )[ *GridIndex ] )
+		{
+			const FGridActor& GridActor = GridActors[ *GridIndex ];
+
+			if ( ( Viewer.ViewLocation - GridActor.Location ).SizeSquared() < GridActor.CullDistanceSquared )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool FNetRelevancyGrid::CanUseGrid( const AActor* Actor )
+{
+	// Anything that does not end in the distance check of AActor::IsNetRelevantFor goes through the virtual call
+	if ( Actor->bAlwaysRelevant || Actor->bOnlyRelevantToOwner || ( Actor->bNetUseOwnerRelevancy && Actor->GetOwner() ) )
+	{
+		return false;
+	}
+
+	const USceneComponent* RootComponent = Actor->GetRootComponent();
+
+	if ( RootComponent == nullptr )
+	{
+		return false;
+	}
+
+	if ( RootComponent->AttachParent && RootComponent->AttachParent->GetOwner() && ( Cast< USkeletalMeshComponent >( RootComponent->AttachParent ) || ( RootComponent->AttachParent->GetOwner() == Actor->GetOwner() ) ) )
+	{
+		return false;
+	}
+
+	if ( Actor->bHidden && !RootComponent->IsCollisionEnabled() )
+	{
+		return false;
+	}
+
+	return UsesDefaultRelevancy( Actor->GetClass() );
+}
+
+bool FNetRelevancyGrid::UsesDefaultRelevancy( UClass* InClass )
+{
+	if ( const bool* bCached = ClassCache.Find( InClass ) )
+	{
+		return *bCached;
+	}
+
+	// Only native classes can override IsNetRelevantFor
+	UClass* NativeClass = InClass;
+	while ( NativeClass != nullptr && !NativeClass->HasAnyClassFlags( CLASS_Native ) )
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	bool bUsesDefault = ( NativeClass == AActor::StaticClass() );
+
+	for ( UClass* TestClass = NativeClass; !bUsesDefault && TestClass != nullptr && TestClass != AActor::StaticClass(); TestClass = TestClass->GetSuperClass() )
+	{
+		bUsesDefault = DefaultRelevancyClassNames.Contains( TestClass->GetFName() );
+	}
+
+	ClassCache.Add( InClass, bUsesDefault );
+
+	return bUsesDefault;
+}
+
+FIntVector FNetRelevancyGrid::GetCell( const FVector& Location ) const
+{
+	return FIntVector( FMath::FloorToInt( Location.X / CellSize ), FMath::FloorToInt( Location.Y / CellSize ), FMath::FloorToInt( Location.Z / CellSize ) );
+}
+
+const TBitArray<>& FNetRelevancyGrid::GetRelevantSet( const FIntVector& Cell )
+{
+	if ( const TBitArray<>* Existing = RelevantSets.Find( Cell ) )
+	{
+		return *Existing;
+	}
+
+	NumCellQueries++;
+
+	TBitArray<>& RelevantSet = RelevantSets.Add( Cell, TBitArray<>( false, GridActors.Num() ) );
+
+	const FBox CellBounds( FVector( Cell.X, Cell.Y, Cell.Z ) * CellSize, FVector( Cell.X + 1, Cell.Y + 1, Cell.Z + 1 ) * CellSize );
+
+	auto AddRelevantActors = [&]( const TArray< int32 >& Indices )
+	{
+		for ( int32 GridIndex : Indices )
+		{
+			const FGridActor& GridActor = GridActors[ GridIndex ];
+
+			if ( CellBounds.ComputeSquaredDistanceToPoint( GridActor.Location ) < GridActor.CullDistanceSquared )
+			{
+				RelevantSet[ GridIndex ] = true;
+			}
+		}
+	};
+
+	const int32 Range = FMath::CeilToInt( MaxCullDistance / CellSize );
+	const int64 NumCellsPerSide = 2 * (int64)Range + 1;
+	const int64 NumNeighbourCells = NumCellsPerSide * NumCellsPerSide * NumCellsPerSide;
+
+	if ( NumNeighbourCells < CellActors.Num() )
+	{
+		for ( int32 Z = Cell.Z - Range; Z <= Cell.Z + Range; Z++ )
+		{
+			for ( int32 Y = Cell.Y - Range; Y <= Cell.Y + Range; Y++ )
+			{
+				for ( int32 X = Cell.X - Range; X <= Cell.X + Range; X++ )
+				{
+					if ( const TArray< int32 >* Indices = CellActors.Find( FIntVector( X, Y, Z ) ) )
+					{
+						AddRelevantActors( *Indices );
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		// Fewer occupied cells than cells in range, just test them all
+		for ( const auto& Pair : CellActors )
+		{
+			AddRelevantActors( Pair.Value );
+		}
+	}
+
+	return RelevantSet;
+}
@@ -9,6 +9,8 @@
 #include "Net/UnrealNetwork.h"
 #include "Net/NetworkProfiler.h"
 #include "Net/RepLayout.h"
+#include "Net/NetworkObjectList.h"
+#include "Net/NetRelevancyGrid.h"
 #include "Engine/ActorChannel.h"
 #include "Engine/VoiceChannel.h"
 #include "GameFramework/GameNetworkManager.h"
@@ -19,6 +21,7 @@
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/GameMode.h"
 #include "PerfCountersHelpers.h"
+#include "ParallelFor.h"
 
 
 #if USE_SERVER_PERF_COUNTERS
@@ -103,6 +106,20 @@ static TAutoConsoleVariable<float> CVarNetDormancyDrawCullDistance(
 	TEXT("Max world units an actor can be away from the local view to draw its dormancy status"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarNetSpatialRelevancy(
+	TEXT("net.SpatialRelevancy"),
+	0,
+	TEXT("Buckets considered actors and viewers into a grid so distance based relevancy is computed once per cell and shared between connections.\n")
+	TEXT("Actors whose class overrides IsNetRelevantFor still use the virtual call. 1 Enables, 0 disables."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNetParallelReplication(
+	TEXT("net.ParallelReplication"),
+	0,
+	TEXT("Sorts each connection's prioritized actor list and compares shared replicated properties on task graph worker threads.\n")
+	TEXT("Net priorities are still evaluated and bunches are still written on the game thread. 1 Enables, 0 disables."),
+	ECVF_Default);
+
 static TAutoConsoleVariable<int32> CVarNetDormancyValidate(
 	TEXT("net.DormancyValidate"),
 	0,
@@ -119,6 +136,7 @@ UNetDriver::UNetDriver(const FObjectInitializer& ObjectInitializer)
 ,	MaxInternetClientRate(10000)
 , 	MaxClientRate(15000)
 ,   bNoTimeouts(false)
+,	SpatialRelevancyCellSize(10000.f)
 ,   ServerConnection(nullptr)
 ,	ClientConnections()
 ,   World(nullptr)
@@ -142,6 +160,8 @@ UNetDriver::UNetDriver(const FObjectInitializer& ObjectInitializer)
 ,	StatPeriod(1.f)
 ,	NetTag(0)
 ,	DebugRelevantActors(false)
+,	NetworkObjects(new FNetworkObjectList)
+,	RelevancyGrid(new FNetRelevancyGrid)
 ,	ProcessQueuedBunchesCurrentFrameMilliseconds(0.0f)
 {
 }
@@ -165,6 +185,12 @@ void UNetDriver::PostInitProperties()
 
 		ProfileStats		= FParse::Param(FCommandLine::Get(),TEXT("profilestats"));
 
+		if (SpatialRelevancyCellSize > 0.f)
+		{
+			RelevancyGrid->SetCellSize(SpatialRelevancyCellSize);
+		}
+		RelevancyGrid->SetDefaultRelevancyClasses(SpatialRelevancyClasses);
+
 #if !UE_BUILD_SHIPPING
 		bNoTimeouts = bNoTimeouts || FParse::Param(FCommandLine::Get(), TEXT("NoTimeouts")) ? true : false;
 #endif // !UE_BUILD_SHIPPING
@@ -1565,6 +1591,8 @@ void UNetDriver::NotifyActorDestroyed( AActor* ThisActor, bool IsSeamlessTravel
 {
 	// Remove the actor from the property tracker map
 	RepChangedPropertyTrackerMap.Remove(ThisActor);
+
+	GetNetworkObjectList().Remove(ThisActor);
 #if WITH_SERVER_CODE
 
 	FActorDestructionInfo* DestructionInfo = NULL;
@@ -1709,6 +1737,9 @@ void UNetDriver::FlushActorDormancy(AActor* Actor)
 			NetConnection->FlushDormancy(Actor);
 		}
 	}
+
+	// Make sure the actor is scheduled for replication again
+	GetNetworkObjectList().FlushDormancy(Actor);
 #endif // WITH_SERVER_CODE
 }
 
@@ -1971,6 +2002,573 @@ FActorPriority::FActorPriority(class UNetConnection* InConnection, struct FActor
 	}
 }
 
+/** Per connection state handed from the prioritization pass of ServerReplicateActors to the replication pass */
+struct FConnectionPriorities
+{
+	UNetConnection*		Connection;
+	FActorPriority*		PriorityList;
+	FActorPriority**	PriorityActors;
+	int32				ConsiderCount;
+	int32				NetRelevantCount;
+	float				PruneActors;
+	bool				bLowNetBandwidth;
+
+	/** Copy of the connection's viewers, only filled in when the sort is deferred */
+	TArray<FNetViewer>	Viewers;
+
+	FConnectionPriorities()
+		: Connection(NULL), PriorityList(NULL), PriorityActors(NULL), ConsiderCount(0), NetRelevantCount(0), PruneActors(0.f), bLowNetBandwidth(false)
+	{}
+};
+
+struct FCompareFActorPriority
+{
+	FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
+	{
+		return B.Priority < A.Priority;
+	}
+};
+
+/**
+ * Sorts the connection's list by the priorities ServerReplicateActors_PrioritizeActors evaluated on the game thread.
+ * Only touches the connection's own priority arrays (GetNetPriority is virtual and may be overridden with game thread only logic),
+ * so this is safe to run on a worker thread while the game thread waits.
+ */
+static void SortPrioritizedActors( FConnectionPriorities& Priorities )
+{
+	Sort( Priorities.PriorityActors, Priorities.ConsiderCount, FCompareFActorPriority() );
+}
+
+void UNetDriver::ServerReplicateActors_PrioritizeActors( UNetConnection* Connection, const TArray<AActor*>& ConsiderList, const bool bCPUSaturated, const float DeltaSeconds, const bool bDeferSort, FConnectionPriorities& OutPriorities )
+{
+	int32 j;
+	int32 ConsiderCount	= 0;
+	int32 DeletedCount = 0;
+
+	TArray<FNetViewer>& ConnectionViewers = World->GetWorldSettings()->ReplicationViewers;
+
+	float PruneActors = 0.f;
+	CLOCK_CYCLES(PruneActors);
+
+	// Prioritize actors for this connection
+	{
+		SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
+
+		// send ClientAdjustment if necessary
+		// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
+		if (Connection->PlayerController)
+		{
+			Connection->PlayerController->SendClientAdjustment();
+		}
+		
+		for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+		{
+			if (Connection->Children[ChildIdx]->PlayerController != NULL)
+			{
+				Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
+			}
+		}
+
+		// Get list of visible/relevant actors.
+		
+		NetTag++;
+		Connection->TickCount++;
+
+		// Set up to skip all sent temporary actors
+		for( j=0; j<Connection->SentTemporaries.Num(); j++ )
+		{
+			Connection->SentTemporaries[j]->NetTag = NetTag;
+		}
+
+		// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
+		ConnectionViewers.Reset();
+		new(ConnectionViewers) FNetViewer(Connection, DeltaSeconds);
+		for (j = 0; j < Connection->Children.Num(); j++)
+		{
+			if (Connection->Children[j]->ViewTarget != NULL)
+			{
+				new(ConnectionViewers) FNetViewer(Connection->Children[j], DeltaSeconds);
+			}
+		}
+
+		// Make list of all actors to consider.
+		check(World == Connection->OwningActor->GetWorld());
+		
+		const int32 NetRelevantCount = GetNetworkObjectList().GetNumObjects() + DestroyedStartupOrDormantActors.Num();
+		FActorPriority* PriorityList = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority;
+		FActorPriority** PriorityActors = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority*;
+
+		// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
+		//@note - if the server is currently CPU saturated then do not sort until framerate improves
+		check(World == Connection->ViewTarget->GetWorld());
+		AGameMode const* const GameMode = World->GetAuthGameMode();
+		const bool bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
+
+		for( AActor* Actor : ConsiderList )
+		{
+			UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+
+			// Skip Actor if dormant
+			if ( CVarSetNetDormancyEnabled.GetValueOnGameThread() == 1 )
+			{
+				// If actor is already dormant on this channel, then skip replication entirely
+				if ( Connection->DormantActors.Contains( Actor ) )
+				{
+					// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
+					// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
+					if ( CVarNetDormancyValidate.GetValueOnGameThread() == 2 )
+					{
+						TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
+
+						if ( Replicator != NULL )
+						{
+							Replicator->Get().ValidateAgainstState( Actor );
+						}
+					}
+
+					continue;
+				}
+
+				// If actor might need to go dormant on this channel, then check
+				if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
+				{
+					bool ShouldGoDormant = true;
+					if (Actor->NetDormancy == DORM_DormantPartial)
+					{
+						float LastReplicationTime  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
+						for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
+						{
+							if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].ViewTarget, Channel, Time, bLowNetBandwidth))
+							{
+								ShouldGoDormant = false;
+								break;
+							}
+						}
+					}
+
+					if (ShouldGoDormant)
+					{
+						// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
+						Channel->StartBecomingDormant();
+					}
+				}
+			}
+
+
+			// Skip actor if not relevant and theres no channel already.
+			// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
+			// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
+			// prioritized actors low.
+			if (!Channel)
+			{
+				if ( !IsLevelInitializedForActor(Actor, Connection) )
+				{
+					// If the level this actor belongs to isn't loaded on client, don't bother sending
+					continue;
+				}
+				if (!IsActorRelevantToConnection(Actor, ConnectionViewers))
+				{
+					continue;
+				}
+			}
+
+			if( Actor->NetTag!=NetTag ) // Do not consider actor for this connection if this connection has it marked dormant
+			{
+				UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
+				Actor->NetTag                 = NetTag;
+				PriorityList  [ConsiderCount] = FActorPriority(Connection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
+				PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
+				ConsiderCount++;
+
+				if (DebugRelevantActors)
+				{
+					LastPrioritizedActors.Add(Actor);
+				}
+			}
+		}
+
+		// Add in deleted actors
+		for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
+		{
+			FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
+			PriorityList  [ConsiderCount] = FActorPriority(Connection, &DInfo, ConnectionViewers);
+			PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
+			ConsiderCount++;
+			DeletedCount++;
+		}
+
+		UNetConnection* NextConnection = Connection;
+		int32 ChildIndex = 0;
+		while (NextConnection != NULL)
+		{
+			for (AActor* Actor : NextConnection->OwnedConsiderList)
+			{
+				UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
+				if (Actor->NetTag != NetTag)
+				{
+					UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+					Actor->NetTag                 = NetTag;
+					PriorityList  [ConsiderCount] = FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
+					PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
+					ConsiderCount++;
+
+					if (DebugRelevantActors)
+					{
+						LastPrioritizedActors.Add(Actor);
+					}
+				}
+			}
+			NextConnection->OwnedConsiderList.Empty();
+
+			NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
+		}
+
+		SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
+		SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
+
+		if (bDeferSort)
+		{
+			// The sort is done by SortPrioritizedActors, outside of the game thread
+			OutPriorities.Viewers = ConnectionViewers;
+		}
+		else
+		{
+			// Sort by priority
+			Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
+		}
+
+		OutPriorities.Connection		= Connection;
+		OutPriorities.PriorityList		= PriorityList;
+		OutPriorities.PriorityActors	= PriorityActors;
+		OutPriorities.ConsiderCount		= ConsiderCount;
+		OutPriorities.NetRelevantCount	= NetRelevantCount;
+		OutPriorities.PruneActors		= PruneActors;
+		OutPriorities.bLowNetBandwidth	= bLowNetBandwidth;
+	} // END PRIORITIZE
+}
+
+int32 UNetDriver::ServerReplicateActors_ProcessPrioritizedActors( FConnectionPriorities& Priorities, const int32 NumConsidered )
+{
+	UNetConnection* Connection				= Priorities.Connection;
+	FActorPriority** PriorityActors			= Priorities.PriorityActors;
+	const int32 ConsiderCount				= Priorities.ConsiderCount;
+	TArray<FNetViewer>& ConnectionViewers	= World->GetWorldSettings()->ReplicationViewers;
+
+	int32 j;
+	int32 Updated = 0;
+	int32 ActorUpdatesThisConnection = 0;
+	int32 ActorUpdatesThisConnectionSent = 0;
+
+	// Update all relevant actors in sorted order.
+	bool bNewSaturated = !Connection->IsNetReady(0);
+	if (bNewSaturated)
+	{
+		j = 0;
+	}
+	else
+	{
+		UE_LOG(LogNetTraffic, Log, TEXT("START"));
+		int32 FinalRelevantCount = 0;
+		for (j = 0; j < ConsiderCount; j++)
+		{
+			// Deletion entry
+			if (PriorityActors[j]->Actor == NULL && PriorityActors[j]->DestructionInfo)
+			{
+				// Make sure client has streaming level loaded
+				if (PriorityActors[j]->DestructionInfo->StreamingLevelName != NAME_None && !Connection->ClientVisibleLevelNames.Contains(PriorityActors[j]->DestructionInfo->StreamingLevelName))
+				{
+					// This deletion entry is for an actor in a streaming level the connection doesn't have loaded, so skip it
+					continue;
+				}
+
+				UActorChannel* Channel = (UActorChannel*)Connection->CreateChannel( CHTYPE_Actor, 1 );
+				if (Channel)
+				{
+					FinalRelevantCount++;
+					UE_LOG(LogNetTraffic, Log, TEXT("Server replicate actor creating destroy channel for NetGUID <%s,%s> Priority: %d"), *PriorityActors[j]->DestructionInfo->NetGUID.ToString(), *PriorityActors[j]->DestructionInfo->PathName, PriorityActors[j]->Priority );
+
+					Channel->SetChannelActorForDestroy( PriorityActors[j]->DestructionInfo ); // Send a close bunch on the new channel
+					Connection->DestroyedStartupOrDormantActors.Remove( PriorityActors[j]->DestructionInfo->NetGUID ); // Remove from connections to-be-destroyed list (close bunch of reliable, so it will make it there)
+				}
+				continue;
+			}
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+			static IConsoleVariable* DebugObjectCvar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.PackageMap.DebugObject"));
+			static IConsoleVariable* DebugAllObjectsCvar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.PackageMap.DebugAll"));
+			if (PriorityActors[j]->Actor && 
+				((DebugObjectCvar && !DebugObjectCvar->GetString().IsEmpty() && PriorityActors[j]->Actor->GetName().Contains(DebugObjectCvar->GetString())) ||
+				(DebugAllObjectsCvar && DebugAllObjectsCvar->GetInt() != 0)))
+			{
+				UE_LOG(LogNetPackageMap, Log, TEXT("Evaluating actor for replication %s"), *PriorityActors[j]->Actor->GetName());
+			}
+#endif
+
+			// Normal actor replication
+			UActorChannel* Channel     = PriorityActors[j]->Channel;
+			UE_LOG(LogNetTraffic, Log, TEXT(" Maybe Replicate %s"),*PriorityActors[j]->Actor->GetName());
+			if ( !Channel || Channel->Actor ) //make sure didn't just close this channel
+			{ 
+				AActor*		Actor       = PriorityActors[j]->Actor;
+				bool		bIsRelevant = false;
+
+				const bool bLevelInitializedForActor = IsLevelInitializedForActor(Actor, Connection);
+
+				// only check visibility on already visible actors every 1.0 + 0.5R seconds
+				// bTearOff actors should never be checked
+				if ( bLevelInitializedForActor )
+				{
+					if (!Actor->bTearOff && (!Channel || Time - Channel->RelevantTime > 1.f))
+					{
+						bIsRelevant = IsActorRelevantToConnection(Actor, ConnectionViewers);
+						if (!bIsRelevant && DebugRelevantActors)
+						{
+							//UE_LOG(LogNetPackageMap, Warning, TEXT("Actor NonRelevant: %s"), *Actor->GetName() );
+							LastNonRelevantActors.Add(Actor);
+						}
+					}
+				}
+				else
+				{
+					// Actor is no longer relevant because the world it is/was in is not loaded by client
+					// exception: player controllers should never show up here
+					UE_LOG(LogNetTraffic, Log, TEXT("- Level not initialized for actor %s"), *Actor->GetName());
+				}
+				
+				// if the actor is now relevant or was recently relevant
+				const bool bIsRecentlyRelevant = bIsRelevant || (Channel && Time - Channel->RelevantTime < RelevantTimeout);
+
+				if( bIsRecentlyRelevant )
+				{	
+					FinalRelevantCount++;
+
+					// Find or create the channel for this actor.
+					// we can't create the channel if the client is in a different world than we are
+					// or the package map doesn't support the actor's class/archetype (or the actor itself in the case of serializable actors)
+					// or it's an editor placed actor and the client hasn't initialized the level it's in
+					if ( Channel == NULL && GuidCache->SupportsObject(Actor->GetClass()) &&
+							GuidCache->SupportsObject(Actor->IsNetStartupActor() ? Actor : Actor->GetArchetype()) )
+					{
+						if (bLevelInitializedForActor)
+						{
+							// Create a new channel for this actor.
+							Channel = (UActorChannel*)Connection->CreateChannel( CHTYPE_Actor, 1 );
+							if( Channel )
+							{
+								Channel->SetChannelActor( Actor );
+							}
+						}
+						// if we couldn't replicate it for a reason that should be temporary, and this Actor is updated very infrequently, make sure we update it again soon
+						else if (Actor->NetUpdateFrequency < 1.0f)
+						{
+							UE_LOG(LogNetTraffic, Log, TEXT("Unable to replicate %s"),*Actor->GetName());
+							Actor->SetNetUpdateTime(Actor->GetWorld()->TimeSeconds + 0.2f * FMath::FRand());
+						}
+					}
+
+					if( Channel )
+					{
+						// if it is relevant then mark the channel as relevant for a short amount of time
+						if( bIsRelevant )
+						{
+							Channel->RelevantTime = Time + 0.5f * FMath::SRand();
+						}
+						// if the channel isn't saturated
+						if( Channel->IsNetReady(0) )
+						{
+							// replicate the actor
+							UE_LOG(LogNetTraffic, Log, TEXT("- Replicate %s. %d"),*Actor->GetName(), PriorityActors[j]->Priority);
+							if (DebugRelevantActors)
+							{
+								LastRelevantActors.Add( Actor );
+							}
+
+							if (Channel->ReplicateActor())
+							{
+								ActorUpdatesThisConnectionSent++;
+								if (DebugRelevantActors)
+								{
+									LastSentActors.Add( Actor );
+								}
+							}
+							ActorUpdatesThisConnection++;
+							Updated++;
+						}
+						else
+						{							
+							UE_LOG(LogNetTraffic, Log, TEXT("- Channel saturated, forcing pending update for %s"),*Actor->GetName());
+							// otherwise force this actor to be considered in the next tick again
+							Actor->ForceNetUpdate();
+						}
+						// second check for channel saturation
+						if (!Connection->IsNetReady(0))
+						{
+							bNewSaturated = true;
+							break;
+						}
+					}
+				}
+				
+				// If the actor wasn't recently relevant, or if it was torn off,
+				// close the actor channel if it exists for this connection
+				if ((!bIsRecentlyRelevant || Actor->bTearOff) && Channel != NULL)
+				{
+					// Non startup (map) actors have their channels closed immediately, which destroys them.
+					// Startup actors get to keep their channels open.
+
+					// Fixme: this should be a setting
+					if ( !bLevelInitializedForActor || !Actor->IsNetStartupActor() )
+					{
+						UE_LOG(LogNetTraffic, Log, TEXT("- Closing channel for no longer relevant actor %s"),*Actor->GetName());
+						Channel->Close();
+					}
+				}
+			}
+		}
+
+		SET_DWORD_STAT(STAT_NumRelevantActors,FinalRelevantCount);
+	}
+
+	// relevant actors that could not be processed this frame are marked to be considered for next frame
+	for ( int32 k=j; k<ConsiderCount; k++ )
+	{
+		AActor* Actor = PriorityActors[k]->Actor;
+		if (!Actor)
+		{
+			// A deletion entry, skip it because we dont have anywhere to store a 'better give higher priority next time'
+			continue;
+		}
+
+		UActorChannel* Channel = PriorityActors[k]->Channel;
+		
+		UE_LOG(LogNetTraffic, Verbose, TEXT("Saturated. %s"), *Actor->GetName());
+		if (Channel != NULL && Time - Channel->RelevantTime <= 1.f)
+		{
+			UE_LOG(LogNetTraffic, Log, TEXT(" Saturated. Mark %s NetUpdateTime to be checked for next tick"), *Actor->GetName());
+			Actor->bPendingNetUpdate = true;
+			GetNetworkObjectList().MarkPendingNetUpdate(Actor);
+		}
+		else if (IsActorRelevantToConnection(Actor, ConnectionViewers))
+		{
+			UE_LOG(LogNetTraffic, Log, TEXT(" Saturated. Mark %s NetUpdateTime to be checked for next tick"), *Actor->GetName());
+			Actor->bPendingNetUpdate = true;
+			GetNetworkObjectList().MarkPendingNetUpdate(Actor);
+			if (Channel != NULL)
+			{
+				Channel->RelevantTime = Time + 0.5f * FMath::SRand();
+			}
+		}
+	}
+
+	UE_LOG(LogNetTraffic, Log, TEXT("Potential %04i ConsiderList %03i ConsiderCount %03i Prune=%01.4f "),Priorities.NetRelevantCount, 
+				NumConsidered, ConsiderCount, FPlatformTime::ToMilliseconds(Priorities.PruneActors) );
+
+	SET_DWORD_STAT(STAT_NumReplicatedActorAttempts,ActorUpdatesThisConnection);
+	SET_DWORD_STAT(STAT_NumReplicatedActors,ActorUpdatesThisConnectionSent);
+
+	return Updated;
+}
+
+void UNetDriver::ServerReplicateActors_PreCompareProperties( const TArray<AActor*>& ConsiderList, const int32 NumClientsToTick )
+{
+	struct FPreCompareJob
+	{
+		const FRepLayout*	RepLayout;
+		FRepState*			RepState;
+		const uint8*		Data;
+	};
+
+	TArray<FPreCompareJob> Jobs;
+	TArray<UActorChannel*> Channels;
+	TArray<FRepState*> RepStates;
+
+	const int32 NumConnections = FMath::Min(NumClientsToTick, ClientConnections.Num());
+
+	for (AActor* Actor : ConsiderList)
+	{
+		Channels.Reset();
+
+		for (int32 ConnIdx = 0; ConnIdx < NumConnections; ConnIdx++)
+		{
+			UNetConnection* Connection = ClientConnections[ConnIdx];
+			if (Connection->ViewTarget == NULL)
+			{
+				continue;
+			}
+
+			UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+			if (Channel != NULL && Channel->Actor != NULL && !Channel->Dormant && !Channel->Closing)
+			{
+				Channels.Add(Channel);
+			}
+		}
+
+		if (Channels.Num() == 0)
+		{
+			continue;
+		}
+
+		// Every replicated object (the actor and its subobjects) shares one FRepChangedPropertyTracker across connections.
+		// Compare against the replication group most connections are in, so that as many of them as possible can skip their own compare.
+		for (auto& Pair : Channels[0]->ReplicationMap)
+		{
+			UObject* Object = Pair.Key.Get();
+			if (Object == NULL)
+			{
+				continue;
+			}
+
+			RepStates.Reset();
+
+			for (UActorChannel* Channel : Channels)
+			{
+				TSharedRef<FObjectReplicator>* Replicator = Channel->ReplicationMap.Find(Pair.Key);
+				if (Replicator != NULL && (*Replicator)->RepState != NULL && (*Replicator)->RepState->LastReplicationFrame != 0)
+				{
+					RepStates.Add((*Replicator)->RepState);
+				}
+			}
+
+			if (RepStates.Num() == 0)
+			{
+				continue;
+			}
+
+			RepStates.Sort([](const FRepState& A, const FRepState& B) { return A.LastReplicationFrame < B.LastReplicationFrame; });
+
+			FRepState* BestRepState = RepStates[0];
+			int32 BestCount = 0;
+			for (int32 RunStart = 0, RunEnd = 0; RunStart < RepStates.Num(); RunStart = RunEnd)
+			{
+				while (RunEnd < RepStates.Num() && RepStates[RunEnd]->LastReplicationFrame == RepStates[RunStart]->LastReplicationFrame)
+				{
+					RunEnd++;
+				}
+
+				if (RunEnd - RunStart > BestCount)
+				{
+					BestCount = RunEnd - RunStart;
+					BestRepState = RepStates[RunStart];
+				}
+			}
+
+			FPreCompareJob Job;
+			Job.RepLayout	= BestRepState->RepLayout.Get();
+			Job.RepState	= BestRepState;
+			Job.Data		= (const uint8*)Object;
+			Jobs.Add(Job);
+		}
+	}
+
+	// Jobs never share a tracker, and property values can't change until the game thread resumes
+	const uint32 Frame = ReplicationFrame;
+	ParallelFor(Jobs.Num(), [&Jobs, Frame](int32 Index)
+	{
+		const FPreCompareJob& Job = Jobs[Index];
+		Job.RepLayout->PreCompareProperties(Job.RepState, Job.Data, Frame);
+	});
+}
+
 int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NetServerRepActorsTime);
@@ -2034,7 +2632,7 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 			check( World == OwningActor->GetWorld() );
 			if( !bNetRelevantActorCount )
 			{
-				NetRelevantActorCount = World->NetworkActors.Num() + 2;
+				NetRelevantActorCount = GetNetworkObjectList().GetNumObjects() + 2;
 				bNetRelevantActorCount = true;
 			}
 			bFoundReadyConnection = true;
@@ -2112,45 +2710,47 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 		SCOPE_CYCLE_COUNTER(STAT_NetConsiderActorsTime);
 		UE_LOG(LogNetTraffic, Log, TEXT("UWorld::ServerTickClients, Building ConsiderList %4.2f"), World->GetTimeSeconds());
 
-		SET_DWORD_STAT( STAT_NumNetActors, World->NetworkActors.Num() );
+		FNetworkObjectList& NetworkObjectList = GetNetworkObjectList();
 
-		for ( TSet<AActor*>::TIterator ActorIt = World->NetworkActors.CreateIterator(); ActorIt; ++ActorIt)
-		{
-			AActor* Actor = *ActorIt;
+		SET_DWORD_STAT( STAT_NumNetActors, NetworkObjectList.GetNumActiveObjects() );
 
-			if (Actor->IsPendingKill() )
-			{
-				ActorIt.RemoveCurrent();
-				continue;
-			}
+		// Only actors that are due for an update (or were flagged with bPendingNetUpdate) are visited here.
+		// Every actor gathered must either be rescheduled, marked pending again, or removed from the list.
+		TArray<AActor*> DueActors;
+		NetworkObjectList.GatherDueObjects(World->TimeSeconds, DueActors);
 
-			if (Actor->GetRemoteRole()==ROLE_None)
+		for ( AActor* Actor : DueActors )
+		{
+			if (Actor->IsPendingKill() || Actor->GetRemoteRole() == ROLE_None)
 			{
-				ActorIt.RemoveCurrent();
+				World->RemoveNetworkActor(Actor);
+				NetworkObjectList.Remove(Actor);
 				continue;
 			}
 
-			// This actor may belong to a different net driver, make sure this is the correct one
-			// (this can happen when using beacon net drivers for example)
+			// This actor replicates through a different net driver (beacons for example). Its NetDriverName can still change, so
+			// keep checking it at its update rate, without touching the NetUpdateTime the other driver maintains.
 			if ( Actor->NetDriverName != NetDriverName )
 			{
+				NetworkObjectList.Schedule(Actor, World->TimeSeconds + 1.f / FMath::Max(Actor->NetUpdateFrequency, 1.f));
 				continue;
 			}
 
-			// Don't send actors that may still be streaming in
+			// Don't send actors that may still be streaming in, but keep them due so they are checked again next frame
 			ULevel* Level = Actor->GetLevel();
 			if ( Level->HasVisibilityRequestPending() || Level->bIsAssociatingLevel )
 			{
+				NetworkObjectList.MarkPendingNetUpdate(Actor);
 				continue;
 			}
 
 			if ( Actor->NetDormancy == DORM_Initial && Actor->IsNetStartupActor() )
 			{
-				// This stat isn't that useful in its current form when using NetworkActors list
-				// We'll want to track initially dormant actors some other way to track them with stats
+				// Initially dormant actors are added back by AActor::FlushNetDormancy through UWorld::AddNetworkActor
 				SCOPE_CYCLE_COUNTER(STAT_NetInitialDormantCheckTime);		
 				NumInitiallyDormant++;
-				ActorIt.RemoveCurrent();
+				World->RemoveNetworkActor(Actor);
+				NetworkObjectList.Remove(Actor);
 				//UE_LOG(LogNetTraffic, Log, TEXT("Skipping Actor %s - its initially dormant!"), *Actor->GetName() );
 				continue;
 			}
@@ -2170,6 +2770,8 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 					//@note: using Time because it's compared against UActorChannel.LastUpdateTime which also uses that value
 					Actor->LastNetUpdateTime = Time;
 				}
+				// queue the actor for its next update, connections that could not replicate it will mark it pending again below
+				NetworkObjectList.Schedule(Actor);
 				/*
 				else
 				{
@@ -2245,27 +2847,42 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 					Actor->CallPreReplication( this );
 				}
 			}
-			/*
 			else
 			{
-				if( Actor->GetAPawn() && (Actor->RemoteRole!=ROLE_None) && (World->GetTimeSeconds() <= Actor->NetUpdateTime) ) 
-				{
-					UE_LOG(LogNetTraffic, Log, TEXT("%s skipped in considerlist because of NetUpdateTime %f"), *Actor->GetName(), (World->GetTimeSeconds() - Actor->NetUpdateTime) );
-				}
+				// NetUpdateTime was pushed back after the actor was queued
+				NetworkObjectList.Schedule(Actor);
 			}
-			*/
 		}
 	}
 
 	SET_DWORD_STAT(STAT_NumInitiallyDormantActors,NumInitiallyDormant);
 	SET_DWORD_STAT(STAT_NumConsideredActors,ConsiderList.Num());
 
+	// Bucket this frame's considered actors so distance based relevancy can be shared between connections
+	if (CVarNetSpatialRelevancy.GetValueOnGameThread() != 0)
+	{
+		RelevancyGrid->Build(ConsiderList);
+	}
+	else
+	{
+		RelevancyGrid->Reset();
+	}
+
+	const bool bParallelReplication = CVarNetParallelReplication.GetValueOnGameThread() != 0;
+
+	// Connections whose prioritized list is sorted on worker threads, then replicated on the game thread once all of them are ready
+	TArray<FConnectionPriorities> DeferredConnections;
+
+	if (bParallelReplication)
+	{
+		ServerReplicateActors_PreCompareProperties(ConsiderList, NumClientsToTick);
+		DeferredConnections.Reserve(NumClientsToTick);
+	}
+
 	for( int32 i=0; i < ClientConnections.Num(); i++ )
 	{
 		UNetConnection* Connection = ClientConnections[i];
 		check(Connection);
-		int32 ActorUpdatesThisConnection = 0;
-		int32 ActorUpdatesThisConnectionSent = 0;
 
 		// if this client shouldn't be ticked this frame
 		if (i >= NumClientsToTick)
@@ -2286,6 +2903,7 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 						//UE_LOG(LogNet, Log, TEXT("flagging %s for a future update"),*Actor->GetName());
 						// flag it for a pending update
 						Actor->bPendingNetUpdate = true;
+						GetNetworkObjectList().MarkPendingNetUpdate(Actor);
 					}
 				}
 			}
@@ -2303,438 +2921,37 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 		}
 		else if (Connection->ViewTarget)
 		{
-			int32 j;
-			int32 ConsiderCount	= 0;
-			int32 DeletedCount = 0;
-			
-			int32 NetRelevantCount = 0;
-			FActorPriority* PriorityList = NULL;
-			FActorPriority** PriorityActors = NULL;
-
-			TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
-
-			float PruneActors = 0.f;
-			CLOCK_CYCLES(PruneActors);
-			FMemMark RelevantActorMark(FMemStack::Get());
-
-			// Prioritize actors for this connection
+			if (bParallelReplication)
 			{
-				SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
-
-				// send ClientAdjustment if necessary
-				// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
-				if (Connection->PlayerController)
-				{
-					Connection->PlayerController->SendClientAdjustment();
-				}
-				
-				for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
-				{
-					if (Connection->Children[ChildIdx]->PlayerController != NULL)
-					{
-						Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
-					}
-				}
-
-				// Get list of visible/relevant actors.
-				
-				NetTag++;
-				Connection->TickCount++;
-
-				// Set up to skip all sent temporary actors
-				for( j=0; j<Connection->SentTemporaries.Num(); j++ )
-				{
-					Connection->SentTemporaries[j]->NetTag = NetTag;
-				}
-
-				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
-				ConnectionViewers.Reset();
-				new(ConnectionViewers) FNetViewer(Connection, DeltaSeconds);
-				for (j = 0; j < Connection->Children.Num(); j++)
-				{
-					if (Connection->Children[j]->ViewTarget != NULL)
-					{
-						new(ConnectionViewers) FNetViewer(Connection->Children[j], DeltaSeconds);
-					}
-				}
-
-				// Make list of all actors to consider.
-				check(World == Connection->OwningActor->GetWorld());
-				
-				NetRelevantCount = World->NetworkActors.Num() + DestroyedStartupOrDormantActors.Num();
-				PriorityList = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority;
-				PriorityActors = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority*;
-
-				// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
-				//@note - if the server is currently CPU saturated then do not sort until framerate improves
-				check(World == Connection->ViewTarget->GetWorld());
-				AGameMode const* const GameMode = World->GetAuthGameMode();
-				bool bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
-
-				for( AActor* Actor : ConsiderList )
-				{
-					UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
-
-					// Skip Actor if dormant
-					if ( CVarSetNetDormancyEnabled.GetValueOnGameThread() == 1 )
-					{
-						// If actor is already dormant on this channel, then skip replication entirely
-						if ( Connection->DormantActors.Contains( Actor ) )
-						{
-							// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
-							// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
-							if ( CVarNetDormancyValidate.GetValueOnGameThread() == 2 )
-							{
-								TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
-
-								if ( Replicator != NULL )
-								{
-									Replicator->Get().ValidateAgainstState( Actor );
-								}
-							}
-
-							continue;
-						}
-
-						// If actor might need to go dormant on this channel, then check
-						if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
-						{
-							bool ShouldGoDormant = true;
-							if (Actor->NetDormancy == DORM_DormantPartial)
-							{
-								float LastReplicationTime  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
-								for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-								{
-									if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].ViewTarget, Channel, Time, bLowNetBandwidth))
-									{
-										ShouldGoDormant = false;
-										break;
-									}
-								}
-							}
-
-							if (ShouldGoDormant)
-							{
-								// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
-								Channel->StartBecomingDormant();
-							}
-						}
-					}
-
-
-					// Skip actor if not relevant and theres no channel already.
-					// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
-					// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
-					// prioritized actors low.
-					if (!Channel)
-					{
-						if ( !IsLevelInitializedForActor(Actor, Connection) )
-						{
-							// If the level this actor belongs to isn't loaded on client, don't bother sending
-							continue;
-						}
-						bool Relevant = false;
-						for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-						{
-							if(Actor->IsNetRelevantFor(ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].ViewTarget, ConnectionViewers[viewerIdx].ViewLocation))
-							{
-								Relevant = true;
-								break;
-							}
-						}
-						if (!Relevant)
-						{
-							continue;
-						}
-					}
-
-					if( Actor->NetTag!=NetTag ) // Do not consider actor for this connection if this connection has it marked dormant
-					{
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
-						Actor->NetTag                 = NetTag;
-						PriorityList  [ConsiderCount] = FActorPriority(Connection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-						PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-						ConsiderCount++;
-
-						if (DebugRelevantActors)
-						{
-							LastPrioritizedActors.Add(Actor);
-						}
-					}
-				}
-
-				// Add in deleted actors
-				for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
-				{
-					FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
-					PriorityList  [ConsiderCount] = FActorPriority(Connection, &DInfo, ConnectionViewers);
-					PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-					ConsiderCount++;
-					DeletedCount++;
-				}
-
-				UNetConnection* NextConnection = Connection;
-				int32 ChildIndex = 0;
-				while (NextConnection != NULL)
-				{
-					for (AActor* Actor : NextConnection->OwnedConsiderList)
-					{
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
-						if (Actor->NetTag != NetTag)
-						{
-							UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
-							Actor->NetTag                 = NetTag;
-							PriorityList  [ConsiderCount] = FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-							PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-							ConsiderCount++;
-
-							if (DebugRelevantActors)
-							{
-								LastPrioritizedActors.Add(Actor);
-							}
-						}
-					}
-					NextConnection->OwnedConsiderList.Empty();
-
-					NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
-				}
-
-				SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
-				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
-
-				// Sort by priority
-				struct FCompareFActorPriority
-				{
-					FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
-					{
-						return B.Priority < A.Priority;
-					}
-				};
-				Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
-
-			} // END PRIORITIZE
-
-			// Update all relevant actors in sorted order.
-			bool bNewSaturated = !Connection->IsNetReady(0);
-			if (bNewSaturated)
-			{
-				j = 0;
+				// Priorities are evaluated here, every connection's list is sorted at once below
+				FConnectionPriorities& ConnectionPriorities = DeferredConnections[DeferredConnections.AddDefaulted()];
+				ServerReplicateActors_PrioritizeActors(Connection, ConsiderList, bCPUSaturated, DeltaSeconds, true, ConnectionPriorities);
 			}
 			else
 			{
-				UE_LOG(LogNetTraffic, Log, TEXT("START"));
-				int32 FinalRelevantCount = 0;
-				for (j = 0; j < ConsiderCount; j++)
-				{
-					// Deletion entry
-					if (PriorityActors[j]->Actor == NULL && PriorityActors[j]->DestructionInfo)
-					{
-						// Make sure client has streaming level loaded
-						if (PriorityActors[j]->DestructionInfo->StreamingLevelName != NAME_None && !Connection->ClientVisibleLevelNames.Contains(PriorityActors[j]->DestructionInfo->StreamingLevelName))
-						{
-							// This deletion entry is for an actor in a streaming level the connection doesn't have loaded, so skip it
-							continue;
-						}
-
-						UActorChannel* Channel = (UActorChannel*)Connection->CreateChannel( CHTYPE_Actor, 1 );
-						if (Channel)
-						{
-							FinalRelevantCount++;
-							UE_LOG(LogNetTraffic, Log, TEXT("Server replicate actor creating destroy channel for NetGUID <%s,%s> Priority: %d"), *PriorityActors[j]->DestructionInfo->NetGUID.ToString(), *PriorityActors[j]->DestructionInfo->PathName, PriorityActors[j]->Priority );
-
-							Channel->SetChannelActorForDestroy( PriorityActors[j]->DestructionInfo ); // Send a close bunch on the new channel
-							Connection->DestroyedStartupOrDormantActors.Remove( PriorityActors[j]->DestructionInfo->NetGUID ); // Remove from connections to-be-destroyed list (close bunch of reliable, so it will make it there)
-						}
-						continue;
-					}
-
-#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-					static IConsoleVariable* DebugObjectCvar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.PackageMap.DebugObject"));
-					static IConsoleVariable* DebugAllObjectsCvar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.PackageMap.DebugAll"));
-					if (PriorityActors[j]->Actor && 
-						((DebugObjectCvar && !DebugObjectCvar->GetString().IsEmpty() && PriorityActors[j]->Actor->GetName().Contains(DebugObjectCvar->GetString())) ||
-						(DebugAllObjectsCvar && DebugAllObjectsCvar->GetInt() != 0)))
-					{
-						UE_LOG(LogNetPackageMap, Log, TEXT("Evaluating actor for replication %s"), *PriorityActors[j]->Actor->GetName());
-					}
-#endif
-
-					// Normal actor replication
-					UActorChannel* Channel     = PriorityActors[j]->Channel;
-					UE_LOG(LogNetTraffic, Log, TEXT(" Maybe Replicate %s"),*PriorityActors[j]->Actor->GetName());
-					if ( !Channel || Channel->Actor ) //make sure didn't just close this channel
-					{ 
-						AActor*		Actor       = PriorityActors[j]->Actor;
-						bool		bIsRelevant = false;
-
-						const bool bLevelInitializedForActor = IsLevelInitializedForActor(Actor, Connection);
-
-						// only check visibility on already visible actors every 1.0 + 0.5R seconds
-						// bTearOff actors should never be checked
-						if ( bLevelInitializedForActor )
-						{
-							if (!Actor->bTearOff && (!Channel || Time - Channel->RelevantTime > 1.f))
-							{
-								for (int32 k = 0; k < ConnectionViewers.Num(); k++)
-								{
-									if (Actor->IsNetRelevantFor(ConnectionViewers[k].InViewer, ConnectionViewers[k].ViewTarget, ConnectionViewers[k].ViewLocation))
-									{
-										bIsRelevant = true;
-										break;
-									}
-									else
-									{
-										//UE_LOG(LogNetPackageMap, Warning, TEXT("Actor NonRelevant: %s"), *Actor->GetName() );
-										if (DebugRelevantActors)
-										{
-											LastNonRelevantActors.Add(Actor);
-										}
-									}
-								}
-							}
-						}
-						else
-						{
-							// Actor is no longer relevant because the world it is/was in is not loaded by client
-							// exception: player controllers should never show up here
-							UE_LOG(LogNetTraffic, Log, TEXT("- Level not initialized for actor %s"), *Actor->GetName());
-						}
-						
-						// if the actor is now relevant or was recently relevant
-						const bool bIsRecentlyRelevant = bIsRelevant || (Channel && Time - Channel->RelevantTime < RelevantTimeout);
-
-						if( bIsRecentlyRelevant )
-						{	
-							FinalRelevantCount++;
-
-							// Find or create the channel for this actor.
-							// we can't create the channel if the client is in a different world than we are
-							// or the package map doesn't support the actor's class/archetype (or the actor itself in the case of serializable actors)
-							// or it's an editor placed actor and the client hasn't initialized the level it's in
-							if ( Channel == NULL && GuidCache->SupportsObject(Actor->GetClass()) &&
-									GuidCache->SupportsObject(Actor->IsNetStartupActor() ? Actor : Actor->GetArchetype()) )
-							{
-								if (bLevelInitializedForActor)
-								{
-									// Create a new channel for this actor.
-									Channel = (UActorChannel*)Connection->CreateChannel( CHTYPE_Actor, 1 );
-									if( Channel )
-									{
-										Channel->SetChannelActor( Actor );
-									}
-								}
-								// if we couldn't replicate it for a reason that should be temporary, and this Actor is updated very infrequently, make sure we update it again soon
-								else if (Actor->NetUpdateFrequency < 1.0f)
-								{
-									UE_LOG(LogNetTraffic, Log, TEXT("Unable to replicate %s"),*Actor->GetName());
-									Actor->NetUpdateTime = Actor->GetWorld()->TimeSeconds + 0.2f * FMath::FRand();
-								}
-							}
-
-							if( Channel )
-							{
-								// if it is relevant then mark the channel as relevant for a short amount of time
-								if( bIsRelevant )
-								{
-									Channel->RelevantTime = Time + 0.5f * FMath::SRand();
-								}
-								// if the channel isn't saturated
-								if( Channel->IsNetReady(0) )
-								{
-									// replicate the actor
-									UE_LOG(LogNetTraffic, Log, TEXT("- Replicate %s. %d"),*Actor->GetName(), PriorityActors[j]->Priority);
-									if (DebugRelevantActors)
-									{
-										LastRelevantActors.Add( Actor );
-									}
-
-									if (Channel->ReplicateActor())
-									{
-										ActorUpdatesThisConnectionSent++;
-										if (DebugRelevantActors)
-										{
-											LastSentActors.Add( Actor );
-										}
-									}
-									ActorUpdatesThisConnection++;
-									Updated++;
-								}
-								else
-								{							
-									UE_LOG(LogNetTraffic, Log, TEXT("- Channel saturated, forcing pending update for %s"),*Actor->GetName());
-									// otherwise force this actor to be considered in the next tick again
-									Actor->ForceNetUpdate();
-								}
-								// second check for channel saturation
-								if (!Connection->IsNetReady(0))
-								{
-									bNewSaturated = true;
-									break;
-								}
-							}
-						}
-						
-						// If the actor wasn't recently relevant, or if it was torn off,
-						// close the actor channel if it exists for this connection
-						if ((!bIsRecentlyRelevant || Actor->bTearOff) && Channel != NULL)
-						{
-							// Non startup (map) actors have their channels closed immediately, which destroys them.
-							// Startup actors get to keep their channels open.
-
-							// Fixme: this should be a setting
-							if ( !bLevelInitializedForActor || !Actor->IsNetStartupActor() )
-							{
-								UE_LOG(LogNetTraffic, Log, TEXT("- Closing channel for no longer relevant actor %s"),*Actor->GetName());
-								Channel->Close();
-							}
-						}
-					}
-				}
-
-				SET_DWORD_STAT(STAT_NumRelevantActors,FinalRelevantCount);
+				FMemMark RelevantActorMark(FMemStack::Get());
+				FConnectionPriorities ConnectionPriorities;
+				ServerReplicateActors_PrioritizeActors(Connection, ConsiderList, bCPUSaturated, DeltaSeconds, false, ConnectionPriorities);
+				Updated += ServerReplicateActors_ProcessPrioritizedActors(ConnectionPriorities, ConsiderList.Num());
 			}
+		}
+	}
 
-			// relevant actors that could not be processed this frame are marked to be considered for next frame
-			for ( int32 k=j; k<ConsiderCount; k++ )
+	if (DeferredConnections.Num() > 0)
+	{
+		{
+			SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
+			ParallelFor(DeferredConnections.Num(), [&DeferredConnections](int32 Index)
 			{
-				AActor* Actor = PriorityActors[k]->Actor;
-				if (!Actor)
-				{
-					// A deletion entry, skip it because we dont have anywhere to store a 'better give higher priority next time'
-					continue;
-				}
-
-				UActorChannel* Channel = PriorityActors[k]->Channel;
-				
-				UE_LOG(LogNetTraffic, Verbose, TEXT("Saturated. %s"), *Actor->GetName());
-				if (Channel != NULL && Time - Channel->RelevantTime <= 1.f)
-				{
-					UE_LOG(LogNetTraffic, Log, TEXT(" Saturated. Mark %s NetUpdateTime to be checked for next tick"), *Actor->GetName());
-					Actor->bPendingNetUpdate = true;
-				}
-				else
-				{
-					for (int32 h = 0; h < ConnectionViewers.Num(); h++)
-					{
-						if (Actor->IsNetRelevantFor(ConnectionViewers[h].InViewer, ConnectionViewers[h].ViewTarget, ConnectionViewers[h].ViewLocation))
-						{
-							UE_LOG(LogNetTraffic, Log, TEXT(" Saturated. Mark %s NetUpdateTime to be checked for next tick"), *Actor->GetName());
-							Actor->bPendingNetUpdate = true;
-							if (Channel != NULL)
-							{
-								Channel->RelevantTime = Time + 0.5f * FMath::SRand();
-							}
-							break;
-						}
-					}
-				}
-			}
-			RelevantActorMark.Pop();
-			UE_LOG(LogNetTraffic, Log, TEXT("Potential %04i ConsiderList %03i ConsiderCount %03i Prune=%01.4f "),NetRelevantCount, 
-						ConsiderList.Num(), ConsiderCount, FPlatformTime::ToMilliseconds(PruneActors) );
+				SortPrioritizedActors(DeferredConnections[Index]);
+			});
+		}
 
-			SET_DWORD_STAT(STAT_NumReplicatedActorAttempts,ActorUpdatesThisConnection);
-			SET_DWORD_STAT(STAT_NumReplicatedActors,ActorUpdatesThisConnectionSent);
+		// Channels and bunches are only ever touched on the game thread
+		for (FConnectionPriorities& ConnectionPriorities : DeferredConnections)
+		{
+			WorldSettings->ReplicationViewers = ConnectionPriorities.Viewers;
+			Updated += ServerReplicateActors_ProcessPrioritizedActors(ConnectionPriorities, ConsiderList.Num());
 		}
 	}
 
@@ -2753,6 +2970,8 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 	}
 	Mark.Pop();
 
+	RelevancyGrid->Reset();
+
 	if (DebugRelevantActors)
 	{
 		PrintDebugRelevantActors();
@@ -2771,6 +2990,12 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 }
 
 
+bool UNetDriver::IsActorRelevantToConnection(const AActor* Actor, const TArray<FNetViewer>& ConnectionViewers)
+{
+	// The grid falls back to AActor::IsNetRelevantFor for actors it was not built with (or when it is empty)
+	return RelevancyGrid->IsRelevantToViewers(Actor, ConnectionViewers);
+}
+
 void UNetDriver::PrintDebugRelevantActors()
 {
 	struct SLocal
@@ -2915,6 +3140,9 @@ void UNetDriver::AddClientConnection(UNetConnection * NewConnection)
 
 	PerfCountersIncrement(TEXT("AddedConnections"));
 
+	// Actors that were dormant on every existing connection still need to be sent to this one
+	GetNetworkObjectList().OnConnectionAdded();
+
 	for (auto It = DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
 	{
 		if (It.Key().IsStatic())
@@ -2935,12 +3163,19 @@ void UNetDriver::SetWorld(class UWorld* InWorld)
 		Notify = NULL;
 	}
 
+	GetNetworkObjectList().Reset();
+
 	if (InWorld)
 	{
 		// Setup new world association
 		World = InWorld;
 		Notify = InWorld;
 		RegisterTickEvents(InWorld);
+
+		if (IsServer())
+		{
+			GetNetworkObjectList().AddInitialObjects(InWorld);
+		}
 	}
 }
 
@@ -2948,6 +3183,8 @@ void UNetDriver::ResetGameWorldState()
 {
 	DestroyedStartupOrDormantActors.Empty();
 
+	GetNetworkObjectList().Reset();
+
 	if ( NetCache.IsValid() )
 	{
 		NetCache->ClearClassNetCache();	// Clear the cache net: it will recreate itself after seamless travel
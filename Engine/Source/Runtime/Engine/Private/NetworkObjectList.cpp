@@ -0,0 +1,305 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetworkObjectList.cpp: Persistent list of replicated actors owned by a net driver.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/NetworkObjectList.h"
+
+void FNetworkObjectList::Add( AActor* Actor )
+{
+	if ( Actor == nullptr || Actor->IsPendingKill() || Actor->GetRemoteRole() == ROLE_None )
+	{
+		return;
+	}
+
+	if ( AllNetworkObjects.Contains( Actor ) )
+	{
+		return;
+	}
+
+	TSharedPtr< FNetworkObjectInfo > Info = MakeShareable( new FNetworkObjectInfo( Actor ) );
+	AllNetworkObjects.Add( Actor, Info );
+	NumActiveObjects++;
+
+	ScheduleInfo( Info, Actor->NetUpdateTime );
+}
+
+void FNetworkObjectList::AddInitialObjects( UWorld* World )
+{
+	if ( World == nullptr )
+	{
+		return;
+	}
+
+	for ( AActor* Actor : World->NetworkActors )
+	{
+		Add( Actor );
+	}
+}
+
+void FNetworkObjectList::Remove( AActor* Actor )
+{
+	TSharedPtr< FNetworkObjectInfo > Info;
+	if ( !AllNetworkObjects.RemoveAndCopyValue( Actor, Info ) )
+	{
+		return;
+	}
+
+	if ( Info->bActive )
+	{
+		NumActiveObjects--;
+	}
+
+	// Any queued entries still reference the info, make sure they are discarded when popped
+	Info->bActive = false;
+	Info->ScheduleSerial = 0;
+
+	if ( Info->bDue )
+	{
+		DueObjects.RemoveSingleSwap( Info, false );
+		Info->bDue = false;
+	}
+}
+
+void FNetworkObjectList::MarkDormant( AActor* Actor, UNetConnection* Connection, int32 NumConnections )
+{
+	TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( Actor );
+	if ( InfoPtr == nullptr )
+	{
+		return;
+	}
+
+	TSharedPtr< FNetworkObjectInfo >& Info = *InfoPtr;
+	Info->DormantConnections.Add( Connection );
+
+	if ( Info->bActive && NumConnections > 0 && Info->DormantConnections.Num() >= NumConnections )
+	{
+		SetActive( Info, false );
+	}
+}
+
+void FNetworkObjectList::MarkActive( AActor* Actor, UNetConnection* Connection )
+{
+	TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( Actor );
+	if ( InfoPtr == nullptr )
+	{
+		return;
+	}
+
+	TSharedPtr< FNetworkObjectInfo >& Info = *InfoPtr;
+	Info->DormantConnections.Remove( Connection );
+
+	if ( !Info->bActive )
+	{
+		SetActive( Info, true );
+	}
+}
+
+void FNetworkObjectList::FlushDormancy( AActor* Actor )
+{
+	TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( Actor );
+	if ( InfoPtr == nullptr )
+	{
+		return;
+	}
+
+	TSharedPtr< FNetworkObjectInfo >& Info = *InfoPtr;
+	Info->DormantConnections.Empty();
+
+	if ( !Info->bActive )
+	{
+		SetActive( Info, true );
+	}
+}
+
+void FNetworkObjectList::OnConnectionAdded()
+{
+	// The new connection has never seen these actors go dormant, so they need to be considered for it
+	for ( auto It = AllNetworkObjects.CreateIterator(); It; ++It )
+	{
+		TSharedPtr< FNetworkObjectInfo >& Info = It.Value();
+		if ( !Info->bActive )
+		{
+			SetActive( Info, true );
+		}
+	}
+}
+
+void FNetworkObjectList::OnConnectionRemoved( UNetConnection* Connection, int32 NumConnections )
+{
+	for ( auto It = AllNetworkObjects.CreateIterator(); It; ++It )
+	{
+		TSharedPtr< FNetworkObjectInfo >& Info = It.Value();
+		Info->DormantConnections.Remove( Connection );
+
+		// Clean up any other connections that have gone away in the meantime
+		for ( auto ConnIt = Info->DormantConnections.CreateIterator(); ConnIt; ++ConnIt )
+		{
+			if ( !ConnIt->IsValid() )
+			{
+				ConnIt.RemoveCurrent();
+			}
+		}
+
+		// Removing a connection can leave an actor dormant on all of the remaining ones
+		if ( Info->bActive && NumConnections > 0 && Info->DormantConnections.Num() >= NumConnections )
+		{
+			SetActive( Info, false );
+		}
+	}
+}
+
+void FNetworkObjectList::Schedule( AActor* Actor )
+{
+	TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( Actor );
+	if ( InfoPtr != nullptr && (*InfoPtr)->bActive && !(*InfoPtr)->bDue )
+	{
+		ScheduleInfo( *InfoPtr, Actor->NetUpdateTime );
+	}
+}
+
+void FNetworkObjectList::Schedule( AActor* Actor, float UpdateTime )
+{
+	TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( Actor );
+	if ( InfoPtr != nullptr && (*InfoPtr)->bActive && !(*InfoPtr)->bDue )
+	{
+		ScheduleInfo( *InfoPtr, UpdateTime );
+	}
+}
+
+void FNetworkObjectList::MarkPendingNetUpdate( AActor* Actor )
+{
+	TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( Actor );
+	if ( InfoPtr != nullptr && (*InfoPtr)->bActive )
+	{
+		MarkInfoDue( *InfoPtr );
+	}
+}
+
+void FNetworkObjectList::GatherDueObjects( float WorldTime, TArray< AActor* >& OutDueObjects )
+{
+	while ( UpdateQueue.Num() > 0 && UpdateQueue.HeapTop().UpdateTime < WorldTime )
+	{
+		FScheduledObject Entry( 0.0f, 0, nullptr );
+		UpdateQueue.HeapPop( Entry, false );
+
+		TSharedPtr< FNetworkObjectInfo >& Info = Entry.Info;
+
+		// Stale entry: the actor was removed, went dormant everywhere, or has been rescheduled since
+		if ( !Info->bActive || Info->bDue || Info->ScheduleSerial != Entry.Serial )
+		{
+			continue;
+		}
+
+		// NetUpdateTime may have been pushed back without telling us, in which case the actor simply moves back in the queue
+		if ( !Info->Actor->bPendingNetUpdate && Info->Actor->NetUpdateTime >= WorldTime )
+		{
+			ScheduleInfo( Info, Info->Actor->NetUpdateTime );
+			continue;
+		}
+
+		MarkInfoDue( Info );
+	}
+
+	OutDueObjects.Reset( DueObjects.Num() );
+
+	for ( const TSharedPtr< FNetworkObjectInfo >& Info : DueObjects )
+	{
+		Info->bDue = false;
+		OutDueObjects.Add( Info->Actor );
+	}
+
+	DueObjects.Reset();
+
+	CompactUpdateQueue();
+}
+
+void FNetworkObjectList::Reset()
+{
+	AllNetworkObjects.Empty();
+	UpdateQueue.Empty();
+	DueObjects.Empty();
+	NumActiveObjects = 0;
+}
+
+FNetworkObjectInfo* FNetworkObjectList::Find( const AActor* Actor ) const
+{
+	const TSharedPtr< FNetworkObjectInfo >* InfoPtr = AllNetworkObjects.Find( const_cast< AActor* >( Actor ) );
+	return InfoPtr ? InfoPtr->Get() : nullptr;
+}
+
+void FNetworkObjectList::ScheduleInfo( const TSharedPtr< FNetworkObjectInfo >& Info, float UpdateTime )
+{
+	Info->ScheduleSerial = NextScheduleSerial++;
+
+	// Zero is reserved for "not scheduled"
+	if ( NextScheduleSerial == 0 )
+	{
+		NextScheduleSerial = 1;
+	}
+
+	UpdateQueue.HeapPush( FScheduledObject( UpdateTime, Info->ScheduleSerial, Info ) );
+}
+
+void FNetworkObjectList::MarkInfoDue( const TSharedPtr< FNetworkObjectInfo >& Info )
+{
+	if ( !Info->bDue )
+	{
+		Info->bDue = true;
+		Info->ScheduleSerial = 0;
+		DueObjects.Add( Info );
+	}
+}
+
+void FNetworkObjectList::SetActive( const TSharedPtr< FNetworkObjectInfo >& Info, bool bActive )
+{
+	if ( Info->bActive == bActive )
+	{
+		return;
+	}
+
+	Info->bActive = bActive;
+
+	if ( bActive )
+	{
+		NumActiveObjects++;
+		ScheduleInfo( Info, Info->Actor->NetUpdateTime );
+	}
+	else
+	{
+		NumActiveObjects--;
+		Info->ScheduleSerial = 0;
+
+		if ( Info->bDue )
+		{
+			DueObjects.RemoveSingleSwap( Info, false );
+			Info->bDue = false;
+		}
+	}
+}
+
+void FNetworkObjectList::CompactUpdateQueue()
+{
+	// Actors that get rescheduled often (ForceNetUpdate, low NetUpdateFrequency) leave stale entries behind.
+	// Rebuild the queue once it holds a lot more entries than there are objects to schedule.
+	if ( UpdateQueue.Num() <= 2 * NumActiveObjects + 256 )
+	{
+		return;
+	}
+
+	TArray< FScheduledObject > OldQueue;
+	Exchange( OldQueue, UpdateQueue );
+	UpdateQueue.Reserve( NumActiveObjects );
+
+	for ( const FScheduledObject& Entry : OldQueue )
+	{
+		if ( Entry.Info->bActive && !Entry.Info->bDue && Entry.Info->ScheduleSerial == Entry.Serial )
+		{
+			UpdateQueue.Add( Entry );
+		}
+	}
+
+	UpdateQueue.Heapify();
+}
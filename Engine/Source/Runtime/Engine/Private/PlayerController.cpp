@@ -20,6 +20,7 @@
 #include "Matinee/InterpTrackInstDirector.h"
 #include "Matinee/MatineeActor.h"
 #include "Engine/ActorChannel.h"
+#include "Net/NetworkObjectList.h"
 #include "GameFramework/SpectatorPawn.h"
 #include "GameFramework/HUD.h"
 #include "ContentStreaming.h"
@@ -596,6 +597,7 @@ void APlayerController::ForceSingleNetUpdateFor(AActor* Target)
 			if (Channel != NULL)
 			{
 				Target->bPendingNetUpdate = true; // will cause some other clients to do lesser checks too, but that's unavoidable with the current functionality
+				Conn->Driver->GetNetworkObjectList().MarkPendingNetUpdate(Target);
 			}
 		}
 	}
@@ -0,0 +1,567 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RepArrayDelta.cpp: Element level delta replication for plain replicated TArray properties.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/RepArrayDelta.h"
+
+static TAutoConsoleVariable<int32> CVarArrayDeltaReplication( TEXT( "net.ArrayDeltaReplication" ), 0,
+	TEXT( "If non zero, replicated TArray properties only send inserted, removed and changed elements instead of going through FRepLayout.\n" )
+	TEXT( "Read once at startup (from an ini or the command line) and included in the network version, so servers and clients that disagree can't connect." ),
+	ECVF_ReadOnly );
+
+namespace RepArrayDelta
+{
+	/** Same limit FRepLayout applies to dynamic arrays */
+	static const int32 MAX_ARRAY_SIZE = 2048;
+
+	/** Largest LCS table built when matching elements. Past this, what is left after trimming is paired up by position. */
+	static const int64 MAX_MATCH_CELLS = 64 * 1024;
+
+	/** Number of updates an element's touch record is kept for */
+	static const int32 TOUCH_HISTORY_LENGTH = 64;
+}
+
+/** Per connection history shared by every base state produced for one array property */
+struct FRepArrayDeltaHistory
+{
+	FRepArrayDeltaHistory() : NextElementID( 0 ), LatestSequence( 0 ), PrunedSequence( 0 ) { }
+
+	/** IDs are never reused, so an element the client only has because of a dropped update can't be mistaken for a new one */
+	int32					NextElementID;
+
+	/** Sequence of the most recently produced base state */
+	int32					LatestSequence;
+
+	/** Touch records up to and including this sequence may have been discarded */
+	int32					PrunedSequence;
+
+	/** Element ID -> sequence of the last update that sent or removed it */
+	TMap< int32, int32 >	LastTouched;
+};
+
+/** Custom INetDeltaBaseState used by FRepArrayDelta */
+class FRepArrayDeltaBaseState : public INetDeltaBaseState
+{
+public:
+	FRepArrayDeltaBaseState( UArrayProperty* InArrayProperty, const TSharedPtr< FRepArrayDeltaHistory >& InHistory, const int32 InSequence )
+		: ArrayProperty( InArrayProperty )
+		, History( InHistory )
+		, Sequence( InSequence )
+	{
+	}
+
+	virtual ~FRepArrayDeltaBaseState()
+	{
+		ArrayProperty->DestroyValue( &Values );
+	}
+
+	virtual bool IsStateEqual( INetDeltaBaseState* OtherState ) override
+	{
+		FRepArrayDeltaBaseState* Other = static_cast< FRepArrayDeltaBaseState* >( OtherState );
+		return ElementIDs == Other->ElementIDs && ArrayProperty->Identical( &Values, &Other->Values );
+	}
+
+	UArrayProperty*							ArrayProperty;
+	TSharedPtr< FRepArrayDeltaHistory >		History;
+	int32									Sequence;
+
+	/** The array as it was sent */
+	FScriptArray							Values;
+	TArray< int32 >							ElementIDs;
+};
+
+static void NetSerializeElement( UProperty* Inner, FArchive& Ar, FNetDeltaSerializeInfo& Parms, void* Data )
+{
+	UStructProperty* StructInner = Cast< UStructProperty >( Inner );
+
+	if ( StructInner != NULL )
+	{
+		// Object references are excluded by IsArrayDeltaProperty, so there is never anything unmapped
+		bool bHasUnmapped = false;
+		Parms.NetSerializeCB->NetSerializeStruct( StructInner->Struct, Ar, Parms.Map, Data, bHasUnmapped );
+	}
+	else
+	{
+		Inner->NetSerializeItem( Ar, Parms.Map, Data );
+	}
+}
+
+void FRepArrayDelta::MatchElements( const UProperty* Inner, FScriptArrayHelper& OldHelper, FScriptArrayHelper& NewHelper, TArray< int32 >& OutMatch, TBitArray<>& OutIdentical )
+{
+	const int32 OldNum = OldHelper.Num();
+	const int32 NewNum = NewHelper.Num();
+
+	OutMatch.Init( INDEX_NONE, NewNum );
+	OutIdentical.Init( false, NewNum );
+
+	auto IsIdentical = [&]( const int32 OldIndex, const int32 NewIndex )
+	{
+		return Inner->Identical( OldHelper.GetRawPtr( OldIndex ), NewHelper.GetRawPtr( NewIndex ) );
+	};
+
+	// Elements in a range with no identical matches are paired up by position, and count as changed in place
+	auto PairRange = [&]( const int32 OldStart, const int32 OldEnd, const int32 NewStart, const int32 NewEnd )
+	{
+		for ( int32 i = 0; i < OldEnd - OldStart && i < NewEnd - NewStart; i++ )
+		{
+			OutMatch[NewStart + i]		= OldStart + i;
+			OutIdentical[NewStart + i]	= IsIdentical( OldStart + i, NewStart + i );
+		}
+	};
+
+	// Most updates only touch one range of the array, so trim everything around it first
+	int32 Prefix = 0;
+	while ( Prefix < OldNum && Prefix < NewNum && IsIdentical( Prefix, Prefix ) )
+	{
+		OutMatch[Prefix]		= Prefix;
+		OutIdentical[Prefix]	= true;
+		Prefix++;
+	}
+
+	int32 Suffix = 0;
+	while ( Prefix + Suffix < OldNum && Prefix + Suffix < NewNum && IsIdentical( OldNum - 1 - Suffix, NewNum - 1 - Suffix ) )
+	{
+		OutMatch[NewNum - 1 - Suffix]		= OldNum - 1 - Suffix;
+		OutIdentical[NewNum - 1 - Suffix]	= true;
+		Suffix++;
+	}
+
+	const int32 NumOld = OldNum - Prefix - Suffix;
+	const int32 NumNew = NewNum - Prefix - Suffix;
+
+	if ( NumOld == 0 || NumNew == 0 )
+	{
+		return;
+	}
+
+	if ( (int64)( NumOld + 1 ) * ( NumNew + 1 ) > RepArrayDelta::MAX_MATCH_CELLS )
+	{
+		PairRange( Prefix, Prefix + NumOld, Prefix, Prefix + NumNew );
+		return;
+	}
+
+	// Lengths[i][j] is the length of the longest common subsequence of the remaining old elements from i and new elements from j
+	const int32 Stride = NumNew + 1;
+
+	TArray< uint16 > Lengths;
+	Lengths.SetNumZeroed( ( NumOld + 1 ) * Stride );
+
+	TBitArray<> Equal( false, NumOld * NumNew );
+
+	for ( int32 i = NumOld - 1; i >= 0; i-- )
+	{
+		for ( int32 j = NumNew - 1; j >= 0; j-- )
+		{
+			if ( IsIdentical( Prefix + i, Prefix + j ) )
+			{
+				Equal[i * NumNew + j] = true;
+				Lengths[i * Stride + j] = Lengths[( i + 1 ) * Stride + j + 1] + 1;
+			}
+			else
+			{
+				Lengths[i * Stride + j] = FMath::Max( Lengths[( i + 1 ) * Stride + j], Lengths[i * Stride + j + 1] );
+			}
+		}
+	}
+
+	int32 i = 0;
+	int32 j = 0;
+	int32 GapOld = 0;
+	int32 GapNew = 0;
+
+	while ( i < NumOld && j < NumNew )
+	{
+		if ( Equal[i * NumNew + j] )
+		{
+			PairRange( Prefix + GapOld, Prefix + i, Prefix + GapNew, Prefix + j );
+
+			OutMatch[Prefix + j]		= Prefix + i;
+			OutIdentical[Prefix + j]	= true;
+
+			GapOld = ++i;
+			GapNew = ++j;
+		}
+		else if ( Lengths[( i + 1 ) * Stride + j] >= Lengths[i * Stride + j + 1] )
+		{
+			i++;
+		}
+		else
+		{
+			j++;
+		}
+	}
+
+	PairRange( Prefix + GapOld, Prefix + NumOld, Prefix + GapNew, Prefix + NumNew );
+}
+
+bool FRepArrayDelta::IsEnabled()
+{
+	// Latched the first time it is asked for (at the latest when the network version is computed), since it changes the wire format
+	static const bool bEnabled = CVarArrayDeltaReplication.GetValueOnAnyThread() != 0;
+	return bEnabled;
+}
+
+bool FRepArrayDelta::IsArrayDeltaProperty( UProperty* Property )
+{
+	if ( !IsEnabled() )
+	{
+		return false;
+	}
+
+	UArrayProperty* ArrayProperty = Cast< UArrayProperty >( Property );
+
+	if ( ArrayProperty == NULL )
+	{
+		return false;
+	}
+
+	// Object references need the unmapped GUID tracking FRepLayout does for them
+	return !ArrayProperty->Inner->ContainsObjectReference();
+}
+
+bool FRepArrayDelta::WriteDelta( UArrayProperty* ArrayProperty, FNetDeltaSerializeInfo& Parms, void* Data )
+{
+	check( Parms.Writer );
+	check( Parms.NewState );
+
+	FBitWriter& Writer	= *Parms.Writer;
+	UProperty* Inner	= ArrayProperty->Inner;
+
+	FScriptArrayHelper NewHelper( ArrayProperty, Data );
+	const int32 NewNum = NewHelper.Num();
+
+	if ( NewNum > RepArrayDelta::MAX_ARRAY_SIZE )
+	{
+		UE_LOG( LogRepTraffic, Error, TEXT( "FRepArrayDelta::WriteDelta: ArrayNum > MAX_ARRAY_SIZE (%s)" ), *ArrayProperty->GetName() );
+		return false;
+	}
+
+	FRepArrayDeltaBaseState* OldState = static_cast< FRepArrayDeltaBaseState* >( Parms.OldState );
+	TSharedPtr< FRepArrayDeltaHistory > History = OldState != NULL ? OldState->History : MakeShareable( new FRepArrayDeltaHistory() );
+
+	// If the base isn't the last state we produced, an update was dropped, and the client may have received any of the ones sent after it
+	const bool bSendOrder		= OldState == NULL || OldState->Sequence != History->LatestSequence;
+	const bool bSendAllValues	= OldState == NULL || OldState->Sequence < History->PrunedSequence;
+
+	FScriptArray EmptyValues;
+	FScriptArrayHelper OldHelper( ArrayProperty, OldState != NULL ? &OldState->Values : &EmptyValues );
+
+	const TArray< int32 > EmptyIDs;
+	const TArray< int32 >& OldIDs = OldState != NULL ? OldState->ElementIDs : EmptyIDs;
+
+	TArray< int32 > Match;
+	TBitArray<> Identical;
+	MatchElements( Inner, OldHelper, NewHelper, Match, Identical );
+
+	TArray< int32 > NewIDs;
+	NewIDs.SetNumUninitialized( NewNum );
+
+	TBitArray<> OldKept( false, OldHelper.Num() );
+
+	TArray< int32, TInlineAllocator< 8 > > ChangedIndices;
+	TArray< int32, TInlineAllocator< 8 > > DeletedIDs;
+
+	for ( int32 NewIndex = 0; NewIndex < NewNum; NewIndex++ )
+	{
+		const int32 OldIndex = Match[NewIndex];
+
+		if ( OldIndex == INDEX_NONE )
+		{
+			NewIDs[NewIndex] = History->NextElementID++;
+			ChangedIndices.Add( NewIndex );
+			continue;
+		}
+
+		NewIDs[NewIndex]	= OldIDs[OldIndex];
+		OldKept[OldIndex]	= true;
+
+		if ( !Identical[NewIndex] )
+		{
+			ChangedIndices.Add( NewIndex );
+		}
+		else if ( bSendOrder && ( bSendAllValues || History->LastTouched.FindRef( NewIDs[NewIndex] ) > OldState->Sequence ) )
+		{
+			// Unchanged since the base, but an update sent after it may have given the client a different value
+			ChangedIndices.Add( NewIndex );
+		}
+	}
+
+	for ( int32 OldIndex = 0; OldIndex < OldHelper.Num(); OldIndex++ )
+	{
+		if ( !OldKept[OldIndex] )
+		{
+			DeletedIDs.Add( OldIDs[OldIndex] );
+		}
+	}
+
+	if ( !bSendOrder && ChangedIndices.Num() == 0 && DeletedIDs.Num() == 0 )
+	{
+		return false;
+	}
+
+	FRepArrayDeltaBaseState* NewState = new FRepArrayDeltaBaseState( ArrayProperty, History, ++History->LatestSequence );
+	*Parms.NewState = TSharedPtr< INetDeltaBaseState >( NewState );
+
+	ArrayProperty->CopyCompleteValue( &NewState->Values, Data );
+
+	for ( const int32 Index : ChangedIndices )
+	{
+		History->LastTouched.Add( NewIDs[Index], NewState->Sequence );
+	}
+
+	for ( const int32 ID : DeletedIDs )
+	{
+		History->LastTouched.Add( ID, NewState->Sequence );
+	}
+
+	if ( NewState->Sequence % RepArrayDelta::TOUCH_HISTORY_LENGTH == 0 )
+	{
+		// Anything restored from further back than this resends every value
+		const int32 OldestKept = NewState->Sequence - RepArrayDelta::TOUCH_HISTORY_LENGTH;
+
+		for ( auto It = History->LastTouched.CreateIterator(); It; ++It )
+		{
+			if ( It.Value() < OldestKept )
+			{
+				History->PrunedSequence = FMath::Max( History->PrunedSequence, It.Value() );
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	//----------------------
+	// Write it out.
+	//----------------------
+	Writer.WriteBit( bSendOrder ? 1 : 0 );
+
+	if ( bSendOrder )
+	{
+		uint32 NumElements = NewNum;
+		Writer.SerializeIntPacked( NumElements );
+
+		for ( const int32 ID : NewIDs )
+		{
+			uint32 PackedID = ID;
+			Writer.SerializeIntPacked( PackedID );
+		}
+	}
+	else
+	{
+		uint32 NumDeleted = DeletedIDs.Num();
+		Writer.SerializeIntPacked( NumDeleted );
+
+		for ( const int32 ID : DeletedIDs )
+		{
+			uint32 PackedID = ID;
+			Writer.SerializeIntPacked( PackedID );
+		}
+	}
+
+	uint32 NumChanged = ChangedIndices.Num();
+	Writer.SerializeIntPacked( NumChanged );
+
+	// Ascending index order, so the client can insert each new element directly at its final index
+	for ( const int32 Index : ChangedIndices )
+	{
+		uint32 PackedID = NewIDs[Index];
+		Writer.SerializeIntPacked( PackedID );
+
+		if ( !bSendOrder )
+		{
+			uint32 PackedIndex = Index;
+			Writer.SerializeIntPacked( PackedIndex );
+		}
+
+		NetSerializeElement( Inner, Writer, Parms, NewHelper.GetRawPtr( Index ) );
+	}
+
+	UE_LOG( LogRepTraffic, Verbose, TEXT( "FRepArrayDelta::WriteDelta: %s. Num: %d, Changed: %d, Deleted: %d, Order: %d" ), *ArrayProperty->GetName(), NewNum, ChangedIndices.Num(), DeletedIDs.Num(), bSendOrder ? 1 : 0 );
+
+	NewState->ElementIDs = MoveTemp( NewIDs );
+
+	return true;
+}
+
+bool FRepArrayDelta::ReadDelta( UArrayProperty* ArrayProperty, FNetDeltaSerializeInfo& Parms, void* Data, TArray< int32 >& ElementIDs )
+{
+	check( Parms.Reader );
+
+	FBitReader& Reader	= *Parms.Reader;
+	UProperty* Inner	= ArrayProperty->Inner;
+
+	//---------------
+	// Read everything before touching the array, so a malformed update leaves it alone
+	//---------------
+	const bool bHasOrder = Reader.ReadBit() != 0;
+
+	TArray< int32 > Order;
+	TArray< int32, TInlineAllocator< 8 > > DeletedIDs;
+
+	uint32 NumIDs = 0;
+	Reader.SerializeIntPacked( NumIDs );
+
+	if ( NumIDs > (uint32)RepArrayDelta::MAX_ARRAY_SIZE )
+	{
+		UE_LOG( LogRep, Warning, TEXT( "FRepArrayDelta::ReadDelta: Too many elements: %u (%s)" ), NumIDs, *ArrayProperty->GetName() );
+		Reader.SetError();
+		return false;
+	}
+
+	for ( uint32 i = 0; i < NumIDs; i++ )
+	{
+		uint32 ID = 0;
+		Reader.SerializeIntPacked( ID );
+
+		if ( bHasOrder )
+		{
+			Order.Add( (int32)ID );
+		}
+		else
+		{
+			DeletedIDs.Add( (int32)ID );
+		}
+	}
+
+	uint32 NumChanged = 0;
+	Reader.SerializeIntPacked( NumChanged );
+
+	if ( NumChanged > (uint32)RepArrayDelta::MAX_ARRAY_SIZE )
+	{
+		UE_LOG( LogRep, Warning, TEXT( "FRepArrayDelta::ReadDelta: Too many changed elements: %u (%s)" ), NumChanged, *ArrayProperty->GetName() );
+		Reader.SetError();
+		return false;
+	}
+
+	TArray< int32 > ChangedIDs;
+	TArray< int32 > ChangedIndices;
+
+	FScriptArray ChangedValues;
+	FScriptArrayHelper ChangedHelper( ArrayProperty, &ChangedValues );
+
+	if ( NumChanged > 0 )
+	{
+		ChangedHelper.AddValues( NumChanged );
+	}
+
+	for ( uint32 i = 0; i < NumChanged && !Reader.IsError(); i++ )
+	{
+		uint32 ID = 0;
+		Reader.SerializeIntPacked( ID );
+		ChangedIDs.Add( (int32)ID );
+
+		if ( !bHasOrder )
+		{
+			uint32 Index = 0;
+			Reader.SerializeIntPacked( Index );
+			ChangedIndices.Add( (int32)Index );
+		}
+
+		NetSerializeElement( Inner, Reader, Parms, ChangedHelper.GetRawPtr( i ) );
+	}
+
+	if ( Reader.IsError() )
+	{
+		ArrayProperty->DestroyValue( &ChangedValues );
+		return false;
+	}
+
+	//---------------
+	// Apply
+	//---------------
+	FScriptArrayHelper ArrayHelper( ArrayProperty, Data );
+
+	if ( ElementIDs.Num() != ArrayHelper.Num() )
+	{
+		// The array was resized locally. Elements we have no ID for are dropped the next time the full order is received.
+		UE_LOG( LogRep, Verbose, TEXT( "FRepArrayDelta::ReadDelta: %s was modified locally (%d IDs, %d elements)" ), *ArrayProperty->GetName(), ElementIDs.Num(), ArrayHelper.Num() );
+
+		if ( ElementIDs.Num() > ArrayHelper.Num() )
+		{
+			ElementIDs.SetNum( ArrayHelper.Num() );
+		}
+
+		while ( ElementIDs.Num() < ArrayHelper.Num() )
+		{
+			ElementIDs.Add( INDEX_NONE );
+		}
+	}
+
+	if ( bHasOrder )
+	{
+		TMap< int32, int32 > ChangedMap;
+		for ( int32 i = 0; i < ChangedIDs.Num(); i++ )
+		{
+			ChangedMap.Add( ChangedIDs[i], i );
+		}
+
+		TMap< int32, int32 > LocalMap;
+		for ( int32 i = 0; i < ElementIDs.Num(); i++ )
+		{
+			LocalMap.Add( ElementIDs[i], i );
+		}
+
+		FScriptArray NewValues;
+		FScriptArrayHelper NewHelper( ArrayProperty, &NewValues );
+
+		if ( Order.Num() > 0 )
+		{
+			NewHelper.AddValues( Order.Num() );
+		}
+
+		for ( int32 i = 0; i < Order.Num(); i++ )
+		{
+			if ( const int32* ChangedIndex = ChangedMap.Find( Order[i] ) )
+			{
+				Inner->CopyCompleteValue( NewHelper.GetRawPtr( i ), ChangedHelper.GetRawPtr( *ChangedIndex ) );
+			}
+			else if ( const int32* LocalIndex = LocalMap.Find( Order[i] ) )
+			{
+				Inner->CopyCompleteValue( NewHelper.GetRawPtr( i ), ArrayHelper.GetRawPtr( *LocalIndex ) );
+			}
+			else
+			{
+				UE_LOG( LogRep, Warning, TEXT( "FRepArrayDelta::ReadDelta: Missing element %d in %s" ), Order[i], *ArrayProperty->GetName() );
+			}
+		}
+
+		ArrayProperty->CopyCompleteValue( Data, &NewValues );
+		ArrayProperty->DestroyValue( &NewValues );
+
+		ElementIDs = MoveTemp( Order );
+	}
+	else
+	{
+		for ( const int32 ID : DeletedIDs )
+		{
+			const int32 Index = ElementIDs.Find( ID );
+
+			if ( Index != INDEX_NONE )
+			{
+				ArrayHelper.RemoveValues( Index );
+				ElementIDs.RemoveAt( Index );
+			}
+		}
+
+		// Elements are sent in ascending index order, so everything before an inserted element is already in place
+		for ( int32 i = 0; i < ChangedIDs.Num(); i++ )
+		{
+			int32 Index = ElementIDs.Find( ChangedIDs[i] );
+
+			if ( Index == INDEX_NONE )
+			{
+				Index = FMath::Min( ChangedIndices[i], ArrayHelper.Num() );
+				ArrayHelper.InsertValues( Index );
+				ElementIDs.Insert( ChangedIDs[i], Index );
+			}
+
+			Inner->CopyCompleteValue( ArrayHelper.GetRawPtr( Index ), ChangedHelper.GetRawPtr( i ) );
+		}
+	}
+
+	ArrayProperty->DestroyValue( &ChangedValues );
+
+	return true;
+}
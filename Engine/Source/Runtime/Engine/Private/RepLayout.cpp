@@ -12,6 +12,8 @@
 
 static TAutoConsoleVariable<int32> CVarAllowPropertySkipping( TEXT( "net.AllowPropertySkipping" ), 1, TEXT( "Allow skipping of properties that haven't changed for other clients" ) );
 
+static TAutoConsoleVariable<int32> CVarShareChangelists( TEXT( "net.ShareChangelists" ), 0, TEXT( "Compare unconditional properties once per frame against a shadow state shared by all connections, and merge the resulting changelists per connection" ) );
+
 static TAutoConsoleVariable<int32> CVarDoPropertyChecksum( TEXT( "net.DoPropertyChecksum" ), 0, TEXT( "" ) );
 
 FAutoConsoleVariable CVarDoReplicationContextString( TEXT( "net.ContextDebug" ), 0, TEXT( "" ) );
@@ -585,6 +587,153 @@ void FRepLayout::SanityCheckShadowStateAgainstChangeList(
 	}
 }
 
+void FRepLayout::CompareUnconditionalProperties( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, const uint32 ReplicationFrame ) const
+{
+	FRepChangedPropertyTracker * ChangeTracker = RepState->RepChangedPropertyTracker.Get();
+
+	// FRepState group changed, force this group to compare again this frame
+	// This happens either once a frame, which is normal, or multiple times a frame 
+	// when multiple connections of the same actor aren't updated at the same time
+	ChangeTracker->LastReplicationFrame			= ReplicationFrame;
+	ChangeTracker->LastReplicationGroupFrame	= RepState->LastReplicationFrame;
+	ChangeTracker->LastRepState					= RepState;
+
+	// Reset changed list if anything changed last time
+	if ( ChangeTracker->UnconditionalPropChanged )
+	{
+		for ( int32 i = UnconditionalLifetime.Num() - 1; i >= 0; i-- )
+		{
+			ChangeTracker->Parents[UnconditionalLifetime[i]].Changed.Empty();
+		}
+	}
+
+	// Loop over all unconditional lifetime properties
+	ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, RepState->StaticBuffer.GetData(), Data, ChangeTracker->Parents, UnconditionalLifetime );
+}
+
+bool FRepLayout::UpdateChangelistState( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, const uint32 ReplicationFrame ) const
+{
+	FRepChangedPropertyTracker * ChangeTracker = RepState->RepChangedPropertyTracker.Get();
+
+	if ( !ChangeTracker->ChangelistState.IsValid() )
+	{
+		// Start sharing from the current state of the object. FRepStates that replicated before this point catch up with a full compare once.
+		FRepChangelistState * NewChangelistState = new FRepChangelistState();
+
+		NewChangelistState->RepLayout = RepState->RepLayout;
+		NewChangelistState->StaticBuffer.AddZeroed( RepState->StaticBuffer.Num() );
+
+		ConstructProperties( NewChangelistState->StaticBuffer );
+		InitProperties( NewChangelistState->StaticBuffer, Data );
+
+		NewChangelistState->ChangedParents.SetNum( Parents.Num() );
+		NewChangelistState->LastCompareFrame = ReplicationFrame;
+
+		ChangeTracker->ChangelistState = MakeShareable( NewChangelistState );
+
+		return true;
+	}
+
+	FRepChangelistState * ChangelistState = ChangeTracker->ChangelistState.Get();
+
+	if ( ChangelistState->LastCompareFrame == ReplicationFrame )
+	{
+		// Someone already compared this frame
+		return false;
+	}
+
+	ChangelistState->LastCompareFrame = ReplicationFrame;
+
+	if ( !CompareProperties( RepState, ChangelistState->StaticBuffer.GetData(), Data, ChangelistState->ChangedParents, UnconditionalLifetime ) )
+	{
+		return true;
+	}
+
+	// Drop the oldest changelist if the history is full, FRepStates that still needed it will do a full compare instead
+	if ( ChangelistState->HistoryEnd - ChangelistState->HistoryStart == FRepChangelistState::MAX_CHANGE_HISTORY )
+	{
+		ChangelistState->HistoryStart++;
+	}
+
+	TArray< uint16 > & Changed = ChangelistState->ChangeHistory[ ChangelistState->HistoryEnd % FRepChangelistState::MAX_CHANGE_HISTORY ];
+
+	Changed.Empty();
+
+	uint8 * ShadowData = ChangelistState->StaticBuffer.GetData();
+
+	// Build the change list in parent order so it is fully sorted, and bring the shared shadow state up to date
+	for ( int32 i = 0; i < Parents.Num(); i++ )
+	{
+		TArray< uint16 > & ParentChanged = ChangelistState->ChangedParents[i].Changed;
+
+		if ( ParentChanged.Num() > 0 )
+		{
+			Changed.Append( ParentChanged );
+			ParentChanged.Empty();
+
+			Parents[i].Property->CopySingleValue( Parents[i].Property->ContainerPtrToValuePtr< uint8 >( ShadowData, Parents[i].ArrayIndex ), Parents[i].Property->ContainerPtrToValuePtr< uint8 >( (void*)Data, Parents[i].ArrayIndex ) );
+		}
+	}
+
+	Changed.Add( 0 );
+
+	ChangelistState->HistoryEnd++;
+
+	return true;
+}
+
+void FRepLayout::MergeChangelistHistory( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, TArray< uint16 > & OutChanged ) const
+{
+	const FRepChangelistState * ChangelistState = RepState->RepChangedPropertyTracker->ChangelistState.Get();
+
+	check( RepState->LastChangelistIndex >= ChangelistState->HistoryStart );
+
+	OutChanged.Empty();
+
+	for ( int32 i = RepState->LastChangelistIndex; i < ChangelistState->HistoryEnd; i++ )
+	{
+		const TArray< uint16 > & HistoryChanged = ChangelistState->ChangeHistory[ i % FRepChangelistState::MAX_CHANGE_HISTORY ];
+
+		if ( OutChanged.Num() == 0 )
+		{
+			OutChanged = HistoryChanged;
+		}
+		else
+		{
+			TArray< uint16 > Temp = OutChanged;
+			MergeDirtyList( RepState, (void*)Data, Temp, HistoryChanged, OutChanged );
+		}
+	}
+}
+
+bool FRepLayout::PreCompareProperties( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, const uint32 ReplicationFrame ) const
+{
+	SCOPE_CYCLE_COUNTER( STAT_NetReplicateDynamicPropTime );
+
+	if ( CVarShareChangelists.GetValueOnAnyThread() > 0 )
+	{
+		return UpdateChangelistState( RepState, Data, ReplicationFrame );
+	}
+
+	// Nothing can be shared if skipping is disabled, or if this FRepState has not been replicated yet (it isn't part of a replication group)
+	if ( CVarAllowPropertySkipping.GetValueOnAnyThread() == 0 || RepState->LastReplicationFrame == 0 )
+	{
+		return false;
+	}
+
+	const FRepChangedPropertyTracker * ChangeTracker = RepState->RepChangedPropertyTracker.Get();
+
+	// This group was already compared this frame
+	if ( ChangeTracker->LastReplicationFrame == ReplicationFrame && ChangeTracker->LastReplicationGroupFrame == RepState->LastReplicationFrame )
+	{
+		return false;
+	}
+
+	CompareUnconditionalProperties( RepState, Data, ReplicationFrame );
+
+	return true;
+}
+
 bool FRepLayout::ReplicateProperties( 
 	FRepState * RESTRICT		RepState, 
 	const uint8* RESTRICT		Data, 
@@ -614,6 +763,10 @@ bool FRepLayout::ReplicateProperties(
 
 	bool PropertyChanged = false;
 
+	// Unconditional property changes merged from the shared changelist history, when it is used
+	bool bUsedChangelistHistory = false;
+	TArray< uint16 > SharedChanged;
+
 #ifdef ENABLE_SUPER_CHECKSUMS
 	const bool bIsAllAcked = AllAcked( RepState );
 
@@ -621,13 +774,37 @@ bool FRepLayout::ReplicateProperties(
 #endif
 	{
 		const int32	AllowSkipping = CVarAllowPropertySkipping.GetValueOnGameThread();
+
+		if ( CVarShareChangelists.GetValueOnGameThread() > 0 )
+		{
+			const bool bCompared = UpdateChangelistState( RepState, Data, NetDriver->ReplicationFrame );
+
+			const FRepChangelistState * ChangelistState = ChangeTracker->ChangelistState.Get();
+
+			if ( RepState->LastChangelistIndex != INDEX_NONE && RepState->LastChangelistIndex >= ChangelistState->HistoryStart )
+			{
+				MergeChangelistHistory( RepState, Data, SharedChanged );
+				bUsedChangelistHistory = true;
+
+				if ( !bCompared )
+				{
+					INC_DWORD_STAT( STAT_NetSharedChangelistComparesSaved );
+				}
+			}
+
+			RepState->LastChangelistIndex = ChangelistState->HistoryEnd;
+		}
 		
 		const bool bCanSkip =	AllowSkipping > 0 && 
 								RepState->LastReplicationFrame != 0 &&
 								ChangeTracker->LastReplicationFrame == NetDriver->ReplicationFrame &&
 								ChangeTracker->LastReplicationGroupFrame == RepState->LastReplicationFrame;
 
-		if ( bCanSkip )
+		if ( bUsedChangelistHistory )
+		{
+			PropertyChanged = SharedChanged.Num() > 0;
+		}
+		else if ( bCanSkip )
 		{
 			INC_DWORD_STAT_BY( STAT_NetSkippedDynamicProps, UnconditionalLifetime.Num() );
 
@@ -641,30 +818,13 @@ bool FRepLayout::ReplicateProperties(
 		}
 		else
 		{
-			// FRepState group changed, force this group to compare again this frame
-			// This happens either once a frame, which is normal, or multiple times a frame 
-			// when multiple connections of the same actor aren't updated at the same time
-			ChangeTracker->LastReplicationFrame			= NetDriver->ReplicationFrame;
-			ChangeTracker->LastReplicationGroupFrame	= RepState->LastReplicationFrame;
-			ChangeTracker->LastRepState					= RepState;
-
-			// Reset changed list if anything changed last time
-			if ( ChangeTracker->UnconditionalPropChanged )
-			{
-				for ( int32 i = UnconditionalLifetime.Num() - 1; i >= 0; i-- )
-				{
-					ChangeTracker->Parents[UnconditionalLifetime[i]].Changed.Empty();
-				}
-			}
-
-			// Loop over all unconditional lifetime properties
-			ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, UnconditionalLifetime );
+			CompareUnconditionalProperties( RepState, Data, NetDriver->ReplicationFrame );
 		}
 
 		// Remember the last frame this FRepState was replicated, so we can note above when the FRepState replication group changes
 		RepState->LastReplicationFrame = NetDriver->ReplicationFrame;
 
-		if ( ChangeTracker->UnconditionalPropChanged )
+		if ( !bUsedChangelistHistory && ChangeTracker->UnconditionalPropChanged )
 		{
 			PropertyChanged	= true;
 		}
@@ -681,6 +841,7 @@ bool FRepLayout::ReplicateProperties(
 		// If we didn't compare this frame, make sure to reset out replication frame
 		// This is to force a compare next time it comes up
 		RepState->LastReplicationFrame = 0;		
+		RepState->LastChangelistIndex = INDEX_NONE;
 	}
 #endif
 
@@ -707,6 +868,12 @@ bool FRepLayout::ReplicateProperties(
 			// We do it in the order of the parents so that the final change list will be fully sorted
 			for ( int32 i = 0; i < Parents.Num(); i++ )
 			{
+				// Unconditional changes come from the shared history in that case, the tracker may hold another group's compare
+				if ( bUsedChangelistHistory && !( Parents[i].Flags & PARENT_IsConditional ) )
+				{
+					continue;
+				}
+
 				if ( ChangeTracker->Parents[i].Changed.Num() > 0 )
 				{
 					Changed.Append( ChangeTracker->Parents[i].Changed );
@@ -721,6 +888,12 @@ bool FRepLayout::ReplicateProperties(
 
 			Changed.Add( 0 );
 
+			if ( SharedChanged.Num() > 0 )
+			{
+				TArray< uint16 > Temp = Changed;
+				MergeDirtyList( RepState, (void*)Data, Temp, SharedChanged, Changed );
+			}
+
 #ifdef SANITY_CHECK_MERGES
 			SanityCheckChangeList( Data, Changed );
 #endif
@@ -2608,10 +2781,10 @@ void FRepLayout::InitRepState(
 	RepState->StaticBuffer.AddZeroed( InObjectClass->GetDefaultsCount() );
 
 	// Construct the properties
-	ConstructProperties( RepState );
+	ConstructProperties( RepState->StaticBuffer );
 
 	// Init the properties
-	InitProperties( RepState, Src );
+	InitProperties( RepState->StaticBuffer, Src );
 	
 	RepState->RepChangedPropertyTracker = InRepChangedPropertyTracker;
 
@@ -2622,9 +2795,9 @@ void FRepLayout::InitRepState(
 	RebuildConditionalProperties( RepState, *InRepChangedPropertyTracker.Get(), FReplicationFlags() );
 }
 
-void FRepLayout::ConstructProperties( FRepState * RepState ) const
+void FRepLayout::ConstructProperties( TArray< uint8 > & ShadowData ) const
 {
-	uint8* StoredData = RepState->StaticBuffer.GetData();
+	uint8* StoredData = ShadowData.GetData();
 
 	// Construct all items
 	for ( int32 i = 0; i < Parents.Num(); i++ )
@@ -2633,16 +2806,16 @@ void FRepLayout::ConstructProperties( FRepState * RepState ) const
 		if ( Parents[i].ArrayIndex == 0 )
 		{
 			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData ) - StoredData;
-			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+			check( Offset >= 0 && Offset < ShadowData.Num() );
 
 			Parents[i].Property->InitializeValue( StoredData + Offset );
 		}
 	}
 }
 
-void FRepLayout::InitProperties( FRepState * RepState, uint8* Src ) const
+void FRepLayout::InitProperties( TArray< uint8 > & ShadowData, const uint8* Src ) const
 {
-	uint8* StoredData = RepState->StaticBuffer.GetData();
+	uint8* StoredData = ShadowData.GetData();
 
 	// Init all items
 	for ( int32 i = 0; i < Parents.Num(); i++ )
@@ -2651,16 +2824,16 @@ void FRepLayout::InitProperties( FRepState * RepState, uint8* Src ) const
 		if ( Parents[i].ArrayIndex == 0 )
 		{
 			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData ) - StoredData;
-			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+			check( Offset >= 0 && Offset < ShadowData.Num() );
 
 			Parents[i].Property->CopyCompleteValue( StoredData + Offset, Src + Offset );
 		}
 	}
 }
 
-void FRepLayout::DestructProperties( FRepState * RepState ) const
+void FRepLayout::DestructProperties( TArray< uint8 > & ShadowData ) const
 {
-	uint8* StoredData = RepState->StaticBuffer.GetData();
+	uint8* StoredData = ShadowData.GetData();
 
 	// Destruct all items
 	for ( int32 i = 0; i < Parents.Num(); i++ )
@@ -2669,13 +2842,13 @@ void FRepLayout::DestructProperties( FRepState * RepState ) const
 		if ( Parents[i].ArrayIndex == 0 )
 		{
 			PTRINT Offset = Parents[i].Property->ContainerPtrToValuePtr<uint8>( StoredData ) - StoredData;
-			check( Offset >= 0 && Offset < RepState->StaticBuffer.Num() );
+			check( Offset >= 0 && Offset < ShadowData.Num() );
 
 			Parents[i].Property->DestroyValue( StoredData + Offset );
 		}
 	}
 
-	RepState->StaticBuffer.Empty();
+	ShadowData.Empty();
 }
 
 void FRepLayout::GetLifetimeCustomDeltaProperties(TArray< int32 > & OutCustom, TArray< ELifetimeCondition >	& OutConditions)
@@ -2695,10 +2868,18 @@ void FRepLayout::GetLifetimeCustomDeltaProperties(TArray< int32 > & OutCustom, T
 	}
 }
 
+FRepChangelistState::~FRepChangelistState()
+{
+	if ( RepLayout.IsValid() && StaticBuffer.Num() > 0 )
+	{
+		RepLayout->DestructProperties( StaticBuffer );
+	}
+}
+
 FRepState::~FRepState()
 {
 	if (RepLayout.IsValid() && StaticBuffer.Num() > 0)
 	{	
-		RepLayout->DestructProperties( this );
+		RepLayout->DestructProperties( StaticBuffer );
 	}
 }
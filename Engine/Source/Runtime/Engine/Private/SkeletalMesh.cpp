@@ -1904,6 +1904,9 @@ FArchive& operator<<(FArchive& Ar, FClothingAssetData& A)
 			Buffer.AddUninitialized( AssetSize );
 			Ar.Serialize( Buffer.GetData(), AssetSize );
 #if WITH_APEX_CLOTHING
+			// Skeletal meshes may be serialized on several loading workers at once
+			static FCriticalSection LoadClothingAssetCritical;
+			FScopeLock LoadClothingAssetLock(&LoadClothingAssetCritical);
 			A.ApexClothingAsset = LoadApexClothingAssetFromBlob(Buffer);
 #endif //#if WITH_APEX_CLOTHING
 		}
@@ -2595,6 +2598,12 @@ void USkeletalMesh::Serialize( FArchive& Ar )
 	}
 }
 
+bool USkeletalMesh::IsSerializeThreadSafe() const
+{
+	// Cooked meshes only read their own LOD models, the clothing assets are created under a lock
+	return true;
+}
+
 void USkeletalMesh::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
 {	
 	USkeletalMesh* This = CastChecked<USkeletalMesh>(InThis);
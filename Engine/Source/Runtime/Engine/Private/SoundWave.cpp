@@ -429,6 +429,11 @@ bool USoundWave::IsLocalizedResource()
 	return( Super::IsLocalizedResource() || Subtitles.Num() > 0 || bIsLocalised );
 }
 
+bool USoundWave::CanBeClusterRoot() const
+{
+	return GAssetClusteringEnabled != 0;
+}
+
 #if WITH_EDITOR
 
 void USoundWave::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
@@ -1500,6 +1500,11 @@ void UStaticMesh::AddReferencedObjects(UObject* InThis, FReferenceCollector& Col
 	Super::AddReferencedObjects( This, Collector );
 }
 
+bool UStaticMesh::CanBeClusterRoot() const
+{
+	return GAssetClusteringEnabled != 0;
+}
+
 #if WITH_EDITOR
 void UStaticMesh::PreEditChange(UProperty* PropertyAboutToChange)
 {
@@ -1998,6 +2003,12 @@ void UStaticMesh::Serialize(FArchive& Ar)
 #endif // WITH_EDITORONLY_DATA
 }
 
+bool UStaticMesh::IsSerializeThreadSafe() const
+{
+	// Cooked meshes only read their own render data, and only resolve the references to their body setup and materials
+	return true;
+}
+
 //
 //	UStaticMesh::PostLoad
 //
@@ -2248,6 +2259,7 @@ void UStaticMesh::AddAssetUserData(UAssetUserData* InUserData)
 			AssetUserData.Remove(ExistingData);
 		}
 		AssetUserData.Add(InUserData);
+		GCClusterWriteBarrier(this, InUserData);
 	}
 }
 
@@ -2290,6 +2302,7 @@ void UStaticMesh::CreateBodySetup()
 	if (BodySetup==NULL)
 	{
 		BodySetup = NewObject<UBodySetup>(this);
+		GCClusterWriteBarrier(this, BodySetup);
 	}
 }
 
@@ -2298,6 +2311,7 @@ void UStaticMesh::CreateNavCollision()
 	if (NavCollision == NULL && BodySetup != NULL)
 	{
 		NavCollision = NewObject<UNavCollision>(this);
+		GCClusterWriteBarrier(this, NavCollision);
 		NavCollision->Setup(BodySetup);
 	}
 }
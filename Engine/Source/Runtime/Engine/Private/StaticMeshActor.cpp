@@ -24,6 +24,8 @@ AStaticMeshActor::AStaticMeshActor(const FObjectInitializer& ObjectInitializer)
 	StaticMeshComponent->bGenerateOverlapEvents = false;
 
 	RootComponent = StaticMeshComponent;
+
+	bCanBeInCluster = true;
 }
 
 void AStaticMeshActor::BeginPlay()
@@ -44,6 +46,12 @@ void AStaticMeshActor::BeginPlay()
 	Super::BeginPlay();
 }
 
+bool AStaticMeshActor::CanBeInCluster() const
+{
+	// BeginPlay turns on replication for these
+	return !bStaticMeshReplicateMovement && Super::CanBeInCluster();
+}
+
 FString AStaticMeshActor::GetDetailedInfoInternal() const
 {
 	return StaticMeshComponent ? StaticMeshComponent->GetDetailedInfoInternal() : TEXT("No_StaticMeshComponent");
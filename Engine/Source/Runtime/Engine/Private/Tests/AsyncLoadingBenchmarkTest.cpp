@@ -0,0 +1,119 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncLoadingBenchmarkTest, "System.Engine.Streaming.Async Loading Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace AsyncLoadingBenchmarkTest
+{
+	/** Packages requested at once, the more there are the more of them wait on each other's imports and reads */
+	const int32 MaxPackages = 500;
+
+	/** Frames are simulated at this rate, async loading gets the time slice the engine gives it by default */
+	const double FrameTime = 1.0 / 60.0;
+	const float AsyncLoadingTimeLimit = 0.005f;
+
+	/** Gives up after this long, so the test can't hang */
+	const double MaxLoadTime = 600.0;
+
+	/**
+	 * Finds packages that aren't loaded yet, in -StreamingBenchmarkPackages=<dir> if it's given and in the game's and the
+	 * engine's content otherwise.
+	 */
+	void FindPackages(TArray<FString>& OutPackageNames)
+	{
+		TArray<FString> Directories;
+		FString PackageDirectory;
+		if (FParse::Value(FCommandLine::Get(), TEXT("StreamingBenchmarkPackages="), PackageDirectory))
+		{
+			Directories.Add(PackageDirectory);
+		}
+		else
+		{
+			Directories.Add(FPaths::GameContentDir());
+			Directories.Add(FPaths::EngineContentDir());
+		}
+
+		TArray<FString> Filenames;
+		for (const FString& Directory : Directories)
+		{
+			IFileManager::Get().FindFilesRecursive(Filenames, *Directory, TEXT("*.uasset"), true, false, false);
+			IFileManager::Get().FindFilesRecursive(Filenames, *Directory, TEXT("*.umap"), true, false, false);
+		}
+
+		for (int32 FileIndex = 0; FileIndex < Filenames.Num() && OutPackageNames.Num() < MaxPackages; ++FileIndex)
+		{
+			FString PackageName;
+			if (FPackageName::TryConvertFilenameToLongPackageName(Filenames[FileIndex], PackageName) && !FindPackage(nullptr, *PackageName))
+			{
+				OutPackageNames.Add(PackageName);
+			}
+		}
+	}
+}
+
+
+/**
+ * Streams a batch of packages in while simulating frames on the game thread, and reports how fast they load and how much
+ * of each frame the game thread spends on them.
+ */
+bool FAsyncLoadingBenchmarkTest::RunTest( const FString& Parameters )
+{
+	using namespace AsyncLoadingBenchmarkTest;
+
+	TArray<FString> PackageNames;
+	FindPackages(PackageNames);
+	if (PackageNames.Num() == 0)
+	{
+		AddLogItem(TEXT("No unloaded packages found, pass -StreamingBenchmarkPackages=<dir> to point the benchmark at some."));
+		return true;
+	}
+
+	int32 NumLoaded = 0;
+	int32 NumFailed = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (const FString& PackageName : PackageNames)
+	{
+		LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda([&NumLoaded, &NumFailed](const FName& Name, UPackage* Package, EAsyncLoadingResult::Type Result)
+		{
+			NumLoaded++;
+			NumFailed += Result == EAsyncLoadingResult::Succeeded ? 0 : 1;
+		}));
+	}
+
+	double GameThreadTime = 0.0;
+	double MaxFrameGameThreadTime = 0.0;
+	int32 NumFrames = 0;
+	while (NumLoaded < PackageNames.Num() && FPlatformTime::Seconds() - StartTime < MaxLoadTime)
+	{
+		const double FrameStartTime = FPlatformTime::Seconds();
+		ProcessAsyncLoading(true, false, AsyncLoadingTimeLimit);
+		const double FrameGameThreadTime = FPlatformTime::Seconds() - FrameStartTime;
+
+		GameThreadTime += FrameGameThreadTime;
+		MaxFrameGameThreadTime = FMath::Max(MaxFrameGameThreadTime, FrameGameThreadTime);
+		NumFrames++;
+
+		const double RestOfFrame = FrameTime - FrameGameThreadTime;
+		if (RestOfFrame > 0.0)
+		{
+			FPlatformProcess::Sleep((float)RestOfFrame);
+		}
+	}
+	const double LoadTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Packages whose completion callback was called"), NumLoaded, PackageNames.Num());
+	if (NumLoaded < PackageNames.Num())
+	{
+		FlushAsyncLoading();
+	}
+
+	AddLogItem(FString::Printf(TEXT("%d packages (%d failed) in %.2fs over %d frames, %.1f packages/s"),
+		PackageNames.Num(), NumFailed, LoadTime, NumFrames, NumLoaded / FMath::Max(LoadTime, 1.0e-6)));
+	AddLogItem(FString::Printf(TEXT("Game thread async loading time: total %.1fms, average %.3fms per frame, longest frame %.3fms"),
+		GameThreadTime * 1000.0, GameThreadTime * 1000.0 / FMath::Max(NumFrames, 1), MaxFrameGameThreadTime * 1000.0));
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
@@ -0,0 +1,166 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBulkDataMemoryMapTest, "System.Engine.Serialization.Bulk Data Memory Mapping", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Loads bulk data with s.MemoryMapBulkData set, from the state FUntypedBulkData::Serialize leaves a lazily loaded payload
+ * of a cooked package in. Checks that read only locks return the mapped bytes, that read-write locks and GetCopy hand out
+ * copies, that single use bulk data unmaps on Unlock, and that payloads that aren't aligned as requested aren't mapped.
+ */
+bool FBulkDataMemoryMapTest::RunTest(const FString& Parameters)
+{
+	// The payload starts on a page so the mapped address meets any alignment the bulk data asks for
+	const int64 PayloadOffset = 4096;
+	const int32 PayloadSize = 1000;
+
+	TArray<uint8> FileData;
+	FileData.AddZeroed(PayloadOffset + PayloadSize + 100);
+	FRandomStream Random(0xb01c);
+	for (int32 Index = 0; Index < PayloadSize; ++Index)
+	{
+		FileData[PayloadOffset + Index] = (uint8)Random.RandHelper(256);
+	}
+	const uint8* Payload = FileData.GetData() + PayloadOffset;
+
+	const FString TempFilename = FPaths::EngineSavedDir() / FGuid::NewGuid().ToString();
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempFilename))
+	{
+		AddError(FString::Printf(TEXT("Couldn't write %s."), *TempFilename));
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	IMappedFileHandle* MappedFile = PlatformFile.OpenMapped(*TempFilename);
+	if (!MappedFile)
+	{
+		AddLogItem(FString::Printf(TEXT("%s can't map files."), PlatformFile.GetName()));
+		PlatformFile.DeleteFile(*TempFilename);
+		return true;
+	}
+	delete MappedFile;
+
+	IConsoleVariable* MemoryMapBulkData = IConsoleManager::Get().FindConsoleVariable(TEXT("s.MemoryMapBulkData"));
+	check(MemoryMapBulkData);
+	const int32 PreviousMemoryMapBulkData = MemoryMapBulkData->GetInt();
+	MemoryMapBulkData->Set(1);
+
+	auto SetUpPayload = [&](FByteBulkData& BulkData, int64 Offset, uint32 Flags)
+	{
+		BulkData.BulkDataFlags = Flags;
+		BulkData.ElementCount = PayloadSize;
+		BulkData.BulkDataOffsetInFile = Offset;
+		BulkData.BulkDataSizeOnDisk = PayloadSize;
+		BulkData.Filename = TempFilename;
+		BulkData.bCanMapPayload = true;
+	};
+
+	auto IsMappedPayload = [&](FByteBulkData& BulkData, const void* Data)
+	{
+		return BulkData.MappedRegion && Data == BulkData.MappedRegion->GetMappedPtr() && FMemory::Memcmp(Data, Payload, PayloadSize) == 0;
+	};
+
+	// Read only locks return the mapping, read-write locks copy it first
+	{
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset, BULKDATA_None);
+
+		const void* Data = BulkData.Lock(LOCK_READ_ONLY);
+		TestTrue(TEXT("Read only lock maps the payload"), BulkData.IsBulkDataMemoryMapped());
+		TestTrue(TEXT("Read only lock returns the mapped bytes"), IsMappedPayload(BulkData, Data));
+		BulkData.Unlock();
+		TestTrue(TEXT("Payload stays mapped after Unlock"), BulkData.IsBulkDataMemoryMapped());
+
+		const void* ConstData = BulkData.LockReadOnly();
+		TestTrue(TEXT("LockReadOnly returns the mapped bytes"), IsMappedPayload(BulkData, ConstData));
+		BulkData.Unlock();
+
+		void* WritableData = BulkData.Lock(LOCK_READ_WRITE);
+		TestFalse(TEXT("Read-write lock unmaps the payload"), BulkData.IsBulkDataMemoryMapped());
+		TestTrue(TEXT("Read-write lock keeps the payload loaded"), BulkData.IsBulkDataLoaded());
+		TestTrue(TEXT("Read-write lock returns a copy of the payload"), WritableData != Data && FMemory::Memcmp(WritableData, Payload, PayloadSize) == 0);
+		BulkData.Unlock();
+
+		// Once changed in memory, the payload is never mapped again
+		TestFalse(TEXT("Payload changed in memory can't be mapped"), BulkData.bCanMapPayload);
+	}
+
+	// GetCopy copies the mapped payload, into new memory or the caller's
+	{
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset, BULKDATA_None);
+		BulkData.Lock(LOCK_READ_ONLY);
+		BulkData.Unlock();
+		const uint8* MappedPtr = BulkData.IsBulkDataMemoryMapped() ? BulkData.MappedRegion->GetMappedPtr() : nullptr;
+		TestNotNull(TEXT("Payload mapped before GetCopy"), MappedPtr);
+
+		void* Copy = nullptr;
+		BulkData.GetCopy(&Copy, false);
+		TestTrue(TEXT("GetCopy into new memory copies the payload"), Copy && Copy != MappedPtr && FMemory::Memcmp(Copy, Payload, PayloadSize) == 0);
+		TestTrue(TEXT("Payload stays mapped after GetCopy into new memory"), BulkData.IsBulkDataMemoryMapped());
+		FMemory::Free(Copy);
+
+		TArray<uint8> Dest;
+		Dest.AddZeroed(PayloadSize);
+		void* DestPtr = Dest.GetData();
+		BulkData.GetCopy(&DestPtr, false);
+		TestTrue(TEXT("GetCopy into the caller's memory copies the payload"), DestPtr == Dest.GetData() && FMemory::Memcmp(Dest.GetData(), Payload, PayloadSize) == 0);
+		TestTrue(TEXT("Payload stays mapped after GetCopy into the caller's memory"), BulkData.IsBulkDataMemoryMapped());
+	}
+
+	// Single use bulk data unmaps once it has been used
+	{
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset, BULKDATA_SingleUse);
+		const void* Data = BulkData.Lock(LOCK_READ_ONLY);
+		TestTrue(TEXT("Single use read only lock returns the mapped bytes"), IsMappedPayload(BulkData, Data));
+		BulkData.Unlock();
+		TestFalse(TEXT("Single use Unlock unmaps the payload"), BulkData.IsBulkDataMemoryMapped());
+		TestFalse(TEXT("Single use Unlock unloads the payload"), BulkData.IsBulkDataLoaded());
+	}
+	{
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset, BULKDATA_SingleUse);
+		TestTrue(TEXT("Single use payload is mapped"), BulkData.TryMapPayload());
+
+		// GetCopy hands over a copy, then discards the mapping as it would discard a loaded payload
+		void* Copy = nullptr;
+		BulkData.GetCopy(&Copy, true);
+		TestTrue(TEXT("Single use GetCopy copies the payload"), Copy && FMemory::Memcmp(Copy, Payload, PayloadSize) == 0);
+		TestFalse(TEXT("Single use GetCopy unmaps the payload"), BulkData.IsBulkDataMemoryMapped());
+		FMemory::Free(Copy);
+	}
+
+	// Alignment, the mapped address of a payload one byte into a page only meets byte alignment
+	{
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset + 1, BULKDATA_None);
+		BulkData.SetBulkDataAlignment(16);
+		TestFalse(TEXT("Payload not aligned as requested isn't mapped"), BulkData.TryMapPayload());
+
+		BulkData.SetBulkDataAlignment(DEFAULT_ALIGNMENT);
+		TestTrue(TEXT("Unaligned payload with the default alignment is mapped"), BulkData.TryMapPayload());
+	}
+	{
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset, BULKDATA_None);
+		BulkData.SetBulkDataAlignment(16);
+		TestTrue(TEXT("Payload aligned as requested is mapped"), BulkData.TryMapPayload());
+	}
+
+	// Nothing is mapped unless asked for
+	{
+		MemoryMapBulkData->Set(0);
+		FByteBulkData BulkData;
+		SetUpPayload(BulkData, PayloadOffset, BULKDATA_None);
+		TestFalse(TEXT("Payload isn't mapped with s.MemoryMapBulkData=0"), BulkData.TryMapPayload());
+	}
+
+	MemoryMapBulkData->Set(PreviousMemoryMapBulkData);
+
+	// The mappings are gone with the bulk data, so the file can be deleted
+	PlatformFile.DeleteFile(*TempFilename);
+
+	return true;
+}
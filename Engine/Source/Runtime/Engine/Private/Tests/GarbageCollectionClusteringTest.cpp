@@ -0,0 +1,208 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "Engine/StaticMeshActor.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Sound/SoundWave.h"
+#include "Sound/SoundClass.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGarbageCollectionClusteringTest, "System.Engine.GC.Asset And Actor Clustering", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace GarbageCollectionClusteringTest
+{
+	const int32 NumMeshes = 2000;
+	const int32 MaterialsPerMesh = 4;
+	const int32 NumTextures = 4000;
+	const int32 NumSounds = 1000;
+	const int32 NumActors = 20000;
+
+	/** Reachability analysis passes measured with and without clusters */
+	const int32 NumPasses = 8;
+
+	/** Keeps the test objects alive the way the world keeps a loaded level and the assets it uses */
+	class FClusteringTestReferences : public FGCObject
+	{
+	public:
+		FClusteringTestReferences()
+			: Level(nullptr)
+		{
+		}
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			Collector.AddReferencedObjects(Assets);
+			Collector.AddReferencedObject(Level);
+		}
+
+		TArray<UObject*> Assets;
+		ULevel* Level;
+	};
+
+	/** Average time of a full reachability analysis. Nothing is garbage, so it's almost all marking. */
+	double MeasureReachability()
+	{
+		double TotalTime = 0.0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+			TotalTime += FPlatformTime::Seconds() - StartTime;
+
+			IncrementalPurgeGarbage(false);
+		}
+		return TotalTime / NumPasses;
+	}
+
+	int32 CountClusteredObjects()
+	{
+		int32 NumObjects = 0;
+		for (const TPair<int32, FUObjectCluster*>& Pair : GUObjectClusters)
+		{
+			NumObjects += Pair.Value->Objects.Num() + 1;
+		}
+		return NumObjects;
+	}
+}
+
+/**
+ * Creates a level worth of static mesh actors using meshes, materials, textures and sound waves, and reports how long
+ * reachability analysis takes before and after clustering them the way loading does (gc.AssetClustering, gc.ActorClustering).
+ * Checks that nothing gets collected while clustered, and that a reference added at runtime dissolves the level's cluster
+ * instead of being missed by the garbage collector.
+ */
+bool FGarbageCollectionClusteringTest::RunTest(const FString& Parameters)
+{
+	using namespace GarbageCollectionClusteringTest;
+
+	FlushAsyncLoading();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	const int32 PreviousNumClusters = GUObjectClusters.Num();
+	const int32 PreviousNumClusteredObjects = CountClusteredObjects();
+
+	UPackage* AssetPackage = NewObject<UPackage>(nullptr, TEXT("/Temp/GarbageCollectionClusteringTestAssets"), RF_Transient);
+	UPackage* LevelPackage = NewObject<UPackage>(nullptr, TEXT("/Temp/GarbageCollectionClusteringTestLevel"), RF_Transient);
+	AssetPackage->AddToRoot();
+	LevelPackage->AddToRoot();
+
+	FClusteringTestReferences References;
+	TArray<TWeakObjectPtr<UObject>> AllObjects;
+
+	TArray<UTexture2D*> Textures;
+	for (int32 Index = 0; Index < NumTextures; ++Index)
+	{
+		UTexture2D* Texture = NewObject<UTexture2D>(AssetPackage, NAME_None, RF_Transient);
+		Textures.Add(Texture);
+		References.Assets.Add(Texture);
+	}
+
+	USoundClass* SoundClass = NewObject<USoundClass>(AssetPackage, NAME_None, RF_Transient);
+	for (int32 Index = 0; Index < NumSounds; ++Index)
+	{
+		USoundWave* Sound = NewObject<USoundWave>(AssetPackage, NAME_None, RF_Transient);
+		Sound->SoundClassObject = SoundClass;
+		References.Assets.Add(Sound);
+	}
+
+	TArray<UStaticMesh*> Meshes;
+	for (int32 MeshIndex = 0; MeshIndex < NumMeshes; ++MeshIndex)
+	{
+		UStaticMesh* Mesh = NewObject<UStaticMesh>(AssetPackage, NAME_None, RF_Transient);
+		Mesh->CreateBodySetup();
+		for (int32 MaterialIndex = 0; MaterialIndex < MaterialsPerMesh; ++MaterialIndex)
+		{
+			UMaterialInstanceConstant* Material = NewObject<UMaterialInstanceConstant>(Mesh, NAME_None, RF_Transient);
+			FTextureParameterValue TextureParameter;
+			TextureParameter.ParameterName = TEXT("Diffuse");
+			TextureParameter.ParameterValue = Textures[(MeshIndex * MaterialsPerMesh + MaterialIndex) % NumTextures];
+			Material->TextureParameterValues.Add(TextureParameter);
+			Mesh->Materials.Add(Material);
+		}
+		Meshes.Add(Mesh);
+		References.Assets.Add(Mesh);
+	}
+
+	ULevel* Level = NewObject<ULevel>(LevelPackage, NAME_None, RF_Transient);
+	References.Level = Level;
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		AStaticMeshActor* Actor = NewObject<AStaticMeshActor>(Level, NAME_None, RF_Transient);
+		Actor->GetStaticMeshComponent()->StaticMesh = Meshes[Index % NumMeshes];
+		Level->Actors.Add(Actor);
+	}
+
+	for (FObjectIterator It; It; ++It)
+	{
+		if (It->IsIn(AssetPackage) || It->IsIn(LevelPackage))
+		{
+			AllObjects.Add(*It);
+		}
+	}
+
+	// Verifying cluster assumptions would only be measured after clustering
+	const bool bPreviousShouldVerifyGCAssumptions = GShouldVerifyGCAssumptions;
+	GShouldVerifyGCAssumptions = false;
+
+	const double UnclusteredTime = MeasureReachability();
+
+	// Same order loading creates them in, assets before the levels using them
+	for (UObject* Asset : References.Assets)
+	{
+		if (Asset->CanBeClusterRoot())
+		{
+			Asset->CreateCluster();
+		}
+	}
+	const int32 NumAssetClusters = GUObjectClusters.Num() - PreviousNumClusters;
+	if (Level->CanBeClusterRoot())
+	{
+		Level->CreateCluster();
+	}
+	const int32 NumClusteredActors = Level->ActorCluster ? Level->ActorCluster->Actors.Num() : 0;
+
+	const double ClusteredTime = MeasureReachability();
+
+	// One more pass with the assumptions verified, this asserts if a cluster is missing a reference
+	GShouldVerifyGCAssumptions = bPreviousShouldVerifyGCAssumptions;
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	AddLogItem(FString::Printf(TEXT("%d objects: %d static mesh actors, %d meshes with %d materials each, %d textures, %d sound waves"),
+		AllObjects.Num(), NumActors, NumMeshes, MaterialsPerMesh, NumTextures, NumSounds));
+	AddLogItem(FString::Printf(TEXT("%d asset clusters, %d actors in the level cluster, %d objects in new clusters"),
+		NumAssetClusters, NumClusteredActors, CountClusteredObjects() - PreviousNumClusteredObjects));
+	AddLogItem(FString::Printf(TEXT("Reachability without clusters %7.2f ms, with clusters %7.2f ms (%.1fx)"),
+		1000.0 * UnclusteredTime, 1000.0 * ClusteredTime, UnclusteredTime / FMath::Max(ClusteredTime, 1.0e-6)));
+
+	bool bAllObjectsAlive = true;
+	for (const TWeakObjectPtr<UObject>& Object : AllObjects)
+	{
+		bAllObjectsAlive = bAllObjectsAlive && Object.IsValid();
+	}
+	TestTrue(TEXT("No clustered object was collected"), bAllObjectsAlive);
+
+	if (Level->ActorCluster)
+	{
+		// A material only the clustered component references, which the garbage collector would not see without the cluster being dissolved
+		AStaticMeshActor* Actor = CastChecked<AStaticMeshActor>(Level->ActorCluster->Actors[0]);
+		UMaterialInstanceConstant* NewMaterial = NewObject<UMaterialInstanceConstant>(GetTransientPackage(), NAME_None, RF_Transient);
+		TWeakObjectPtr<UMaterialInstanceConstant> WeakNewMaterial(NewMaterial);
+		Actor->GetStaticMeshComponent()->SetMaterial(0, NewMaterial);
+		NewMaterial = nullptr;
+
+		const int32 LevelClusterIndex = GUObjectArray.ObjectToIndex(Level->ActorCluster);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		TestFalse(TEXT("Level cluster was dissolved"), GUObjectClusters.Contains(LevelClusterIndex));
+		TestTrue(TEXT("Object referenced after clustering was not collected"), WeakNewMaterial.IsValid());
+	}
+
+	References.Assets.Empty();
+	References.Level = nullptr;
+	AssetPackage->RemoveFromRoot();
+	LevelPackage->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	TestEqual(TEXT("Unreferenced clusters were collected"), GUObjectClusters.Num(), PreviousNumClusters);
+
+	return true;
+}
@@ -0,0 +1,266 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGarbageCollectionSoakTest, "System.Engine.GC.Incremental Reachability Soak", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace GarbageCollectionSoakTest
+{
+	/** Live objects are kept in long redirector chains, so marking has a deep graph to walk and not just a wide one */
+	const int32 NumChains = 64;
+	const int32 ChainLength = 4000;
+
+	/** Unreferenced redirectors created every frame */
+	const int32 GarbagePerFrame = 2000;
+
+	/** Chain links moved from one chain to another every frame, while marking may be in progress */
+	const int32 MovesPerFrame = 50;
+
+	/** Garbage collection passes per mode */
+	const int32 NumPasses = 8;
+
+	/** Gives up on an incremental pass after this many frames, so the test can't hang */
+	const int32 MaxFramesPerPass = 100000;
+
+	struct FPauseStats
+	{
+		/** Longest single call into the garbage collector */
+		double MaxPause;
+		/** Longest call that neither started nor finished a pass, only set for incremental passes */
+		double MaxStepPause;
+		double TotalTime;
+		int32 NumCalls;
+		int32 NumPasses;
+
+		FPauseStats()
+			: MaxPause(0.0)
+			, MaxStepPause(0.0)
+			, TotalTime(0.0)
+			, NumCalls(0)
+			, NumPasses(0)
+		{
+		}
+
+		void AddPause(double Pause)
+		{
+			MaxPause = FMath::Max(MaxPause, Pause);
+			TotalTime += Pause;
+			NumCalls++;
+		}
+	};
+
+	/** Redirector chains hanging off a rooted package, mutated between garbage collection steps */
+	class FSoakWorld
+	{
+	public:
+		FSoakWorld()
+			: Random(ChainLength)
+		{
+			Package = NewObject<UPackage>(nullptr, TEXT("/Temp/GarbageCollectionSoakTest"), RF_Transient);
+			Package->AddToRoot();
+
+			for (int32 ChainIndex = 0; ChainIndex < NumChains; ++ChainIndex)
+			{
+				UObjectRedirector* Head = NewObject<UObjectRedirector>(Package, NAME_None, RF_Transient);
+				Head->AddToRoot();
+				Head->DestinationObject = nullptr;
+				for (int32 LinkIndex = 1; LinkIndex < ChainLength; ++LinkIndex)
+				{
+					UObjectRedirector* Link = NewObject<UObjectRedirector>(GetTransientPackage(), NAME_None, RF_Transient);
+					Link->DestinationObject = Head->DestinationObject;
+					Head->DestinationObject = Link;
+				}
+				Heads.Add(Head);
+			}
+		}
+
+		~FSoakWorld()
+		{
+			for (UObjectRedirector* Head : Heads)
+			{
+				Head->RemoveFromRoot();
+			}
+			Package->RemoveFromRoot();
+		}
+
+		/** One frame of gameplay: some garbage, and links moved between chains with the write barrier the way gameplay code has to */
+		void Tick()
+		{
+			for (int32 Index = 0; Index < GarbagePerFrame; ++Index)
+			{
+				UObjectRedirector* Garbage = NewObject<UObjectRedirector>(GetTransientPackage(), NAME_None, RF_Transient);
+				Garbage->DestinationObject = Heads[Index % NumChains];
+				if (GarbageSamples.Num() < 100)
+				{
+					GarbageSamples.Add(Garbage);
+				}
+			}
+
+			for (int32 Move = 0; Move < MovesPerFrame; ++Move)
+			{
+				UObjectRedirector* From = FindLink(Heads[Random.RandHelper(NumChains)]);
+				UObjectRedirector* To = FindLink(Heads[Random.RandHelper(NumChains)]);
+				UObjectRedirector* Link = Cast<UObjectRedirector>(From->DestinationObject);
+				if (Link == nullptr || Link == To)
+				{
+					continue;
+				}
+
+				// Unlink it from the first chain. Nothing new is referenced here, so no barrier needed.
+				From->DestinationObject = Link->DestinationObject;
+
+				// Insert it into the second chain. Both the link and what comes after it may only be reachable through
+				// objects that have already been marked now.
+				Link->DestinationObject = To->DestinationObject;
+				GCWriteBarrier(Link->DestinationObject);
+				To->DestinationObject = Link;
+				GCWriteBarrier(Link);
+			}
+		}
+
+		/** Walks every chain, returns the number of links or INDEX_NONE if one of them has been collected */
+		int32 CountLinks() const
+		{
+			int32 NumLinks = 0;
+			for (UObjectRedirector* Head : Heads)
+			{
+				for (UObject* Link = Head; Link; Link = CastChecked<UObjectRedirector>(Link)->DestinationObject)
+				{
+					if (!Link->IsValidLowLevel() || Link->IsPendingKill() || Link->IsUnreachable())
+					{
+						return INDEX_NONE;
+					}
+					NumLinks++;
+				}
+			}
+			return NumLinks;
+		}
+
+		/** Weak pointers to some of the garbage, all of which should be gone after a full purge */
+		TArray<TWeakObjectPtr<UObjectRedirector>> GarbageSamples;
+
+	private:
+		/** A random link somewhere in the first few hundred of a chain */
+		UObjectRedirector* FindLink(UObjectRedirector* Head)
+		{
+			UObjectRedirector* Link = Head;
+			for (int32 Steps = Random.RandHelper(256); Steps > 0 && Link->DestinationObject; --Steps)
+			{
+				Link = CastChecked<UObjectRedirector>(Link->DestinationObject);
+			}
+			return Link;
+		}
+
+		UPackage* Package;
+		TArray<UObjectRedirector*> Heads;
+		FRandomStream Random;
+	};
+}
+
+/**
+ * Keeps a quarter million objects alive in redirector chains that are rearranged every frame, creates garbage every frame,
+ * and collects it with CollectGarbage and with TryCollectGarbageIncremental, reporting the longest pause of each.
+ * Checks that no live object gets collected while incremental marking is spread over several frames.
+ */
+bool FGarbageCollectionSoakTest::RunTest(const FString& Parameters)
+{
+	using namespace GarbageCollectionSoakTest;
+
+	IConsoleVariable* IncrementalReachability = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.IncrementalReachability"));
+	IConsoleVariable* TimeLimit = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.IncrementalReachabilityTimeLimit"));
+	if (IncrementalReachability == nullptr || TimeLimit == nullptr)
+	{
+		AddError(TEXT("Incremental reachability console variables not found"));
+		return false;
+	}
+
+	// An incremental pass can't finish while async loading is in progress
+	FlushAsyncLoading();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	const int32 PreviousIncrementalReachability = IncrementalReachability->GetInt();
+	const int32 ExpectedLinks = NumChains * ChainLength;
+	bool bLinksSurvived = true;
+
+	FSoakWorld World;
+
+	FPauseStats FullStats;
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		World.Tick();
+
+		const double StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+		FullStats.AddPause(FPlatformTime::Seconds() - StartTime);
+		FullStats.NumPasses++;
+
+		// Purging is incremental either way, keep it out of the measurements
+		IncrementalPurgeGarbage(false);
+		bLinksSurvived = bLinksSurvived && World.CountLinks() == ExpectedLinks;
+	}
+
+	IncrementalReachability->Set(1);
+
+	FPauseStats IncrementalStats;
+	double MaxStartPause = 0.0;
+	double MaxFinishPause = 0.0;
+	for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+	{
+		bool bCollected = false;
+		for (int32 Frame = 0; Frame < MaxFramesPerPass && !bCollected; ++Frame)
+		{
+			World.Tick();
+
+			const bool bStarting = !IsIncrementalReachabilityAnalysisPending();
+			const double StartTime = FPlatformTime::Seconds();
+			bCollected = TryCollectGarbageIncremental(GARBAGE_COLLECTION_KEEPFLAGS);
+			const double Pause = FPlatformTime::Seconds() - StartTime;
+
+			IncrementalStats.AddPause(Pause);
+			if (bStarting)
+			{
+				MaxStartPause = FMath::Max(MaxStartPause, Pause);
+			}
+			else if (bCollected)
+			{
+				MaxFinishPause = FMath::Max(MaxFinishPause, Pause);
+			}
+			else
+			{
+				IncrementalStats.MaxStepPause = FMath::Max(IncrementalStats.MaxStepPause, Pause);
+			}
+		}
+
+		if (!bCollected)
+		{
+			AddError(FString::Printf(TEXT("Incremental garbage collection did not finish within %d frames"), MaxFramesPerPass));
+			break;
+		}
+		IncrementalStats.NumPasses++;
+
+		IncrementalPurgeGarbage(false);
+		bLinksSurvived = bLinksSurvived && World.CountLinks() == ExpectedLinks;
+	}
+
+	IncrementalReachability->Set(PreviousIncrementalReachability);
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum() - GUObjectArray.GetObjectArrayNumPermanent();
+	AddLogItem(FString::Printf(TEXT("~%d objects, %d live links in %d chains, %d garbage objects and %d moved links per frame"),
+		NumObjects, ExpectedLinks, NumChains, GarbagePerFrame, MovesPerFrame));
+	AddLogItem(FString::Printf(TEXT("Full:        %d passes, max pause %7.2f ms, average %7.2f ms per pass"),
+		FullStats.NumPasses, 1000.0 * FullStats.MaxPause, 1000.0 * FullStats.TotalTime / FMath::Max(FullStats.NumPasses, 1)));
+	AddLogItem(FString::Printf(TEXT("Incremental: %d passes, max pause %7.2f ms (start %.2f ms, step %.2f ms, finish %.2f ms, budget %.2f ms), %.1f frames and %7.2f ms per pass"),
+		IncrementalStats.NumPasses, 1000.0 * IncrementalStats.MaxPause, 1000.0 * MaxStartPause, 1000.0 * IncrementalStats.MaxStepPause, 1000.0 * MaxFinishPause, 1000.0 * TimeLimit->GetFloat(),
+		(float)IncrementalStats.NumCalls / FMath::Max(IncrementalStats.NumPasses, 1), 1000.0 * IncrementalStats.TotalTime / FMath::Max(IncrementalStats.NumPasses, 1)));
+
+	TestTrue(TEXT("No live object was collected"), bLinksSurvived);
+
+	bool bGarbageCollected = true;
+	for (const TWeakObjectPtr<UObjectRedirector>& Sample : World.GarbageSamples)
+	{
+		bGarbageCollected = bGarbageCollected && !Sample.IsValid(true);
+	}
+	TestTrue(TEXT("Unreferenced objects were collected"), bGarbageCollected);
+
+	return true;
+}
@@ -0,0 +1,252 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "Net/NetQuantization.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetQuantizationPerfTest, "System.Engine.Net.Quantization Bits And Throughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace NetQuantizationTest
+{
+	const int32 NumActors = 1000;
+	const int32 NumUpdates = 100;
+	const float UpdateTime = 1.0f / 30.0f;
+
+	/** Percentage of actors that stand still for the whole run */
+	const int32 StationaryPercent = 30;
+
+	typedef TQuantizedRange<131072, 10> FHorizontalAxis;
+	typedef TQuantizedRange<16384, 10> FVerticalAxis;
+	typedef TQuantizedVector<FHorizontalAxis, FHorizontalAxis, FVerticalAxis> FLocationQuantization;
+	typedef TQuantizedVector<TQuantizedRange<8192, 10>> FVelocityQuantization;
+	typedef TQuantizedQuat<15> FRotationQuantization;
+
+	struct FActorState
+	{
+		FVector Location;
+		FVector Velocity;
+		FRotator Rotation;
+	};
+
+	/** Random walk with a mostly yaw only rotation, roughly what characters and vehicles look like */
+	void SimulateActors(TArray<FActorState>& States, FRandomStream& Random)
+	{
+		for (int32 ActorIndex = 0; ActorIndex < States.Num(); ++ActorIndex)
+		{
+			if ((ActorIndex % 100) < StationaryPercent)
+			{
+				continue;
+			}
+
+			FActorState& State = States[ActorIndex];
+			State.Velocity += FVector(Random.FRandRange(-50.f, 50.f), Random.FRandRange(-50.f, 50.f), Random.FRandRange(-5.f, 5.f));
+			State.Velocity = State.Velocity.GetClampedToMaxSize(1200.f);
+			State.Location += State.Velocity * UpdateTime;
+			State.Location.X = FMath::Clamp(State.Location.X, -100000.f, 100000.f);
+			State.Location.Y = FMath::Clamp(State.Location.Y, -100000.f, 100000.f);
+			State.Location.Z = FMath::Clamp(State.Location.Z, -5000.f, 5000.f);
+			State.Rotation.Yaw = FRotator::ClampAxis(State.Rotation.Yaw + Random.FRandRange(-10.f, 10.f));
+			State.Rotation.Pitch = FMath::Clamp(State.Rotation.Pitch + Random.FRandRange(-1.f, 1.f), -10.f, 10.f);
+		}
+	}
+
+	/** Generates every update up front, so the timed loops only contain serialization */
+	void GenerateUpdates(TArray<TArray<FActorState>>& OutUpdates)
+	{
+		FRandomStream Random(NumActors);
+
+		TArray<FActorState> States;
+		States.SetNum(NumActors);
+		for (FActorState& State : States)
+		{
+			State.Location = FVector(Random.FRandRange(-100000.f, 100000.f), Random.FRandRange(-100000.f, 100000.f), Random.FRandRange(-5000.f, 5000.f));
+			State.Velocity = FVector::ZeroVector;
+			State.Rotation = FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f);
+		}
+
+		OutUpdates.SetNum(NumUpdates);
+		for (int32 Update = 0; Update < NumUpdates; ++Update)
+		{
+			SimulateActors(States, Random);
+			OutUpdates[Update] = States;
+		}
+	}
+
+	struct FSchemeResult
+	{
+		int64 NumBits;
+		double EncodeTime;
+		double DecodeTime;
+		float MaxLocationError;
+		float MaxRotationError;
+
+		FSchemeResult()
+			: NumBits(0)
+			, EncodeTime(0.0)
+			, DecodeTime(0.0)
+			, MaxLocationError(0.f)
+			, MaxRotationError(0.f)
+		{
+		}
+	};
+
+	/**
+	 * Runs every update through Encode and Decode. Each update of all actors goes into one bit stream, so the measured time is
+	 * dominated by the quantization itself. Encode(Ar, ActorIndex, State) and Decode(Ar, ActorIndex, OutState) must keep
+	 * whatever baseline they need per actor.
+	 */
+	template<typename EncodeFunc, typename DecodeFunc>
+	FSchemeResult RunScheme(const TArray<TArray<FActorState>>& Updates, EncodeFunc Encode, DecodeFunc Decode)
+	{
+		FSchemeResult Result;
+		FActorState Decoded;
+
+		for (const TArray<FActorState>& States : Updates)
+		{
+			FBitWriter Writer(0, true);
+
+			const double EncodeStart = FPlatformTime::Seconds();
+			for (int32 ActorIndex = 0; ActorIndex < States.Num(); ++ActorIndex)
+			{
+				Encode(Writer, ActorIndex, States[ActorIndex]);
+			}
+			Result.EncodeTime += FPlatformTime::Seconds() - EncodeStart;
+			Result.NumBits += Writer.GetNumBits();
+
+			FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+
+			for (int32 ActorIndex = 0; ActorIndex < States.Num(); ++ActorIndex)
+			{
+				const double DecodeStart = FPlatformTime::Seconds();
+				Decode(Reader, ActorIndex, Decoded);
+				Result.DecodeTime += FPlatformTime::Seconds() - DecodeStart;
+
+				Result.MaxLocationError = FMath::Max(Result.MaxLocationError, FVector::Dist(Decoded.Location, States[ActorIndex].Location));
+				Result.MaxRotationError = FMath::Max(Result.MaxRotationError, FMath::RadiansToDegrees(Decoded.Rotation.Quaternion().AngularDistance(States[ActorIndex].Rotation.Quaternion())));
+			}
+		}
+
+		return Result;
+	}
+}
+
+/**
+ * Measures bits per actor per update and encode/decode throughput of FRepMovement's built in quantization against the
+ * TQuantizedVector/TQuantizedQuat templates, both as absolute values and as deltas against the previous update.
+ */
+bool FNetQuantizationPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace NetQuantizationTest;
+
+	TArray<TArray<FActorState>> Updates;
+	GenerateUpdates(Updates);
+
+	auto ReportScheme = [this](const TCHAR* Name, const FSchemeResult& Result)
+	{
+		const int64 NumSamples = (int64)NumActors * NumUpdates;
+		AddLogItem(FString::Printf(TEXT("%-32s %6.1f bits/actor/update, encode %6.1f ns/actor, decode %6.1f ns/actor, max error %.3f units %.4f degrees"),
+			Name,
+			(double)Result.NumBits / NumSamples,
+			1.0e9 * Result.EncodeTime / NumSamples,
+			1.0e9 * Result.DecodeTime / NumSamples,
+			Result.MaxLocationError, Result.MaxRotationError));
+	};
+
+	auto SerializeRepMovement = [](FArchive& Ar, FActorState& State, ERotatorQuantization RotationQuantization)
+	{
+		FRepMovement RepMovement;
+		RepMovement.RotationQuantizationLevel = RotationQuantization;
+		RepMovement.Location = State.Location;
+		RepMovement.LinearVelocity = State.Velocity;
+		RepMovement.Rotation = State.Rotation;
+
+		bool bSuccess = true;
+		RepMovement.NetSerialize(Ar, nullptr, bSuccess);
+
+		State.Location = RepMovement.Location;
+		State.Velocity = RepMovement.LinearVelocity;
+		State.Rotation = RepMovement.Rotation;
+	};
+
+	// FRepMovement with its default settings
+	{
+		const FSchemeResult Result = RunScheme(Updates,
+			[&](FArchive& Ar, int32 ActorIndex, const FActorState& State) { FActorState Copy = State; SerializeRepMovement(Ar, Copy, ERotatorQuantization::ByteComponents); },
+			[&](FArchive& Ar, int32 ActorIndex, FActorState& OutState) { SerializeRepMovement(Ar, OutState, ERotatorQuantization::ByteComponents); });
+
+		ReportScheme(TEXT("FRepMovement (ByteComponents)"), Result);
+	}
+
+	// FRepMovement sending a smallest three quaternion
+	{
+		const FSchemeResult Result = RunScheme(Updates,
+			[&](FArchive& Ar, int32 ActorIndex, const FActorState& State) { FActorState Copy = State; SerializeRepMovement(Ar, Copy, ERotatorQuantization::QuatSmallestThree); },
+			[&](FArchive& Ar, int32 ActorIndex, FActorState& OutState) { SerializeRepMovement(Ar, OutState, ERotatorQuantization::QuatSmallestThree); });
+
+		ReportScheme(TEXT("FRepMovement (QuatSmallestThree)"), Result);
+
+		TestTrue(TEXT("QuatSmallestThree rotation error is within 0.01 degrees"), Result.MaxRotationError < 0.01f);
+	}
+
+	auto SerializeAbsolute = [](FArchive& Ar, FActorState& State)
+	{
+		FQuat Quat = State.Rotation.Quaternion();
+		FLocationQuantization::Serialize(Ar, State.Location);
+		FVelocityQuantization::Serialize(Ar, State.Velocity);
+		FRotationQuantization::Serialize(Ar, Quat);
+		State.Rotation = Quat.Rotator();
+	};
+
+	// Templates, absolute values
+	{
+		const FSchemeResult Result = RunScheme(Updates,
+			[&](FArchive& Ar, int32 ActorIndex, const FActorState& State) { FActorState Copy = State; SerializeAbsolute(Ar, Copy); },
+			[&](FArchive& Ar, int32 ActorIndex, FActorState& OutState) { SerializeAbsolute(Ar, OutState); });
+
+		ReportScheme(TEXT("Quantized (absolute)"), Result);
+
+		TestEqual(TEXT("Absolute encoding uses exactly the compile time bit count"), Result.NumBits,
+			(int64)NumActors * NumUpdates * (FLocationQuantization::NumBits + FVelocityQuantization::NumBits + FRotationQuantization::NumBits));
+		TestTrue(TEXT("Absolute location error is within the quantization precision"), Result.MaxLocationError <= 0.1f);
+	}
+
+	// Templates, delta against the previous update. The sender keeps the rounded value as its baseline, the receiver keeps what it decoded.
+	{
+		TArray<FActorState> SenderBaselines;
+		TArray<FActorState> ReceiverBaselines;
+		SenderBaselines.SetNumZeroed(NumActors);
+		ReceiverBaselines.SetNumZeroed(NumActors);
+
+		auto SerializeDelta = [](FArchive& Ar, FActorState& State, const FActorState& Baseline)
+		{
+			FQuat Quat = State.Rotation.Quaternion();
+			FLocationQuantization::SerializeDelta(Ar, State.Location, Baseline.Location);
+			FVelocityQuantization::SerializeDelta(Ar, State.Velocity, Baseline.Velocity);
+			FRotationQuantization::SerializeDelta(Ar, Quat, Baseline.Rotation.Quaternion());
+			State.Rotation = Quat.Rotator();
+		};
+
+		const FSchemeResult Result = RunScheme(Updates,
+			[&](FArchive& Ar, int32 ActorIndex, const FActorState& State)
+			{
+				FActorState Copy = State;
+				SerializeDelta(Ar, Copy, SenderBaselines[ActorIndex]);
+
+				FActorState& Baseline = SenderBaselines[ActorIndex];
+				Baseline.Location = FLocationQuantization::Round(State.Location);
+				Baseline.Velocity = FVelocityQuantization::Round(State.Velocity);
+				Baseline.Rotation = FRotationQuantization::Round(State.Rotation.Quaternion()).Rotator();
+			},
+			[&](FArchive& Ar, int32 ActorIndex, FActorState& OutState)
+			{
+				SerializeDelta(Ar, OutState, ReceiverBaselines[ActorIndex]);
+				ReceiverBaselines[ActorIndex] = OutState;
+			});
+
+		ReportScheme(TEXT("Quantized (delta)"), Result);
+
+		TestTrue(TEXT("Delta location error is within the quantization precision"), Result.MaxLocationError <= 0.1f);
+		TestTrue(TEXT("Delta rotation error is within 0.01 degrees"), Result.MaxRotationError < 0.01f);
+	}
+
+	return true;
+}
@@ -0,0 +1,129 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "Net/NetworkObjectList.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNetworkObjectListPerfTest, "System.Engine.Net.NetworkObjectList Consider Cost", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace NetworkObjectListTest
+{
+	const int32 ActorCounts[] = { 1000, 5000, 20000, 50000 };
+	const int32 NumFrames = 300;
+	const float ServerTickTime = 1.0f / 30.0f;
+	const float NetUpdateFrequencies[] = { 1.0f, 2.0f, 10.0f, 30.0f, 100.0f };
+
+	/** Percentage of actors that are dormant on every connection */
+	const int32 DormantPercent = 50;
+
+	void ResetActors(const TArray<AActor*>& Actors)
+	{
+		for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+		{
+			Actors[ActorIndex]->NetUpdateTime = 0.0f;
+			Actors[ActorIndex]->bPendingNetUpdate = false;
+			Actors[ActorIndex]->NetUpdateFrequency = NetUpdateFrequencies[ActorIndex % ARRAY_COUNT(NetUpdateFrequencies)];
+		}
+	}
+
+	/** Mirrors the per-actor work ServerReplicateActors does when an actor is due */
+	FORCEINLINE void ConsiderActor(AActor* Actor, float WorldTime, FRandomStream& Random)
+	{
+		Actor->NetUpdateTime = WorldTime + Random.FRand() * ServerTickTime + 1.f / Actor->NetUpdateFrequency;
+	}
+
+	FORCEINLINE bool IsDormantEverywhere(int32 ActorIndex)
+	{
+		return (ActorIndex % 100) < DormantPercent;
+	}
+}
+
+/**
+ * Measures the cost of building the consider list in UNetDriver::ServerReplicateActors against the number of network actors,
+ * comparing a full walk of UWorld::NetworkActors with the scheduled FNetworkObjectList.
+ */
+bool FNetworkObjectListPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace NetworkObjectListTest;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+
+	TArray<AActor*> Actors;
+
+	for (int32 ActorCount : ActorCounts)
+	{
+		while (Actors.Num() < ActorCount)
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			Actor->SetReplicates(true);
+			Actors.Add(Actor);
+		}
+
+		// Legacy path: visit every network actor every frame
+		ResetActors(Actors);
+		int32 LegacyConsidered = 0;
+		FRandomStream LegacyRandom(ActorCount);
+		const double LegacyStart = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const float WorldTime = Frame * ServerTickTime;
+			int32 ActorIndex = 0;
+			for (AActor* Actor : Actors)
+			{
+				if (!IsDormantEverywhere(ActorIndex++) && (Actor->bPendingNetUpdate || WorldTime > Actor->NetUpdateTime))
+				{
+					ConsiderActor(Actor, WorldTime, LegacyRandom);
+					LegacyConsidered++;
+				}
+			}
+		}
+		const double LegacyTime = FPlatformTime::Seconds() - LegacyStart;
+
+		// Scheduled path: only visit actors that are due
+		ResetActors(Actors);
+		FNetworkObjectList NetworkObjects;
+		for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+		{
+			NetworkObjects.Add(Actors[ActorIndex]);
+			if (IsDormantEverywhere(ActorIndex))
+			{
+				NetworkObjects.MarkDormant(Actors[ActorIndex], nullptr, 1);
+			}
+		}
+
+		int32 ScheduledConsidered = 0;
+		FRandomStream ScheduledRandom(ActorCount);
+		TArray<AActor*> DueActors;
+		const double ScheduledStart = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const float WorldTime = Frame * ServerTickTime;
+			NetworkObjects.GatherDueObjects(WorldTime, DueActors);
+			for (AActor* Actor : DueActors)
+			{
+				ConsiderActor(Actor, WorldTime, ScheduledRandom);
+				NetworkObjects.Schedule(Actor);
+			}
+			ScheduledConsidered += DueActors.Num();
+		}
+		const double ScheduledTime = FPlatformTime::Seconds() - ScheduledStart;
+
+		AddLogItem(FString::Printf(TEXT("%6d actors (%d%% dormant): full scan %7.3f ms/frame (%d considered), scheduled %7.3f ms/frame (%d considered)"),
+			ActorCount, DormantPercent,
+			1000.0 * LegacyTime / NumFrames, LegacyConsidered,
+			1000.0 * ScheduledTime / NumFrames, ScheduledConsidered));
+
+		// Update order differs between the two paths, so the jitter each actor receives differs slightly. Only sanity check the totals.
+		TestTrue(FString::Printf(TEXT("Scheduled list considers a similar number of actors as a full scan (%d actors)"), ActorCount),
+			FMath::Abs(ScheduledConsidered - LegacyConsidered) <= LegacyConsidered / 10);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
@@ -0,0 +1,227 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "Net/RepArrayDelta.h"
+#include "Animation/AnimSequence.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRepArrayDeltaTest, "System.Engine.Net.Array Delta Replication", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+namespace RepArrayDeltaTest
+{
+	/** Any replicated TArray<int32> will do, FRepArrayDelta only needs the property to copy, compare and serialize elements */
+	UArrayProperty* FindIntArrayProperty()
+	{
+		return FindField<UArrayProperty>(UAnimSequence::StaticClass(), TEXT("CompressedTrackOffsets"));
+	}
+
+	/** Writes updates the way FObjectReplicator does for one connection, keeping every base state it produced */
+	struct FServer
+	{
+		UArrayProperty* ArrayProperty;
+		TArray<TSharedPtr<INetDeltaBaseState>> States;
+
+		FServer(UArrayProperty* InArrayProperty)
+			: ArrayProperty(InArrayProperty)
+		{
+			States.Add(nullptr);
+		}
+
+		/** Writes the difference between the state at BaseIndex and Values. Returns false if there was nothing to send. */
+		bool Write(TArray<int32>& Values, int32 BaseIndex, FNetBitWriter& Writer)
+		{
+			TSharedPtr<INetDeltaBaseState> NewState;
+
+			FNetDeltaSerializeInfo Parms;
+			Parms.Writer = &Writer;
+			Parms.OldState = States[BaseIndex].Get();
+			Parms.NewState = &NewState;
+
+			if (!FRepArrayDelta::WriteDelta(ArrayProperty, Parms, &Values))
+			{
+				return false;
+			}
+			States.Add(NewState);
+			return true;
+		}
+	};
+
+	/** Reads an update into Values, as FObjectReplicator::ReceivedBunch does */
+	bool Read(UArrayProperty* ArrayProperty, FNetBitWriter& Writer, TArray<int32>& Values, TArray<int32>& ElementIDs)
+	{
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+
+		FNetDeltaSerializeInfo Parms;
+		Parms.Reader = &Reader;
+
+		return FRepArrayDelta::ReadDelta(ArrayProperty, Parms, &Values, ElementIDs) && !Reader.IsError();
+	}
+
+	/** Applies a random mix of inserts, removes, in place changes and moves */
+	void Mutate(TArray<int32>& Values, FRandomStream& Random, int32& NextValue)
+	{
+		const int32 NumEdits = Random.RandRange(1, 4);
+		for (int32 Edit = 0; Edit < NumEdits; ++Edit)
+		{
+			const int32 Kind = Random.RandHelper(4);
+			if (Kind == 0 || Values.Num() == 0)
+			{
+				Values.Insert(NextValue++, Random.RandRange(0, Values.Num()));
+			}
+			else if (Kind == 1)
+			{
+				Values.RemoveAt(Random.RandHelper(Values.Num()));
+			}
+			else if (Kind == 2)
+			{
+				Values[Random.RandHelper(Values.Num())] = NextValue++;
+			}
+			else
+			{
+				const int32 Value = Values[Random.RandHelper(Values.Num())];
+				Values.RemoveSingle(Value);
+				Values.Insert(Value, Random.RandRange(0, Values.Num()));
+			}
+		}
+	}
+}
+
+/**
+ * Checks how FRepArrayDelta pairs up old and new elements, that a client applying every update ends up with the server's array,
+ * and that a client that missed an update converges once the server restores the base state of the dropped update.
+ */
+bool FRepArrayDeltaTest::RunTest(const FString& Parameters)
+{
+	using namespace RepArrayDeltaTest;
+
+	UArrayProperty* ArrayProperty = FindIntArrayProperty();
+	if (ArrayProperty == nullptr)
+	{
+		AddError(TEXT("Couldn't find a TArray<int32> property to replicate."));
+		return false;
+	}
+
+	// Element matching
+	{
+		auto TestMatch = [&](const TCHAR* Name, TArray<int32> Old, TArray<int32> New, const int32* ExpectedMatch, const bool* ExpectedIdentical)
+		{
+			FScriptArrayHelper OldHelper(ArrayProperty, &Old);
+			FScriptArrayHelper NewHelper(ArrayProperty, &New);
+
+			TArray<int32> Match;
+			TBitArray<> Identical;
+			FRepArrayDelta::MatchElements(ArrayProperty->Inner, OldHelper, NewHelper, Match, Identical);
+
+			TestEqual(*FString::Printf(TEXT("%s: number of matches"), Name), Match.Num(), New.Num());
+			for (int32 Index = 0; Index < Match.Num() && Index < New.Num(); ++Index)
+			{
+				TestEqual(*FString::Printf(TEXT("%s: match of element %d"), Name, Index), Match[Index], ExpectedMatch[Index]);
+				TestEqual(*FString::Printf(TEXT("%s: element %d identical"), Name, Index), (bool)Identical[Index], ExpectedIdentical[Index]);
+			}
+		};
+
+		const int32 Old[] = { 1, 2, 3, 4 };
+
+		const int32 Inserted[] = { 1, 2, 9, 3, 4 };
+		const int32 InsertedMatch[] = { 0, 1, INDEX_NONE, 2, 3 };
+		const bool InsertedIdentical[] = { true, true, false, true, true };
+		TestMatch(TEXT("Insert"), TArray<int32>(Old, ARRAY_COUNT(Old)), TArray<int32>(Inserted, ARRAY_COUNT(Inserted)), InsertedMatch, InsertedIdentical);
+
+		const int32 Removed[] = { 1, 3, 4 };
+		const int32 RemovedMatch[] = { 0, 2, 3 };
+		const bool RemovedIdentical[] = { true, true, true };
+		TestMatch(TEXT("Remove"), TArray<int32>(Old, ARRAY_COUNT(Old)), TArray<int32>(Removed, ARRAY_COUNT(Removed)), RemovedMatch, RemovedIdentical);
+
+		const int32 Changed[] = { 1, 5, 3, 4 };
+		const int32 ChangedMatch[] = { 0, 1, 2, 3 };
+		const bool ChangedIdentical[] = { true, false, true, true };
+		TestMatch(TEXT("Change in place"), TArray<int32>(Old, ARRAY_COUNT(Old)), TArray<int32>(Changed, ARRAY_COUNT(Changed)), ChangedMatch, ChangedIdentical);
+
+		// The moved element is sent as removed and inserted, everything else keeps its ID
+		const int32 Reordered[] = { 4, 1, 2, 3 };
+		const int32 ReorderedMatch[] = { INDEX_NONE, 0, 1, 2 };
+		const bool ReorderedIdentical[] = { false, true, true, true };
+		TestMatch(TEXT("Reorder"), TArray<int32>(Old, ARRAY_COUNT(Old)), TArray<int32>(Reordered, ARRAY_COUNT(Reordered)), ReorderedMatch, ReorderedIdentical);
+	}
+
+	// Every update received
+	{
+		FRandomStream Random(0x5eed);
+		FServer Server(ArrayProperty);
+		TArray<int32> ServerValues;
+		TArray<int32> ClientValues;
+		TArray<int32> ClientIDs;
+		int32 NextValue = 0;
+
+		for (int32 Update = 0; Update < 200; ++Update)
+		{
+			Mutate(ServerValues, Random, NextValue);
+
+			FNetBitWriter Writer(1024);
+			if (Server.Write(ServerValues, Server.States.Num() - 1, Writer))
+			{
+				TestTrue(*FString::Printf(TEXT("Read update %d"), Update), Read(ArrayProperty, Writer, ClientValues, ClientIDs));
+			}
+			TestEqual(*FString::Printf(TEXT("Client array after update %d"), Update), ClientValues, ServerValues);
+		}
+
+		FNetBitWriter Writer(1024);
+		TestFalse(TEXT("Nothing to send when the array did not change"), Server.Write(ServerValues, Server.States.Num() - 1, Writer));
+	}
+
+	// Dropped update: the client misses one update but receives the ones after it, then the server restores the base of the dropped one
+	for (int32 Seed = 0; Seed < 20; ++Seed)
+	{
+		FRandomStream Random(Seed);
+		FServer Server(ArrayProperty);
+		TArray<int32> ServerValues;
+		TArray<int32> ClientValues;
+		TArray<int32> ClientIDs;
+		int32 NextValue = 0;
+
+		const int32 NumUpdates = 8;
+		const int32 DroppedUpdate = Random.RandRange(1, NumUpdates - 2);
+
+		int32 DroppedBase = INDEX_NONE;
+		for (int32 Update = 0; Update < NumUpdates; ++Update)
+		{
+			Mutate(ServerValues, Random, NextValue);
+
+			const int32 BaseIndex = Server.States.Num() - 1;
+			FNetBitWriter Writer(1024);
+			if (Server.Write(ServerValues, BaseIndex, Writer))
+			{
+				if (Update == DroppedUpdate)
+				{
+					DroppedBase = BaseIndex;
+				}
+				else
+				{
+					Read(ArrayProperty, Writer, ClientValues, ClientIDs);
+				}
+			}
+		}
+
+		if (DroppedBase == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// On the NAK, FObjectReplicator goes back to the state the dropped update was made from
+		Mutate(ServerValues, Random, NextValue);
+		FNetBitWriter Writer(1024);
+		TestTrue(*FString::Printf(TEXT("Seed %d: update after a restore is always sent"), Seed), Server.Write(ServerValues, DroppedBase, Writer));
+		TestTrue(*FString::Printf(TEXT("Seed %d: read update after a restore"), Seed), Read(ArrayProperty, Writer, ClientValues, ClientIDs));
+		TestEqual(*FString::Printf(TEXT("Seed %d: client array after a restore"), Seed), ClientValues, ServerValues);
+
+		// And it carries on from there with plain deltas
+		Mutate(ServerValues, Random, NextValue);
+		FNetBitWriter NextWriter(1024);
+		if (Server.Write(ServerValues, Server.States.Num() - 1, NextWriter))
+		{
+			TestTrue(*FString::Printf(TEXT("Seed %d: read update after recovering"), Seed), Read(ArrayProperty, NextWriter, ClientValues, ClientIDs));
+		}
+		TestEqual(*FString::Printf(TEXT("Seed %d: client array after recovering"), Seed), ClientValues, ServerValues);
+	}
+
+	return true;
+}
@@ -0,0 +1,227 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUObjectHashStressTest, "System.Engine.UObject.Object Hash Multithreaded Stress", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace UObjectHashStressTest
+{
+	/** Objects each thread creates in each of the two creating phases */
+	const int32 NumObjectsPerThread = 20000;
+
+	/** Objects are spread over this many outers, so threads share outers like objects loaded into the same packages do */
+	const int32 NumOuters = 64;
+
+	const int32 MaxThreads = 32;
+
+	/**
+	 * Creates objects, then either finds every object all the threads created or creates more, so that lookups run while
+	 * other threads are hashing new objects.
+	 */
+	class FHashWorker : public FRunnable
+	{
+	public:
+		FHashWorker(int32 InThreadIndex, const TArray<UObject*>& InOuters, const TArray<FHashWorker*>& InWorkers, FEvent* InStartEvent, FEvent* InMixedEvent, FThreadSafeCounter& InReadyCounter)
+			: MixedSeconds(0.0)
+			, NumFinds(0)
+			, NumNotFound(0)
+			, ThreadIndex(InThreadIndex)
+			, Outers(InOuters)
+			, Workers(InWorkers)
+			, StartEvent(InStartEvent)
+			, MixedEvent(InMixedEvent)
+			, ReadyCounter(InReadyCounter)
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			ReadyCounter.Increment();
+			StartEvent->Wait();
+
+			CreateObjects(0, Created);
+
+			ReadyCounter.Increment();
+			MixedEvent->Wait();
+
+			const double StartTime = FPlatformTime::Seconds();
+			if (IsFinder())
+			{
+				for (int32 Index = 0; Index < NumObjectsPerThread; ++Index)
+				{
+					for (const FHashWorker* Worker : Workers)
+					{
+						UObject* Object = Worker->Created[Index];
+						NumNotFound += StaticFindObjectFast(UObjectRedirector::StaticClass(), Object->GetOuter(), Object->GetFName(), true) != Object ? 1 : 0;
+						NumFinds++;
+					}
+				}
+			}
+			else
+			{
+				CreateObjects(1, CreatedWhileFinding);
+			}
+			MixedSeconds = FPlatformTime::Seconds() - StartTime;
+
+			ReadyCounter.Increment();
+			return 0;
+		}
+
+		/** Half the threads find objects while the other half creates them */
+		bool IsFinder() const
+		{
+			return ThreadIndex % 2 == 0;
+		}
+
+		/** Objects created in the first phase, and by creating threads in the second */
+		TArray<UObject*> Created;
+		TArray<UObject*> CreatedWhileFinding;
+
+		/** How long this thread took in the second phase */
+		double MixedSeconds;
+
+		int32 NumFinds;
+
+		/** Lookups that didn't return the object that was looked for */
+		int32 NumNotFound;
+
+	private:
+		void CreateObjects(int32 Batch, TArray<UObject*>& OutObjects)
+		{
+			const FName Name(*FString::Printf(TEXT("HashStress%dBatch%dObj"), ThreadIndex, Batch));
+			OutObjects.Reserve(NumObjectsPerThread);
+			for (int32 Index = 0; Index < NumObjectsPerThread; ++Index)
+			{
+				UObject* Outer = Outers[(ThreadIndex + Index) % Outers.Num()];
+				OutObjects.Add(NewObject<UObjectRedirector>(Outer, FName(Name, Index + 1), RF_Transient));
+			}
+		}
+
+		int32 ThreadIndex;
+		const TArray<UObject*>& Outers;
+		const TArray<FHashWorker*>& Workers;
+		FEvent* StartEvent;
+		FEvent* MixedEvent;
+		FThreadSafeCounter& ReadyCounter;
+	};
+
+	/** Releases the waiting workers and returns how long it took all of them to reach the counter again */
+	double RunPhase(FEvent* Event, FThreadSafeCounter& ReadyCounter, int32 NumReady)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Event->Trigger();
+		while (ReadyCounter.GetValue() < NumReady)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+
+/**
+ * Creates objects from every core at once, then has half the threads look all of them up while the other half keeps
+ * creating more. Reports objects created and found per second, and checks that every lookup found its object and that
+ * the outer and class lookups see every object.
+ */
+bool FUObjectHashStressTest::RunTest( const FString& Parameters )
+{
+	using namespace UObjectHashStressTest;
+
+	const int32 NumThreads = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 2, MaxThreads);
+
+	UPackage* Package = NewObject<UPackage>(nullptr, TEXT("/Temp/UObjectHashStressTest"), RF_Transient);
+	Package->AddToRoot();
+	TArray<UObject*> Outers;
+	for (int32 Index = 0; Index < NumOuters; ++Index)
+	{
+		Outers.Add(NewObject<UObjectRedirector>(Package, NAME_None, RF_Transient));
+	}
+
+	TArray<UObject*> ObjectsOfClassBefore;
+	GetObjectsOfClass(UObjectRedirector::StaticClass(), ObjectsOfClassBefore, false);
+
+	FEvent* StartEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	FEvent* MixedEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	FThreadSafeCounter ReadyCounter;
+
+	TArray<FHashWorker*> Workers;
+	TArray<FRunnableThread*> Threads;
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		Workers.Add(new FHashWorker(Index, Outers, Workers, StartEvent, MixedEvent, ReadyCounter));
+	}
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		Threads.Add(FRunnableThread::Create(Workers[Index], *FString::Printf(TEXT("UObjectHashStressTest%d"), Index)));
+	}
+
+	while (ReadyCounter.GetValue() < NumThreads)
+	{
+		FPlatformProcess::Sleep(0.0f);
+	}
+
+	const double CreateSeconds = RunPhase(StartEvent, ReadyCounter, 2 * NumThreads);
+	RunPhase(MixedEvent, ReadyCounter, 3 * NumThreads);
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		Threads[Index]->WaitForCompletion();
+	}
+
+	int32 NumObjects = 0;
+	int32 NumFinds = 0;
+	int32 NumNotFound = 0;
+	int32 NumCreatedWhileFinding = 0;
+	double FindSeconds = 0.0;
+	double CreateWhileFindingSeconds = 0.0;
+	for (FHashWorker* Worker : Workers)
+	{
+		NumObjects += Worker->Created.Num() + Worker->CreatedWhileFinding.Num();
+		NumFinds += Worker->NumFinds;
+		NumNotFound += Worker->NumNotFound;
+		NumCreatedWhileFinding += Worker->CreatedWhileFinding.Num();
+		double& Seconds = Worker->IsFinder() ? FindSeconds : CreateWhileFindingSeconds;
+		Seconds = FMath::Max(Seconds, Worker->MixedSeconds);
+	}
+
+	AddLogItem(FString::Printf(TEXT("%d threads, %d objects in %d outers"), NumThreads, NumObjects, NumOuters));
+	AddLogItem(FString::Printf(TEXT("create                  %8.2f M objects/s"), NumThreads * NumObjectsPerThread / FMath::Max(CreateSeconds, 1.0e-6) / 1.0e6));
+	AddLogItem(FString::Printf(TEXT("find while creating     %8.2f M objects/s"), NumFinds / FMath::Max(FindSeconds, 1.0e-6) / 1.0e6));
+	AddLogItem(FString::Printf(TEXT("create while finding    %8.2f M objects/s"), NumCreatedWhileFinding / FMath::Max(CreateWhileFindingSeconds, 1.0e-6) / 1.0e6));
+
+	TestEqual(TEXT("Lookups that didn't find the object they looked for"), NumNotFound, 0);
+
+	TArray<UObject*> Inners;
+	GetObjectsWithOuter(Package, Inners, true);
+	TestEqual(TEXT("Objects found by outer"), Inners.Num(), NumOuters + NumObjects);
+
+	TArray<UObject*> ObjectsOfClass;
+	GetObjectsOfClass(UObjectRedirector::StaticClass(), ObjectsOfClass, false);
+	TestEqual(TEXT("Objects found by class"), ObjectsOfClass.Num() - ObjectsOfClassBefore.Num(), NumObjects);
+
+	// Objects created off the game thread are kept by GC until they're handed over to it.
+	for (FHashWorker* Worker : Workers)
+	{
+		for (UObject* Object : Worker->Created)
+		{
+			Object->ClearInternalFlags(EInternalObjectFlags::Async);
+		}
+		for (UObject* Object : Worker->CreatedWhileFinding)
+		{
+			Object->ClearInternalFlags(EInternalObjectFlags::Async);
+		}
+	}
+	for (int32 Index = 0; Index < NumThreads; ++Index)
+	{
+		delete Threads[Index];
+		delete Workers[Index];
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(StartEvent);
+	FPlatformProcess::ReturnSynchEventToPool(MixedEvent);
+
+	Package->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
@@ -0,0 +1,149 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnversionedPropertyBenchmarkTest, "System.Engine.Serialization.Unversioned Property Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace UnversionedPropertyBenchmarkTest
+{
+	/** Each format is loaded this many times, to even out the timings */
+	const int32 NumLoads = 10;
+
+	/** Saves properties to memory like a cooked package does, except object references and names are stored raw */
+	class FPropertyWriter : public FObjectWriter
+	{
+	public:
+		FPropertyWriter(TArray<uint8>& InBytes, bool bUnversioned)
+			: FObjectWriter(InBytes)
+		{
+			ArIsPersistent = true;
+			SetFilterEditorOnly(true);
+			SetUseUnversionedPropertySerialization(bUnversioned);
+		}
+	};
+
+	/** Loads properties saved by FPropertyWriter back into the objects they were saved from */
+	class FPropertyReader : public FObjectReader
+	{
+	public:
+		FPropertyReader(TArray<uint8>& InBytes, bool bUnversioned)
+			: FObjectReader(InBytes)
+		{
+			ArIsPersistent = true;
+			SetFilterEditorOnly(true);
+			SetUseUnversionedPropertySerialization(bUnversioned);
+		}
+	};
+
+	/** Finds the package given by -PropertyBenchmarkPackage=, or else the largest map in the game's or the engine's content */
+	FString FindPackage()
+	{
+		FString PackageName;
+		if (FParse::Value(FCommandLine::Get(), TEXT("PropertyBenchmarkPackage="), PackageName))
+		{
+			return PackageName;
+		}
+
+		const FString Directories[] = { FPaths::GameContentDir(), FPaths::EngineContentDir() };
+		for (const FString& Directory : Directories)
+		{
+			TArray<FString> Filenames;
+			IFileManager::Get().FindFilesRecursive(Filenames, *Directory, TEXT("*.umap"), true, false, false);
+
+			int64 LargestSize = -1;
+			for (const FString& Filename : Filenames)
+			{
+				const int64 Size = IFileManager::Get().FileSize(*Filename);
+				if (Size > LargestSize && FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName))
+				{
+					LargestSize = Size;
+				}
+			}
+			if (LargestSize >= 0)
+			{
+				return PackageName;
+			}
+		}
+		return FString();
+	}
+
+	/** Saves the properties of all Objects, one after the other */
+	void SaveProperties(const TArray<UObject*>& Objects, TArray<uint8>& OutBytes, bool bUnversioned)
+	{
+		FPropertyWriter Writer(OutBytes, bUnversioned);
+		for (UObject* Object : Objects)
+		{
+			UClass* Class = Object->GetClass();
+			Class->SerializeTaggedProperties(Writer, (uint8*)Object, Class, (uint8*)Object->GetArchetype());
+		}
+	}
+
+	/** Loads the properties saved by SaveProperties() back into Objects, and returns how long it took */
+	double LoadProperties(const TArray<UObject*>& Objects, TArray<uint8>& Bytes, bool bUnversioned)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		FPropertyReader Reader(Bytes, bUnversioned);
+		for (UObject* Object : Objects)
+		{
+			UClass* Class = Object->GetClass();
+			Class->SerializeTaggedProperties(Reader, (uint8*)Object, Class, (uint8*)Object->GetArchetype());
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+
+/**
+ * Saves the properties of every object in a large level with and without tags, and compares how big they are and how
+ * long they take to load. Only the properties are measured, the native data objects serialize after them is the same
+ * in both formats. Also checks that unversioned properties load back the values they were saved from.
+ */
+bool FUnversionedPropertyBenchmarkTest::RunTest( const FString& Parameters )
+{
+	using namespace UnversionedPropertyBenchmarkTest;
+
+	const FString PackageName = FindPackage();
+	if (PackageName.IsEmpty())
+	{
+		AddLogItem(TEXT("No map found, pass -PropertyBenchmarkPackage=<package> to point the benchmark at one."));
+		return true;
+	}
+
+	UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+	TestNotNull(*FString::Printf(TEXT("Package %s"), *PackageName), Package);
+	if (!Package)
+	{
+		return false;
+	}
+
+	TArray<UObject*> Objects;
+	GetObjectsWithOuter(Package, Objects, true, RF_ClassDefaultObject, EInternalObjectFlags::PendingKill);
+	Objects.RemoveAll([](UObject* Object) { return Object->IsA<UField>(); });
+
+	TArray<uint8> Tagged;
+	TArray<uint8> Unversioned;
+	SaveProperties(Objects, Tagged, false);
+	SaveProperties(Objects, Unversioned, true);
+
+	double TaggedLoadTime = 0.0;
+	double UnversionedLoadTime = 0.0;
+	for (int32 LoadIndex = 0; LoadIndex < NumLoads; ++LoadIndex)
+	{
+		TaggedLoadTime += LoadProperties(Objects, Tagged, false);
+		UnversionedLoadTime += LoadProperties(Objects, Unversioned, true);
+	}
+
+	TArray<uint8> Resaved;
+	SaveProperties(Objects, Resaved, true);
+	TestTrue(TEXT("Unversioned properties are saved the same after loading them"), Resaved == Unversioned);
+
+	AddLogItem(FString::Printf(TEXT("%s: %d objects"), *PackageName, Objects.Num()));
+	AddLogItem(FString::Printf(TEXT("Tagged properties: %d bytes, %.3fms to load"), Tagged.Num(), TaggedLoadTime * 1000.0 / NumLoads));
+	AddLogItem(FString::Printf(TEXT("Unversioned properties: %d bytes (%.1f%%), %.3fms to load (%.1f%%)"),
+		Unversioned.Num(), 100.0 * Unversioned.Num() / FMath::Max(Tagged.Num(), 1),
+		UnversionedLoadTime * 1000.0 / NumLoads, 100.0 * UnversionedLoadTime / FMath::Max(TaggedLoadTime, 1.0e-9)));
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
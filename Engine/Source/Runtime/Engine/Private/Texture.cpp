@@ -293,6 +293,11 @@ void UTexture::PostLoad()
 	}
 }
 
+bool UTexture::CanBeClusterRoot() const
+{
+	return GAssetClusteringEnabled != 0;
+}
+
 void UTexture::BeginDestroy()
 {
 	Super::BeginDestroy();
@@ -3,6 +3,7 @@
 #include "EnginePrivate.h"
 #include "NetworkReplayStreaming.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/RepArrayDelta.h"
 #include "GeneralProjectSettings.h"
 
 FNetworkVersion::FGetLocalNetworkVersionOverride FNetworkVersion::GetLocalNetworkVersionOverride;
@@ -47,6 +48,12 @@ uint32 FNetworkVersion::GetLocalNetworkVersion(bool AllowOverrideDelegate /*=tru
 	// Hash with internal protocol version
 	uint32 LocalNetworkVersion = FCrc::MemCrc32( &InternalProtocolVersion, sizeof( InternalProtocolVersion ), VersionHash );
 
+	// Element level array replication changes how replicated TArrays are written, so it has to match on both ends
+	if ( FRepArrayDelta::IsEnabled() )
+	{
+		LocalNetworkVersion = FCrc::StrCrc32( TEXT( "ArrayDeltaReplication" ), LocalNetworkVersion );
+	}
+
 #if 0//!(UE_BUILD_SHIPPING || UE_BUILD_TEST)	// DISABLED FOR NOW, MESSES UP COPIED BUILDS
 	if ( !FEngineVersion::Current().HasChangelist() )
 	{
@@ -20,6 +20,7 @@
 #include "ParticleDefinitions.h"
 #include "Database.h"
 #include "Net/NetworkProfiler.h"
+#include "Net/NetworkObjectList.h"
 #include "PrecomputedLightVolume.h"
 #include "UObjectAnnotation.h"
 #include "RenderCore.h"
@@ -303,6 +304,12 @@ void UWorld::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collecto
 	Super::AddReferencedObjects( InThis, Collector );
 }
 
+bool UWorld::CanBeInCluster() const
+{
+	// The world keeps changing what it references, it must never end up in a level's actor cluster
+	return false;
+}
+
 #if WITH_EDITOR
 bool UWorld::Rename(const TCHAR* InName, UObject* NewOuter, ERenameFlags Flags)
 {
@@ -3389,6 +3396,18 @@ void UWorld::AddNetworkActor( AActor* Actor )
 	}
 
 	NetworkActors.Add( Actor );
+
+	// Keep the server net drivers' persistent replication lists in sync
+	if ( FWorldContext* Context = GEngine ? GEngine->GetWorldContextFromWorld(this) : nullptr )
+	{
+		for ( FNamedNetDriver& Driver : Context->ActiveNetDrivers )
+		{
+			if ( Driver.NetDriver != nullptr && Driver.NetDriver->GetWorld() == this && Driver.NetDriver->IsServer() )
+			{
+				Driver.NetDriver->GetNetworkObjectList().Add( Actor );
+			}
+		}
+	}
 }
 
 void UWorld::RemoveNetworkActor( AActor* Actor )
@@ -3399,6 +3418,17 @@ void UWorld::RemoveNetworkActor( AActor* Actor )
 	}
 
 	NetworkActors.Remove( Actor );
+
+	if ( FWorldContext* Context = GEngine ? GEngine->GetWorldContextFromWorld(this) : nullptr )
+	{
+		for ( FNamedNetDriver& Driver : Context->ActiveNetDrivers )
+		{
+			if ( Driver.NetDriver != nullptr )
+			{
+				Driver.NetDriver->GetNetworkObjectList().Remove( Actor );
+			}
+		}
+	}
 }
 
 FDelegateHandle UWorld::AddOnActorSpawnedHandler( const FOnActorSpawned::FDelegate& InHandler )
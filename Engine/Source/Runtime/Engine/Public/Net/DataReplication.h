@@ -75,6 +75,8 @@ public:
 
 	TMap< int32, UStructProperty* >					UnmappedCustomProperties;
 
+	TMap< int32, TArray< int32 > >					ArrayDeltaElementIDs;		// Element IDs of received array delta properties, see FRepArrayDelta
+
 	TArray< UProperty*,TInlineAllocator< 32 > >		RepNotifies;
 	TMap< UProperty*, TArray<uint8> >				RepNotifyMetaData;
 
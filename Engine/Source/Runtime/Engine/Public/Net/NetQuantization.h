@@ -0,0 +1,482 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetQuantization.h:
+	Compile time configurable quantization for NetSerialize functions.
+=============================================================================*/
+#pragma once
+
+/**
+ *	Net Quantization
+ *
+ *	These templates write fixed point values with FArchive::SerializeInt/SerializeBits, which FBitWriter and FBitReader
+ *	pack to exactly as many bits as the value range needs. They can be used from any NetSerialize function.
+ *
+ *	The range and precision of every axis are template parameters, so the bit count of each type is known at compile time:
+ *
+ *		// +/- 131072 units horizontally and +/- 16384 units vertically, to 1/10th of a unit: 22 + 22 + 19 bits
+ *		typedef TQuantizedRange< 131072, 10 > FHorizontalAxis;
+ *		typedef TQuantizedRange< 16384, 10 > FVerticalAxis;
+ *		typedef TQuantizedVector< FHorizontalAxis, FHorizontalAxis, FVerticalAxis > FLocationQuantization;
+ *
+ *		bool NetSerialize( FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess )
+ *		{
+ *			bOutSuccess = FLocationQuantization::Serialize( Ar, Location );
+ *			bOutSuccess &= TQuantizedQuat< 15 >::Serialize( Ar, Rotation );
+ *			return true;
+ *		}
+ *
+ *	Every type also has SerializeDelta, which encodes the value relative to a baseline both sides agree on
+ *	(typically the last value acknowledged by the receiver, or the previous sample of a stream). Components that
+ *	did not change cost a single bit, and small changes are sent as a short signed delta.
+ *	The sender should use the value returned by Round (what the receiver actually ended up with) as its next baseline,
+ *	so both sides keep quantizing against the same number.
+ *
+ *	Serialize and SerializeDelta return false if a value had to be clamped to fit the range.
+ */
+
+namespace NetQuantizationPrivate
+{
+	/** Number of bits needed to store values in [0, MaxValue] */
+	template< uint32 MaxValue >
+	struct TBitsForValue
+	{
+		enum { Value = 1 + TBitsForValue< MaxValue / 2 >::Value };
+	};
+
+	template<>
+	struct TBitsForValue< 0 >
+	{
+		enum { Value = 0 };
+	};
+
+	/**
+	 * Writes Quantized (in [0, NumSteps)) relative to BaselineQuantized:
+	 *	0								- same as the baseline
+	 *	1 0 <sign> <magnitude - 1>		- |delta| <= 2^SmallDeltaBits
+	 *	1 1 <value>						- anything else, written in full
+	 * If bWrap is set, values are angles on a circle of NumSteps (a power of two) and deltas take the short way around.
+	 */
+	template< uint32 NumSteps, uint32 SmallDeltaBits, bool bWrap >
+	void SerializeQuantizedDelta( FArchive& Ar, uint32& Quantized, const uint32 BaselineQuantized )
+	{
+		static_assert( SmallDeltaBits > 0 && SmallDeltaBits < 31, "SmallDeltaBits out of range" );
+
+		int32 Delta = 0;
+
+		if ( Ar.IsSaving() )
+		{
+			Delta = (int32)Quantized - (int32)BaselineQuantized;
+
+			if ( bWrap )
+			{
+				// Sign extend the difference from NumSteps to 32 bits (shifting left unsigned, since Delta may be negative)
+				const int32 Shift = 32 - TBitsForValue< NumSteps - 1 >::Value;
+				Delta = (int32)( (uint32)Delta << Shift ) >> Shift;
+			}
+		}
+
+		uint8 bChanged = ( Delta != 0 ) ? 1 : 0;
+		Ar.SerializeBits( &bChanged, 1 );
+
+		if ( !bChanged )
+		{
+			Quantized = BaselineQuantized;
+			return;
+		}
+
+		uint8 bFullValue = ( FMath::Abs( Delta ) > ( 1 << SmallDeltaBits ) ) ? 1 : 0;
+		Ar.SerializeBits( &bFullValue, 1 );
+
+		if ( bFullValue )
+		{
+			Ar.SerializeInt( Quantized, NumSteps );
+			return;
+		}
+
+		uint8 bNegative = ( Delta < 0 ) ? 1 : 0;
+		Ar.SerializeBits( &bNegative, 1 );
+
+		uint32 Magnitude = Ar.IsSaving() ? FMath::Abs( Delta ) - 1 : 0;
+		Ar.SerializeInt( Magnitude, 1 << SmallDeltaBits );
+
+		if ( Ar.IsLoading() )
+		{
+			Delta = bNegative ? -(int32)( Magnitude + 1 ) : (int32)( Magnitude + 1 );
+
+			if ( bWrap )
+			{
+				Quantized = (uint32)( (int32)BaselineQuantized + Delta ) & ( NumSteps - 1 );
+			}
+			else
+			{
+				Quantized = (uint32)FMath::Clamp< int32 >( (int32)BaselineQuantized + Delta, 0, NumSteps - 1 );
+			}
+		}
+	}
+}
+
+/**
+ * A single float stored as fixed point in [-Range, Range], with Precision steps per unit.
+ * e.g. TQuantizedRange< 1048576, 1 > matches the range of FVector_NetQuantize, with a fixed 22 bits.
+ */
+template< uint32 Range, uint32 Precision, uint32 SmallDeltaBits = 7 >
+struct TQuantizedRange
+{
+	static_assert( Range > 0 && Precision > 0, "Range and Precision must be positive" );
+	static_assert( (uint64)Range * Precision < ( 1 << 30 ), "Range * Precision must fit in 30 bits" );
+
+	enum { HalfSteps	= Range * Precision };
+	enum { NumSteps		= 2 * HalfSteps + 1 };
+	enum { NumBits		= NetQuantizationPrivate::TBitsForValue< NumSteps - 1 >::Value };
+
+	static FORCEINLINE uint32 Quantize( const float Value, bool& bOutClamped )
+	{
+		const float Scaled = FMath::RoundToFloat( Value * Precision );
+		const float Clamped = FMath::Clamp( Scaled, -(float)HalfSteps, (float)HalfSteps );
+
+		bOutClamped |= ( Clamped != Scaled );
+
+		return (uint32)( (int32)Clamped + HalfSteps );
+	}
+
+	static FORCEINLINE float Dequantize( const uint32 Quantized )
+	{
+		return (float)( (int32)Quantized - HalfSteps ) / Precision;
+	}
+
+	/** Returns the value the receiver ends up with */
+	static FORCEINLINE float Round( const float Value )
+	{
+		bool bClamped = false;
+		return Dequantize( Quantize( Value, bClamped ) );
+	}
+
+	static bool Serialize( FArchive& Ar, float& Value )
+	{
+		bool bClamped = false;
+		uint32 Quantized = Ar.IsSaving() ? Quantize( Value, bClamped ) : 0;
+
+		Ar.SerializeInt( Quantized, NumSteps );
+
+		if ( Ar.IsLoading() )
+		{
+			Value = Dequantize( FMath::Min< uint32 >( Quantized, NumSteps - 1 ) );
+		}
+
+		return !bClamped;
+	}
+
+	static bool SerializeDelta( FArchive& Ar, float& Value, const float Baseline )
+	{
+		bool bClamped = false;
+		bool bBaselineClamped = false;
+
+		const uint32 BaselineQuantized = Quantize( Baseline, bBaselineClamped );
+		uint32 Quantized = Ar.IsSaving() ? Quantize( Value, bClamped ) : 0;
+
+		NetQuantizationPrivate::SerializeQuantizedDelta< NumSteps, SmallDeltaBits, false >( Ar, Quantized, BaselineQuantized );
+
+		if ( Ar.IsLoading() )
+		{
+			Value = Dequantize( FMath::Min< uint32 >( Quantized, NumSteps - 1 ) );
+		}
+
+		return !bClamped;
+	}
+};
+
+/** A vector with an independent TQuantizedRange (or compatible type) per axis */
+template< typename XAxis, typename YAxis = XAxis, typename ZAxis = YAxis >
+struct TQuantizedVector
+{
+	enum { NumBits = XAxis::NumBits + YAxis::NumBits + ZAxis::NumBits };
+
+	static FORCEINLINE FVector Round( const FVector& Vector )
+	{
+		return FVector( XAxis::Round( Vector.X ), YAxis::Round( Vector.Y ), ZAxis::Round( Vector.Z ) );
+	}
+
+	static bool Serialize( FArchive& Ar, FVector& Vector )
+	{
+		bool bSuccess = XAxis::Serialize( Ar, Vector.X );
+		bSuccess &= YAxis::Serialize( Ar, Vector.Y );
+		bSuccess &= ZAxis::Serialize( Ar, Vector.Z );
+		return bSuccess;
+	}
+
+	static bool SerializeDelta( FArchive& Ar, FVector& Vector, const FVector& Baseline )
+	{
+		// Stationary objects are common enough to be worth a bit for the whole vector
+		uint8 bChanged = ( Ar.IsSaving() && Round( Vector ) != Round( Baseline ) ) ? 1 : 0;
+		Ar.SerializeBits( &bChanged, 1 );
+
+		if ( !bChanged )
+		{
+			if ( Ar.IsLoading() )
+			{
+				Vector = Round( Baseline );
+			}
+			return true;
+		}
+
+		bool bSuccess = XAxis::SerializeDelta( Ar, Vector.X, Baseline.X );
+		bSuccess &= YAxis::SerializeDelta( Ar, Vector.Y, Baseline.Y );
+		bSuccess &= ZAxis::SerializeDelta( Ar, Vector.Z, Baseline.Z );
+		return bSuccess;
+	}
+};
+
+/** Rotator with each axis stored as BitsPerComponent bits of a full turn. Axes that are zero only cost one bit. */
+template< uint32 BitsPerComponent, uint32 SmallDeltaBits = 5 >
+struct TQuantizedRotator
+{
+	static_assert( BitsPerComponent > 1 && BitsPerComponent <= 16, "BitsPerComponent must be in [2, 16]" );
+
+	enum { NumSteps	= 1 << BitsPerComponent };
+	enum { MaxBits	= 3 * ( BitsPerComponent + 1 ) };
+
+	static FORCEINLINE uint32 Quantize( const float Angle )
+	{
+		return (uint32)FMath::RoundToInt( Angle * ( NumSteps / 360.f ) ) & ( NumSteps - 1 );
+	}
+
+	static FORCEINLINE float Dequantize( const uint32 Quantized )
+	{
+		return Quantized * ( 360.f / NumSteps );
+	}
+
+	static FORCEINLINE FRotator Round( const FRotator& Rotator )
+	{
+		return FRotator( Dequantize( Quantize( Rotator.Pitch ) ), Dequantize( Quantize( Rotator.Yaw ) ), Dequantize( Quantize( Rotator.Roll ) ) );
+	}
+
+	static bool Serialize( FArchive& Ar, FRotator& Rotator )
+	{
+		SerializeAxis( Ar, Rotator.Pitch );
+		SerializeAxis( Ar, Rotator.Yaw );
+		SerializeAxis( Ar, Rotator.Roll );
+		return true;
+	}
+
+	static bool SerializeDelta( FArchive& Ar, FRotator& Rotator, const FRotator& Baseline )
+	{
+		SerializeAxisDelta( Ar, Rotator.Pitch, Baseline.Pitch );
+		SerializeAxisDelta( Ar, Rotator.Yaw, Baseline.Yaw );
+		SerializeAxisDelta( Ar, Rotator.Roll, Baseline.Roll );
+		return true;
+	}
+
+private:
+	static void SerializeAxis( FArchive& Ar, float& Angle )
+	{
+		uint32 Quantized = Ar.IsSaving() ? Quantize( Angle ) : 0;
+
+		uint8 bNonZero = ( Quantized != 0 ) ? 1 : 0;
+		Ar.SerializeBits( &bNonZero, 1 );
+
+		if ( bNonZero )
+		{
+			Ar.SerializeInt( Quantized, NumSteps );
+		}
+
+		if ( Ar.IsLoading() )
+		{
+			Angle = bNonZero ? Dequantize( Quantized ) : 0.f;
+		}
+	}
+
+	static void SerializeAxisDelta( FArchive& Ar, float& Angle, const float BaselineAngle )
+	{
+		uint32 Quantized = Ar.IsSaving() ? Quantize( Angle ) : 0;
+
+		NetQuantizationPrivate::SerializeQuantizedDelta< NumSteps, SmallDeltaBits, true >( Ar, Quantized, Quantize( BaselineAngle ) );
+
+		if ( Ar.IsLoading() )
+		{
+			Angle = Dequantize( Quantized );
+		}
+	}
+};
+
+/**
+ * Unit quaternion packed as "smallest three": the index of the largest component in 2 bits, then the other three
+ * (which are always within +/- 1/sqrt(2)) with BitsPerComponent bits each. The largest component is rebuilt from the unit length.
+ * 15 bits per component is a maximum error well under 0.01 degrees in 47 bits.
+ */
+template< uint32 BitsPerComponent >
+struct TQuantizedQuat
+{
+	static_assert( BitsPerComponent > 1 && BitsPerComponent <= 30, "BitsPerComponent must be in [2, 30]" );
+
+	enum { NumSteps	= 1 << BitsPerComponent };
+	enum { NumBits	= 2 + 3 * BitsPerComponent };
+
+	static FORCEINLINE FQuat Round( const FQuat& Quat )
+	{
+		uint32 Largest = 0;
+		uint32 Quantized[3];
+		Quantize( Quat, Largest, Quantized );
+		return Dequantize( Largest, Quantized );
+	}
+
+	static bool Serialize( FArchive& Ar, FQuat& Quat )
+	{
+		uint32 Largest = 0;
+		uint32 Quantized[3] = { 0, 0, 0 };
+
+		if ( Ar.IsSaving() )
+		{
+			Quantize( Quat, Largest, Quantized );
+		}
+
+		Ar.SerializeInt( Largest, 4 );
+		Ar.SerializeInt( Quantized[0], NumSteps );
+		Ar.SerializeInt( Quantized[1], NumSteps );
+		Ar.SerializeInt( Quantized[2], NumSteps );
+
+		if ( Ar.IsLoading() )
+		{
+			Quat = Dequantize( Largest, Quantized );
+		}
+
+		return true;
+	}
+
+	/** Rotations tend to change all components at once, so the delta form only saves anything when the rotation did not change */
+	static bool SerializeDelta( FArchive& Ar, FQuat& Quat, const FQuat& Baseline )
+	{
+		uint8 bChanged = 1;
+
+		if ( Ar.IsSaving() )
+		{
+			uint32 Largest = 0, BaselineLargest = 0;
+			uint32 Quantized[3], BaselineQuantized[3];
+			Quantize( Quat, Largest, Quantized );
+			Quantize( Baseline, BaselineLargest, BaselineQuantized );
+
+			bChanged = ( Largest != BaselineLargest || FMemory::Memcmp( Quantized, BaselineQuantized, sizeof( Quantized ) ) != 0 ) ? 1 : 0;
+		}
+
+		Ar.SerializeBits( &bChanged, 1 );
+
+		if ( !bChanged )
+		{
+			if ( Ar.IsLoading() )
+			{
+				Quat = Round( Baseline );
+			}
+			return true;
+		}
+
+		return Serialize( Ar, Quat );
+	}
+
+private:
+	static FORCEINLINE float MaxComponent() { return 0.707106781f; }
+
+	static void Quantize( const FQuat& InQuat, uint32& OutLargest, uint32* OutQuantized )
+	{
+		const FQuat Quat = InQuat.GetNormalized();
+		const float Components[4] = { Quat.X, Quat.Y, Quat.Z, Quat.W };
+
+		OutLargest = 0;
+		for ( uint32 i = 1; i < 4; i++ )
+		{
+			if ( FMath::Abs( Components[i] ) > FMath::Abs( Components[OutLargest] ) )
+			{
+				OutLargest = i;
+			}
+		}
+
+		// q and -q are the same rotation, flip so the dropped component is positive
+		const float Sign = Components[OutLargest] < 0.f ? -1.f : 1.f;
+
+		for ( uint32 i = 0, Out = 0; i < 4; i++ )
+		{
+			if ( i != OutLargest )
+			{
+				const float Normalized = FMath::Clamp( ( Components[i] * Sign / MaxComponent() ) * 0.5f + 0.5f, 0.f, 1.f );
+				OutQuantized[Out++] = (uint32)FMath::RoundToInt( Normalized * ( NumSteps - 1 ) );
+			}
+		}
+	}
+
+	static FQuat Dequantize( const uint32 Largest, const uint32* Quantized )
+	{
+		float Components[4];
+		float SumSquares = 0.f;
+
+		for ( uint32 i = 0, In = 0; i < 4; i++ )
+		{
+			if ( i != Largest )
+			{
+				Components[i] = ( ( (float)Quantized[In++] / ( NumSteps - 1 ) ) * 2.f - 1.f ) * MaxComponent();
+				SumSquares += FMath::Square( Components[i] );
+			}
+		}
+
+		Components[Largest & 3] = FMath::Sqrt( FMath::Max( 0.f, 1.f - SumSquares ) );
+
+		FQuat Quat( Components[0], Components[1], Components[2], Components[3] );
+		Quat.Normalize();
+		return Quat;
+	}
+};
+
+/** Transform made of a quantized translation, a smallest three rotation and a quantized scale. Unit scale costs one bit. */
+template< typename TranslationQuantization, uint32 RotationBits, typename ScaleQuantization >
+struct TQuantizedTransform
+{
+	static FTransform Round( const FTransform& Transform )
+	{
+		return FTransform( TQuantizedQuat< RotationBits >::Round( Transform.GetRotation() ), TranslationQuantization::Round( Transform.GetTranslation() ), ScaleQuantization::Round( Transform.GetScale3D() ) );
+	}
+
+	static bool Serialize( FArchive& Ar, FTransform& Transform )
+	{
+		FVector Translation	= Transform.GetTranslation();
+		FQuat Rotation		= Transform.GetRotation();
+		FVector Scale		= Transform.GetScale3D();
+
+		bool bSuccess = TranslationQuantization::Serialize( Ar, Translation );
+		bSuccess &= TQuantizedQuat< RotationBits >::Serialize( Ar, Rotation );
+
+		uint8 bUnitScale = ScaleQuantization::Round( Scale ).Equals( FVector( 1.f ), 0.f ) ? 1 : 0;
+		Ar.SerializeBits( &bUnitScale, 1 );
+
+		if ( bUnitScale )
+		{
+			Scale = FVector( 1.f );
+		}
+		else
+		{
+			bSuccess &= ScaleQuantization::Serialize( Ar, Scale );
+		}
+
+		if ( Ar.IsLoading() )
+		{
+			Transform = FTransform( Rotation, Translation, Scale );
+		}
+
+		return bSuccess;
+	}
+
+	static bool SerializeDelta( FArchive& Ar, FTransform& Transform, const FTransform& Baseline )
+	{
+		FVector Translation	= Transform.GetTranslation();
+		FQuat Rotation		= Transform.GetRotation();
+		FVector Scale		= Transform.GetScale3D();
+
+		bool bSuccess = TranslationQuantization::SerializeDelta( Ar, Translation, Baseline.GetTranslation() );
+		bSuccess &= TQuantizedQuat< RotationBits >::SerializeDelta( Ar, Rotation, Baseline.GetRotation() );
+		bSuccess &= ScaleQuantization::SerializeDelta( Ar, Scale, Baseline.GetScale3D() );
+
+		if ( Ar.IsLoading() )
+		{
+			Transform = FTransform( Rotation, Translation, Scale );
+		}
+
+		return bSuccess;
+	}
+};
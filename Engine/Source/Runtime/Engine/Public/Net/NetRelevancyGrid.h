@@ -0,0 +1,79 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetRelevancyGrid.h:
+	Optional spatial hash used by UNetDriver::ServerReplicateActors to answer
+	distance based relevancy once per grid cell instead of once per actor/connection pair.
+=============================================================================*/
+#pragma once
+
+class AActor;
+struct FNetViewer;
+
+/**
+ * FNetRelevancyGrid
+ *	Buckets this frame's considered actors into a 3D grid of CellSize units.
+ *	The first time a viewer in a given cell asks for relevancy, the set of actors within NetCullDistance of any point
+ *	of that cell is computed and cached for the rest of the frame, so every connection whose viewers share a cell reuses it.
+ *
+ *	The cached set is only a superset of the relevant actors, so actors in it are then checked against the exact
+ *	viewer location, which gives the same result as AActor::IsNetRelevantFor without the virtual call.
+ *
+ *	Only actors whose native class is known to use the default AActor::IsNetRelevantFor are handled by the grid.
+ *	Everything else (pawns, player controllers, classes with custom relevancy rules) falls back to the virtual call.
+ */
+class ENGINE_API FNetRelevancyGrid
+{
+public:
+	FNetRelevancyGrid();
+
+	/** Sets the size of a grid cell, in world units. Clears any cached data. */
+	void SetCellSize( float InCellSize );
+
+	/** Sets additional native classes (and their subclasses) that are known not to override IsNetRelevantFor */
+	void SetDefaultRelevancyClasses( const TArray< FString >& ClassNames );
+
+	/** Rebuilds the grid from the actors considered for replication this frame */
+	void Build( const TArray< AActor* >& ConsiderList );
+
+	/** Discards all per-frame data */
+	void Reset();
+
+	/** Returns true if Actor is relevant to any of the viewers. Falls back to AActor::IsNetRelevantFor for actors the grid does not handle. */
+	bool IsRelevantToViewers( const AActor* Actor, const TArray< FNetViewer >& Viewers );
+
+	/** Number of per-cell relevant sets computed since the last Build, for stats */
+	int32 GetNumCellQueries() const { return NumCellQueries; }
+
+private:
+	struct FGridActor
+	{
+		const AActor* Actor;
+		FVector Location;
+		float CullDistanceSquared;
+	};
+
+	/** Returns true if this actor's relevancy only depends on viewers through ownership and distance */
+	bool CanUseGrid( const AActor* Actor );
+
+	/** Returns true if the native class of InClass is known to use the default relevancy implementation */
+	bool UsesDefaultRelevancy( UClass* InClass );
+
+	FIntVector GetCell( const FVector& Location ) const;
+
+	/** Returns the set of grid actors (as a bit per index in GridActors) within cull distance of some point of Cell, computing it if needed */
+	const TBitArray<>& GetRelevantSet( const FIntVector& Cell );
+
+	float CellSize;
+	float MaxCullDistance;
+
+	TArray< FGridActor > GridActors;
+	TMap< const AActor*, int32 > ActorToGridIndex;
+	TMap< FIntVector, TArray< int32 > > CellActors;
+	TMap< FIntVector, TBitArray<> > RelevantSets;
+
+	TArray< FName > DefaultRelevancyClassNames;
+	TMap< UClass*, bool > ClassCache;
+
+	int32 NumCellQueries;
+};
@@ -0,0 +1,151 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetworkObjectList.h:
+	Persistent, incrementally maintained list of replicated actors owned by a UNetDriver.
+=============================================================================*/
+#pragma once
+
+class AActor;
+class UNetConnection;
+
+/** Bookkeeping the net driver keeps for every replicated actor it knows about */
+struct FNetworkObjectInfo
+{
+	/** The actor this info describes */
+	AActor* Actor;
+
+	/** Connections this actor is currently dormant on */
+	TSet< TWeakObjectPtr< UNetConnection > > DormantConnections;
+
+	/** Incremented every time the actor is (re)scheduled, used to discard stale entries in the update queue */
+	uint32 ScheduleSerial;
+
+	/** True if the actor is not dormant on every connection, and so takes part in update scheduling */
+	uint8 bActive:1;
+
+	/** True if the actor is already in the list of objects due for consideration this frame */
+	uint8 bDue:1;
+
+	explicit FNetworkObjectInfo( AActor* InActor )
+		: Actor( InActor )
+		, ScheduleSerial( 0 )
+		, bActive( true )
+		, bDue( false )
+	{}
+};
+
+/**
+ * FNetworkObjectList
+ *	Holds every actor a net driver may replicate, split into active and fully dormant objects.
+ *
+ *	Active objects are kept in a queue ordered by AActor::NetUpdateTime, so that UNetDriver::ServerReplicateActors
+ *	only has to visit actors that are actually due for an update (or were flagged with bPendingNetUpdate),
+ *	instead of walking every network actor in the world each net tick.
+ *
+ *	Objects that are dormant on every client connection are not scheduled at all until their dormancy is flushed.
+ *	The list is kept up to date by the world (actor spawn/destroy), the net driver (dormancy flushes, connection
+ *	changes) and actor channels (channels going dormant or being reopened).
+ */
+class ENGINE_API FNetworkObjectList
+{
+public:
+	typedef TMap< AActor*, TSharedPtr< FNetworkObjectInfo > > FNetworkObjectMap;
+
+	FNetworkObjectList()
+		: NumActiveObjects( 0 )
+		, NextScheduleSerial( 1 )
+	{}
+
+	/**
+	 * Adds an actor if it replicates. Does nothing if the actor is already known.
+	 * Actors of every net driver are added, as AActor::NetDriverName can still change after the actor is spawned (beacons for example).
+	 */
+	void Add( AActor* Actor );
+
+	/** Adds all existing network actors of a world, used when a net driver is associated with a world that already has actors */
+	void AddInitialObjects( UWorld* World );
+
+	/** Removes an actor from the list entirely */
+	void Remove( AActor* Actor );
+
+	/** Records that an actor has gone dormant on Connection. Once dormant on all NumConnections connections, the actor stops being scheduled. */
+	void MarkDormant( AActor* Actor, UNetConnection* Connection, int32 NumConnections );
+
+	/** Records that an actor is no longer dormant on Connection, scheduling it again if it was dormant on every connection */
+	void MarkActive( AActor* Actor, UNetConnection* Connection );
+
+	/** Removes an actor from every connection's dormant set, scheduling it again if needed */
+	void FlushDormancy( AActor* Actor );
+
+	/** Called when a client connection is added: fully dormant actors are not dormant on the new connection yet */
+	void OnConnectionAdded();
+
+	/** Called after a client connection has been removed from the driver */
+	void OnConnectionRemoved( UNetConnection* Connection, int32 NumConnections );
+
+	/** Queues the actor for the next update at its current NetUpdateTime. Call after NetUpdateTime has been recomputed, or moved earlier. */
+	void Schedule( AActor* Actor );
+
+	/** Queues the actor to be due again at UpdateTime, without changing its NetUpdateTime. Used for actors another net driver replicates. */
+	void Schedule( AActor* Actor, float UpdateTime );
+
+	/** Makes the actor due for consideration on the next call to GatherDueObjects, regardless of its NetUpdateTime */
+	void MarkPendingNetUpdate( AActor* Actor );
+
+	/**
+	 * Collects every active actor whose NetUpdateTime is earlier than WorldTime, or that has been marked pending.
+	 * Collected actors are no longer scheduled: the caller is responsible for calling Schedule, MarkPendingNetUpdate or Remove on each of them.
+	 */
+	void GatherDueObjects( float WorldTime, TArray< AActor* >& OutDueObjects );
+
+	/** Removes everything */
+	void Reset();
+
+	/** Returns the info for an actor, or NULL if the actor is not in the list */
+	FNetworkObjectInfo* Find( const AActor* Actor ) const;
+
+	/** Returns every object in the list, active or dormant */
+	const FNetworkObjectMap& GetAllObjects() const { return AllNetworkObjects; }
+
+	/** Returns the number of objects in the list */
+	int32 GetNumObjects() const { return AllNetworkObjects.Num(); }
+
+	/** Returns the number of objects that are not dormant on every connection */
+	int32 GetNumActiveObjects() const { return NumActiveObjects; }
+
+private:
+	/** Entry in the update queue. Entries are never removed eagerly: they are discarded when popped if their serial no longer matches the info's */
+	struct FScheduledObject
+	{
+		float UpdateTime;
+		uint32 Serial;
+		TSharedPtr< FNetworkObjectInfo > Info;
+
+		FScheduledObject( float InUpdateTime, uint32 InSerial, const TSharedPtr< FNetworkObjectInfo >& InInfo )
+			: UpdateTime( InUpdateTime ), Serial( InSerial ), Info( InInfo )
+		{}
+
+		friend bool operator<( const FScheduledObject& A, const FScheduledObject& B )
+		{
+			return A.UpdateTime < B.UpdateTime;
+		}
+	};
+
+	void ScheduleInfo( const TSharedPtr< FNetworkObjectInfo >& Info, float UpdateTime );
+	void MarkInfoDue( const TSharedPtr< FNetworkObjectInfo >& Info );
+	void SetActive( const TSharedPtr< FNetworkObjectInfo >& Info, bool bActive );
+	void CompactUpdateQueue();
+
+	/** Every object known to the driver */
+	FNetworkObjectMap AllNetworkObjects;
+
+	/** Min-heap of scheduled update times for active objects */
+	TArray< FScheduledObject > UpdateQueue;
+
+	/** Active objects that must be considered on the next GatherDueObjects call, whatever their NetUpdateTime */
+	TArray< TSharedPtr< FNetworkObjectInfo > > DueObjects;
+
+	int32 NumActiveObjects;
+	uint32 NextScheduleSerial;
+};
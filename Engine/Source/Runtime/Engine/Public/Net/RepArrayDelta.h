@@ -0,0 +1,60 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RepArrayDelta.h:
+	Element level delta replication for plain replicated TArray properties.
+=============================================================================*/
+#pragma once
+
+class UArrayProperty;
+class FScriptArrayHelper;
+struct FNetDeltaSerializeInfo;
+
+/**
+ * FRepArrayDelta
+ *	When net.ArrayDeltaReplication is enabled, replicated TArray properties are taken out of FRepLayout and sent through
+ *	the custom delta path (the same one FFastArraySerializer uses), without any changes to game code.
+ *	The setting is fixed for the lifetime of the process and is part of FNetworkVersion::GetLocalNetworkVersion.
+ *
+ *	For every connection, the server keeps a copy of the array as it was last sent, along with an ID for each element.
+ *	Each update diffs the current array against that copy (common prefix/suffix, then a bounded LCS of what is left),
+ *	so an element keeps its ID when other elements are inserted or removed around it, and when its own value changes in place.
+ *	Only removed IDs, and the ID, index and value of inserted or changed elements, are sent.
+ *
+ *	Base states follow the usual custom delta rules: on a NAK, FObjectReplicator restores the state the dropped update was made from.
+ *	Because later updates may have arrived in the meantime, the first update after a restore also carries the full ID order,
+ *	and resends every element touched since that state. The client rebuilds the array from the order list, so it converges
+ *	regardless of which of the earlier updates it received.
+ *
+ *	Arrays whose elements contain object references are left to FRepLayout, since it tracks unmapped network GUIDs for them.
+ *	Client side element IDs are stored on the FObjectReplicator, and changes made locally by client code to one of these
+ *	arrays are only corrected by the next update that carries the full order.
+ */
+class ENGINE_API FRepArrayDelta
+{
+public:
+	/** Returns true if net.ArrayDeltaReplication was enabled at startup */
+	static bool IsEnabled();
+
+	/** Returns true if this property should be replicated by FRepArrayDelta instead of FRepLayout */
+	static bool IsArrayDeltaProperty( UProperty* Property );
+
+	/**
+	 * Finds which old element each new element corresponds to.
+	 * OutMatch[NewIndex] is the index of the old element, or INDEX_NONE if it was inserted. OutIdentical is set if its value did not change.
+	 * Matched elements always keep their relative order, so the client only ever has to insert and remove.
+	 */
+	static void MatchElements( const UProperty* Inner, FScriptArrayHelper& OldHelper, FScriptArrayHelper& NewHelper, TArray< int32 >& OutMatch, TBitArray<>& OutIdentical );
+
+	/**
+	 * Writes the difference between Parms.OldState and the array at Data to Parms.Writer.
+	 * Returns false (and leaves Parms.NewState unset) if there was nothing to send.
+	 */
+	static bool WriteDelta( UArrayProperty* ArrayProperty, FNetDeltaSerializeInfo& Parms, void* Data );
+
+	/**
+	 * Reads an update written by WriteDelta from Parms.Reader and applies it to the array at Data.
+	 * ElementIDs holds the IDs of the client's copy of the array and is kept in sync with it.
+	 */
+	static bool ReadDelta( UArrayProperty* ArrayProperty, FNetDeltaSerializeInfo& Parms, void* Data, TArray< int32 >& ElementIDs );
+};
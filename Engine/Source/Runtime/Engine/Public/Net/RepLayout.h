@@ -11,6 +11,7 @@
 
 class FOutBunch;
 class FInBunch;
+class FRepChangelistState;
 
 class FRepChangedParent
 {
@@ -64,6 +65,8 @@ public:
 	uint32						ActiveStatusChanged;
 	bool						UnconditionalPropChanged;
 	bool						ForceAlwaysActive;				// Used for client replay recording. The server has already evaluated any custom conditions, so the client doesn't need to.
+
+	TSharedPtr< FRepChangelistState >	ChangelistState;		// Shared changelist history of the unconditional properties, created on first use when net.ShareChangelists is enabled
 };
 
 class FRepLayout;
@@ -78,6 +81,37 @@ public:
 	bool				Resend;
 };
 
+/** FRepChangelistState
+ *  Changelists of an object's unconditional lifetime properties, computed at most once per replication frame against a shadow state
+ *  that is shared by every connection. Each FRepState remembers how far into this history it has sent, and merges the changelists
+ *  it hasn't seen yet instead of comparing the properties again.
+ */
+class FRepChangelistState
+{
+public:
+	FRepChangelistState() : 
+		HistoryStart( 0 ),
+		HistoryEnd( 0 ),
+		LastCompareFrame( 0 )
+	{ }
+
+	~FRepChangelistState();
+
+	static const int32 MAX_CHANGE_HISTORY = 64;
+
+	TSharedPtr< FRepLayout >	RepLayout;
+
+	TArray< uint8 >				StaticBuffer;					// Property values as of the last compare
+
+	TArray< FRepChangedParent >	ChangedParents;					// Scratch space used while comparing
+
+	TArray< uint16 >			ChangeHistory[MAX_CHANGE_HISTORY];
+	int32						HistoryStart;
+	int32						HistoryEnd;
+
+	uint32						LastCompareFrame;
+};
+
 class FUnmappedGuidMgrElement
 {
 public:
@@ -119,7 +153,8 @@ public:
 		NumNaks( 0 ),
 		OpenAckedCalled( false ),
 		AwakeFromDormancy( false ),
-		ActiveStatusChanged( 0 )
+		ActiveStatusChanged( 0 ),
+		LastChangelistIndex( INDEX_NONE )
 	{ }
 
 	~FRepState();
@@ -151,6 +186,8 @@ public:
 	TArray< uint16 >				ConditionalLifetime;		// Properties the need to be checked conditionally (based on net initial, role, etc)
 	FReplicationFlags				RepFlags;
 	uint32							ActiveStatusChanged;
+
+	int32							LastChangelistIndex;		// Index into the shared FRepChangelistState history up to which changes have been sent, INDEX_NONE if not sharing yet
 };
 
 enum ERepLayoutCmdType
@@ -248,6 +285,7 @@ public:
 class FRepLayout
 {
 	friend class FRepState;
+	friend class FRepChangelistState;
 
 public:
 	FRepLayout() : FirstNonCustomParent( 0 ), RoleIndex( -1 ), RemoteRoleIndex( -1 ), Owner( NULL ) {}
@@ -280,6 +318,14 @@ public:
 		const FReplicationFlags &	RepFlags,
 		bool &						bContentBlockWritten ) const;
 
+	/**
+	 * Compares the unconditional lifetime properties of Data against the shadow state of RepState ahead of ReplicateProperties,
+	 * so every FRepState in the same replication group can skip the compare this frame.
+	 * Only writes to RepState's FRepChangedPropertyTracker, so it can run on a worker thread as long as no other call uses the same tracker.
+	 * Returns false if there was nothing to compare.
+	 */
+	bool PreCompareProperties( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, const uint32 ReplicationFrame ) const;
+
 	void SendProperties( 
 		FRepState *	RESTRICT		RepState, 
 		const FReplicationFlags &	RepFlags,
@@ -362,6 +408,12 @@ private:
 		const uint16			CmdIndex,
 		const uint16			Handle ) const;
 
+	void CompareUnconditionalProperties( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, const uint32 ReplicationFrame ) const;
+
+	bool UpdateChangelistState( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, const uint32 ReplicationFrame ) const;
+
+	void MergeChangelistHistory( FRepState * RESTRICT RepState, const uint8* RESTRICT Data, TArray< uint16 > & OutChanged ) const;
+
 	bool CompareProperties( 
 		FRepState * RESTRICT				RepState, 
 		const uint8* RESTRICT				CompareData,
@@ -441,9 +493,9 @@ private:
 		void *				Data,
 		bool &				bHasUnmapped ) const;
 
-	void ConstructProperties( FRepState * RepState ) const;
-	void InitProperties( FRepState * RepState, uint8* Src ) const;
-	void DestructProperties( FRepState * RepState ) const;
+	void ConstructProperties( TArray< uint8 > & ShadowData ) const;
+	void InitProperties( TArray< uint8 > & ShadowData, const uint8* Src ) const;
+	void DestructProperties( TArray< uint8 > & ShadowData ) const;
 
 	TArray< FRepParentCmd >		Parents;
 	TArray< FRepLayoutCmd >		Cmds;
@@ -737,6 +737,9 @@ int32 FEngineLoop::PreInit( const TCHAR* CmdLine )
 	}
 #endif // STATS
 
+	// The main thread never exits before the allocator goes away, so it can cache free blocks too
+	FMemory::SetupTLSCachesOnCurrentThread();
+
 	// Name of project file before normalization (as specified in command line).
 	// Used to fixup project name if necessary.
 	FString GameProjectFilePathUnnormalized;
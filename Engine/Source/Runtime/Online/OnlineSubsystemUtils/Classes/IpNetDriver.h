@@ -7,6 +7,17 @@
 #pragma once
 #include "IpNetDriver.generated.h"
 
+/** A packet queued by UIpConnection::LowLevelSend, waiting for UIpNetDriver to send it with the rest of the frame's packets */
+struct FIpNetDriverPendingSend
+{
+	/** Where the packet is in PendingSendData */
+	int32 Offset;
+	int32 Count;
+
+	/** Kept alive here, the connection may be destroyed before the flush */
+	TSharedPtr<FInternetAddr> Destination;
+};
+
 UCLASS(transient, config=Engine)
 class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 {
@@ -37,6 +48,7 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 	virtual bool InitListen( FNetworkNotify* InNotify, FURL& LocalURL, bool bReuseAddressAndPort, FString& Error ) override;
 	virtual void ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject = NULL) override;
 	virtual void TickDispatch( float DeltaTime ) override;
+	virtual void TickFlush( float DeltaSeconds ) override;
 	virtual FString LowLevelGetNetworkNumber() override;
 	virtual void LowLevelDestroy() override;
 	virtual class ISocketSubsystem* GetSocketSubsystem() override;
@@ -57,6 +69,16 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 	 * @return The port number to use for client sockets. Base implementation returns 0.
 	 */
 	virtual int GetClientPort();
+
+	/**
+	 * Queues a packet to be sent with every other packet of this frame by FlushPendingSends, with a single SendToBatch call.
+	 *
+	 * @return false if send batching is disabled (net.IpNetDriverBatchSends), in which case the caller should send it straight away
+	 */
+	bool QueuePendingSend(const uint8* Data, int32 Count, const TSharedPtr<FInternetAddr>& Destination);
+
+	/** Sends all packets queued by QueuePendingSend */
+	void FlushPendingSends();
 	//~ End UIpNetDriver Interface.
 
 	//~ Begin FExec Interface
@@ -70,4 +92,13 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 
 	/** @return TCPIP connection to server */
 	class UIpConnection* GetServerConnection();
+
+private:
+	/** Packets waiting for FlushPendingSends, and the data they point into */
+	TArray<FIpNetDriverPendingSend> PendingSends;
+	TArray<uint8> PendingSendData;
+
+	/** Buffers and source addresses for RecvFromBatch, allocated on the first TickDispatch */
+	TArray<uint8> RecvData;
+	TArray<TSharedRef<FInternetAddr>> RecvAddresses;
 };
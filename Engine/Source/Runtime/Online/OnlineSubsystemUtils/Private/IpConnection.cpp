@@ -148,7 +148,16 @@ void UIpConnection::LowLevelSend( void* Data, int32 Count )
 		UE_LOG( LogNet, Warning, TEXT( "UIpConnection::LowLevelSend: Count > MaxPacketSize! Count: %i, MaxPacket: %i %s" ), Count, MaxPacket, *Describe() );
 	}
 
-	Socket->SendTo(DataToSend, Count, BytesSent, *RemoteAddr);
+	// The driver sends every packet of the frame together, if it can
+	UIpNetDriver* IpDriver = Cast<UIpNetDriver>(Driver);
+	if ( IpDriver != NULL && Socket == IpDriver->Socket && IpDriver->QueuePendingSend(DataToSend, Count, RemoteAddr) )
+	{
+		BytesSent = Count;
+	}
+	else
+	{
+		Socket->SendTo(DataToSend, Count, BytesSent, *RemoteAddr);
+	}
 	UNCLOCK_CYCLES(Driver->SendCycles);
 	NETWORK_PROFILER(GNetworkProfiler.FlushOutgoingBunches(this));
 	NETWORK_PROFILER(GNetworkProfiler.TrackSocketSendTo(Socket->GetDescription(),Data,BytesSent,NumPacketIdBits,NumBunchBits,NumAckBits,NumPaddingBits,this));
@@ -17,6 +17,16 @@ Notes:
 	Declarations.
 -----------------------------------------------------------------------------*/
 
+static TAutoConsoleVariable<int32> CVarNetIpNetDriverBatchSends(
+	TEXT("net.IpNetDriverBatchSends"),
+	1,
+	TEXT("If true, UIpNetDriver queues every packet sent during a frame and sends them together at the end of TickFlush, with as few system calls as the platform allows."));
+
+static TAutoConsoleVariable<int32> CVarNetIpNetDriverRecvBatchSize(
+	TEXT("net.IpNetDriverRecvBatchSize"),
+	64,
+	TEXT("Number of packets UIpNetDriver reads from the socket per call, on platforms that support batched receives."));
+
 
 UIpNetDriver::UIpNetDriver(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -170,16 +180,54 @@ void UIpNetDriver::TickDispatch( float DeltaTime )
 
 	const double StartReceiveTime = FPlatformTime::Seconds();
 
-	// Process all incoming packets.
-	uint8 Data[MAX_PACKET_SIZE];
-	TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr();
+	// Process all incoming packets, reading them in batches.
+	const int32 RecvBatchSize = FMath::Max(CVarNetIpNetDriverRecvBatchSize.GetValueOnGameThread(), 1);
+	if (RecvAddresses.Num() != RecvBatchSize)
+	{
+		RecvData.SetNumUninitialized(RecvBatchSize * MAX_PACKET_SIZE);
+		RecvAddresses.Reset();
+		for (int32 Index = 0; Index < RecvBatchSize; ++Index)
+		{
+			RecvAddresses.Add(SocketSubsystem->CreateInternetAddr());
+		}
+	}
+
+	TArray<FSocketRecvMessage, TInlineAllocator<64>> RecvMessages;
+	RecvMessages.AddDefaulted(RecvBatchSize);
+	for (int32 Index = 0; Index < RecvBatchSize; ++Index)
+	{
+		RecvMessages[Index].Data = RecvData.GetData() + Index * MAX_PACKET_SIZE;
+		RecvMessages[Index].BufferSize = MAX_PACKET_SIZE;
+		RecvMessages[Index].Source = &RecvAddresses[Index].Get();
+	}
+
+	int32 NumBatched = 0;
+	int32 BatchIndex = 0;
+
 	for( ; Socket != NULL; )
 	{
-		int32 BytesRead = 0;
-		// Get data, if any.
-		CLOCK_CYCLES(RecvCycles);
-		bool bOk = Socket->RecvFrom(Data, sizeof(Data), BytesRead, *FromAddr);
-		UNCLOCK_CYCLES(RecvCycles);
+		bool bOk = true;
+
+		// Get more data, if any, once the last batch has been processed.
+		if (BatchIndex >= NumBatched)
+		{
+			BatchIndex = 0;
+			CLOCK_CYCLES(RecvCycles);
+			bOk = Socket->RecvFromBatch(RecvMessages.GetData(), RecvMessages.Num(), NumBatched);
+			UNCLOCK_CYCLES(RecvCycles);
+		}
+
+		// On failure, the first message holds the source address, if there was one
+		FSocketRecvMessage& Message = RecvMessages[BatchIndex];
+		uint8* Data = Message.Data;
+		const int32 BytesRead = bOk ? Message.BytesRead : 0;
+		TSharedRef<FInternetAddr> FromAddr = RecvAddresses[BatchIndex];
+
+		if (bOk)
+		{
+			BatchIndex++;
+		}
+
 		// Handle result.
 		if( bOk == false )
 		{
@@ -316,6 +364,75 @@ void UIpNetDriver::TickDispatch( float DeltaTime )
 	}
 }
 
+void UIpNetDriver::TickFlush( float DeltaSeconds )
+{
+	Super::TickFlush( DeltaSeconds );
+
+	FlushPendingSends();
+}
+
+bool UIpNetDriver::QueuePendingSend(const uint8* Data, int32 Count, const TSharedPtr<FInternetAddr>& Destination)
+{
+	if (CVarNetIpNetDriverBatchSends.GetValueOnGameThread() == 0 || !Destination.IsValid())
+	{
+		return false;
+	}
+
+	FIpNetDriverPendingSend& PendingSend = PendingSends[PendingSends.AddDefaulted()];
+	PendingSend.Offset = PendingSendData.Num();
+	PendingSend.Count = Count;
+	PendingSend.Destination = Destination;
+
+	PendingSendData.Append(Data, Count);
+
+	return true;
+}
+
+void UIpNetDriver::FlushPendingSends()
+{
+	if (PendingSends.Num() == 0)
+	{
+		return;
+	}
+
+	if (Socket != NULL)
+	{
+		TArray<FSocketSendMessage, TInlineAllocator<64>> SendMessages;
+		SendMessages.AddDefaulted(PendingSends.Num());
+
+		for (int32 Index = 0; Index < PendingSends.Num(); ++Index)
+		{
+			SendMessages[Index].Data = PendingSendData.GetData() + PendingSends[Index].Offset;
+			SendMessages[Index].Count = PendingSends[Index].Count;
+			SendMessages[Index].Destination = PendingSends[Index].Destination.Get();
+		}
+
+		int32 NumSent = 0;
+		CLOCK_CYCLES(SendCycles);
+
+		// A packet the OS refuses is dropped, the same as when it is sent straight away. Carry on with the rest.
+		while (NumSent < SendMessages.Num())
+		{
+			int32 NumSentThisCall = 0;
+			const bool bAllSent = Socket->SendToBatch(SendMessages.GetData() + NumSent, SendMessages.Num() - NumSent, NumSentThisCall);
+
+			NumSent += NumSentThisCall;
+
+			if (!bAllSent)
+			{
+				const ESocketErrors Error = GetSocketSubsystem()->GetLastErrorCode();
+				UE_LOG(LogNet, Verbose, TEXT("UIpNetDriver::FlushPendingSends: failed to send packet to %s: %s"), *SendMessages[NumSent].Destination->ToString(true), GetSocketSubsystem()->GetSocketError(Error));
+				NumSent++;
+			}
+		}
+
+		UNCLOCK_CYCLES(SendCycles);
+	}
+
+	PendingSends.Reset();
+	PendingSendData.Reset();
+}
+
 void UIpNetDriver::ProcessRemoteFunction(class AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, class UObject* SubObject )
 {
 	bool bIsServer = IsServer();
@@ -390,6 +507,9 @@ void UIpNetDriver::LowLevelDestroy()
 {
 	Super::LowLevelDestroy();
 
+	// Connections send their close bunches while being destroyed
+	FlushPendingSends();
+
 	// Close the socket.
 	if( Socket && !HasAnyFlags(RF_ClassDefaultObject) )
 	{
@@ -0,0 +1,21 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.IO;
+
+public class CompressionHandlerComponent : ModuleRules
+{
+    public CompressionHandlerComponent(TargetInfo Target)
+    {
+        PublicDependencyModuleNames.AddRange(
+            new string[] {
+				"Core",
+                "PacketHandler",
+            }
+        );
+
+        AddThirdPartyPrivateStaticDependencies(Target,
+            "zlib"
+            );
+    }
+}
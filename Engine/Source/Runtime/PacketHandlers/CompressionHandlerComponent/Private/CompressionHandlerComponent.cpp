@@ -0,0 +1,435 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CompressionHandlerComponent.h"
+#include "ThirdParty/zlib/zlib-1.2.5/Inc/zlib.h"
+
+IMPLEMENT_MODULE(FCompressionHandlerComponentModuleInterface, CompressionHandlerComponent);
+
+namespace PacketCompression
+{
+	/* Header byte values */
+	enum EPacketType : uint8
+	{
+		Raw			= 0,
+		Deflated	= 1
+	};
+
+	/* Largest packet we will inflate, anything bigger than this is not a valid packet */
+	const int32 MaxPacketSize = 16384;
+
+	/* Deflate can reach 32KB back, leave room for the packet itself */
+	const int32 MaxDictionarySize = 32768 - MaxPacketSize;
+
+	/* Size of the dictionary written by -PacketCompressionCapture */
+	const int32 TrainedDictionarySize = 8192;
+
+	/* Length of the byte strings the trainer counts */
+	const int32 TrainingSegmentLength = 8;
+
+	/* Stop capturing after this many bytes */
+	const int32 MaxCaptureBytes = 4 * 1024 * 1024;
+
+	/* Packets recorded by -PacketCompressionCapture */
+	TArray<TArray<uint8>> CapturedPackets;
+	int32 CapturedBytes = 0;
+
+	static void* ZAlloc(void* Opaque, unsigned int Size, unsigned int Num)
+	{
+		return FMemory::Malloc(Size * Num);
+	}
+
+	static void ZFree(void* Opaque, void* Ptr)
+	{
+		FMemory::Free(Ptr);
+	}
+}
+
+/*
+* The dictionary and a deflate and inflate stream. Every packet is compressed on its own, by resetting the stream and
+* priming it with the dictionary, so one context can be shared by all connections (packets are only handled on the game thread).
+*/
+class FPacketCompressionContext
+{
+public:
+	FPacketCompressionContext(const TArray<uint8>& InDictionary, int32 Level)
+		: Dictionary(InDictionary)
+		, bValid(false)
+	{
+		FMemory::Memzero(&DeflateStream, sizeof(DeflateStream));
+		FMemory::Memzero(&InflateStream, sizeof(InflateStream));
+
+		DeflateStream.zalloc = &PacketCompression::ZAlloc;
+		DeflateStream.zfree = &PacketCompression::ZFree;
+		InflateStream.zalloc = &PacketCompression::ZAlloc;
+		InflateStream.zfree = &PacketCompression::ZFree;
+
+		// Negative window bits for raw deflate, the zlib header and checksum would cost 6 bytes on every packet
+		const bool bDeflateInit = deflateInit2(&DeflateStream, FMath::Clamp(Level, 1, 9), Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY) == Z_OK;
+		const bool bInflateInit = inflateInit2(&InflateStream, -MAX_WBITS) == Z_OK;
+
+		bValid = bDeflateInit && bInflateInit;
+
+		if (Dictionary.Num() > PacketCompression::MaxDictionarySize)
+		{
+			UE_LOG(PacketHandlerLog, Warning, TEXT("Packet compression dictionary is %d bytes, only the last %d are used."), Dictionary.Num(), PacketCompression::MaxDictionarySize);
+			Dictionary.RemoveAt(0, Dictionary.Num() - PacketCompression::MaxDictionarySize);
+		}
+
+		DecompressBuffer.SetNumUninitialized(PacketCompression::MaxPacketSize);
+		CompressBuffer.SetNumUninitialized(PacketCompression::MaxPacketSize);
+	}
+
+	~FPacketCompressionContext()
+	{
+		deflateEnd(&DeflateStream);
+		inflateEnd(&InflateStream);
+	}
+
+	bool IsValid() const
+	{
+		return bValid;
+	}
+
+	/* Compresses Data into CompressBuffer. Returns the compressed size, or 0 if it would not be smaller than MaxSize */
+	int32 Compress(const uint8* Data, int32 Count, int32 MaxSize)
+	{
+		MaxSize = FMath::Min(MaxSize, CompressBuffer.Num());
+
+		if (!bValid || MaxSize <= 0 || deflateReset(&DeflateStream) != Z_OK)
+		{
+			return 0;
+		}
+
+		if (Dictionary.Num() > 0 && deflateSetDictionary(&DeflateStream, Dictionary.GetData(), Dictionary.Num()) != Z_OK)
+		{
+			return 0;
+		}
+
+		DeflateStream.next_in = (Bytef*)Data;
+		DeflateStream.avail_in = Count;
+		DeflateStream.next_out = CompressBuffer.GetData();
+		DeflateStream.avail_out = MaxSize;
+
+		// Anything other than Z_STREAM_END means the output did not fit
+		if (deflate(&DeflateStream, Z_FINISH) != Z_STREAM_END)
+		{
+			return 0;
+		}
+
+		return MaxSize - DeflateStream.avail_out;
+	}
+
+	/* Decompresses Data into DecompressBuffer. Returns the decompressed size, or -1 on failure */
+	int32 Decompress(const uint8* Data, int32 Count)
+	{
+		if (!bValid || inflateReset(&InflateStream) != Z_OK)
+		{
+			return -1;
+		}
+
+		InflateStream.next_in = (Bytef*)Data;
+		InflateStream.avail_in = Count;
+		InflateStream.next_out = DecompressBuffer.GetData();
+		InflateStream.avail_out = DecompressBuffer.Num();
+
+		if (Dictionary.Num() > 0 && inflateSetDictionary(&InflateStream, Dictionary.GetData(), Dictionary.Num()) != Z_OK)
+		{
+			return -1;
+		}
+
+		if (inflate(&InflateStream, Z_FINISH) != Z_STREAM_END)
+		{
+			return -1;
+		}
+
+		return DecompressBuffer.Num() - InflateStream.avail_out;
+	}
+
+	TArray<uint8> CompressBuffer;
+	TArray<uint8> DecompressBuffer;
+
+private:
+	TArray<uint8> Dictionary;
+
+	z_stream DeflateStream;
+	z_stream InflateStream;
+
+	bool bValid;
+};
+
+// STATS
+FPacketCompressionStats::FPacketCompressionStats()
+: PacketsOut(0)
+, CompressedPacketsOut(0)
+, RawBytesOut(0)
+, WireBytesOut(0)
+, PacketsIn(0)
+, CompressedPacketsIn(0)
+, WireBytesIn(0)
+, RawBytesIn(0)
+, DecompressFailures(0)
+{
+}
+
+float FPacketCompressionStats::GetOutgoingSavings() const
+{
+	return RawBytesOut > 0 ? 100.f * (1.f - (float)((double)WireBytesOut / (double)RawBytesOut)) : 0.f;
+}
+
+// COMPRESSION
+CompressionHandlerComponent::CompressionHandlerComponent(TSharedPtr<FPacketCompressionContext> InContext)
+: Context(InContext)
+{
+}
+
+CompressionHandlerComponent::~CompressionHandlerComponent()
+{
+	if (Stats.PacketsOut > 0 || Stats.PacketsIn > 0)
+	{
+		UE_LOG(PacketHandlerLog, Log, TEXT("Packet compression: sent %llu packets (%llu compressed), %llu bytes as %llu (%.1f%% saved). Received %llu packets (%llu compressed), %llu bytes as %llu, %llu failed to decompress."),
+			Stats.PacketsOut, Stats.CompressedPacketsOut, Stats.RawBytesOut, Stats.WireBytesOut, Stats.GetOutgoingSavings(),
+			Stats.PacketsIn, Stats.CompressedPacketsIn, Stats.WireBytesIn, Stats.RawBytesIn, Stats.DecompressFailures);
+	}
+}
+
+void CompressionHandlerComponent::Initialize()
+{
+	// Nothing to negotiate, both ends are configured with the same dictionary
+	SetActive(true);
+	Initialized();
+	State = Handler::Component::State::Initialized;
+}
+
+bool CompressionHandlerComponent::IsValid() const
+{
+	return Context.IsValid() && Context->IsValid();
+}
+
+void CompressionHandlerComponent::Outgoing(FBitWriter& Packet)
+{
+	const int32 Count = (int32)Packet.GetNumBytes();
+
+	if (State != Handler::Component::State::Initialized || !IsValid() || Count == 0)
+	{
+		return;
+	}
+
+	static const bool bCapture = FParse::Param(FCommandLine::Get(), TEXT("PacketCompressionCapture"));
+
+	if (bCapture && PacketCompression::CapturedBytes < PacketCompression::MaxCaptureBytes)
+	{
+		PacketCompression::CapturedPackets.Add(TArray<uint8>(Packet.GetData(), Count));
+		PacketCompression::CapturedBytes += Count;
+	}
+
+	// Only worth it if the compressed packet and its header are smaller than the raw packet and its header
+	const int32 CompressedSize = Context->Compress(Packet.GetData(), Count, Count - 1);
+
+	FBitWriter Local;
+	Local.AllowAppend(true);
+	Local.SetAllowResize(true);
+
+	uint8 PacketType = CompressedSize > 0 ? PacketCompression::Deflated : PacketCompression::Raw;
+	Local << PacketType;
+
+	if (CompressedSize > 0)
+	{
+		Local.Serialize(Context->CompressBuffer.GetData(), CompressedSize);
+		Stats.CompressedPacketsOut++;
+	}
+	else
+	{
+		Local.Serialize(Packet.GetData(), Count);
+	}
+
+	Stats.PacketsOut++;
+	Stats.RawBytesOut += Count;
+	Stats.WireBytesOut += Local.GetNumBytes();
+
+	Packet = Local;
+}
+
+void CompressionHandlerComponent::Incoming(FBitReader& Packet)
+{
+	if (State != Handler::Component::State::Initialized || !IsValid() || Packet.GetBytesLeft() == 0)
+	{
+		return;
+	}
+
+	Stats.PacketsIn++;
+	Stats.WireBytesIn += Packet.GetBytesLeft();
+
+	uint8 PacketType = 0;
+	Packet << PacketType;
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(Packet.GetBytesLeft());
+	Packet.Serialize(Payload.GetData(), Payload.Num());
+
+	if (PacketType == PacketCompression::Raw && !Packet.IsError())
+	{
+		Stats.RawBytesIn += Payload.Num();
+
+		FBitReader Copy(Payload.GetData(), Payload.Num() * 8);
+		Packet = Copy;
+		return;
+	}
+
+	const int32 DecompressedSize = (PacketType == PacketCompression::Deflated && !Packet.IsError()) ? Context->Decompress(Payload.GetData(), Payload.Num()) : -1;
+
+	if (DecompressedSize < 0)
+	{
+		// Corrupt, or compressed with a different dictionary. Drop it, no more bytes will be read from the packet.
+		Stats.DecompressFailures++;
+		UE_LOG(PacketHandlerLog, Verbose, TEXT("Dropping packet that failed to decompress (%d bytes, type %d)."), Payload.Num(), PacketType);
+
+		FBitReader Empty;
+		Packet = Empty;
+		return;
+	}
+
+	Stats.CompressedPacketsIn++;
+	Stats.RawBytesIn += DecompressedSize;
+
+	FBitReader Decompressed(Context->DecompressBuffer.GetData(), DecompressedSize * 8);
+	Packet = Decompressed;
+}
+
+// MODULE INTERFACE
+TSharedPtr<HandlerComponent> FCompressionHandlerComponentModuleInterface::CreateComponentInstance(FString& Options)
+{
+	FString DictionaryPath;
+	int32 Level = 6;
+
+	FParse::Value(*Options, TEXT("Dictionary="), DictionaryPath);
+	FParse::Value(*Options, TEXT("Level="), Level);
+
+	const FString ContextKey = FString::Printf(TEXT("%s:%d"), *DictionaryPath, Level);
+
+	if (TSharedPtr<FPacketCompressionContext>* Existing = Contexts.Find(ContextKey))
+	{
+		return MakeShareable(new CompressionHandlerComponent(*Existing));
+	}
+
+	TArray<uint8> Dictionary;
+
+	if (!DictionaryPath.IsEmpty())
+	{
+		const FString FullPath = FPaths::IsRelative(DictionaryPath) ? FPaths::GameContentDir() / DictionaryPath : DictionaryPath;
+
+		// A missing dictionary still works, just not as well. Both ends have to agree though, so make it loud.
+		if (!FFileHelper::LoadFileToArray(Dictionary, *FullPath))
+		{
+			UE_LOG(PacketHandlerLog, Warning, TEXT("Unable to load packet compression dictionary %s, compressing without one."), *FullPath);
+		}
+	}
+
+	UE_LOG(PacketHandlerLog, Log, TEXT("Packet compression using a %d byte dictionary (CRC 0x%08X), level %d."), Dictionary.Num(), FCrc::MemCrc32(Dictionary.GetData(), Dictionary.Num()), Level);
+
+	TSharedPtr<FPacketCompressionContext> Context = MakeShareable(new FPacketCompressionContext(Dictionary, Level));
+	Contexts.Add(ContextKey, Context);
+
+	return MakeShareable(new CompressionHandlerComponent(Context));
+}
+
+void FCompressionHandlerComponentModuleInterface::ShutdownModule()
+{
+	Contexts.Empty();
+
+	if (PacketCompression::CapturedPackets.Num() > 0)
+	{
+		TArray<uint8> Dictionary;
+		TrainDictionary(PacketCompression::CapturedPackets, PacketCompression::TrainedDictionarySize, Dictionary);
+
+		const FString DictionaryPath = FPaths::GameSavedDir() / TEXT("PacketCompression") / TEXT("PacketDictionary.bin");
+
+		if (FFileHelper::SaveArrayToFile(Dictionary, *DictionaryPath))
+		{
+			UE_LOG(PacketHandlerLog, Log, TEXT("Wrote %d byte packet compression dictionary trained on %d packets to %s"), Dictionary.Num(), PacketCompression::CapturedPackets.Num(), *DictionaryPath);
+		}
+
+		PacketCompression::CapturedPackets.Empty();
+		PacketCompression::CapturedBytes = 0;
+	}
+}
+
+void FCompressionHandlerComponentModuleInterface::TrainDictionary(const TArray<TArray<uint8>>& Samples, int32 DictionarySize, TArray<uint8>& OutDictionary)
+{
+	const int32 SegmentLength = PacketCompression::TrainingSegmentLength;
+
+	OutDictionary.Reset();
+	DictionarySize = FMath::Clamp(DictionarySize, 0, PacketCompression::MaxDictionarySize);
+
+	struct FSegment
+	{
+		FSegment()
+			: Data(nullptr)
+			, NumPackets(0)
+		{
+		}
+
+		const uint8* Data;
+		int32 NumPackets;
+	};
+
+	// Count how many packets each segment appears in, rather than how often, so one long repetitive packet does not dominate
+	TMap<uint64, FSegment> Segments;
+	TSet<uint64> SeenInPacket;
+
+	for (const TArray<uint8>& Sample : Samples)
+	{
+		SeenInPacket.Reset();
+
+		for (int32 Offset = 0; Offset + SegmentLength <= Sample.Num(); ++Offset)
+		{
+			uint64 Key = 0;
+			FMemory::Memcpy(&Key, Sample.GetData() + Offset, SegmentLength);
+
+			bool bAlreadySeen = false;
+			SeenInPacket.Add(Key, &bAlreadySeen);
+
+			if (!bAlreadySeen)
+			{
+				FSegment& Segment = Segments.FindOrAdd(Key);
+				if (Segment.NumPackets++ == 0)
+				{
+					Segment.Data = Sample.GetData() + Offset;
+				}
+			}
+		}
+	}
+
+	TArray<FSegment> Sorted;
+	for (auto& Pair : Segments)
+	{
+		// A segment only ever seen in one packet will not help the next one
+		if (Pair.Value.NumPackets > 1)
+		{
+			Sorted.Add(Pair.Value);
+		}
+	}
+
+	Sorted.Sort([](const FSegment& A, const FSegment& B) { return A.NumPackets > B.NumPackets; });
+
+	// Most common first, then reversed so they end up closest to the packet
+	TArray<const FSegment*> Chosen;
+	int32 ChosenSize = 0;
+
+	for (const FSegment& Segment : Sorted)
+	{
+		if (ChosenSize + SegmentLength > DictionarySize)
+		{
+			break;
+		}
+
+		Chosen.Add(&Segment);
+		ChosenSize += SegmentLength;
+	}
+
+	OutDictionary.Reserve(ChosenSize);
+
+	for (int32 Index = Chosen.Num() - 1; Index >= 0; --Index)
+	{
+		OutDictionary.Append(Chosen[Index]->Data, SegmentLength);
+	}
+}
@@ -0,0 +1,108 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "PacketHandler.h"
+#include "ModuleManager.h"
+#include "Core.h"
+
+class FPacketCompressionContext;
+
+/* Per connection compression statistics */
+struct COMPRESSIONHANDLERCOMPONENT_API FPacketCompressionStats
+{
+	FPacketCompressionStats();
+
+	/* Number of outgoing packets, and how many of them were sent compressed */
+	uint64 PacketsOut;
+	uint64 CompressedPacketsOut;
+
+	/* Outgoing bytes before and after this component */
+	uint64 RawBytesOut;
+	uint64 WireBytesOut;
+
+	/* Number of incoming packets, and how many of them were compressed */
+	uint64 PacketsIn;
+	uint64 CompressedPacketsIn;
+
+	/* Incoming bytes before and after this component */
+	uint64 WireBytesIn;
+	uint64 RawBytesIn;
+
+	/* Incoming packets that could not be decompressed and were dropped */
+	uint64 DecompressFailures;
+
+	/* Percentage of outgoing bytes saved, negative if the header byte cost more than compression saved */
+	float GetOutgoingSavings() const;
+};
+
+/*
+* Compresses outgoing packets with raw deflate, primed with a dictionary shared by client and server.
+*
+* Packets are compressed independently of each other, so lost or reordered packets do not matter, and the dictionary
+* is what makes compressing packets of a few hundred bytes worthwhile. Every packet gets a one byte header saying
+* whether it is compressed. Packets that do not get smaller are sent raw.
+*
+* Configure it before any encryption component, so it sees the plain packet:
+*
+*	[PacketHandlerComponents]
+*	Components=CompressionHandlerComponent(Dictionary=Net/PacketDictionary.bin,Level=6)
+*
+* Dictionary is relative to the game content directory (and has to be staged as a non-UFS file), and Level is the zlib
+* compression level. Both ends must use the same dictionary, packets compressed with a different one fail to decompress
+* and are dropped. Running with -PacketCompressionCapture records outgoing packets and writes a dictionary trained on them
+* to Saved/PacketCompression/PacketDictionary.bin on shutdown.
+*/
+class COMPRESSIONHANDLERCOMPONENT_API CompressionHandlerComponent : public HandlerComponent
+{
+public:
+	/* Initializes default data */
+	CompressionHandlerComponent(TSharedPtr<FPacketCompressionContext> InContext);
+
+	/* Logs the statistics for this connection */
+	virtual ~CompressionHandlerComponent();
+
+	/* Initializes the handler component */
+	virtual void Initialize() override;
+
+	/* Whether the handler component is valid */
+	virtual bool IsValid() const override;
+
+	/* Handles any incoming packets */
+	virtual void Incoming(FBitReader& Packet) override;
+
+	/* Handles any outgoing packets */
+	virtual void Outgoing(FBitWriter& Packet) override;
+
+	/* Statistics for this connection */
+	const FPacketCompressionStats& GetStats() const
+	{
+		return Stats;
+	}
+
+protected:
+	/* Dictionary and zlib streams, shared by every connection using the same settings */
+	TSharedPtr<FPacketCompressionContext> Context;
+
+	/* Statistics for this connection */
+	FPacketCompressionStats Stats;
+};
+
+/* Compression Module Interface */
+class FCompressionHandlerComponentModuleInterface : public FPacketHandlerComponentModuleInterface
+{
+public:
+	virtual TSharedPtr<HandlerComponent> CreateComponentInstance(FString& Options) override;
+
+	virtual void ShutdownModule() override;
+
+	/*
+	* Builds a deflate dictionary from sample packets: byte strings that appear in the most packets are kept,
+	* with the most common ones at the end of the dictionary, where deflate can reach them with the shortest distances.
+	*/
+	static void TrainDictionary(const TArray<TArray<uint8>>& Samples, int32 DictionarySize, TArray<uint8>& OutDictionary);
+
+private:
+	/* Contexts by dictionary path and level */
+	TMap<FString, TSharedPtr<FPacketCompressionContext>> Contexts;
+};
@@ -12,201 +12,11 @@
 #include "PublicKey.inl"
 #include "AES.h"
 #include "GenericPlatformChunkInstall.h"
+#include "PakCompressedReaderPolicy.h"
 
 DEFINE_LOG_CATEGORY(LogPakFile);
 
 
-/**
- * Class to handle correctly reading from a compressed file within a compressed package
- */
-class FPakSimpleEncryption
-{
-public:
-	enum
-	{
-		Alignment = FAES::AESBlockSize,
-	};
-
-	static FORCEINLINE int64 AlignReadRequest(int64 Size) 
-	{
-		return Align(Size, Alignment);
-	}
-
-	static FORCEINLINE void DecryptBlock(void* Data, int64 Size)
-	{
-#ifdef AES_KEY
-		FAES::DecryptData((uint8*)Data, Size);
-#endif
-	}
-};
-
-/**
- * Thread local class to manage working buffers for file compression
- */
-class FCompressionScratchBuffers : public TThreadSingleton<FCompressionScratchBuffers>
-{
-public:
-	FCompressionScratchBuffers()
-		: TempBufferSize(0)
-		, ScratchBufferSize(0)
-	{}
-
-	int64				TempBufferSize;
-	TAutoPtr<uint8>		TempBuffer;
-	int64				ScratchBufferSize;
-	TAutoPtr<uint8>		ScratchBuffer;
-
-	void EnsureBufferSpace(int64 CompressionBlockSize, int64 ScrachSize)
-	{
-		if(TempBufferSize < CompressionBlockSize)
-		{
-			TempBufferSize = CompressionBlockSize;
-			TempBuffer.Reset((uint8*)FMemory::Malloc(TempBufferSize));
-		}
-		if(ScratchBufferSize < ScrachSize)
-		{
-			ScratchBufferSize = ScrachSize;
-			ScratchBuffer.Reset((uint8*)FMemory::Malloc(ScratchBufferSize));
-		}
-	}
-};
-
-/**
- * Class to handle correctly reading from a compressed file within a pak
- */
-template< typename EncryptionPolicy = FPakNoEncryption >
-class FPakCompressedReaderPolicy
-{
-public:
-	class FPakUncompressTask : public FNonAbandonableTask
-	{
-	public:
-		uint8*				UncompressedBuffer;
-		int32				UncompressedSize;
-		uint8*				CompressedBuffer;
-		int32				CompressedSize;
-		ECompressionFlags	Flags;
-		void*				CopyOut;
-		int64				CopyOffset;
-		int64				CopyLength;
-
-		void DoWork()
-		{
-			// Decrypt and Uncompress from memory to memory.
-			int64 EncryptionSize = EncryptionPolicy::AlignReadRequest(CompressedSize);
-			EncryptionPolicy::DecryptBlock(CompressedBuffer, EncryptionSize);
-			FCompression::UncompressMemory(Flags, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize, false);
-			if (CopyOut)
-			{
-				FMemory::Memcpy(CopyOut, UncompressedBuffer+CopyOffset, CopyLength);
-			}
-		}
-
-		FORCEINLINE TStatId GetStatId() const
-		{
-			// TODO: This is called too early in engine startup.
-			return TStatId();
-			//RETURN_QUICK_DECLARE_CYCLE_STAT(FPakUncompressTask, STATGROUP_ThreadPoolAsyncTasks);
-		}
-	};
-
-	FPakCompressedReaderPolicy(const FPakFile& InPakFile, const FPakEntry& InPakEntry, FArchive* InPakReader)
-		: PakFile(InPakFile)
-		, PakEntry(InPakEntry)
-		, PakReader(InPakReader)
-	{
-	}
-
-	/** Pak file that own this file data */
-	const FPakFile&		PakFile;
-	/** Pak file entry for this file. */
-	const FPakEntry&	PakEntry;
-	/** Pak file archive to read the data from. */
-	FArchive*			PakReader;
-
-	FORCEINLINE int64 FileSize() const
-	{
-		return PakEntry.UncompressedSize;
-	}
-
-	void Serialize(int64 DesiredPosition, void* V, int64 Length)
-	{
-		const int32 CompressionBlockSize = PakEntry.CompressionBlockSize;
-		uint32 CompressionBlockIndex = DesiredPosition / CompressionBlockSize;
-		uint8* WorkingBuffers[2];
-		int64 DirectCopyStart = DesiredPosition % PakEntry.CompressionBlockSize;
-		FAsyncTask<FPakUncompressTask> UncompressTask;
-		FCompressionScratchBuffers& ScratchSpace = FCompressionScratchBuffers::Get();
-		bool bStartedUncompress = false;
-
-		int64 WorkingBufferRequiredSize = FCompression::CompressMemoryBound((ECompressionFlags)PakEntry.CompressionMethod,CompressionBlockSize);
-		WorkingBufferRequiredSize = EncryptionPolicy::AlignReadRequest(WorkingBufferRequiredSize);
-		ScratchSpace.EnsureBufferSpace(CompressionBlockSize, WorkingBufferRequiredSize*2);
-		WorkingBuffers[0] = ScratchSpace.ScratchBuffer;
-		WorkingBuffers[1] = ScratchSpace.ScratchBuffer + WorkingBufferRequiredSize;
-
-		while (Length > 0)
-		{
-			const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[CompressionBlockIndex];
-			int64 Pos = CompressionBlockIndex * CompressionBlockSize;
-			int64 CompressedBlockSize = Block.CompressedEnd-Block.CompressedStart;
-			int64 UncompressedBlockSize = FMath::Min<int64>(PakEntry.UncompressedSize-Pos, PakEntry.CompressionBlockSize);
-			int64 ReadSize = EncryptionPolicy::AlignReadRequest(CompressedBlockSize);
-			int64 WriteSize = FMath::Min<int64>(UncompressedBlockSize - DirectCopyStart, Length);
-			PakReader->Seek(Block.CompressedStart);
-			PakReader->Serialize(WorkingBuffers[CompressionBlockIndex & 1],ReadSize);
-			if (bStartedUncompress)
-			{
-				UncompressTask.EnsureCompletion();
-				bStartedUncompress = false;
-			}
-
-			FPakUncompressTask& TaskDetails = UncompressTask.GetTask();
-			if (DirectCopyStart == 0 && Length >= CompressionBlockSize)
-			{
-				// Block can be decompressed directly into output buffer
-				TaskDetails.Flags = (ECompressionFlags)PakEntry.CompressionMethod;
-				TaskDetails.UncompressedBuffer = (uint8*)V;
-				TaskDetails.UncompressedSize = UncompressedBlockSize;
-				TaskDetails.CompressedBuffer = WorkingBuffers[CompressionBlockIndex & 1];
-				TaskDetails.CompressedSize = CompressedBlockSize;
-				TaskDetails.CopyOut = nullptr;
-			}
-			else
-			{
-				// Block needs to be copied from a working buffer
-				TaskDetails.Flags = (ECompressionFlags)PakEntry.CompressionMethod;
-				TaskDetails.UncompressedBuffer = (uint8*)ScratchSpace.TempBuffer;
-				TaskDetails.UncompressedSize = UncompressedBlockSize;
-				TaskDetails.CompressedBuffer = WorkingBuffers[CompressionBlockIndex & 1];
-				TaskDetails.CompressedSize = CompressedBlockSize;
-				TaskDetails.CopyOut = V;
-				TaskDetails.CopyOffset = DirectCopyStart;
-				TaskDetails.CopyLength = WriteSize;
-			}
-			
-			if (Length == WriteSize)
-			{
-				UncompressTask.StartSynchronousTask();
-			}
-			else
-			{
-				UncompressTask.StartBackgroundTask();
-			}
-			bStartedUncompress = true;
-			V = (void*)((uint8*)V + WriteSize);
-			Length -= WriteSize;
-			DirectCopyStart = 0;
-			++CompressionBlockIndex;
-		}
-
-		if(bStartedUncompress)
-		{
-			UncompressTask.EnsureCompletion();
-		}
-	}
-};
-
 bool FPakEntry::VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEntry& FileEntryB)
 {
 	bool bResult = true;
@@ -348,57 +158,159 @@ void FPakFile::LoadIndex(FArchive* Reader)
 		MakeDirectoryFromPath(MountPoint);
 		// Allocate enough memory to hold all entries (and not reallocate while they're being added to it).
 		Files.Empty(NumEntries);
+		IndexFiles.Empty(NumEntries);
+		FileHashes.Reset(NumEntries);
+		DirectoryHashes.Reset(NumEntries / 16);
+		Directories.Empty();
+		Names.Empty();
 
+		TArray<TCHAR, TInlineAllocator<1024>> Filename;
 		for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
 		{
-			// Serialize from memory.
+			// Filenames are read straight from the index data, serialized the way FString is, instead of into an FString each.
+			int32 SaveNum = 0;
+			IndexReader << SaveNum;
+			const bool bUCS2 = SaveNum < 0;
+			const int32 NumChars = FMath::Abs(SaveNum);
+			const int64 FilenameOffset = IndexReader.Tell();
+			const int64 FilenameSize = (int64)NumChars * (bUCS2 ? sizeof(UCS2CHAR) : sizeof(ANSICHAR));
+			if (FilenameOffset + FilenameSize > IndexData.Num())
+			{
+				UE_LOG(LogPakFile, Fatal, TEXT("Corrupted index in pak file (filename out of range)."));
+			}
+			IndexReader.Seek(FilenameOffset + FilenameSize);
+
+			// Without the terminator
+			const int32 FilenameLen = FMath::Max(NumChars - 1, 0);
+			const uint8* FilenameData = IndexData.GetData() + FilenameOffset;
+			Filename.SetNumUninitialized(FilenameLen + 1);
+			for (int32 CharIndex = 0; CharIndex < FilenameLen; CharIndex++)
+			{
+				Filename[CharIndex] = bUCS2 ? (TCHAR)(FilenameData[CharIndex * 2] | (FilenameData[CharIndex * 2 + 1] << 8)) : (TCHAR)FilenameData[CharIndex];
+			}
+			Filename[FilenameLen] = 0;
+
 			FPakEntry Entry;
-			FString Filename;
-			IndexReader << Filename;
 			Entry.Serialize(IndexReader, Info.Version);
 
-			// Add new file info.
-			Files.Add(Entry);
-
-			// Construct Index of all directories in pak file.
-			FString Path = FPaths::GetPath(Filename);
-			MakeDirectoryFromPath(Path);
-			FPakDirectory* Directory = Index.Find(Path);
-			if (Directory != NULL)
+			// Split the filename into its directory and its name.
+			int32 DirectoryLen = FilenameLen;
+			while (DirectoryLen > 0 && Filename[DirectoryLen - 1] != '/')
 			{
-				Directory->Add(Filename, &Files.Last());	
+				DirectoryLen--;
 			}
-			else
-			{
-				FPakDirectory NewDirectory;
-				NewDirectory.Add(Filename, &Files.Last());
-				Index.Add(Path, NewDirectory);
+			const int32 DirectoryIndex = FindOrAddDirectory(Filename.GetData(), DirectoryLen);
+			const uint64 Hash = HashPath(Filename.GetData() + DirectoryLen, FilenameLen - DirectoryLen, Directories[DirectoryIndex].Hash);
 
-				// add the parent directories up to the mount point
-				while (MountPoint != Path)
-				{
-					Path = Path.Left(Path.Len()-1);
-					int32 Offset = 0;
-					if (Path.FindLastChar('/', Offset))
-					{
-						Path = Path.Left(Offset);
-						MakeDirectoryFromPath(Path);
-						if (Index.Find(Path) == NULL)
-						{
-							FPakDirectory ParentDirectory;
-							Index.Add(Path, ParentDirectory);
-						}
-					}
-					else
-					{
-						Path = MountPoint;
-					}
-				}
+			const int32 ExistingFileIndex = FileHashes.FindOrAdd(Hash, Files.Num(), [this, &Filename, FilenameLen, DirectoryIndex, DirectoryLen](int32 FileIndex)
+			{
+				return IndexFiles[FileIndex].DirectoryIndex == DirectoryIndex && !FCString::Stricmp(&Names[IndexFiles[FileIndex].NameOffset], Filename.GetData() + DirectoryLen);
+			});
+			if (ExistingFileIndex != INDEX_NONE)
+			{
+				// The same file twice, the last one wins.
+				Files[ExistingFileIndex] = Entry;
+				continue;
 			}
+
+			// Add new file info.
+			Files.Add(Entry);
+			FPakIndexFile& IndexFile = IndexFiles[IndexFiles.AddUninitialized()];
+			IndexFile.DirectoryIndex = DirectoryIndex;
+			IndexFile.NameOffset = Names.Num();
+			Names.Append(Filename.GetData() + DirectoryLen, FilenameLen - DirectoryLen + 1);
+		}
+
+		// Group the files by directory, listing a directory then only looks at the files in it.
+		for (const FPakIndexFile& IndexFile : IndexFiles)
+		{
+			Directories[IndexFile.DirectoryIndex].NumFiles++;
+		}
+		int32 FirstFile = 0;
+		for (FPakIndexDirectory& Directory : Directories)
+		{
+			Directory.FirstFile = FirstFile;
+			FirstFile += Directory.NumFiles;
+			Directory.NumFiles = 0;
 		}
+		DirectoryFiles.Empty(IndexFiles.Num());
+		DirectoryFiles.AddUninitialized(IndexFiles.Num());
+		for (int32 FileIndex = 0; FileIndex < IndexFiles.Num(); FileIndex++)
+		{
+			FPakIndexDirectory& Directory = Directories[IndexFiles[FileIndex].DirectoryIndex];
+			DirectoryFiles[Directory.FirstFile + Directory.NumFiles++] = FileIndex;
+		}
+
+		Names.Shrink();
+		Directories.Shrink();
 	}
 }
 
+int32 FPakFile::FindOrAddDirectory(const TCHAR* Path, int32 Len)
+{
+	const uint64 Hash = HashPath(Path, Len);
+	const int32 NewDirectoryIndex = Directories.Num();
+	const int32 ExistingDirectoryIndex = DirectoryHashes.FindOrAdd(Hash, NewDirectoryIndex, [this, Path, Len](int32 DirectoryIndex)
+	{
+		const FPakIndexDirectory& Directory = Directories[DirectoryIndex];
+		return Directory.NameLen == Len && !FCString::Strnicmp(&Names[Directory.NameOffset], Path, Len);
+	});
+	if (ExistingDirectoryIndex != INDEX_NONE)
+	{
+		return ExistingDirectoryIndex;
+	}
+
+	FPakIndexDirectory& Directory = Directories[Directories.AddUninitialized()];
+	Directory.Hash = Hash;
+	Directory.NameOffset = Names.Num();
+	Directory.NameLen = Len;
+	Directory.FirstFile = 0;
+	Directory.NumFiles = 0;
+	Names.Append(Path, Len);
+	Names.Add(0);
+
+	// add the parent directories up to the mount point
+	int32 ParentLen = Len - 1;
+	while (ParentLen > 0 && Path[ParentLen - 1] != '/')
+	{
+		ParentLen--;
+	}
+	if (ParentLen > 0)
+	{
+		FindOrAddDirectory(Path, ParentLen);
+	}
+
+	return NewDirectoryIndex;
+}
+
+int32 FPakFile::FindFileIndex(const TCHAR* Path, int32 Len) const
+{
+	return FileHashes.Find(HashPath(Path, Len), [this, Path, Len](int32 FileIndex)
+	{
+		const FPakIndexFile& File = IndexFiles[FileIndex];
+		const FPakIndexDirectory& Directory = Directories[File.DirectoryIndex];
+		return Directory.NameLen <= Len
+			&& !FCString::Strnicmp(&Names[Directory.NameOffset], Path, Directory.NameLen)
+			&& !FCString::Strnicmp(&Names[File.NameOffset], Path + Directory.NameLen, Len - Directory.NameLen)
+			&& Names[File.NameOffset + Len - Directory.NameLen] == 0;
+	});
+}
+
+int32 FPakFile::FindDirectoryIndex(const TCHAR* Path, int32 Len) const
+{
+	return DirectoryHashes.Find(HashPath(Path, Len), [this, Path, Len](int32 DirectoryIndex)
+	{
+		const FPakIndexDirectory& Directory = Directories[DirectoryIndex];
+		return Directory.NameLen == Len && !FCString::Strnicmp(&Names[Directory.NameOffset], Path, Len);
+	});
+}
+
+SIZE_T FPakFile::GetIndexAllocatedSize() const
+{
+	return Files.GetAllocatedSize() + IndexFiles.GetAllocatedSize() + Directories.GetAllocatedSize() + DirectoryFiles.GetAllocatedSize()
+		+ Names.GetAllocatedSize() + FileHashes.GetAllocatedSize() + DirectoryHashes.GetAllocatedSize();
+}
+
 FArchive* FPakFile::GetSharedReader(IPlatformFile* LowerLevel)
 {
 	uint32 Thread = FPlatformTLS::GetCurrentThreadId();
@@ -840,6 +752,89 @@ IFileHandle* FPakPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
 	return Result;
 }
 
+/**
+ * Maps a file stored uncompressed and unencrypted in a pak file, by mapping the part of the pak file it is stored in.
+ */
+class FPakMappedFileHandle : public IMappedFileHandle
+{
+	/** The whole pak file, mapped by the lower level platform file. */
+	IMappedFileHandle* PakHandle;
+	/** Offset of the file's data in the pak file. */
+	int64 OffsetInPak;
+
+public:
+	FPakMappedFileHandle(IMappedFileHandle* InPakHandle, int64 InOffsetInPak, int64 InFileSize)
+		: IMappedFileHandle(InFileSize)
+		, PakHandle(InPakHandle)
+		, OffsetInPak(InOffsetInPak)
+	{
+	}
+
+	virtual ~FPakMappedFileHandle()
+	{
+		delete PakHandle;
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) override
+	{
+		check(Offset >= 0 && Offset <= GetFileSize());
+		return PakHandle->MapRegion(OffsetInPak + Offset, FMath::Min<int64>(BytesToMap, GetFileSize() - Offset));
+	}
+};
+
+IMappedFileHandle* FPakPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	FPakFile* PakFile = NULL;
+	const FPakEntry* FileEntry = FindFileInPakFiles(Filename, &PakFile);
+	if (FileEntry == NULL)
+	{
+#if !USING_SIGNED_CONTENT
+		if (!bSigned)
+		{
+			return LowerLevel->OpenMapped(Filename);
+		}
+#endif
+		return NULL;
+	}
+
+	// Only files that are stored as they are can be mapped, and signed pak files have to be read through the signature checks.
+	if (bSigned || FileEntry->CompressionMethod != COMPRESS_None || FileEntry->bEncrypted)
+	{
+		return NULL;
+	}
+
+	IMappedFileHandle* PakHandle = LowerLevel->OpenMapped(*PakFile->GetFilename());
+	if (PakHandle == NULL)
+	{
+		return NULL;
+	}
+
+	const int32 Version = PakFile->GetInfo().Version;
+	const int64 HeaderSize = FileEntry->GetSerializedSize(Version);
+
+	// Check that the file header is OK, like FPakFileHandle does before its first read.
+	if (!FileEntry->Verified)
+	{
+		IMappedFileRegion* HeaderRegion = PakHandle->MapRegion(FileEntry->Offset, HeaderSize);
+		if (HeaderRegion != NULL && HeaderRegion->GetMappedSize() == HeaderSize)
+		{
+			FPakEntry FileHeader;
+			FBufferReader HeaderReader((void*)HeaderRegion->GetMappedPtr(), HeaderSize, false);
+			FileHeader.Serialize(HeaderReader, Version);
+			FileEntry->Verified = FPakEntry::VerifyPakEntriesMatch(*FileEntry, FileHeader);
+		}
+		delete HeaderRegion;
+
+		if (!FileEntry->Verified)
+		{
+			delete PakHandle;
+			return NULL;
+		}
+	}
+
+	return new FPakMappedFileHandle(PakHandle, FileEntry->Offset + HeaderSize, FileEntry->UncompressedSize);
+}
+
 bool FPakPlatformFile::BufferedCopyFile(IFileHandle& Dest, IFileHandle& Source, const int64 FileSize, uint8* Buffer, const int64 BufferSize) const
 {	
 	int64 RemainingSizeToCopy = FileSize;
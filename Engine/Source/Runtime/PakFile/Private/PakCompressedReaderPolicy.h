@@ -0,0 +1,351 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AES.h"
+
+/**
+ * Class to handle correctly reading from a compressed file within a compressed package
+ */
+class FPakSimpleEncryption
+{
+public:
+	enum
+	{
+		Alignment = FAES::AESBlockSize,
+	};
+
+	static FORCEINLINE int64 AlignReadRequest(int64 Size) 
+	{
+		return Align(Size, Alignment);
+	}
+
+	static FORCEINLINE void DecryptBlock(void* Data, int64 Size)
+	{
+#ifdef AES_KEY
+		FAES::DecryptData((uint8*)Data, Size);
+#endif
+	}
+};
+
+/**
+ * Thread local class to manage working buffers for file compression
+ */
+class FCompressionScratchBuffers : public TThreadSingleton<FCompressionScratchBuffers>
+{
+public:
+	FCompressionScratchBuffers()
+		: ScratchBufferSize(0)
+	{}
+
+	int64				ScratchBufferSize;
+	TAutoPtr<uint8>		ScratchBuffer;
+
+	void EnsureBufferSpace(int64 ScrachSize)
+	{
+		if(ScratchBufferSize < ScrachSize)
+		{
+			ScratchBufferSize = ScrachSize;
+			ScratchBuffer.Reset((uint8*)FMemory::Malloc(ScratchBufferSize));
+		}
+	}
+};
+
+/**
+ * Class to handle correctly reading from a compressed file within a pak.
+ *
+ * The blocks a read needs are decompressed in parallel, the last one on the reading thread and the others on the thread pool.
+ * Blocks that are only partially read are kept in a small cache, and once reads look sequential the next few blocks are read
+ * and decompressed in the background so they're ready by the time they're asked for.
+ */
+template< typename EncryptionPolicy = FPakNoEncryption >
+class FPakCompressedReaderPolicy
+{
+public:
+	class FPakUncompressTask : public FNonAbandonableTask
+	{
+	public:
+		uint8*				UncompressedBuffer;
+		int32				UncompressedSize;
+		uint8*				CompressedBuffer;
+		int32				CompressedSize;
+		ECompressionFlags	Flags;
+
+		void DoWork()
+		{
+			// Decrypt and Uncompress from memory to memory.
+			int64 EncryptionSize = EncryptionPolicy::AlignReadRequest(CompressedSize);
+			EncryptionPolicy::DecryptBlock(CompressedBuffer, EncryptionSize);
+			FCompression::UncompressMemory(Flags, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize, false);
+		}
+
+		FORCEINLINE TStatId GetStatId() const
+		{
+			// TODO: This is called too early in engine startup.
+			return TStatId();
+			//RETURN_QUICK_DECLARE_CYCLE_STAT(FPakUncompressTask, STATGROUP_ThreadPoolAsyncTasks);
+		}
+	};
+
+	enum
+	{
+		/** Most blocks decompressed at once by a single read */
+		MaxBlocksInFlight = 16,
+		/** Blocks read and decompressed ahead of a sequential reader */
+		ReadAheadBlocks = 4,
+		/** Room for the read ahead blocks and the partially read blocks at both ends of a read */
+		MaxCachedBlocks = ReadAheadBlocks + 2,
+	};
+
+	FPakCompressedReaderPolicy(const FPakFile& InPakFile, const FPakEntry& InPakEntry, FArchive* InPakReader)
+		: PakFile(InPakFile)
+		, PakEntry(InPakEntry)
+		, PakReader(InPakReader)
+		, NextSequentialPosition(0)
+		, UseCounter(0)
+	{
+	}
+
+	~FPakCompressedReaderPolicy()
+	{
+		// Read ahead blocks may still be decompressing into the cache
+		for (FCachedBlock& Cached : CachedBlocks)
+		{
+			WaitForBlock(Cached);
+		}
+	}
+
+	/** Pak file that own this file data */
+	const FPakFile&		PakFile;
+	/** Pak file entry for this file. */
+	const FPakEntry&	PakEntry;
+	/** Pak file archive to read the data from. */
+	FArchive*			PakReader;
+
+	FORCEINLINE int64 FileSize() const
+	{
+		return PakEntry.UncompressedSize;
+	}
+
+	void Serialize(int64 DesiredPosition, void* V, int64 Length)
+	{
+		const int64 CompressionBlockSize = PakEntry.CompressionBlockSize;
+		const int64 EndPosition = DesiredPosition + Length;
+		const bool bSequential = DesiredPosition == NextSequentialPosition;
+		NextSequentialPosition = EndPosition;
+
+		int32 CompressionBlockIndex = DesiredPosition / CompressionBlockSize;
+		int64 DirectCopyStart = DesiredPosition % CompressionBlockSize;
+
+		while (Length > 0)
+		{
+			int64 UncompressedBlockSize = GetUncompressedBlockSize(CompressionBlockIndex);
+			int64 WriteSize = FMath::Min<int64>(UncompressedBlockSize - DirectCopyStart, Length);
+
+			// Partially read before, or read ahead
+			if (FCachedBlock* Cached = FindCachedBlock(CompressionBlockIndex))
+			{
+				WaitForBlock(*Cached);
+				FMemory::Memcpy(V, Cached->UncompressedData.GetData() + DirectCopyStart, WriteSize);
+				V = (void*)((uint8*)V + WriteSize);
+				Length -= WriteSize;
+				DirectCopyStart = 0;
+				++CompressionBlockIndex;
+			}
+			else
+			{
+				// Decompress the consecutive blocks that aren't cached all at once, into the output buffer where they're read
+				// completely and into the cache where they're not.
+				const int32 MaxBlocks = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, (int32)MaxBlocksInFlight);
+				const int64 WorkingBufferRequiredSize = GetWorkingBufferRequiredSize();
+				FCompressionScratchBuffers& ScratchSpace = FCompressionScratchBuffers::Get();
+				ScratchSpace.EnsureBufferSpace(WorkingBufferRequiredSize * MaxBlocks);
+
+				FAsyncTask<FPakUncompressTask> DirectTasks[MaxBlocksInFlight];
+				FAsyncTask<FPakUncompressTask>* Tasks[MaxBlocksInFlight];
+				FCachedBlock* CopyFrom[MaxBlocksInFlight];
+				void* CopyOut[MaxBlocksInFlight];
+				int64 CopyOffsets[MaxBlocksInFlight];
+				int64 CopyLengths[MaxBlocksInFlight];
+				int32 NumBlocks = 0;
+				do
+				{
+					if (DirectCopyStart == 0 && WriteSize == UncompressedBlockSize)
+					{
+						// Block can be decompressed directly into output buffer
+						const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[CompressionBlockIndex];
+						uint8* CompressedBuffer = ScratchSpace.ScratchBuffer + NumBlocks * WorkingBufferRequiredSize;
+						ReadCompressedBlock(CompressionBlockIndex, CompressedBuffer);
+
+						FPakUncompressTask& TaskDetails = DirectTasks[NumBlocks].GetTask();
+						TaskDetails.Flags = (ECompressionFlags)PakEntry.CompressionMethod;
+						TaskDetails.UncompressedBuffer = (uint8*)V;
+						TaskDetails.UncompressedSize = UncompressedBlockSize;
+						TaskDetails.CompressedBuffer = CompressedBuffer;
+						TaskDetails.CompressedSize = Block.CompressedEnd - Block.CompressedStart;
+						Tasks[NumBlocks] = &DirectTasks[NumBlocks];
+						CopyFrom[NumBlocks] = nullptr;
+					}
+					else
+					{
+						// Block needs to be copied from a working buffer
+						FCachedBlock& Cached = AddCachedBlock(CompressionBlockIndex);
+						Tasks[NumBlocks] = &Cached.Task;
+						CopyFrom[NumBlocks] = &Cached;
+						CopyOut[NumBlocks] = V;
+						CopyOffsets[NumBlocks] = DirectCopyStart;
+						CopyLengths[NumBlocks] = WriteSize;
+					}
+					NumBlocks++;
+
+					V = (void*)((uint8*)V + WriteSize);
+					Length -= WriteSize;
+					DirectCopyStart = 0;
+					++CompressionBlockIndex;
+					if (Length > 0)
+					{
+						UncompressedBlockSize = GetUncompressedBlockSize(CompressionBlockIndex);
+						WriteSize = FMath::Min<int64>(UncompressedBlockSize, Length);
+					}
+				}
+				while (Length > 0 && NumBlocks < MaxBlocks && !FindCachedBlock(CompressionBlockIndex));
+
+				// The reading thread decompresses the last block itself instead of only waiting
+				for (int32 Index = 0; Index < NumBlocks - 1; Index++)
+				{
+					Tasks[Index]->StartBackgroundTask();
+				}
+				Tasks[NumBlocks - 1]->StartSynchronousTask();
+
+				for (int32 Index = 0; Index < NumBlocks; Index++)
+				{
+					Tasks[Index]->EnsureCompletion();
+					if (CopyFrom[Index])
+					{
+						FMemory::Memcpy(CopyOut[Index], CopyFrom[Index]->UncompressedData.GetData() + CopyOffsets[Index], CopyLengths[Index]);
+					}
+				}
+			}
+		}
+
+		if (bSequential && FPlatformProcess::SupportsMultithreading() && GThreadPool)
+		{
+			ReadAhead(EndPosition / CompressionBlockSize);
+		}
+	}
+
+private:
+
+	/** A decompressed block kept for the next reads, or one still being decompressed in the background. */
+	struct FCachedBlock
+	{
+		/** Index of the block in the entry, INDEX_NONE if the slot is empty */
+		int32 BlockIndex;
+		/** Value of UseCounter when the block was last needed, the least recently used block is replaced first */
+		uint32 LastUsed;
+		/** Compressed data, it has to stay around until the task is done with it */
+		TArray<uint8> CompressedData;
+		TArray<uint8> UncompressedData;
+		FAsyncTask<FPakUncompressTask> Task;
+
+		FCachedBlock()
+			: BlockIndex(INDEX_NONE)
+			, LastUsed(0)
+		{
+		}
+	};
+
+	int64 GetUncompressedBlockSize(int32 BlockIndex) const
+	{
+		return FMath::Min<int64>(PakEntry.UncompressedSize - (int64)BlockIndex * PakEntry.CompressionBlockSize, PakEntry.CompressionBlockSize);
+	}
+
+	int64 GetWorkingBufferRequiredSize() const
+	{
+		return EncryptionPolicy::AlignReadRequest(FCompression::CompressMemoryBound((ECompressionFlags)PakEntry.CompressionMethod, PakEntry.CompressionBlockSize));
+	}
+
+	/** Reads a block's compressed data, padded for decryption, into Buffer. */
+	void ReadCompressedBlock(int32 BlockIndex, uint8* Buffer)
+	{
+		const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+		PakReader->Seek(Block.CompressedStart);
+		PakReader->Serialize(Buffer, EncryptionPolicy::AlignReadRequest(Block.CompressedEnd - Block.CompressedStart));
+	}
+
+	FCachedBlock* FindCachedBlock(int32 BlockIndex)
+	{
+		for (FCachedBlock& Cached : CachedBlocks)
+		{
+			if (Cached.BlockIndex == BlockIndex)
+			{
+				Cached.LastUsed = ++UseCounter;
+				return &Cached;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Replaces the least recently used cached block with a new one and reads its compressed data, the caller starts its task.
+	 * The block returned last is always the most recently used one, so it isn't replaced by the next call.
+	 */
+	FCachedBlock& AddCachedBlock(int32 BlockIndex)
+	{
+		FCachedBlock* Oldest = &CachedBlocks[0];
+		for (FCachedBlock& Cached : CachedBlocks)
+		{
+			if (Cached.LastUsed < Oldest->LastUsed)
+			{
+				Oldest = &Cached;
+			}
+		}
+		WaitForBlock(*Oldest);
+
+		const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+		Oldest->BlockIndex = BlockIndex;
+		Oldest->LastUsed = ++UseCounter;
+		Oldest->CompressedData.SetNumUninitialized(GetWorkingBufferRequiredSize());
+		Oldest->UncompressedData.SetNumUninitialized(GetUncompressedBlockSize(BlockIndex));
+		ReadCompressedBlock(BlockIndex, Oldest->CompressedData.GetData());
+
+		FPakUncompressTask& TaskDetails = Oldest->Task.GetTask();
+		TaskDetails.Flags = (ECompressionFlags)PakEntry.CompressionMethod;
+		TaskDetails.UncompressedBuffer = Oldest->UncompressedData.GetData();
+		TaskDetails.UncompressedSize = GetUncompressedBlockSize(BlockIndex);
+		TaskDetails.CompressedBuffer = Oldest->CompressedData.GetData();
+		TaskDetails.CompressedSize = Block.CompressedEnd - Block.CompressedStart;
+		return *Oldest;
+	}
+
+	/** Waits for a block that may still be decompressing in the background, decompresses it here if no worker picked it up yet. */
+	static void WaitForBlock(FCachedBlock& Cached)
+	{
+		if (!Cached.Task.IsIdle())
+		{
+			Cached.Task.EnsureCompletion();
+		}
+	}
+
+	/**
+	 * Reads the blocks following a sequential read and starts decompressing them in the background. The reads happen here
+	 * since the pak reader belongs to this thread.
+	 */
+	void ReadAhead(int32 FirstBlockIndex)
+	{
+		const int32 EndBlockIndex = FMath::Min<int32>(FirstBlockIndex + ReadAheadBlocks, PakEntry.CompressionBlocks.Num());
+		for (int32 BlockIndex = FirstBlockIndex; BlockIndex < EndBlockIndex; BlockIndex++)
+		{
+			if (!FindCachedBlock(BlockIndex))
+			{
+				AddCachedBlock(BlockIndex).Task.StartBackgroundTask();
+			}
+		}
+	}
+
+	/** Where the read following a sequential read starts */
+	int64 NextSequentialPosition;
+	/** Incremented every time a cached block is used */
+	uint32 UseCounter;
+	FCachedBlock CachedBlocks[MaxCachedBlocks];
+};
@@ -0,0 +1,164 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PakFilePrivatePCH.h"
+#include "IPlatformFilePak.h"
+#include "../PakCompressedReaderPolicy.h"
+#include "SecureHash.h"
+#include "AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPakCompressedReadTest, "System.Engine.PakFile.Compressed Read", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace PakCompressedReadTest
+{
+	const TCHAR* MountPoint = TEXT("../../../");
+	const TCHAR* Filename = TEXT("Game/Content/Compressed.bin");
+
+	const int32 CompressionBlockSize = 4096;
+	/** Ten full blocks and a short last one */
+	const int32 FileSize = 10 * CompressionBlockSize + 1234;
+
+	/** Writes a pak with a single zlib compressed entry holding Data, laid out the way UnrealPak lays it out. */
+	void WriteCompressedPak(const TArray<uint8>& Data, TArray<uint8>& PakData)
+	{
+		FPakEntry Entry;
+		Entry.Offset = 0;
+		Entry.UncompressedSize = Data.Num();
+		Entry.CompressionMethod = COMPRESS_ZLIB;
+		Entry.CompressionBlockSize = CompressionBlockSize;
+		FSHA1::HashBuffer(Data.GetData(), Data.Num(), Entry.Hash);
+
+		TArray<TArray<uint8>> CompressedBlocks;
+		for (int32 BlockStart = 0; BlockStart < Data.Num(); BlockStart += CompressionBlockSize)
+		{
+			const int32 UncompressedSize = FMath::Min(CompressionBlockSize, Data.Num() - BlockStart);
+			TArray<uint8>& CompressedBlock = CompressedBlocks[CompressedBlocks.AddDefaulted()];
+			int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, UncompressedSize);
+			CompressedBlock.SetNumUninitialized(CompressedSize);
+			verify(FCompression::CompressMemory(COMPRESS_ZLIB, CompressedBlock.GetData(), CompressedSize, Data.GetData() + BlockStart, UncompressedSize));
+			CompressedBlock.SetNum(CompressedSize);
+		}
+
+		// Block offsets are absolute and the blocks follow the entry's header
+		Entry.CompressionBlocks.SetNum(CompressedBlocks.Num());
+		int64 CompressedStart = Entry.GetSerializedSize(FPakInfo::PakFile_Version_Latest);
+		for (int32 BlockIndex = 0; BlockIndex < CompressedBlocks.Num(); BlockIndex++)
+		{
+			Entry.CompressionBlocks[BlockIndex].CompressedStart = CompressedStart;
+			Entry.CompressionBlocks[BlockIndex].CompressedEnd = CompressedStart + CompressedBlocks[BlockIndex].Num();
+			CompressedStart += CompressedBlocks[BlockIndex].Num();
+		}
+		Entry.Size = CompressedStart - Entry.GetSerializedSize(FPakInfo::PakFile_Version_Latest);
+
+		FMemoryWriter PakWriter(PakData);
+		Entry.Serialize(PakWriter, FPakInfo::PakFile_Version_Latest);
+		for (TArray<uint8>& CompressedBlock : CompressedBlocks)
+		{
+			PakWriter.Serialize(CompressedBlock.GetData(), CompressedBlock.Num());
+		}
+
+		TArray<uint8> IndexData;
+		FMemoryWriter IndexWriter(IndexData);
+		FString IndexMountPoint(MountPoint);
+		FString IndexFilename(Filename);
+		int32 NumEntries = 1;
+		IndexWriter << IndexMountPoint << NumEntries << IndexFilename;
+		Entry.Serialize(IndexWriter, FPakInfo::PakFile_Version_Latest);
+
+		FPakInfo Info;
+		Info.IndexOffset = PakData.Num();
+		Info.IndexSize = IndexData.Num();
+		FSHA1::HashBuffer(IndexData.GetData(), IndexData.Num(), Info.IndexHash);
+
+		PakWriter.Serialize(IndexData.GetData(), IndexData.Num());
+		Info.Serialize(PakWriter);
+	}
+
+	/** Reads Size bytes at Offset through Handle and checks them against the source data */
+	bool ReadMatches(IFileHandle& Handle, const TArray<uint8>& Data, int64 Offset, int64 Size)
+	{
+		TArray<uint8> ReadData;
+		ReadData.SetNumUninitialized(Size);
+		return Handle.Seek(Offset) && Handle.Read(ReadData.GetData(), Size) && FMemory::Memcmp(ReadData.GetData(), Data.GetData() + Offset, Size) == 0;
+	}
+}
+
+
+/**
+ * Reads a compressed pak entry whole, at unaligned offsets that start and end inside blocks, and sequentially in chunks that
+ * straddle block boundaries so blocks are read ahead, and checks every read against the data that went into the pak.
+ */
+bool FPakCompressedReadTest::RunTest(const FString& Parameters)
+{
+	using namespace PakCompressedReadTest;
+
+	// Compressible, but not so much that a mix up between blocks could go unnoticed
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(FileSize);
+	FRandomStream Random(0x9a4);
+	for (int32 Index = 0; Index < FileSize; Index++)
+	{
+		Data[Index] = (Index % 64 < 32) ? (uint8)(Index / CompressionBlockSize) : (uint8)Random.RandHelper(16);
+	}
+
+	TArray<uint8> PakData;
+	WriteCompressedPak(Data, PakData);
+
+	FMemoryReader PakReader(PakData);
+	FPakFile PakFile(&PakReader);
+	const FPakEntry* Entry = PakFile.Find(FString(MountPoint) + Filename);
+	TestNotNull(TEXT("Compressed entry is in the pak"), Entry);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	typedef FPakFileHandle< FPakCompressedReaderPolicy<> > FCompressedHandle;
+
+	// Whole file, every block goes straight to the output
+	{
+		FCompressedHandle Handle(PakFile, *Entry, &PakReader, true);
+		TestEqual(TEXT("Uncompressed size"), Handle.Size(), (int64)FileSize);
+		TestTrue(TEXT("Whole file"), ReadMatches(Handle, Data, 0, FileSize));
+	}
+
+	// Unaligned reads, the blocks at both ends are only partially read and go through the cache
+	{
+		FCompressedHandle Handle(PakFile, *Entry, &PakReader, true);
+		const int64 Offsets[] = { 1, CompressionBlockSize - 1, CompressionBlockSize + 100, 3 * CompressionBlockSize + 7, FileSize - 1000, FileSize - 1 };
+		const int64 Sizes[] = { 1, 100, CompressionBlockSize, 2 * CompressionBlockSize + 3, 5 * CompressionBlockSize };
+		for (int64 Offset : Offsets)
+		{
+			for (int64 Size : Sizes)
+			{
+				const int64 ClampedSize = FMath::Min(Size, FileSize - Offset);
+				TestTrue(*FString::Printf(TEXT("%lld bytes at %lld"), ClampedSize, Offset), ReadMatches(Handle, Data, Offset, ClampedSize));
+			}
+		}
+
+		for (int32 Index = 0; Index < 200; Index++)
+		{
+			const int64 Offset = Random.RandHelper(FileSize);
+			const int64 Size = Random.RandRange(1, FileSize - (int32)Offset);
+			TestTrue(*FString::Printf(TEXT("Random read of %lld bytes at %lld"), Size, Offset), ReadMatches(Handle, Data, Offset, Size));
+		}
+	}
+
+	// Sequential reads across block boundaries, the blocks after each read are read ahead
+	const int64 ChunkSizes[] = { 1000, CompressionBlockSize - 1, CompressionBlockSize + 1, 3 * CompressionBlockSize / 2 };
+	for (int64 ChunkSize : ChunkSizes)
+	{
+		FCompressedHandle Handle(PakFile, *Entry, &PakReader, true);
+		for (int64 Offset = 0; Offset < FileSize; Offset += ChunkSize)
+		{
+			const int64 Size = FMath::Min(ChunkSize, FileSize - Offset);
+			TestTrue(*FString::Printf(TEXT("Sequential read of %lld bytes at %lld"), Size, Offset), ReadMatches(Handle, Data, Offset, Size));
+		}
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,146 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "PakFilePrivatePCH.h"
+#include "IPlatformFilePak.h"
+#include "SecureHash.h"
+#include "AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPakIndexBenchmarkTest, "System.Engine.PakFile.Index Mount And Lookup", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace PakIndexBenchmarkTest
+{
+	/** Files in the synthetic pak, about what a large game's content pak has */
+	const int32 NumFiles = 500000;
+
+	/** 20 top level directories with 500 directories of 50 files each */
+	const int32 FilesPerDirectory = 50;
+	const int32 DirectoriesPerTopLevelDirectory = 500;
+
+	const TCHAR* MountPoint = TEXT("../../../");
+
+	/** @return the name of a file in the synthetic pak, relative to its mount point */
+	FString GetRelativeFilename(int32 Index)
+	{
+		const int32 DirectoryIndex = Index / FilesPerDirectory;
+		return FString::Printf(TEXT("Game/Content/Region%02d/Area%03d/Asset_%06d.uasset"), DirectoryIndex / DirectoriesPerTopLevelDirectory, DirectoryIndex % DirectoriesPerTopLevelDirectory, Index);
+	}
+
+	/** Writes a pak that only has an index and a trailer, the entries point at made up offsets. */
+	void WriteSyntheticPak(TArray<uint8>& PakData)
+	{
+		TArray<uint8> IndexData;
+		FMemoryWriter IndexWriter(IndexData);
+		FString IndexMountPoint(MountPoint);
+		int32 NumEntries = NumFiles;
+		IndexWriter << IndexMountPoint;
+		IndexWriter << NumEntries;
+		for (int32 Index = 0; Index < NumFiles; Index++)
+		{
+			FString Filename = GetRelativeFilename(Index);
+			FPakEntry Entry;
+			Entry.Offset = Index;
+			Entry.Size = Index;
+			Entry.UncompressedSize = Index;
+			IndexWriter << Filename;
+			Entry.Serialize(IndexWriter, FPakInfo::PakFile_Version_Latest);
+		}
+
+		FPakInfo Info;
+		Info.IndexOffset = 0;
+		Info.IndexSize = IndexData.Num();
+		FSHA1::HashBuffer(IndexData.GetData(), IndexData.Num(), Info.IndexHash);
+
+		FMemoryWriter PakWriter(PakData);
+		PakWriter.Serialize(IndexData.GetData(), IndexData.Num());
+		Info.Serialize(PakWriter);
+	}
+}
+
+
+/**
+ * Mounts a synthetic pak with 500k files and looks up every one of them, reports how long that takes and how much memory
+ * the index uses. Also checks that lookups ignore case, that misses miss, and that directories list the right files.
+ */
+bool FPakIndexBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace PakIndexBenchmarkTest;
+
+	TArray<uint8> PakData;
+	WriteSyntheticPak(PakData);
+
+	TArray<FString> Filenames;
+	Filenames.Reserve(NumFiles);
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		Filenames.Add(FString(MountPoint) + GetRelativeFilename(Index));
+	}
+
+	FMemoryReader PakReader(PakData);
+	const double MountStartTime = FPlatformTime::Seconds();
+	FPakFile* PakFile = new FPakFile(&PakReader);
+	const double MountTime = FPlatformTime::Seconds() - MountStartTime;
+	TestTrue(TEXT("Synthetic pak is valid"), PakFile->IsValid());
+	if (!PakFile->IsValid())
+	{
+		delete PakFile;
+		return false;
+	}
+
+	const double FindStartTime = FPlatformTime::Seconds();
+	int32 NumWrongEntries = 0;
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		const FPakEntry* Entry = PakFile->Find(Filenames[Index]);
+		NumWrongEntries += (!Entry || Entry->Offset != Index) ? 1 : 0;
+	}
+	const double FindTime = FPlatformTime::Seconds() - FindStartTime;
+
+	const double MissStartTime = FPlatformTime::Seconds();
+	int32 NumFoundMisses = 0;
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		NumFoundMisses += PakFile->Find(Filenames[Index].Replace(TEXT(".uasset"), TEXT(".uexp"))) ? 1 : 0;
+	}
+	const double MissTime = FPlatformTime::Seconds() - MissStartTime;
+
+	AddLogItem(FString::Printf(TEXT("%d files: mount %.1fms, index %.1fMB, %.0fns per hit, %.0fns per miss (including building the missing name)"),
+		NumFiles, 1000.0 * MountTime, PakFile->GetIndexAllocatedSize() / (1024.0 * 1024.0), 1.0e9 * FindTime / NumFiles, 1.0e9 * MissTime / NumFiles));
+
+	TestEqual(TEXT("Files not found, or found with the wrong entry"), NumWrongEntries, 0);
+	TestEqual(TEXT("Files found that aren't in the pak"), NumFoundMisses, 0);
+
+	const FPakEntry* UpperCaseEntry = PakFile->Find(Filenames[1234].ToUpper());
+	TestTrue(TEXT("Lookups ignore case"), UpperCaseEntry && UpperCaseEntry->Offset == 1234);
+	TestEqual(TEXT("Entries know their filename"), FString(MountPoint) + PakFile->GetRelativeFilename(*PakFile->Find(Filenames[4321])), Filenames[4321]);
+
+	TestTrue(TEXT("Leaf directories exist"), PakFile->DirectoryExists(TEXT("../../../Game/Content/Region03/Area042")));
+	TestTrue(TEXT("Parent directories exist"), PakFile->DirectoryExists(TEXT("../../../Game/Content/")));
+	TestFalse(TEXT("Missing directories don't exist"), PakFile->DirectoryExists(TEXT("../../../Game/Content/Region03/Area999")));
+
+	TArray<FString> FilesInDirectory;
+	PakFile->FindFilesAtPath(FilesInDirectory, TEXT("../../../Game/Content/Region03/Area042/"));
+	const int32 FirstFileInDirectory = (3 * DirectoriesPerTopLevelDirectory + 42) * FilesPerDirectory;
+	TestEqual(TEXT("Files in a directory"), FilesInDirectory.Num(), FilesPerDirectory);
+	TestTrue(TEXT("Directory lists its files"), FilesInDirectory.Contains(Filenames[FirstFileInDirectory]) && FilesInDirectory.Contains(Filenames[FirstFileInDirectory + FilesPerDirectory - 1]));
+
+	TArray<FString> Subdirectories;
+	PakFile->FindFilesAtPath(Subdirectories, TEXT("../../../Game/Content/"), false, true);
+	TestEqual(TEXT("Directories in a directory"), Subdirectories.Num(), NumFiles / FilesPerDirectory / DirectoriesPerTopLevelDirectory);
+
+	const double IterateStartTime = FPlatformTime::Seconds();
+	int32 NumIterated = 0;
+	for (FPakFile::FFileIterator It(*PakFile); It; ++It)
+	{
+		NumIterated += It.Filename().Len() > 0 ? 1 : 0;
+	}
+	AddLogItem(FString::Printf(TEXT("Iterating all files with their names: %.1fms"), 1000.0 * (FPlatformTime::Seconds() - IterateStartTime)));
+	TestEqual(TEXT("Iterated files"), NumIterated, NumFiles);
+
+	delete PakFile;
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -242,8 +242,149 @@ struct FPakEntry
 	static bool VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEntry& FileEntryB);
 };
 
-/** Pak directory type. */
-typedef TMap<FString, FPakEntry*> FPakDirectory;
+/**
+ * Hash table from the hash of a path to an index in the pak index. It doesn't store the paths, the caller checks every
+ * candidate with the same hash against the path it is looking for, so two paths with the same hash don't get mixed up.
+ */
+class FPakPathHashTable
+{
+public:
+	FPakPathHashTable()
+		: HashMask(0)
+		, NumValues(0)
+	{
+	}
+
+	/**
+	 * Empties the table.
+	 *
+	 * @param ExpectedNum Number of values the table should have room for without growing.
+	 */
+	void Reset(int32 ExpectedNum)
+	{
+		const uint32 NumSlots = FMath::RoundUpToPowerOfTwo(FMath::Max(ExpectedNum * 2, 16));
+		Hashes.Empty(NumSlots);
+		Hashes.AddZeroed(NumSlots);
+		Values.Empty(NumSlots);
+		Values.AddUninitialized(NumSlots);
+		HashMask = NumSlots - 1;
+		NumValues = 0;
+	}
+
+	/**
+	 * Finds a value with the given hash.
+	 *
+	 * @param Hash Hash to look for.
+	 * @param IsMatch Called with every value that has the hash, returns true if it is the one the caller is looking for.
+	 * @return The value, INDEX_NONE if there is none.
+	 */
+	template <typename PredicateType>
+	int32 Find(uint64 Hash, PredicateType IsMatch) const
+	{
+		if (NumValues > 0)
+		{
+			Hash = FixHash(Hash);
+			for (uint32 Slot = (uint32)Hash & HashMask; Hashes[Slot] != 0; Slot = (Slot + 1) & HashMask)
+			{
+				if (Hashes[Slot] == Hash && IsMatch(Values[Slot]))
+				{
+					return Values[Slot];
+				}
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Adds a value unless the table already has a matching one.
+	 *
+	 * @param Hash Hash of the value.
+	 * @param Value Value to add.
+	 * @param IsMatch Called with every value that has the hash, returns true if it is the same as Value.
+	 * @return The value that was already there, INDEX_NONE if Value was added.
+	 */
+	template <typename PredicateType>
+	int32 FindOrAdd(uint64 Hash, int32 Value, PredicateType IsMatch)
+	{
+		const int32 ExistingValue = Find(Hash, IsMatch);
+		if (ExistingValue == INDEX_NONE)
+		{
+			if ((NumValues + 1) * 2 > Hashes.Num())
+			{
+				Grow();
+			}
+			AddUnchecked(FixHash(Hash), Value);
+		}
+		return ExistingValue;
+	}
+
+	/** @return the memory used by this table */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Hashes.GetAllocatedSize() + Values.GetAllocatedSize();
+	}
+
+private:
+	/** Zero marks an empty slot */
+	static uint64 FixHash(uint64 Hash)
+	{
+		return Hash ? Hash : 1;
+	}
+
+	void AddUnchecked(uint64 Hash, int32 Value)
+	{
+		uint32 Slot = (uint32)Hash & HashMask;
+		while (Hashes[Slot] != 0)
+		{
+			Slot = (Slot + 1) & HashMask;
+		}
+		Hashes[Slot] = Hash;
+		Values[Slot] = Value;
+		NumValues++;
+	}
+
+	void Grow()
+	{
+		TArray<uint64> OldHashes = MoveTemp(Hashes);
+		TArray<int32> OldValues = MoveTemp(Values);
+		Reset(FMath::Max(OldHashes.Num(), 16));
+		for (int32 Slot = 0; Slot < OldHashes.Num(); Slot++)
+		{
+			if (OldHashes[Slot] != 0)
+			{
+				AddUnchecked(OldHashes[Slot], OldValues[Slot]);
+			}
+		}
+	}
+
+	/** Open addressing with linear probing, a hash of zero is an empty slot. */
+	TArray<uint64> Hashes;
+	TArray<int32> Values;
+	uint32 HashMask;
+	int32 NumValues;
+};
+
+/** Directory in the pak index. */
+struct FPakIndexDirectory
+{
+	/** Hash of the path, the hashes of the files in the directory continue it with their names */
+	uint64 Hash;
+	/** Path relative to the mount point, ending with '/' unless it is the mount point itself, in the pak's name pool */
+	int32 NameOffset;
+	int32 NameLen;
+	/** Range of the pak's DirectoryFiles that lists the files directly in this directory */
+	int32 FirstFile;
+	int32 NumFiles;
+};
+
+/** Name of a file in the pak index. */
+struct FPakIndexFile
+{
+	/** Directory the file is in */
+	int32 DirectoryIndex;
+	/** File name without the directory, in the pak's name pool */
+	int32 NameOffset;
+};
 
 /**
  * Pak file.
@@ -264,8 +405,18 @@ class PAKFILE_API FPakFile : FNoncopyable
 	FString MountPoint;
 	/** Info on all files stored in pak. */
 	TArray<FPakEntry> Files;	
-	/** Pak Index organized as a map of directories for faster Directory iteration. */
-	TMap<FString, FPakDirectory> Index;
+	/** Name of every file, in the same order as Files. */
+	TArray<FPakIndexFile> IndexFiles;
+	/** All directories with files in them, and all of their parent directories up to the mount point. */
+	TArray<FPakIndexDirectory> Directories;
+	/** Indices of the files in each directory, grouped by directory. */
+	TArray<int32> DirectoryFiles;
+	/** Null terminated directory paths and file names. Full paths are only put together when they are asked for. */
+	TArray<TCHAR> Names;
+	/** Files, by the hash of their path relative to the mount point. */
+	FPakPathHashTable FileHashes;
+	/** Directories, by the hash of their path relative to the mount point. */
+	FPakPathHashTable DirectoryHashes;
 	/** Timestamp of this pak file. */
 	FDateTime Timestamp;	
 	/** True if this is a signed pak file. */
@@ -325,16 +476,6 @@ public:
 		return PakFilename;
 	}
 
-	/**
-	 * Gets pak file index.
-	 *
-	 * @return Pak index.
-	 */
-	const TMap<FString, FPakDirectory>& GetIndex() const
-	{
-		return Index;
-	}
-
 	/**
 	 * Gets shared pak file archive for given thread.
 	 *
@@ -350,18 +491,28 @@ public:
 	 */
 	const FPakEntry* Find(const FString& Filename) const
 	{		
-		const FPakEntry*const * FoundFile = NULL;
 		if (Filename.StartsWith(MountPoint))
 		{
-			FString Path(FPaths::GetPath(Filename));
-			const FPakDirectory* PakDirectory = FindDirectory(*Path);
-			if (PakDirectory != NULL)
+			const int32 FileIndex = FindFileIndex(*Filename + MountPoint.Len(), Filename.Len() - MountPoint.Len());
+			if (FileIndex != INDEX_NONE)
 			{
-				FString RelativeFilename(Filename.Mid(MountPoint.Len()));
-				FoundFile = PakDirectory->Find(RelativeFilename);
+				return &Files[FileIndex];
 			}
 		}
-		return FoundFile ? *FoundFile : NULL;
+		return NULL;
+	}
+
+	/**
+	 * Gets the name a file is stored under in the pak.
+	 *
+	 * @param Entry Entry of a file in this pak.
+	 * @return Filename relative to the mount point.
+	 */
+	FString GetRelativeFilename(const FPakEntry& Entry) const
+	{
+		const int32 FileIndex = (int32)(&Entry - Files.GetData());
+		check(Files.IsValidIndex(FileIndex));
+		return GetRelativeFilename(FileIndex);
 	}
 
 	/**
@@ -407,9 +558,9 @@ public:
 		if ((Directory.StartsWith(MountPoint)) || (MountPoint.StartsWith(Directory)))
 		{
 			TArray<FString> DirectoriesInPak; // List of all unique directories at path
-			for (TMap<FString, FPakDirectory>::TConstIterator It(Index); It; ++It)
+			for (const FPakIndexDirectory& PakDirectory : Directories)
 			{
-				FString PakPath(MountPoint + It.Key());
+				FString PakPath(MountPoint + &Names[PakDirectory.NameOffset]);
 				// Check if the file is under the specified path.
 				if (PakPath.StartsWith(Directory))
 				{				
@@ -418,10 +569,7 @@ public:
 						// Add everything
 						if (bIncludeFiles)
 						{
-							for (FPakDirectory::TConstIterator DirectoryIt(It.Value()); DirectoryIt; ++DirectoryIt)
-							{
-								OutFiles.Add(MountPoint + DirectoryIt.Key());
-							}
+							AddFilesInDirectory(OutFiles, PakPath, PakDirectory);
 						}
 						if (bIncludeDirectories)
 						{
@@ -437,10 +585,7 @@ public:
 						// Add files in the specified folder only.
 						if (bIncludeFiles && SubDirIndex == INDEX_NONE)
 						{
-							for (FPakDirectory::TConstIterator DirectoryIt(It.Value()); DirectoryIt; ++DirectoryIt)
-							{
-								OutFiles.Add(MountPoint + DirectoryIt.Key());
-							}
+							AddFilesInDirectory(OutFiles, PakPath, PakDirectory);
 						}
 						// Add sub-folders in the specified folder only
 						if (bIncludeDirectories && SubDirIndex >= 0)
@@ -455,34 +600,18 @@ public:
 	}
 
 	/**
-	 * Finds a directory in pak file.
+	 * Checks if a directory exists in pak file.
 	 *
 	 * @param InPath Directory path.
-	 * @return Pointer to a map with directory contents if the directory was found, NULL otherwise.
+	 * @return true if the given path exists in pak file, false otherwise.
 	 */
-	const FPakDirectory* FindDirectory(const TCHAR* InPath) const
+	bool DirectoryExists(const TCHAR* InPath) const
 	{
 		FString Directory(InPath);
 		MakeDirectoryFromPath(Directory);
-		const FPakDirectory* PakDirectory = NULL;
 
 		// Check the specified path is under the mount point of this pak file.
-		if (Directory.StartsWith(MountPoint))
-		{
-			PakDirectory = Index.Find(Directory.Mid(MountPoint.Len()));
-		}
-		return PakDirectory;
-	}
-
-	/**
-	 * Checks if a directory exists in pak file.
-	 *
-	 * @param InPath Directory path.
-	 * @return true if the given path exists in pak file, false otherwise.
-	 */
-	bool DirectoryExists(const TCHAR* InPath) const
-	{
-		return !!FindDirectory(InPath);
+		return Directory.StartsWith(MountPoint) && FindDirectoryIndex(*Directory + MountPoint.Len(), Directory.Len() - MountPoint.Len()) != INDEX_NONE;
 	}
 
 	/** Iterator class used to iterate over all files in pak. */
@@ -490,10 +619,8 @@ public:
 	{
 		/** Owner pak file. */
 		const FPakFile& PakFile;
-		/** Index iterator. */
-		TMap<FString, FPakDirectory>::TConstIterator IndexIt;
-		/** Directory iterator. */
-		FPakDirectory::TConstIterator DirectoryIt;
+		/** Index of the current file. */
+		int32 FileIndex;
 
 	public:
 		/**
@@ -503,27 +630,13 @@ public:
 		 */
 		FFileIterator(const FPakFile& InPakFile)
 		:	PakFile(InPakFile)
-		, IndexIt(PakFile.GetIndex())
-		, DirectoryIt((IndexIt ? FPakDirectory::TConstIterator(IndexIt.Value()): FPakDirectory()))
+		, FileIndex(0)
 		{
 		}
 
 		FFileIterator& operator++()		
 		{ 
-			// Continue with the next file
-			++DirectoryIt;
-			while (!DirectoryIt && IndexIt)
-			{
-				// No more files in the current directory, jump to the next one.
-				++IndexIt;
-				if (IndexIt)
-				{
-					// No need to check if there's files in the current directory. If a directory
-					// exists in the index it is always non-empty.
-					DirectoryIt.~TConstIterator();
-					new(&DirectoryIt) FPakDirectory::TConstIterator(IndexIt.Value());
-				}
-			}
+			++FileIndex;
 			return *this; 
 		}
 
@@ -531,7 +644,7 @@ public:
 		/** conversion to "bool" returning true if the iterator is valid. */
 		FORCEINLINE_EXPLICIT_OPERATOR_BOOL() const
 		{ 
-			return !!IndexIt; 
+			return FileIndex < PakFile.Files.Num(); 
 		}
 		/** inverse of the "bool" operator */
 		FORCEINLINE bool operator !() const
@@ -539,10 +652,35 @@ public:
 			return !(bool)*this;
 		}
 
-		const FString& Filename() const		{ return DirectoryIt.Key(); }
-		const FPakEntry& Info() const	{ return *DirectoryIt.Value(); }
+		/** Filename relative to the mount point, put together from the index on every call. */
+		FString Filename() const		{ return PakFile.GetRelativeFilename(FileIndex); }
+		const FPakEntry& Info() const	{ return PakFile.Files[FileIndex]; }
 	};
 
+	/**
+	 * Gets the memory used by the index of this pak, not counting the compression block tables of the entries.
+	 *
+	 * @return Size in bytes.
+	 */
+	SIZE_T GetIndexAllocatedSize() const;
+
+	/**
+	 * Hashes a path relative to the mount point the way the index does, ignoring case.
+	 *
+	 * @param Path Path to hash.
+	 * @param Len Number of characters in Path.
+	 * @param Hash Hash of a directory to hash a path inside of it, Path is then relative to that directory.
+	 * @return 64 bit FNV-1a hash.
+	 */
+	static uint64 HashPath(const TCHAR* Path, int32 Len, uint64 Hash = 0xcbf29ce484222325ull)
+	{
+		for (int32 Index = 0; Index < Len; Index++)
+		{
+			Hash = (Hash ^ (uint64)FChar::ToLower(Path[Index])) * 0x100000001b3ull;
+		}
+		return Hash;
+	}
+
 	/**
 	 * Gets this pak file info.
 	 *
@@ -575,6 +713,46 @@ private:
 	 */
 	void LoadIndex(FArchive* Reader);
 
+	/**
+	 * Adds a directory, and its parent directories up to the mount point, to the index.
+	 *
+	 * @param Path Path relative to the mount point, ending with '/'.
+	 * @param Len Number of characters in Path.
+	 * @return Index of the directory.
+	 */
+	int32 FindOrAddDirectory(const TCHAR* Path, int32 Len);
+
+	/**
+	 * @param Path Path relative to the mount point.
+	 * @param Len Number of characters in Path.
+	 * @return Index of the file in Files, INDEX_NONE if there is no such file.
+	 */
+	int32 FindFileIndex(const TCHAR* Path, int32 Len) const;
+
+	/**
+	 * @param Path Path relative to the mount point, ending with '/'.
+	 * @param Len Number of characters in Path.
+	 * @return Index of the directory in Directories, INDEX_NONE if there is no such directory.
+	 */
+	int32 FindDirectoryIndex(const TCHAR* Path, int32 Len) const;
+
+	/** @return the path of a file relative to the mount point */
+	FString GetRelativeFilename(int32 FileIndex) const
+	{
+		const FPakIndexFile& File = IndexFiles[FileIndex];
+		return FString(&Names[Directories[File.DirectoryIndex].NameOffset]) + &Names[File.NameOffset];
+	}
+
+	/** Adds the full path of every file directly in a directory. */
+	template <class ContainerType>
+	void AddFilesInDirectory(ContainerType& OutFiles, const FString& PakPath, const FPakIndexDirectory& PakDirectory) const
+	{
+		for (int32 Index = PakDirectory.FirstFile; Index < PakDirectory.FirstFile + PakDirectory.NumFiles; Index++)
+		{
+			OutFiles.Add(PakPath + &Names[IndexFiles[DirectoryFiles[Index]].NameOffset]);
+		}
+	}
+
 public:
 
 	/**
@@ -1121,16 +1299,7 @@ public:
 		auto FileEntry = FindFileInPakFiles(Filename, &PakFile);
 		if (FileEntry)
 		{
-			const FString Path(FPaths::GetPath(Filename));
-			const FPakDirectory* PakDirectory = PakFile->FindDirectory(*Path);
-			if (PakDirectory != nullptr)
-			{
-				const FString* RealFilename = PakDirectory->FindKey(const_cast<FPakEntry*>(FileEntry));
-				if (RealFilename != nullptr)
-				{
-					return *RealFilename;
-				}
-			}
+			return PakFile->GetRelativeFilename(*FileEntry);
 		}
 
 		// Fall back to lower level.
@@ -1139,6 +1308,8 @@ public:
 
 	virtual IFileHandle* OpenRead(const TCHAR* Filename, bool bAllowWrite = false) override;
 
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override;
+
 	virtual IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override
 	{
 		// No modifications allowed on pak files.
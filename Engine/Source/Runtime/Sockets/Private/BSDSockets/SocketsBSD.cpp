@@ -196,6 +196,107 @@ bool FSocketBSD::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketRe
 }
 
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_MMSG
+
+/** Most messages handed to a single sendmmsg/recvmmsg call, the headers live on the stack */
+#define MAX_MMSG_BATCH_SIZE 64
+
+bool FSocketBSD::SendToBatch(FSocketSendMessage* Messages, int32 NumMessages, int32& NumSent)
+{
+	mmsghdr Headers[MAX_MMSG_BATCH_SIZE];
+	iovec Buffers[MAX_MMSG_BATCH_SIZE];
+
+	NumSent = 0;
+
+	while (NumSent < NumMessages)
+	{
+		const int32 BatchSize = FMath::Min(NumMessages - NumSent, MAX_MMSG_BATCH_SIZE);
+
+		FMemory::Memzero(Headers, sizeof(mmsghdr) * BatchSize);
+
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			const FSocketSendMessage& Message = Messages[NumSent + Index];
+
+			Buffers[Index].iov_base = (void*)Message.Data;
+			Buffers[Index].iov_len = Message.Count;
+
+			Headers[Index].msg_hdr.msg_name = (sockaddr*)(FInternetAddrBSD&)*Message.Destination;
+			Headers[Index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			Headers[Index].msg_hdr.msg_iov = &Buffers[Index];
+			Headers[Index].msg_hdr.msg_iovlen = 1;
+		}
+
+		// If a message fails after others were sent, the count sent so far is returned and the next call reports the error
+		const int32 Result = sendmmsg(Socket, Headers, BatchSize, 0);
+
+		if (Result < 0)
+		{
+			break;
+		}
+
+		for (int32 Index = 0; Index < Result; ++Index)
+		{
+			Messages[NumSent + Index].BytesSent = Headers[Index].msg_len;
+		}
+
+		NumSent += Result;
+	}
+
+	if (NumSent > 0)
+	{
+		UpdateActivity();
+	}
+
+	return NumSent == NumMessages;
+}
+
+
+bool FSocketBSD::RecvFromBatch(FSocketRecvMessage* Messages, int32 NumMessages, int32& NumReceived, ESocketReceiveFlags::Type Flags)
+{
+	mmsghdr Headers[MAX_MMSG_BATCH_SIZE];
+	iovec Buffers[MAX_MMSG_BATCH_SIZE];
+
+	const int32 BatchSize = FMath::Min(NumMessages, MAX_MMSG_BATCH_SIZE);
+
+	FMemory::Memzero(Headers, sizeof(mmsghdr) * BatchSize);
+
+	for (int32 Index = 0; Index < BatchSize; ++Index)
+	{
+		FSocketRecvMessage& Message = Messages[Index];
+
+		Buffers[Index].iov_base = Message.Data;
+		Buffers[Index].iov_len = Message.BufferSize;
+
+		Headers[Index].msg_hdr.msg_name = (sockaddr*)(FInternetAddrBSD&)*Message.Source;
+		Headers[Index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		Headers[Index].msg_hdr.msg_iov = &Buffers[Index];
+		Headers[Index].msg_hdr.msg_iovlen = 1;
+	}
+
+	// On a non-blocking socket this returns whatever is queued. Like sendmmsg, an error after the first datagram is kept for the next call.
+	const int32 Result = recvmmsg(Socket, Headers, BatchSize, TranslateFlags(Flags), nullptr);
+
+	if (Result <= 0)
+	{
+		NumReceived = 0;
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Result; ++Index)
+	{
+		Messages[Index].BytesRead = Headers[Index].msg_len;
+	}
+
+	NumReceived = Result;
+	UpdateActivity();
+
+	return true;
+}
+
+#endif // PLATFORM_HAS_BSD_SOCKET_FEATURE_MMSG
+
+
 bool FSocketBSD::Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime)
 {
 	if ((Condition == ESocketWaitConditions::WaitForRead) || (Condition == ESocketWaitConditions::WaitForReadOrWrite))
@@ -41,4 +41,33 @@ bool FSocket::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketRecei
 		UE_LOG(LogSockets, Verbose, TEXT("Socket '%s' Recv %i Bytes"), *SocketDescription, BytesRead );
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+
+bool FSocket::SendToBatch(FSocketSendMessage* Messages, int32 NumMessages, int32& NumSent)
+{
+	for (NumSent = 0; NumSent < NumMessages; ++NumSent)
+	{
+		FSocketSendMessage& Message = Messages[NumSent];
+
+		if (!SendTo(Message.Data, Message.Count, Message.BytesSent, *Message.Destination))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+bool FSocket::RecvFromBatch(FSocketRecvMessage* Messages, int32 NumMessages, int32& NumReceived, ESocketReceiveFlags::Type Flags)
+{
+	NumReceived = 0;
+
+	if (NumMessages > 0 && RecvFrom(Messages[0].Data, Messages[0].BufferSize, Messages[0].BytesRead, *Messages[0].Source, Flags))
+	{
+		NumReceived = 1;
+	}
+
+	return NumReceived > 0;
+}
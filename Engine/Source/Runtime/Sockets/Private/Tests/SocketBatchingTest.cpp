@@ -0,0 +1,196 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "SocketsPrivatePCH.h"
+#include "Sockets.h"
+#include "AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSocketBatchingPerfTest, "System.Engine.Networking.Sockets.Batched Send And Receive", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace SocketBatchingTest
+{
+	/** Roughly a 64 player server at 30Hz, one packet per client per frame */
+	const int32 PacketsPerFrame = 64;
+	const int32 NumFrames = 300;
+	const int32 PacketSize = 400;
+
+	/** Give up on a frame's packets after this long, loopback should never drop but the test must not hang if it does */
+	const double ReceiveTimeout = 1.0;
+
+	struct FResult
+	{
+		int32 SocketCalls;
+		int32 PacketsReceived;
+		double Time;
+
+		FResult()
+			: SocketCalls(0)
+			, PacketsReceived(0)
+			, Time(0.0)
+		{
+		}
+	};
+
+	FSocket* CreateLoopbackSocket(ISocketSubsystem* SocketSubsystem, TSharedRef<FInternetAddr>& OutAddr)
+	{
+		FSocket* Socket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("SocketBatchingTest"), true);
+		if (Socket == nullptr)
+		{
+			return nullptr;
+		}
+
+		int32 BufferSize = 0;
+		Socket->SetNonBlocking();
+		Socket->SetReceiveBufferSize(PacketsPerFrame * PacketSize * 4, BufferSize);
+		Socket->SetSendBufferSize(PacketsPerFrame * PacketSize * 4, BufferSize);
+
+		OutAddr = SocketSubsystem->CreateInternetAddr(0x7f000001, 0);
+		if (!Socket->Bind(*OutAddr))
+		{
+			SocketSubsystem->DestroySocket(Socket);
+			return nullptr;
+		}
+
+		OutAddr->SetPort(Socket->GetPortNo());
+		return Socket;
+	}
+}
+
+/**
+ * Sends a frame's worth of packets over loopback and reads them back, first with one SendTo/RecvFrom per packet,
+ * then with SendToBatch/RecvFromBatch, and reports socket calls (system calls) and packets per second for both.
+ */
+bool FSocketBatchingPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace SocketBatchingTest;
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get();
+	if (SocketSubsystem == nullptr)
+	{
+		AddError(TEXT("No socket subsystem"));
+		return false;
+	}
+
+	TSharedRef<FInternetAddr> SenderAddr = SocketSubsystem->CreateInternetAddr();
+	TSharedRef<FInternetAddr> ReceiverAddr = SocketSubsystem->CreateInternetAddr();
+	FSocket* Sender = CreateLoopbackSocket(SocketSubsystem, SenderAddr);
+	FSocket* Receiver = CreateLoopbackSocket(SocketSubsystem, ReceiverAddr);
+
+	if (Sender == nullptr || Receiver == nullptr)
+	{
+		AddError(TEXT("Unable to create loopback sockets"));
+		SocketSubsystem->DestroySocket(Sender);
+		SocketSubsystem->DestroySocket(Receiver);
+		return false;
+	}
+
+	TArray<uint8> SendData;
+	SendData.SetNumUninitialized(PacketsPerFrame * PacketSize);
+	for (int32 Index = 0; Index < SendData.Num(); ++Index)
+	{
+		SendData[Index] = (uint8)Index;
+	}
+
+	TArray<uint8> RecvData;
+	RecvData.SetNumUninitialized(PacketsPerFrame * PacketSize);
+
+	TArray<TSharedRef<FInternetAddr>> SourceAddrs;
+	TArray<FSocketSendMessage> SendMessages;
+	TArray<FSocketRecvMessage> RecvMessages;
+	SendMessages.AddDefaulted(PacketsPerFrame);
+	RecvMessages.AddDefaulted(PacketsPerFrame);
+
+	for (int32 Index = 0; Index < PacketsPerFrame; ++Index)
+	{
+		SourceAddrs.Add(SocketSubsystem->CreateInternetAddr());
+
+		SendMessages[Index].Data = SendData.GetData() + Index * PacketSize;
+		SendMessages[Index].Count = PacketSize;
+		SendMessages[Index].Destination = &ReceiverAddr.Get();
+
+		RecvMessages[Index].Data = RecvData.GetData() + Index * PacketSize;
+		RecvMessages[Index].BufferSize = PacketSize;
+		RecvMessages[Index].Source = &SourceAddrs[Index].Get();
+	}
+
+	// One call per packet, the way UIpNetDriver used to work
+	FResult Single;
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (int32 Index = 0; Index < PacketsPerFrame; ++Index)
+			{
+				int32 BytesSent = 0;
+				Sender->SendTo(SendMessages[Index].Data, PacketSize, BytesSent, *ReceiverAddr);
+				Single.SocketCalls++;
+			}
+
+			int32 Received = 0;
+			const double FrameStart = FPlatformTime::Seconds();
+			while (Received < PacketsPerFrame && FPlatformTime::Seconds() - FrameStart < ReceiveTimeout)
+			{
+				int32 BytesRead = 0;
+				Single.SocketCalls++;
+				if (Receiver->RecvFrom(RecvData.GetData(), PacketSize, BytesRead, *SourceAddrs[0]) && BytesRead > 0)
+				{
+					Received++;
+				}
+			}
+			Single.PacketsReceived += Received;
+		}
+		Single.Time = FPlatformTime::Seconds() - StartTime;
+	}
+
+	// Batched
+	FResult Batched;
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			int32 NumSent = 0;
+			Sender->SendToBatch(SendMessages.GetData(), PacketsPerFrame, NumSent);
+			Batched.SocketCalls += PLATFORM_HAS_BSD_SOCKET_FEATURE_MMSG ? 1 : PacketsPerFrame;
+
+			int32 Received = 0;
+			const double FrameStart = FPlatformTime::Seconds();
+			while (Received < PacketsPerFrame && FPlatformTime::Seconds() - FrameStart < ReceiveTimeout)
+			{
+				int32 NumReceived = 0;
+				Batched.SocketCalls++;
+				if (Receiver->RecvFromBatch(RecvMessages.GetData() + Received, PacketsPerFrame - Received, NumReceived))
+				{
+					Received += NumReceived;
+				}
+			}
+			Batched.PacketsReceived += Received;
+		}
+		Batched.Time = FPlatformTime::Seconds() - StartTime;
+	}
+
+	const int32 NumPackets = PacketsPerFrame * NumFrames;
+
+	AddLogItem(FString::Printf(TEXT("%d packets of %d bytes, %d per frame (batched system calls %s)"),
+		NumPackets, PacketSize, PacketsPerFrame, PLATFORM_HAS_BSD_SOCKET_FEATURE_MMSG ? TEXT("available") : TEXT("not available, batches are loops")));
+	AddLogItem(FString::Printf(TEXT("Per packet: %6d socket calls (%5.1f per frame), %9.0f packets/s"),
+		Single.SocketCalls, (float)Single.SocketCalls / NumFrames, Single.PacketsReceived / FMath::Max(Single.Time, 1.0e-6)));
+	AddLogItem(FString::Printf(TEXT("Batched:    %6d socket calls (%5.1f per frame), %9.0f packets/s"),
+		Batched.SocketCalls, (float)Batched.SocketCalls / NumFrames, Batched.PacketsReceived / FMath::Max(Batched.Time, 1.0e-6)));
+
+	TestEqual(TEXT("Batched receive got every packet"), Batched.PacketsReceived, NumPackets);
+
+	bool bPayloadMatches = true;
+	for (int32 Index = 0; Index < PacketsPerFrame && bPayloadMatches; ++Index)
+	{
+		bPayloadMatches = RecvMessages[Index].BytesRead == PacketSize && FMemory::Memcmp(RecvMessages[Index].Data, SendMessages[Index].Data, PacketSize) == 0 && *RecvMessages[Index].Source == *SenderAddr;
+	}
+	TestTrue(TEXT("Batched receive returns the packets in order, with the sender's address"), bPayloadMatches);
+
+	SocketSubsystem->DestroySocket(Sender);
+	SocketSubsystem->DestroySocket(Receiver);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -6,6 +6,58 @@
 #include "IPAddress.h"
 #include "SocketTypes.h"
 
+/**
+ * One datagram of a batched send
+ */
+struct FSocketSendMessage
+{
+	/** The buffer to send */
+	const uint8* Data;
+
+	/** The size of the data to send */
+	int32 Count;
+
+	/** The network byte ordered address to send to */
+	const FInternetAddr* Destination;
+
+	/** Out param indicating how much was sent */
+	int32 BytesSent;
+
+	FSocketSendMessage()
+		: Data(nullptr)
+		, Count(0)
+		, Destination(nullptr)
+		, BytesSent(0)
+	{
+	}
+};
+
+/**
+ * One datagram of a batched receive
+ */
+struct FSocketRecvMessage
+{
+	/** The buffer to read into */
+	uint8* Data;
+
+	/** The max size of the buffer */
+	int32 BufferSize;
+
+	/** Out param indicating how many bytes were read */
+	int32 BytesRead;
+
+	/** Receives the address of the sender, must be created by the socket subsystem that created the socket */
+	FInternetAddr* Source;
+
+	FSocketRecvMessage()
+		: Data(nullptr)
+		, BufferSize(0)
+		, BytesRead(0)
+		, Source(nullptr)
+	{
+	}
+};
+
 /**
  * This is our abstract base class that hides the platform specific socket implementation
  */
@@ -155,6 +207,32 @@ public:
 	 */
 	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None);
 
+	/**
+	 * Sends several datagrams, with as few system calls as the platform allows (sendmmsg on Linux, one SendTo per message elsewhere).
+	 * Messages are sent in order, and sending stops at the first one that fails.
+	 *
+	 * @param Messages the datagrams to send, BytesSent is filled in for every message that was sent
+	 * @param NumMessages the number of entries in Messages
+	 * @param NumSent out param indicating how many messages were sent
+	 *
+	 * @return true if all messages were sent, false if one failed (the socket subsystem has the error code)
+	 */
+	virtual bool SendToBatch(FSocketSendMessage* Messages, int32 NumMessages, int32& NumSent);
+
+	/**
+	 * Reads up to NumMessages datagrams, with as few system calls as the platform allows (recvmmsg on Linux).
+	 * Platforms without a batched receive read one datagram per call, since a socket error (e.g. ICMP port unreachable)
+	 * is only reported once, and reading ahead would lose it.
+	 *
+	 * @param Messages buffers to read into, BytesRead and Source are filled in for every message that was read
+	 * @param NumMessages the number of entries in Messages
+	 * @param NumReceived out param indicating how many messages were read
+	 * @param Flags the receive flags
+	 *
+	 * @return true if any datagram was read, false if none could be (the socket subsystem has the error code)
+	 */
+	virtual bool RecvFromBatch(FSocketRecvMessage* Messages, int32 NumMessages, int32& NumReceived, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None);
+
 	/**
 	 * Blocks until the specified condition is met.
 	 *